@@ -0,0 +1,27 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <cstdint>
+#include <nncase/runtime/compiler_defs.h>
+#include <span>
+#include <vector>
+
+namespace nncase::codegen
+{
+/**
+ * @brief Compress a section body into a lz4 block, it's decompressed by the runtime on load.
+ */
+NNCASE_API std::vector<uint8_t> compress_section(std::span<const uint8_t> input);
+}
@@ -37,6 +37,9 @@ struct module_builder_params
 {
     const schedule::model_schedule_result &model_sched;
     const schedule::module_schedule_result &module_sched;
+    uint32_t max_batch;
+    bool compress_sections;
+    bool share_constants;
 };
 
 struct function_call_id
@@ -77,6 +80,8 @@ public:
     virtual ~module_builder() = default;
 
     uint32_t alignment() const noexcept { return alignment_; }
+    uint32_t max_batch() const noexcept { return params_.max_batch; }
+    bool dynamic_batch() const noexcept { return params_.max_batch > 1; }
     void config_dump(const std::filesystem::path &dump_dir, bool dump_asm);
     void build(binary_writer &writer);
 
@@ -111,10 +116,12 @@ private:
     void decompile(std::string_view stage, std::string_view section_name, std::span<const uint8_t> input, std::span<const symbol> symbols);
 
     void write_constants();
+    void remap_rdata_allocations(const std::unordered_map<size_t, size_t> &constant_starts);
     void generate_merge_info();
     void generate_symbol_offsets();
     void write_symbol_refs();
     void link();
+    void write_rdata_blocks();
     void write_binary(binary_writer &writer);
     void write_function_binary(binary_writer &writer, const schedule::function_schedule_result &function_sched);
 
@@ -125,6 +132,9 @@ private:
     std::map<std::string, section, std::less<>> section_writer_;
     std::map<std::string, rdata_merge_info, std::less<>> rdata_section_merges_;
     std::unordered_map<std::string_view, std::pair<size_t, std::string_view>> symbol_offsets_;
+    std::unordered_map<const ir::output_connector *, schedule::buffer_allocation> rdata_allocations_;
+    size_t rdata_usage_ = 0;
+    std::vector<std::pair<size_t, size_t>> rdata_blocks_;
 
     const schedule::function_schedule_result *current_function_;
     std::unordered_map<const schedule::function_schedule_result *, std::streampos> entry_points_;
@@ -1097,6 +1097,26 @@ struct op_writer<nncase::runtime::stackvm::tensor_lut1d_op_t>
     }
 };
 
+template <>
+struct op_writer<nncase::runtime::stackvm::tensor_matmul_op_t>
+{
+    void operator()(const nncase::runtime::stackvm::tensor_matmul_op_t &op, binary_writer &writer) const
+    {
+        writer.write(static_cast<uint8_t>(op.opcode));
+        writer.write(static_cast<uint16_t>(op.funct));
+        writer.write(static_cast<uint8_t>(op.datatype));
+        writer.write(op.rshape_src1);
+        writer.write(op.rstride_src1);
+        writer.write(op.rshape_src2);
+        writer.write(op.rstride_src2);
+        writer.write(op.rstride_dest);
+        writer.write(op.transpose_a);
+        writer.write(op.transpose_b);
+        writer.write(op.fused_clamp_low);
+        writer.write(op.fused_clamp_high);
+    }
+};
+
 template <>
 struct op_writer<nncase::runtime::stackvm::tensor_onehot_op_t>
 {
@@ -1129,6 +1149,29 @@ struct op_writer<nncase::runtime::stackvm::tensor_pad_op_t>
     }
 };
 
+template <>
+struct op_writer<nncase::runtime::stackvm::tensor_preprocess_op_t>
+{
+    void operator()(const nncase::runtime::stackvm::tensor_preprocess_op_t &op, binary_writer &writer) const
+    {
+        writer.write(static_cast<uint8_t>(op.opcode));
+        writer.write(static_cast<uint16_t>(op.funct));
+        writer.write(static_cast<uint8_t>(op.datatype));
+        writer.write(op.rshape_src);
+        writer.write(op.rstride_src);
+        writer.write(op.rstride_dest);
+        writer.write(op.rpaddings);
+        writer.write(op.input_nhwc);
+        writer.write(op.output_nhwc);
+        writer.write(op.swap_rb);
+        writer.write(op.zero_point);
+        writer.write(op.scale);
+        writer.write(op.resize_h);
+        writer.write(op.resize_w);
+        writer.write(op.pad_value);
+    }
+};
+
 template <>
 struct op_writer<nncase::runtime::stackvm::tensor_quantize_op_t>
 {
@@ -1465,8 +1508,10 @@ public:
     void tensor_gather_nd_(datatype_t datatype, uint8_t rshape_src, uint8_t rshape_dest, uint8_t rstride_src, uint8_t rstride_dest, uint8_t rshape_indices, uint8_t batch_dims);
     void tensor_hardmax_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, int32_t axis);
     void tensor_lut1d_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest, uint16_t table_len);
+    void tensor_matmul_(datatype_t datatype, uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rstride_dest, bool transpose_a, bool transpose_b, float fused_clamp_low, float fused_clamp_high);
     void tensor_onehot_(datatype_t datatype, uint8_t rshape_indices, uint8_t rshape_dest, uint8_t rstride_dest, uint8_t axis, onehot_mode_t onehot_mode);
     void tensor_pad_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest, uint8_t rpaddings, pad_mode_t pad_mode);
+    void tensor_preprocess_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest, uint8_t rpaddings, bool input_nhwc, bool output_nhwc, bool swap_rb, int32_t zero_point, float scale, int32_t resize_h, int32_t resize_w, float pad_value);
     void tensor_quantize_(datatype_t in_datatype, datatype_t dst_datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest);
     void tensor_random_normal_(datatype_t datatype_dest, uint8_t rshape_dest, float mean, float std, float seed);
     void tensor_random_uniform_(datatype_t datatype_dest, uint8_t rshape_dest, float low, float high, float seed);
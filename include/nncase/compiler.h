@@ -57,11 +57,19 @@ struct compile_options
     bool use_mse_quant_w = false;
     std::string input_layout = "NCHW";
     std::string output_layout = "NCHW";
+    uint32_t max_batch = 1;
+    std::string compute_type = "float32";
+    bool compress_sections = false;
+    bool share_constants = false;
+    uint32_t compile_threads = 1;
+    bool dump_pass_profile = false;
+    bool dump_eval_profile = false;
 };
 
 struct import_options
 {
     std::span<const std::string> output_arrays;
+    std::filesystem::path model_dir; // ONNX external data locations are relative to this directory
 };
 
 struct ptq_options_base
@@ -74,6 +82,7 @@ struct ptq_dataset_options : ptq_options_base
 {
     std::filesystem::path dataset;
     std::string dataset_format;
+    std::filesystem::path dataset_cache;
 };
 
 struct ptq_tensor_options : ptq_options_base
@@ -92,6 +101,7 @@ struct dump_range_dataset_options : dump_range_options_base
 {
     std::filesystem::path dataset;
     std::string dataset_format;
+    std::filesystem::path dataset_cache;
 };
 struct dump_range_tensor_options : dump_range_options_base
 {
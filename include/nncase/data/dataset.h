@@ -13,8 +13,10 @@
  * limitations under the License.
  */
 #pragma once
+#include <algorithm>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <nncase/io_utils.h>
 #include <nncase/runtime/datatypes.h>
 #include <optional>
@@ -95,7 +97,7 @@ public:
     };
 
     dataset(const std::filesystem::path &path, std::function<bool(const std::filesystem::path &)> file_filter, xt::dynamic_shape<size_t> input_shape, std::string input_layout);
-    virtual ~dataset() = default;
+    virtual ~dataset();
 
     template <class T>
     iterator<T> begin()
@@ -109,39 +111,73 @@ public:
         return { *this, filenames_.size() };
     }
 
-    size_t batch_size() const noexcept { return 1; }
+    size_t batch_size() const noexcept { return batch_size_; }
     size_t total_size() const noexcept { return filenames_.size(); }
 
+    /**
+     * @brief Set the samples per batch, samples are stacked on the first axis of the input shape.
+     *
+     * The last batch holds the remaining samples when the total size is not a multiple of it.
+     */
+    void batch_size(size_t value);
+
+    /**
+     * @brief Decode batches ahead of the iterator on background workers.
+     * @param workers Decode threads, 0 decodes in the iterator
+     * @param depth Max batches decoded ahead of the iterator
+     */
+    void prefetch(size_t workers, size_t depth = 4);
+
+    /**
+     * @brief Keep preprocessed samples in a directory, keyed by file, shape, layout and datatype.
+     *
+     * Passes over the dataset after the first one read the cache instead of decoding.
+     */
+    void cache_dir(std::filesystem::path path);
+
 protected:
     virtual void process(const std::vector<uint8_t> &src, float *dest, const xt::dynamic_shape<size_t> &shape, std::string layout) = 0;
     virtual void process(const std::vector<uint8_t> &src, uint8_t *dest, const xt::dynamic_shape<size_t> &shape, std::string layout) = 0;
     virtual void process(const std::vector<uint8_t> &src, int8_t *dest, const xt::dynamic_shape<size_t> &shape, std::string layout) = 0;
     virtual bool do_normalize() const noexcept { return true; }
+    virtual bool do_cache() const noexcept { return true; }
 
 private:
+    class prefetcher;
+    using sample_decoder = std::function<void(const std::vector<uint8_t> &src, uint8_t *dest)>;
+
     template <class T>
     std::optional<data_batch<T>> batch(size_t from)
     {
-        if (from + batch_size() <= filenames_.size())
+        if (from < filenames_.size())
         {
-            size_t start = from;
+            auto samples = std::min(batch_size_, filenames_.size() - from);
+            auto shape = input_shape_;
+            shape[0] *= samples;
 
-            xt::xarray<T> batch(input_shape_);
-            auto file = read_file(filenames_[from++]);
-            process(file, batch.data(), batch.shape(), input_layout_);
-
-            std::span<const std::filesystem::path> filenames(filenames_.data() + start, filenames_.data() + from);
+            xt::xarray<T> batch(shape);
+            load_batch(from, samples, reinterpret_cast<uint8_t *>(batch.data()), to_datatype<T>(), xt::compute_size(input_shape_) * sizeof(T),
+                [this](const std::vector<uint8_t> &src, uint8_t *dest) { process(src, reinterpret_cast<T *>(dest), input_shape_, input_layout_); });
 
+            std::span<const std::filesystem::path> filenames(filenames_.data() + from, samples);
             return data_batch<T> { std::move(batch), filenames };
         }
 
         return {};
     }
 
+    void load_batch(size_t from, size_t samples, uint8_t *dest, datatype_t type, size_t sample_bytes, sample_decoder decoder);
+    void load_sample(size_t index, uint8_t *dest, datatype_t type, size_t sample_bytes, const sample_decoder &decoder);
+
 private:
     std::vector<std::filesystem::path> filenames_;
     xt::dynamic_shape<size_t> input_shape_;
     std::string input_layout_;
+    size_t batch_size_ = 1;
+    size_t prefetch_workers_ = 0;
+    size_t prefetch_depth_ = 4;
+    std::filesystem::path cache_dir_;
+    std::unique_ptr<prefetcher> prefetcher_;
 };
 
 class NNCASE_API image_dataset : public dataset
@@ -165,5 +201,6 @@ protected:
     void process(const std::vector<uint8_t> &src, uint8_t *dest, const xt::dynamic_shape<size_t> &shape, std::string layout) override;
     void process(const std::vector<uint8_t> &src, int8_t *dest, const xt::dynamic_shape<size_t> &shape, std::string layout) override;
     bool do_normalize() const noexcept override { return false; }
+    bool do_cache() const noexcept override { return false; }
 };
 }
@@ -24,6 +24,7 @@ namespace nncase::importer
 struct import_options
 {
     std::span<const std::string> output_arrays;
+    std::filesystem::path model_dir; // ONNX external data locations are relative to this directory
 };
 
 void import_tflite(ir::graph &graph, std::span<const uint8_t> model, const import_options &options, std::string &real_inlayout, std::string &real_outlayout);
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #pragma once
+#include "evaluate_profiler.h"
 #include "evaluate_types.h"
 #include "quantizer.h"
 #include <nncase/schedule/schedule_types.h>
@@ -136,10 +137,14 @@ public:
     void end_sample();
     void end_collect_distribution(const std::function<void(size_t cnt, size_t total)> &progress);
 
+    evaluate_profiler *profiler() const noexcept { return profiler_; }
+    void profiler(evaluate_profiler *profiler) noexcept { profiler_ = profiler; }
+
     void evaluate(eval_step step, size_t stage, bool record_output_buffers);
 
 private:
     const schedule::model_schedule_result &sched_;
     std::unordered_map<module_type_t, module_evaluate_context> module_ctxs_;
+    evaluate_profiler *profiler_ = nullptr;
 };
 }
@@ -0,0 +1,64 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "node.h"
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nncase::ir
+{
+struct node_cost
+{
+    uint64_t flops = 0; // multiply and add count as one op each
+    uint64_t bytes = 0; // inputs read plus outputs written once
+};
+
+struct node_eval_profile
+{
+    std::string name;
+    std::string opcode;
+    node_cost cost;
+    size_t runs = 0;
+    std::chrono::nanoseconds duration {};
+};
+
+struct machine_peak
+{
+    double gflops = 0;
+    double gbps = 0;
+};
+
+// Measured once per process on the calling thread
+NNCASE_API const machine_peak &measure_machine_peak();
+NNCASE_API node_cost estimate_cost(node &n);
+
+class NNCASE_API evaluate_profiler
+{
+public:
+    void record(node &n, std::chrono::nanoseconds duration);
+    const std::vector<node_eval_profile> &entries() const noexcept { return entries_; }
+
+    // Per node time, throughput and roofline efficiency, slowest first
+    void dump(std::ostream &output, const machine_peak &peak) const;
+
+private:
+    std::unordered_map<node *, size_t> indices_;
+    std::vector<node_eval_profile> entries_;
+};
+}
@@ -33,6 +33,9 @@ public:
     void end_sample();
     void end_collect_distribution(const std::function<void(size_t cnt, size_t total)> &progress);
 
+    // Time every node evaluated until it is reset to nullptr
+    void profiler(evaluate_profiler *profiler) noexcept;
+
     evaluate_tensor memory_at(const output_connector &conn);
     evaluate_tensor memory_at(const input_connector &conn);
 
@@ -181,6 +181,27 @@ inline shape_t get_binary_output_shape(const shape_t &input_a_shape, const shape
     return out_shape;
 }
 
+inline shape_t get_matmul_output_shape(const shape_t &input_a_shape, const shape_t &input_b_shape, bool transpose_a, bool transpose_b)
+{
+    if (input_a_shape.size() < 2 || input_b_shape.size() < 2)
+        throw std::invalid_argument("matmul inputs must be at least 2 rank");
+
+    const auto a_rank = input_a_shape.size(), b_rank = input_b_shape.size();
+    const auto m = input_a_shape[a_rank - (transpose_a ? 1 : 2)];
+    const auto k = input_a_shape[a_rank - (transpose_a ? 2 : 1)];
+    const auto b_k = input_b_shape[b_rank - (transpose_b ? 1 : 2)];
+    const auto n = input_b_shape[b_rank - (transpose_b ? 2 : 1)];
+    if (k != b_k)
+        throw std::invalid_argument("input a's cols must be equal to input b's rows");
+
+    // Batch dims broadcast like binary ops
+    auto out_shape = get_binary_output_shape(shape_t(input_a_shape.begin(), input_a_shape.end() - 2),
+        shape_t(input_b_shape.begin(), input_b_shape.end() - 2));
+    out_shape.push_back(m);
+    out_shape.push_back(n);
+    return out_shape;
+}
+
 inline std::vector<shape_t> get_input_shapes(std::span<input_connector *const> inputs)
 {
     std::vector<shape_t> shapes;
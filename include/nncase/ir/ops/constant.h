@@ -16,6 +16,7 @@
 #include "../debug.h"
 #include "../node.h"
 #include "../op_utils.h"
+#include <memory>
 #include <nncase/runtime/debug.h>
 #include <vector>
 
@@ -79,7 +80,18 @@ public:
 
     template <class TShape, class... TDataArgs>
     constant(datatype_t type, TShape &&shape, TDataArgs... data_args)
-        : data_(std::forward<TDataArgs>(data_args)...), datatype_(type)
+        : storage_(std::forward<TDataArgs>(data_args)...), data_(storage_), datatype_(type)
+    {
+        if (ir::get_bytes(type, shape) != data_.size())
+            throw std::invalid_argument("Shape and data size don't match");
+        add_output("output", type, std::forward<TShape>(shape), mem_rdata)
+            .attributes(cnctr_attr_no_layout_strides);
+    }
+
+    // References data owned by keep_alive (e.g. a mapped weights file) instead of copying it
+    template <class TShape>
+    constant(datatype_t type, TShape &&shape, std::span<const std::byte> data, std::shared_ptr<const void> keep_alive)
+        : data_(data), keep_alive_(std::move(keep_alive)), datatype_(type)
     {
         if (ir::get_bytes(type, shape) != data_.size())
             throw std::invalid_argument("Shape and data size don't match");
@@ -134,7 +146,9 @@ protected:
     bool properties_equal(node &other) const override;
 
 private:
-    std::vector<std::byte> data_;
+    std::vector<std::byte> storage_;
+    std::span<const std::byte> data_;
+    std::shared_ptr<const void> keep_alive_;
     datatype_t datatype_;
     size_t alignment_ = 8;
 };
@@ -44,6 +44,7 @@ public:
     value_range<float> fused_activation() const noexcept { return fused_activation_; }
 
     conv2d(shape_t input_shape, shape_t weights_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation);
+    conv2d(datatype_t input_type, shape_t input_shape, shape_t weights_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation);
 
 protected:
     bool properties_equal(node &other) const override;
@@ -29,13 +29,17 @@ public:
     output_connector &output() { return output_at(0); }
 
     value_range<float> fused_activation() const noexcept { return fused_activation_; }
+    bool transpose_a() const noexcept { return transpose_a_; }
+    bool transpose_b() const noexcept { return transpose_b_; }
 
-    matmul(shape_t input_a_shape, shape_t input_b_shape, value_range<float> fused_activation);
+    matmul(shape_t input_a_shape, shape_t input_b_shape, value_range<float> fused_activation, bool transpose_a = false, bool transpose_b = false);
 
 protected:
     bool properties_equal(node &other) const override;
 
 private:
     value_range<float> fused_activation_;
+    bool transpose_a_;
+    bool transpose_b_;
 };
 }
@@ -0,0 +1,60 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../node.h"
+#include <xtensor/xtensor.hpp>
+
+namespace nncase::ir
+{
+/**
+ * Fused input preprocessing: dequantize, layout change, RGB<->BGR swap,
+ * letterbox (bilinear resize + constant pad on H/W) and mean/std normalize.
+ * Inputs are the frame (N, C, H, W or N, H, W, C), mean [C] and std [C].
+ * Output is always float32.
+ */
+class NNCASE_API preprocess : public node
+{
+public:
+    DEFINE_NODE_OPCODE(op_preprocess);
+
+    input_connector &input() { return input_at(0); }
+    input_connector &mean() { return input_at(1); }
+    input_connector &std() { return input_at(2); }
+    output_connector &output() { return output_at(0); }
+
+    bool input_nhwc() const noexcept { return input_nhwc_; }
+    bool output_nhwc() const noexcept { return output_nhwc_; }
+    bool swap_rb() const noexcept { return swap_rb_; }
+    const quant_param_t &dequant() const noexcept { return dequant_; }
+    const std::array<int32_t, 2> &resize_shape() const noexcept { return resize_shape_; }
+    const xt::svector<padding> &paddings() const noexcept { return paddings_; }
+    float pad_value() const noexcept { return pad_value_; }
+
+    preprocess(datatype_t input_type, shape_t input_shape, bool input_nhwc, bool output_nhwc, bool swap_rb, quant_param_t dequant,
+        std::array<int32_t, 2> resize_shape, xt::svector<padding> paddings, float pad_value);
+
+protected:
+    bool properties_equal(node &other) const override;
+
+private:
+    bool input_nhwc_;
+    bool output_nhwc_;
+    bool swap_rb_;
+    quant_param_t dequant_;
+    std::array<int32_t, 2> resize_shape_;
+    xt::svector<padding> paddings_;
+    float pad_value_;
+};
+}
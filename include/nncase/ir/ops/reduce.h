@@ -32,6 +32,7 @@ public:
     bool keep_dims() const noexcept { return keep_dims_; }
 
     reduce(reduce_op_t reduce_op, shape_t input_shape, axis_t axis, float init_value, bool keep_dims);
+    reduce(datatype_t input_type, reduce_op_t reduce_op, shape_t input_shape, axis_t axis, float init_value, bool keep_dims);
 
 protected:
     bool properties_equal(node &other) const override;
@@ -29,6 +29,7 @@ public:
     unary_op_t unary_op() const noexcept { return unary_op_; }
 
     unary(unary_op_t unary_op, shape_t input_shape);
+    unary(datatype_t input_type, unary_op_t unary_op, shape_t input_shape);
 
 protected:
     bool properties_equal(node &other) const override;
@@ -17,10 +17,51 @@
 #include <nncase/runtime/datatypes.h>
 #include <nncase/runtime/error.h>
 #include <nncase/runtime/result.h>
+#include <string>
+#include <vector>
 
 BEGIN_NS_NNCASE_KERNELS
 
-NNCASE_API result<void> conv2d(const float *input, const float *weights, const float *bias, float *output,
+using conv2d_float_kernel_t = result<void> (*)(const float *input, const float *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept;
+
+/**
+ * @brief Conv2d kernel variant selected from the static shapes and attributes.
+ */
+struct conv2d_plan
+{
+    /// Specialized float kernel, 16bit types run it on widened images. The reference kernel is used when it is nullptr
+    conv2d_float_kernel_t kernel;
+    const char *name;
+};
+
+NNCASE_API conv2d_plan plan_conv2d(datatype_t type, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape,
+    const padding &padding_h, const padding &padding_w, int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w) noexcept;
+
+/**
+ * @brief A conv2d variant the kernel tuner times, a num_threads of 0 keeps the thread count of the context.
+ */
+struct conv2d_candidate
+{
+    conv2d_plan plan;
+    uint32_t num_threads;
+    std::string name;
+};
+
+/// The static plan on all the threads comes first, then halved thread counts and the reference kernel
+NNCASE_API std::vector<conv2d_candidate> conv2d_candidates(const conv2d_plan &plan, uint32_t num_threads);
+
+template <class T>
+NNCASE_API result<void> conv2d(const T *input, const T *weights, const T *bias, T *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,
+    const conv2d_plan &plan, kernel_context &context = default_kernel_context()) noexcept;
+
+template <class T>
+NNCASE_API result<void> conv2d(const T *input, const T *weights, const T *bias, T *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
     const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
     int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
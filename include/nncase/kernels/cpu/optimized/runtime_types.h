@@ -35,7 +35,7 @@
     }                                 \
     }
 
-enum copy_impl_select
+enum copy_impl_select : int32_t
 {
     all_contiguous,
     src_contiguous,
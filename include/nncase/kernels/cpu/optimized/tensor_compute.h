@@ -15,6 +15,7 @@
 #pragma once
 #include "runtime_types.h"
 #include <cstring>
+#include <nncase/kernels/convolution.h>
 
 BEGIN_NS_NNCASE_KERNELS_CPU_OPT
 
@@ -22,6 +23,11 @@ NNCASE_API result<void> concat(datatype_t type, gsl::span<const gsl::byte *const
     gsl::span<const runtime_shape_t> in_strides, const runtime_shape_t &out_strides, size_t axis, const runtime_shape_t &concat_dims,
     kernel_context &context = default_kernel_context()) noexcept;
 
+NNCASE_API result<void> preprocess(datatype_t type, const gsl::byte *input, float *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool input_nhwc, bool output_nhwc, bool swap_rb,
+    const quant_param_t &dequant, int32_t resize_h, int32_t resize_w, const runtime_paddings_t &paddings, float pad_value,
+    const float *mean, const float *std, kernel_context &context = default_kernel_context()) noexcept;
+
 NNCASE_API result<void> resize_bilinear(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers,
     kernel_context &context = default_kernel_context()) noexcept;
@@ -30,6 +36,10 @@ NNCASE_API result<void> resize_nearest_neighbor(datatype_t type, const gsl::byte
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers,
     kernel_context &context = default_kernel_context()) noexcept;
 
+NNCASE_API result<void> convert(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides,
+    kernel_context &context = default_kernel_context()) noexcept;
+
 NNCASE_API result<void> copy(datatype_t type, const gsl::byte *src, gsl::byte *dest,
     const runtime_shape_t &shape, const runtime_shape_t &src_strides, const runtime_shape_t &dest_strides,
     int dims_offset, copy_impl_select impl_select, kernel_context &context) noexcept;
@@ -39,6 +49,9 @@ NNCASE_API result<void> conv2d(const float *input, const float *weights, const f
     const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
     int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept;
 
+NNCASE_API conv2d_plan select_conv2d(const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape,
+    const padding &padding_h, const padding &padding_w, int32_t groups, int32_t stride_h, int32_t stride_w) noexcept;
+
 NNCASE_API result<void> dequantize(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, float scale, float bias,
     kernel_context &context) noexcept;
@@ -51,9 +64,18 @@ NNCASE_API result<void> gather_nd(datatype_t type, const gsl::byte *input, gsl::
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const int32_t *indices, const runtime_shape_t &indices_shape, size_t batch_dims,
     kernel_context &context = default_kernel_context()) noexcept;
 
+NNCASE_API result<void> matmul(const float *input_a, const float *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, bool transpose_a, bool transpose_b,
+    value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
+
 NNCASE_API result<void> onehot(datatype_t type, const int32_t *indices, gsl::byte *output, const runtime_shape_t &indices_shape, const runtime_shape_t &out_shape,
     const runtime_shape_t &out_strides, gsl::byte *depth, gsl::byte *off_value, gsl::byte *on_value, size_t axis, onehot_mode_t mode, kernel_context &context) noexcept;
 
+NNCASE_API result<void> pad(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const runtime_paddings_t &paddings, pad_mode_t mode,
+    const scalar &pad_value, kernel_context &context = default_kernel_context()) noexcept;
+
 NNCASE_API result<void> quantize(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, float scale, float bias,
     kernel_context &context) noexcept;
@@ -62,4 +84,9 @@ NNCASE_API result<void> slice(datatype_t type, const gsl::byte *input, gsl::byte
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const runtime_shape_t &begins, const runtime_axis_t &ends, const runtime_axis_t &strides,
     kernel_context &context = default_kernel_context()) noexcept;
 
+template <typename T>
+NNCASE_API result<void> topk(const T *input, T *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, const int64_t k, const int32_t axis, const bool largest, const bool sorted,
+    kernel_context &context = default_kernel_context()) noexcept;
+
 END_NS_NNCASE_KERNELS_CPU_OPT
@@ -18,7 +18,8 @@
 
 BEGIN_NS_NNCASE_KERNELS_CPU_REF
 
-NNCASE_API result<void> conv2d(const float *input, const float *weights, const float *bias, float *output,
+template <class T>
+NNCASE_API result<void> conv2d(const T *input, const T *weights, const T *bias, T *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
     const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
     int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept;
@@ -15,13 +15,80 @@
 #pragma once
 #include <nncase/runtime/result.h>
 
+BEGIN_NS_NNCASE_RUNTIME
+class allocation_tracker;
+class kernel_tuner;
+END_NS_NNCASE_RUNTIME
+
 BEGIN_NS_NNCASE_KERNELS
 
 struct NNCASE_API kernel_context
 {
     uint32_t num_threads;
+    // Temporary buffers of the kernels are allocated and counted here when set
+    runtime::allocation_tracker *scratch_allocator = nullptr;
+    // Kernel variants and thread counts are picked by it when set
+    runtime::kernel_tuner *tuner = nullptr;
 };
 
 NNCASE_API kernel_context &default_kernel_context();
 
+namespace detail
+{
+NNCASE_API result<gsl::span<gsl::byte>> allocate_scratch(runtime::allocation_tracker *allocator, size_t bytes) noexcept;
+NNCASE_API void free_scratch(runtime::allocation_tracker *allocator, gsl::span<gsl::byte> buffer) noexcept;
+}
+
+/**
+ * @brief A temporary buffer of a kernel, uninitialized.
+ */
+template <class T>
+class scratch_buffer
+{
+    static_assert(std::is_trivially_destructible_v<T>);
+
+public:
+    scratch_buffer() = default;
+    scratch_buffer(const scratch_buffer &) = delete;
+    scratch_buffer(scratch_buffer &&other) noexcept
+        : allocator_(other.allocator_), buffer_(other.buffer_), count_(other.count_)
+    {
+        other.buffer_ = {};
+        other.count_ = 0;
+    }
+
+    ~scratch_buffer()
+    {
+        detail::free_scratch(allocator_, buffer_);
+    }
+
+    scratch_buffer &operator=(const scratch_buffer &) = delete;
+    scratch_buffer &operator=(scratch_buffer &&other) noexcept
+    {
+        std::swap(allocator_, other.allocator_);
+        std::swap(buffer_, other.buffer_);
+        std::swap(count_, other.count_);
+        return *this;
+    }
+
+    static result<scratch_buffer> allocate(kernel_context &context, size_t count) noexcept
+    {
+        scratch_buffer buffer;
+        buffer.allocator_ = context.scratch_allocator;
+        try_set(buffer.buffer_, detail::allocate_scratch(buffer.allocator_, count * sizeof(T)));
+        buffer.count_ = count;
+        return ok(std::move(buffer));
+    }
+
+    T *data() const noexcept { return reinterpret_cast<T *>(buffer_.data()); }
+    size_t size() const noexcept { return count_; }
+    T &operator[](size_t index) const noexcept { return data()[index]; }
+
+private:
+    runtime::allocation_tracker *allocator_ = nullptr;
+    // The allocator may return more than asked, the whole span goes back to it
+    gsl::span<gsl::byte> buffer_;
+    size_t count_ = 0;
+};
+
 END_NS_NNCASE_KERNELS
\ No newline at end of file
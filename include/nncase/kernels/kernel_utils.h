@@ -134,6 +134,33 @@ inline T apply_activation(T value, value_range<T> activation)
     return clamp(value, activation.min, activation.max);
 }
 
+// Narrows a float result to T, bfloat16 is rounded to nearest instead of truncated
+template <class T>
+inline T from_float(float value) noexcept
+{
+    return static_cast<T>(value);
+}
+
+template <>
+inline bfloat16 from_float<bfloat16>(float value) noexcept
+{
+    return bfloat16::round_to_bfloat16(value);
+}
+
+// Float to integer conversion truncating toward zero, out of range values saturate and NaN becomes 0
+template <class T>
+inline T saturate_cast(float value) noexcept
+{
+    static_assert(std::is_integral_v<T>);
+    constexpr auto lo = (float)std::numeric_limits<T>::lowest();
+    // Largest float not above max(), 32/64-bit max() itself rounds up out of range
+    constexpr auto hi = (float)(std::numeric_limits<T>::max() - (std::numeric_limits<T>::max() >> 24));
+    value = value != value ? 0.f : value;
+    value = value > lo ? value : lo;
+    value = value < hi ? value : hi;
+    return static_cast<T>(value);
+}
+
 template <class TShape>
 TShape get_reduced_offset(const TShape &in_offset, const TShape &reduced_shape)
 {
@@ -289,5 +316,124 @@ inline size_t get_nearest_neighbor(T input_value, size_t shape_size, float scale
     return output_value;
 }
 
+// Gather indices may be negative (counted from the end of the axis)
+inline size_t normalize_gather_index(int32_t index, size_t dim) noexcept
+{
+    return index < 0 ? size_t(index + (int32_t)dim) : size_t(index);
+}
+
+// Checks every index tuple of gather/gather_nd against the dims it selects from
+inline bool check_gather_indices(const int32_t *indices, size_t count, const size_t *dims, size_t dims_count) noexcept
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        auto index = indices[i];
+        auto dim = (int32_t)dims[i % dims_count];
+        if (index < -dim || index >= dim)
+            return false;
+    }
+
+    return true;
+}
+
+// Merges the innermost dims that are dense in both tensors into rows for elementwise kernels,
+// fails when the last dim is strided in either of them
+inline bool get_contiguous_rows(const runtime_shape_t &shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides,
+    size_t &outer_dims, size_t &row_size) noexcept
+{
+    outer_dims = shape.size();
+    row_size = 1;
+    while (outer_dims)
+    {
+        const auto dim = outer_dims - 1;
+        if (shape[dim] != 1 && (in_strides[dim] != row_size || out_strides[dim] != row_size))
+            break;
+        row_size *= shape[dim];
+        outer_dims--;
+    }
+
+    return outer_dims == 0 || row_size > 1;
+}
+
+// Element offsets of a row from get_contiguous_rows
+inline void get_row_offsets(size_t row, const runtime_shape_t &shape, size_t outer_dims, const runtime_shape_t &in_strides,
+    const runtime_shape_t &out_strides, size_t &in_offset, size_t &out_offset) noexcept
+{
+    in_offset = out_offset = 0;
+    for (size_t i = outer_dims; i-- > 0;)
+    {
+        const auto index = row % shape[i];
+        row /= shape[i];
+        in_offset += index * in_strides[i];
+        out_offset += index * out_strides[i];
+    }
+}
+
+// Pads without interior or negative paddings whose last dim is dense in both tensors can be done a row at a time
+inline bool is_row_padding(const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides,
+    const runtime_paddings_t &paddings) noexcept
+{
+    if (std::any_of(paddings.begin(), paddings.end(), [](const padding &p) { return p.before < 0 || p.after < 0 || p.interior != 0; }))
+        return false;
+    if (in_shape.empty())
+        return true;
+
+    const auto width = in_shape.back();
+    const auto out_width = width + paddings.back().sum();
+    return (width == 1 || in_strides.back() == 1) && (out_width == 1 || out_strides.back() == 1);
+}
+
+// Batch dims of a matmul broadcast like binary ops, the last two dims are the matrices
+inline bool get_matmul_output_shape(const runtime_shape_t &in_a_shape, const runtime_shape_t &in_b_shape, bool transpose_a, bool transpose_b, runtime_shape_t &out_shape) noexcept
+{
+    if (in_a_shape.size() < 2 || in_b_shape.size() < 2)
+        return false;
+
+    const auto a_rank = in_a_shape.size(), b_rank = in_b_shape.size();
+    const auto m = in_a_shape[a_rank - (transpose_a ? 1 : 2)];
+    const auto k = in_a_shape[a_rank - (transpose_a ? 2 : 1)];
+    const auto b_k = in_b_shape[b_rank - (transpose_b ? 1 : 2)];
+    const auto n = in_b_shape[b_rank - (transpose_b ? 2 : 1)];
+    if (k != b_k)
+        return false;
+
+    const auto out_rank = std::max(a_rank, b_rank);
+    out_shape.resize(out_rank);
+    for (size_t i = 0; i < out_rank - 2; i++)
+    {
+        const auto a_dim = (int32_t)i - (int32_t)(out_rank - a_rank);
+        const auto b_dim = (int32_t)i - (int32_t)(out_rank - b_rank);
+        const auto a = a_dim < 0 ? 1 : in_a_shape[a_dim];
+        const auto b = b_dim < 0 ? 1 : in_b_shape[b_dim];
+        if (a != b && a != 1 && b != 1)
+            return false;
+        out_shape[i] = a == 1 ? b : a;
+    }
+
+    out_shape[out_rank - 2] = m;
+    out_shape[out_rank - 1] = n;
+    return true;
+}
+
+// Element offsets of the operands and the output for a linear batch index of a matmul
+inline void get_matmul_batch_offsets(size_t batch, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape, const runtime_shape_t &in_b_strides,
+    size_t &a_offset, size_t &b_offset, size_t &out_offset) noexcept
+{
+    a_offset = b_offset = out_offset = 0;
+    const auto batch_rank = (int32_t)out_shape.size() - 2;
+    const auto a_ext = batch_rank - ((int32_t)in_a_shape.size() - 2);
+    const auto b_ext = batch_rank - ((int32_t)in_b_shape.size() - 2);
+    for (int32_t i = batch_rank - 1; i >= 0; i--)
+    {
+        const auto index = batch % out_shape[i];
+        batch /= out_shape[i];
+        out_offset += index * out_strides[i];
+        if (i >= a_ext && in_a_shape[i - a_ext] != 1)
+            a_offset += index * in_a_strides[i - a_ext];
+        if (i >= b_ext && in_b_shape[i - b_ext] != 1)
+            b_offset += index * in_b_strides[i - b_ext];
+    }
+}
 }
 END_NS_NNCASE_KERNELS
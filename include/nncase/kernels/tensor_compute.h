@@ -17,6 +17,9 @@
 #include <nncase/runtime/datatypes.h>
 #include <nncase/runtime/error.h>
 #include <nncase/runtime/result.h>
+#include <vector>
+
+enum copy_impl_select : int32_t;
 
 BEGIN_NS_NNCASE_KERNELS
 
@@ -37,10 +40,31 @@ NNCASE_API result<void> convert(datatype_t in_type, datatype_t out_type, const g
 NNCASE_API result<void> copy(datatype_t type, const gsl::byte *src, gsl::byte *dest,
     const runtime_shape_t &shape, const runtime_shape_t &src_strides, const runtime_shape_t &dest_strides, kernel_context &context = default_kernel_context()) noexcept;
 
+/**
+ * @brief Copy kernel variant selected from the shape and strides.
+ */
+struct copy_plan
+{
+    /// The reference kernel is used when neither side is contiguous
+    bool optimized;
+    copy_impl_select impl_select;
+    int dims_offset;
+    const char *name;
+};
+
+NNCASE_API copy_plan plan_copy(const runtime_shape_t &shape, const runtime_shape_t &src_strides, const runtime_shape_t &dest_strides) noexcept;
+
+/// Plans the kernel tuner times against each other, the static plan comes first
+NNCASE_API std::vector<copy_plan> copy_candidates(const copy_plan &plan);
+
+NNCASE_API result<void> copy(datatype_t type, const gsl::byte *src, gsl::byte *dest, const runtime_shape_t &shape, const runtime_shape_t &src_strides,
+    const runtime_shape_t &dest_strides, const copy_plan &plan, kernel_context &context = default_kernel_context()) noexcept;
+
 NNCASE_API result<void> transpose(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
     const runtime_shape_t &perm, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context = default_kernel_context()) noexcept;
 
-NNCASE_API result<void> binary(binary_op_t op, const float *input_a, const float *input_b, float *output,
+template <class T>
+NNCASE_API result<void> binary(binary_op_t op, const T *input_a, const T *input_b, T *output,
     const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
     const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
 
@@ -51,6 +75,11 @@ NNCASE_API result<void> dequantize(datatype_t in_type, datatype_t out_type, cons
 NNCASE_API result<void> lut1d(datatype_t type, const gsl::byte *input, const gsl::byte *table, gsl::byte *output, const runtime_shape_t &shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const scalar &min, const scalar &max) noexcept;
 
+NNCASE_API result<void> matmul(const float *input_a, const float *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, bool transpose_a, bool transpose_b,
+    value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
+
 NNCASE_API result<void> onehot(datatype_t type, const int32_t *indices, gsl::byte *output, const runtime_shape_t &indices_shape, const runtime_shape_t &out_shape,
     const runtime_shape_t &out_strides, gsl::byte *depth, gsl::byte *off_value, gsl::byte *on_value, size_t axis, onehot_mode_t mode,
     kernel_context &context = default_kernel_context()) noexcept;
@@ -63,10 +92,12 @@ NNCASE_API result<void> quantize(datatype_t in_type, datatype_t out_type, const
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, float scale, float bias,
     kernel_context &context = default_kernel_context()) noexcept;
 
-NNCASE_API result<void> unary(unary_op_t op, const float *input, float *output, const runtime_shape_t &shape,
+template <class T>
+NNCASE_API result<void> unary(unary_op_t op, const T *input, T *output, const runtime_shape_t &shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context = default_kernel_context()) noexcept;
 
-NNCASE_API result<void> reduce(reduce_op_t op, float init_value, const float *input, float *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
+template <class T>
+NNCASE_API result<void> reduce(reduce_op_t op, float init_value, const T *input, T *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool keep_dims, kernel_context &context = default_kernel_context()) noexcept;
 
 template <typename T>
@@ -79,6 +110,11 @@ result<void> reduce_prod(const T *input, T *output, const runtime_shape_t &in_sh
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides,
     const runtime_shape_t &axes, bool keep_dims) noexcept;
 
+NNCASE_API result<void> preprocess(datatype_t type, const gsl::byte *input, float *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool input_nhwc, bool output_nhwc, bool swap_rb,
+    const quant_param_t &dequant, int32_t resize_h, int32_t resize_w, const runtime_paddings_t &paddings, float pad_value,
+    const float *mean, const float *std, kernel_context &context = default_kernel_context()) noexcept;
+
 NNCASE_API result<void> resize_bilinear(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers,
     kernel_context &context = default_kernel_context()) noexcept;
@@ -122,6 +158,6 @@ NNCASE_API result<void> topk(const T *input, T *output_values, int64_t *output_i
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
     const runtime_shape_t &output_values_shape, const runtime_shape_t &output_values_strides,
     const runtime_shape_t &output_indices_shape, const runtime_shape_t &output_indices_strides,
-    const int64_t k, const int32_t axis, const bool largest, const bool sorted) noexcept;
+    const int64_t k, const int32_t axis, const bool largest, const bool sorted, kernel_context &context = default_kernel_context()) noexcept;
 
 END_NS_NNCASE_KERNELS
@@ -13,11 +13,27 @@
  * limitations under the License.
  */
 #pragma once
+#include "datatypes.h"
+#include "model.h"
+#include "result.h"
+#include <array>
+#include <atomic>
 #include <memory>
 #include <nncase/runtime/compiler_defs.h>
+#include <vector>
 
 BEGIN_NS_NNCASE_RUNTIME
 
+enum class memory_category_t : uint8_t
+{
+    data,
+    section,
+    tensor,
+    scratch
+};
+
+NNCASE_INLINE_VAR constexpr size_t memory_categories = 4;
+
 class NNCASE_API allocation_state
 {
 public:
@@ -28,7 +44,97 @@ class NNCASE_API host_allocator
 {
 public:
     virtual ~host_allocator();
+
+    /**
+     * @brief Returns an empty span when out of memory.
+     */
     virtual gsl::span<gsl::byte> allocate(allocation_state &state, size_t bytes) = 0;
+
+    /**
+     * @brief Does nothing by default, for allocators that release their memory on their own.
+     */
+    virtual void free(allocation_state &state, gsl::span<gsl::byte> buffer) noexcept;
+};
+
+NNCASE_API host_allocator &default_host_allocator() noexcept;
+
+struct memory_usage
+{
+    size_t data_bytes = 0;
+    size_t section_bytes = 0;
+    size_t tensor_bytes = 0;
+    size_t scratch_bytes = 0;
+    size_t peak_scratch_bytes = 0;
+    size_t peak_bytes = 0;
+
+    size_t total_bytes() const noexcept { return data_bytes + section_bytes + tensor_bytes + scratch_bytes; }
+};
+
+struct module_memory_stats
+{
+    module_type_t type;
+    std::vector<mempool_desc> mempools;
+    memory_usage usage;
+};
+
+struct runtime_memory_stats
+{
+    std::vector<module_memory_stats> modules;
+    memory_usage usage;
+};
+
+/**
+ * @brief Allocates through a host_allocator and counts the live bytes of each category.
+ *
+ * A module's tracker has the interpreter's one as parent, so an allocation is
+ * counted by both. The allocator always receives the root tracker as state.
+ * Trackers are shared, buffers and tensors keep theirs alive.
+ */
+class NNCASE_API allocation_tracker : public allocation_state, public std::enable_shared_from_this<allocation_tracker>
+{
+public:
+    struct deleter
+    {
+        std::shared_ptr<allocation_tracker> tracker;
+        memory_category_t category;
+        size_t bytes;
+        // Size of the span the allocator returned, it gets the whole span back
+        size_t capacity;
+
+        void operator()(gsl::byte *ptr) const noexcept
+        {
+            tracker->free(category, { ptr, capacity });
+        }
+    };
+
+    using buffer_t = std::unique_ptr<gsl::byte[], deleter>;
+
+    explicit allocation_tracker(host_allocator &allocator) noexcept;
+    explicit allocation_tracker(std::shared_ptr<allocation_tracker> parent) noexcept;
+
+    host_allocator &allocator() const noexcept { return allocator_; }
+
+    /**
+     * @brief Returns the span of the allocator, it may be larger than bytes and is counted whole. Pass it to free unchanged.
+     */
+    result<gsl::span<gsl::byte>> allocate(memory_category_t category, size_t bytes) noexcept;
+    void free(memory_category_t category, gsl::span<gsl::byte> buffer) noexcept;
+    result<buffer_t> allocate_buffer(memory_category_t category, size_t bytes) noexcept;
+
+    memory_usage usage() const noexcept;
+
+private:
+    void add(memory_category_t category, size_t bytes) noexcept;
+    void sub(memory_category_t category, size_t bytes) noexcept;
+
+private:
+    std::shared_ptr<allocation_tracker> parent_;
+    allocation_tracker &root_;
+    host_allocator &allocator_;
+    std::array<std::atomic<size_t>, memory_categories> bytes_ {};
+    std::atomic<size_t> total_bytes_ = 0;
+    std::atomic<size_t> peak_scratch_bytes_ = 0;
+    std::atomic<size_t> peak_bytes_ = 0;
 };
 
 END_NS_NNCASE_RUNTIME
@@ -0,0 +1,59 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "result.h"
+#include <functional>
+#include <memory>
+
+BEGIN_NS_NNCASE_RUNTIME
+
+/**
+ * @brief Runs tasks in a 3 stage pipeline (copy inputs, compute, copy outputs).
+ *
+ * Copies are done on a dedicated copy worker, so the copies of one task overlap
+ * with the compute of another. Tasks of the same session must not be in flight
+ * at the same time since they share the bindings.
+ */
+class NNCASE_API async_scheduler
+{
+public:
+    using stage_t = std::function<result<void>()>;
+    using callback_t = std::function<void(result<void>)>;
+
+    struct task
+    {
+        stage_t copy_inputs;
+        stage_t compute;
+        stage_t copy_outputs;
+        callback_t callback;
+    };
+
+    explicit async_scheduler(size_t compute_workers = 1);
+    async_scheduler(const async_scheduler &) = delete;
+    ~async_scheduler();
+    async_scheduler &operator=(const async_scheduler &) = delete;
+
+    static async_scheduler &default_scheduler();
+
+    result<void> post(task t) noexcept;
+    /// Returns once no task is in flight, callbacks may still be running
+    void wait_idle();
+
+private:
+    struct state;
+    std::unique_ptr<state> state_;
+};
+
+END_NS_NNCASE_RUNTIME
@@ -0,0 +1,46 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "result.h"
+#include <memory>
+
+BEGIN_NS_NNCASE_RUNTIME
+
+struct constant_registry_stats
+{
+    size_t blocks = 0;
+    size_t bytes = 0;
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+/**
+ * @brief Process-wide registry of constant blocks shared by loaded models.
+ *
+ * Blocks are looked up by the content hash emitted by the compiler and their bytes
+ * are compared before sharing. A block is freed when the last module holding it is
+ * destroyed, it is not counted by the interpreters' memory trackers. It may be used
+ * from any thread.
+ */
+class NNCASE_API constant_registry
+{
+public:
+    using block_t = std::shared_ptr<const gsl::byte>;
+
+    static result<block_t> acquire(uint64_t hash, gsl::span<const gsl::byte> data) noexcept;
+    static constant_registry_stats stats() noexcept;
+};
+
+END_NS_NNCASE_RUNTIME
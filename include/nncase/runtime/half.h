@@ -15,10 +15,17 @@
 #pragma once
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <float.h>
 #include <functional>
 #include <limits>
 #include <nncase/runtime/compiler_defs.h>
+#if defined(__F16C__)
+#include <immintrin.h>
+#define NNCASE_HALF_F16C 1
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define NNCASE_HALF_NATIVE 1
+#endif
 
 namespace nncase
 {
@@ -70,6 +77,13 @@ public:
 
     operator float() const noexcept
     {
+#if NNCASE_HALF_F16C
+        return _cvtsh_ss(value_);
+#elif NNCASE_HALF_NATIVE
+        __fp16 h;
+        std::memcpy(&h, &value_, sizeof(h));
+        return (float)h;
+#else
         const fp32 magic = { 113 << 23 };
         const unsigned int shifted_exp = 0x7c00 << 13; // exponent mask after shift
         fp32 o;
@@ -91,6 +105,7 @@ public:
 
         o.u32 |= (value_ & 0x8000) << 16; // sign bit
         return o.f32;
+#endif
     }
 
     const uint16_t &raw() const noexcept { return value_; }
@@ -103,6 +118,14 @@ public:
 
     static half round_to_half(float v)
     {
+#if NNCASE_HALF_F16C
+        return from_raw(_cvtss_sh(v, _MM_FROUND_TO_NEAREST_INT));
+#elif NNCASE_HALF_NATIVE
+        __fp16 h = (__fp16)v;
+        half o;
+        std::memcpy(&o.value_, &h, sizeof(h));
+        return o;
+#else
         fp32 f;
         f.f32 = v;
         const fp32 f32infy = { 255 << 23 };
@@ -150,6 +173,7 @@ public:
         }
         o.value_ |= static_cast<uint16_t>(sign >> 16);
         return o;
+#endif
     }
 
     static constexpr half epsilon() noexcept
@@ -17,12 +17,16 @@
 #include "model.h"
 #include "result.h"
 #include "runtime_module.h"
+#include <functional>
 #include <gsl/gsl-lite.hpp>
 #include <memory>
 #include <unordered_map>
 
 BEGIN_NS_NNCASE_RUNTIME
 
+class async_scheduler;
+class kernel_tuner;
+
 class NNCASE_API options_dict
 {
 public:
@@ -54,6 +58,12 @@ public:
     interpreter(interpreter &) = delete;
     interpreter(interpreter &&) = default;
 
+    /**
+     * @brief Route the host allocations of the runtime through allocator, must be set before load_model.
+     *
+     * The allocator must outlive the interpreter and the tensors it allocated.
+     */
+    result<void> allocator(host_allocator &allocator) noexcept;
     NNCASE_NODISCARD result<void> load_model(gsl::span<const gsl::byte> buffer) noexcept;
 
     size_t inputs_size() const noexcept;
@@ -67,15 +77,62 @@ public:
     result<runtime_tensor> output_tensor(size_t index) noexcept;
     result<void> output_tensor(size_t index, runtime_tensor tensor) noexcept;
 
+    size_t max_batch() const noexcept;
+    size_t batch() const noexcept;
+    result<void> batch(size_t value) noexcept;
+
     result<void> run() noexcept;
 
+    using run_callback_t = std::function<void(result<void>)>;
+
+    /**
+     * @brief Run asynchronously, callback is invoked on a worker thread when finished.
+     *
+     * Input and output tensors must not be touched and the interpreter must not
+     * be run again until the callback is invoked.
+     */
+    result<void> run_async(run_callback_t callback) noexcept;
+    result<void> run_async(async_scheduler &scheduler, run_callback_t callback) noexcept;
+
+    /**
+     * @brief Run tensor calls into other modules concurrently.
+     *
+     * Consecutive calls whose modules and buffers are independent run on per module
+     * worker threads, the caller waits for them before any op that reads their results.
+     * Modules must be safe to run on another thread than the one loading the model.
+     */
+    bool concurrent_calls() const noexcept;
+    result<void> concurrent_calls(bool value) noexcept;
+
     result<runtime_module *> find_module_by_id(size_t index) noexcept;
+    const std::shared_ptr<allocation_tracker> &memory_tracker() const noexcept;
+
+    /**
+     * @brief Bytes held by the interpreter in total and per module.
+     *
+     * Sections that are not compressed are read from the model buffer and only
+     * show up in the mempool sizes.
+     */
+    result<runtime_memory_stats> memory_stats() const noexcept;
     options_dict &options() noexcept;
 
+    /**
+     * @brief Pick kernel variants through tuner, nullptr keeps the static choices.
+     *
+     * Ops are planned on their first run, so set it before that. The tuner must outlive
+     * the interpreter and may be shared by interpreters.
+     */
+    kernel_tuner *tuner() const noexcept;
+    void tuner(kernel_tuner *tuner) noexcept;
+
 private:
     std::vector<std::unique_ptr<runtime_module>> modules_;
     runtime_function *entry_function_;
+    host_allocator *allocator_;
+    std::shared_ptr<allocation_tracker> memory_tracker_;
     options_dict options_;
+    bool concurrent_calls_;
+    kernel_tuner *tuner_;
 };
 
 END_NS_NNCASE_RUNTIME
@@ -0,0 +1,79 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "result.h"
+#include <functional>
+#include <memory>
+#include <string>
+
+BEGIN_NS_NNCASE_RUNTIME
+
+/**
+ * @brief Picks kernel variants by timing them on this machine.
+ *
+ * The winners are cached by CPU model and op signature. A cache file may hold entries
+ * of several CPU models, only the ones of this machine are used and all are saved back.
+ * When tuning is off only cached choices are used, other ops keep their static choice.
+ */
+class NNCASE_API kernel_tuner
+{
+public:
+    using run_candidate_t = std::function<result<void>(size_t index)>;
+
+    kernel_tuner(bool tuning = true);
+    kernel_tuner(const kernel_tuner &) = delete;
+    ~kernel_tuner();
+
+    kernel_tuner &operator=(const kernel_tuner &) = delete;
+
+    bool tuning() const noexcept;
+    void tuning(bool value) noexcept;
+    size_t size() const noexcept;
+
+    /// A missing file leaves the cache empty
+    result<void> load(const char *path) noexcept;
+    result<void> save(const char *path) const noexcept;
+
+    /**
+     * @brief Index of the fastest candidate for the signature.
+     *
+     * The first candidate is the static choice, it is returned when the signature is
+     * not cached and tuning is off. run executes a candidate on the op's own buffers.
+     */
+    result<size_t> select(const std::string &signature, gsl::span<const std::string> candidates, const run_candidate_t &run) noexcept;
+
+    static const std::string &cpu_model() noexcept;
+
+private:
+    struct state;
+    std::unique_ptr<state> state_;
+};
+
+/// Appends "name=v0xv1x...;" to an op signature
+template <class TValues>
+void append_signature(std::string &signature, const char *name, const TValues &values)
+{
+    signature += name;
+    signature += '=';
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        if (i)
+            signature += 'x';
+        signature += std::to_string(values[i]);
+    }
+    signature += ';';
+}
+
+END_NS_NNCASE_RUNTIME
@@ -76,10 +76,20 @@ struct section_header
     uint32_t flags;
     uint32_t body_start;
     uint32_t body_size;
-    uint32_t reserved0;
+    uint32_t memory_size;
 };
 
 NNCASE_INLINE_VAR constexpr uint32_t SECTION_MERGED_INTO_RDATA = 1;
+// Body is a lz4 block, memory_size is the size after decompression
+NNCASE_INLINE_VAR constexpr uint32_t SECTION_COMPRESSED = 2;
+
+// Entry of the .rdata_blocks section, a constant block of .rdata identified by the FNV-1a hash of its content
+struct rdata_block_desc
+{
+    uint64_t hash;
+    uint32_t start;
+    uint32_t size;
+};
 
 struct shape_header
 {
@@ -62,6 +62,13 @@ namespace nncase
             return nncase::err(std::move(v.unwrap_err())); \
     }
 
+// Binds name to the object referred by a result<std::reference_wrapper<T>>
+#define try_ref(name, x)                                        \
+    auto name##_ref = (x);                                      \
+    if (!name##_ref.is_ok())                                    \
+        return nncase::err(std::move(name##_ref.unwrap_err())); \
+    auto &name = name##_ref.unwrap().get()
+
 template <class T>
 struct Ok
 {
@@ -35,6 +35,7 @@ class NNCASE_API runtime_function
 private:
     struct inout_tensor_info
     {
+        runtime_shape_t base_shape;
         runtime_shape_t shape;
         runtime_shape_t strides;
         memory_range range;
@@ -64,23 +65,35 @@ public:
     result<runtime_tensor> output_tensor(size_t index) noexcept;
     result<void> output_tensor(size_t index, runtime_tensor tensor) noexcept;
 
+    size_t batch() const noexcept;
+    result<void> batch(size_t value) noexcept;
+    virtual size_t max_batch() const noexcept;
+
     result<void> invoke() noexcept;
 
+    // Phases of invoke, can be pipelined across functions
+    result<void> copy_inputs() noexcept;
+    result<void> compute() noexcept;
+    result<void> copy_outputs() noexcept;
+
 protected:
     virtual result<void> initialize_core(runtime_function_init_context &context) noexcept = 0;
     virtual result<runtime_tensor> allocate_input_tensor(size_t index) noexcept = 0;
     virtual result<runtime_tensor> allocate_output_tensor(size_t index) noexcept = 0;
     virtual result<void> validate_input_tensor(size_t index, runtime_tensor tensor) noexcept = 0;
     virtual result<void> validate_output_tensor(size_t index, runtime_tensor tensor) noexcept = 0;
+    result<runtime_tensor> allocate_host_tensor(datatype_t datatype, const runtime_shape_t &shape) noexcept;
     result<runtime_tensor> device_input_tensor(size_t index) noexcept;
     result<runtime_tensor> device_output_tensor(size_t index) noexcept;
     virtual result<void> invoke_core() noexcept = 0;
+    virtual result<void> batch_core(size_t value) noexcept;
 
 private:
     function_header header_;
     std::vector<inout_tensor_info> input_tensors_;
     std::vector<inout_tensor_info> output_tensors_;
     runtime_module &rt_module_;
+    size_t batch_ = 1;
 };
 
 END_NS_NNCASE_RUNTIME
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #pragma once
+#include "allocator.h"
 #include "model.h"
 #include "result.h"
 #include "runtime_function.h"
@@ -28,6 +29,8 @@ struct NNCASE_API runtime_module_init_context
     virtual interpreter &interp() noexcept = 0;
     virtual const module_header &header() noexcept = 0;
     virtual gsl::span<const gsl::byte> section(const char *name) noexcept = 0;
+    // Decompresses a compressed section into a buffer owned by the caller, the buffer is empty if the section is not compressed
+    virtual result<allocation_tracker::buffer_t> take_compressed_section(const char *name) noexcept = 0;
 };
 
 class NNCASE_API runtime_module
@@ -51,6 +54,9 @@ public:
 
     result<runtime_function *> find_function_by_id(size_t index) noexcept;
 
+    allocation_tracker &memory_tracker() const noexcept { return *memory_tracker_; }
+    result<module_memory_stats> memory_stats() const noexcept;
+
 protected:
     virtual result<void> initialize_before_functions(runtime_module_init_context &context) noexcept;
     virtual result<void> initialize_after_functions(runtime_module_init_context &context) noexcept;
@@ -63,6 +69,8 @@ private:
     std::vector<mempool_desc> mempools_;
     std::vector<mempool_desc> shared_mempools_;
     std::vector<std::unique_ptr<runtime_function>> functions_;
+    std::shared_ptr<allocation_tracker> memory_tracker_;
+    std::vector<allocation_tracker::buffer_t> section_cache_;
     interpreter *interp_ = nullptr;
 };
 
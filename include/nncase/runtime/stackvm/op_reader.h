@@ -1313,6 +1313,28 @@ struct op_reader<tensor_lut1d_op_t>
     }
 };
 
+template <>
+struct op_reader<tensor_matmul_op_t>
+{
+    tensor_matmul_op_t operator()(span_reader &reader) const
+    {
+        tensor_matmul_op_t op(default_init);
+        op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
+        op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
+        op.datatype = static_cast<datatype_t>(reader.read_unaligned<uint8_t>());
+        op.rshape_src1 = reader.read_unaligned<uint8_t>();
+        op.rstride_src1 = reader.read_unaligned<uint8_t>();
+        op.rshape_src2 = reader.read_unaligned<uint8_t>();
+        op.rstride_src2 = reader.read_unaligned<uint8_t>();
+        op.rstride_dest = reader.read_unaligned<uint8_t>();
+        op.transpose_a = reader.read_unaligned<bool>();
+        op.transpose_b = reader.read_unaligned<bool>();
+        op.fused_clamp_low = reader.read_unaligned<float>();
+        op.fused_clamp_high = reader.read_unaligned<float>();
+        return op;
+    }
+};
+
 template <>
 struct op_reader<tensor_onehot_op_t>
 {
@@ -1349,6 +1371,31 @@ struct op_reader<tensor_pad_op_t>
     }
 };
 
+template <>
+struct op_reader<tensor_preprocess_op_t>
+{
+    tensor_preprocess_op_t operator()(span_reader &reader) const
+    {
+        tensor_preprocess_op_t op(default_init);
+        op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
+        op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
+        op.datatype = static_cast<datatype_t>(reader.read_unaligned<uint8_t>());
+        op.rshape_src = reader.read_unaligned<uint8_t>();
+        op.rstride_src = reader.read_unaligned<uint8_t>();
+        op.rstride_dest = reader.read_unaligned<uint8_t>();
+        op.rpaddings = reader.read_unaligned<uint8_t>();
+        op.input_nhwc = reader.read_unaligned<bool>();
+        op.output_nhwc = reader.read_unaligned<bool>();
+        op.swap_rb = reader.read_unaligned<bool>();
+        op.zero_point = reader.read_unaligned<int32_t>();
+        op.scale = reader.read_unaligned<float>();
+        op.resize_h = reader.read_unaligned<int32_t>();
+        op.resize_w = reader.read_unaligned<int32_t>();
+        op.pad_value = reader.read_unaligned<float>();
+        return op;
+    }
+};
+
 template <>
 struct op_reader<tensor_quantize_op_t>
 {
@@ -1597,6 +1644,282 @@ struct op_reader<tensor_transpose_op_t>
     }
 };
 
+/**
+ * @brief Read the next op and pass it to the decoder as its typed op struct.
+ */
+template <class TDecoder>
+result<void> decode_op(span_reader &reader, TDecoder &&decoder) noexcept
+{
+    auto opcode = static_cast<opcode_t>(reader.peek_unaligned<uint8_t>());
+    if (opcode == opcode_t::TENSOR)
+    {
+        auto tensor_funct = static_cast<tensor_function_t>(reader.peek_unaligned_with_offset<uint16_t>(1));
+        switch (tensor_funct)
+        {
+        case tensor_function_t::BATCH_TO_SPACE:
+            return decoder(op_reader<tensor_batch_to_space_op_t>()(reader));
+        case tensor_function_t::BROADCAST:
+            return decoder(op_reader<tensor_broadcast_op_t>()(reader));
+        case tensor_function_t::BINARY:
+            return decoder(op_reader<tensor_binary_op_t>()(reader));
+        case tensor_function_t::CALL:
+            return decoder(op_reader<tensor_call_op_t>()(reader));
+        case tensor_function_t::CONV2D:
+            return decoder(op_reader<tensor_conv2d_op_t>()(reader));
+        case tensor_function_t::COPY:
+            return decoder(op_reader<tensor_copy_op_t>()(reader));
+        case tensor_function_t::CONVERT:
+            return decoder(op_reader<tensor_convert_op_t>()(reader));
+        case tensor_function_t::CUMSUM:
+            return decoder(op_reader<tensor_cumsum_op_t>()(reader));
+        case tensor_function_t::DEQUANTIZE:
+            return decoder(op_reader<tensor_dequantize_op_t>()(reader));
+        case tensor_function_t::GATHER:
+            return decoder(op_reader<tensor_gather_op_t>()(reader));
+        case tensor_function_t::GATHER_ND:
+            return decoder(op_reader<tensor_gather_nd_op_t>()(reader));
+        case tensor_function_t::HARDMAX:
+            return decoder(op_reader<tensor_hardmax_op_t>()(reader));
+        case tensor_function_t::LUT1D:
+            return decoder(op_reader<tensor_lut1d_op_t>()(reader));
+        case tensor_function_t::MATMUL:
+            return decoder(op_reader<tensor_matmul_op_t>()(reader));
+        case tensor_function_t::ONEHOT:
+            return decoder(op_reader<tensor_onehot_op_t>()(reader));
+        case tensor_function_t::PAD:
+            return decoder(op_reader<tensor_pad_op_t>()(reader));
+        case tensor_function_t::PREPROCESS:
+            return decoder(op_reader<tensor_preprocess_op_t>()(reader));
+        case tensor_function_t::QUANTIZE:
+            return decoder(op_reader<tensor_quantize_op_t>()(reader));
+        case tensor_function_t::RANDOM_NORMAL:
+            return decoder(op_reader<tensor_random_normal_op_t>()(reader));
+        case tensor_function_t::RANDOM_UNIFORM:
+            return decoder(op_reader<tensor_random_uniform_op_t>()(reader));
+        case tensor_function_t::REDUCE:
+            return decoder(op_reader<tensor_reduce_op_t>()(reader));
+        case tensor_function_t::REDUCE_ARG:
+            return decoder(op_reader<tensor_reduce_arg_op_t>()(reader));
+        case tensor_function_t::REDUCE_PROD:
+            return decoder(op_reader<tensor_reduce_prod_op_t>()(reader));
+        case tensor_function_t::REDUCE_WINDOW2D:
+            return decoder(op_reader<tensor_reduce_window2d_op_t>()(reader));
+        case tensor_function_t::RESIZE_IMAGE:
+            return decoder(op_reader<tensor_resize_image_op_t>()(reader));
+        case tensor_function_t::SLICE:
+            return decoder(op_reader<tensor_slice_op_t>()(reader));
+        case tensor_function_t::TERNARY:
+            return decoder(op_reader<tensor_ternary_op_t>()(reader));
+        case tensor_function_t::TOPK:
+            return decoder(op_reader<tensor_topk_op_t>()(reader));
+        case tensor_function_t::UNARY:
+            return decoder(op_reader<tensor_unary_op_t>()(reader));
+        case tensor_function_t::TRANSPOSE:
+            return decoder(op_reader<tensor_transpose_op_t>()(reader));
+        default:
+            break;
+        }
+    }
+    else
+    {
+        switch (opcode)
+        {
+        case opcode_t::NOP:
+            return decoder(op_reader<nop_op_t>()(reader));
+        case opcode_t::BR:
+            return decoder(op_reader<br_op_t>()(reader));
+        case opcode_t::BR_TRUE:
+            return decoder(op_reader<br_true_op_t>()(reader));
+        case opcode_t::BR_FALSE:
+            return decoder(op_reader<br_false_op_t>()(reader));
+        case opcode_t::RET:
+            return decoder(op_reader<ret_op_t>()(reader));
+        case opcode_t::CALL:
+            return decoder(op_reader<call_op_t>()(reader));
+        case opcode_t::ECALL:
+            return decoder(op_reader<ecall_op_t>()(reader));
+        case opcode_t::THROW:
+            return decoder(op_reader<throw_op_t>()(reader));
+        case opcode_t::BREAK:
+            return decoder(op_reader<break_op_t>()(reader));
+        case opcode_t::LDC_I4:
+            return decoder(op_reader<ldc_i4_op_t>()(reader));
+        case opcode_t::LDNULL:
+            return decoder(op_reader<ldnull_op_t>()(reader));
+        case opcode_t::LDC_I4_0:
+            return decoder(op_reader<ldc_i4_0_op_t>()(reader));
+        case opcode_t::LDC_I4_1:
+            return decoder(op_reader<ldc_i4_1_op_t>()(reader));
+        case opcode_t::LDC_R4:
+            return decoder(op_reader<ldc_r4_op_t>()(reader));
+        case opcode_t::LDIND_I1:
+            return decoder(op_reader<ldind_i1_op_t>()(reader));
+        case opcode_t::LDIND_I2:
+            return decoder(op_reader<ldind_i2_op_t>()(reader));
+        case opcode_t::LDIND_I4:
+            return decoder(op_reader<ldind_i4_op_t>()(reader));
+        case opcode_t::LDIND_I:
+            return decoder(op_reader<ldind_i_op_t>()(reader));
+        case opcode_t::LDIND_U1:
+            return decoder(op_reader<ldind_u1_op_t>()(reader));
+        case opcode_t::LDIND_U2:
+            return decoder(op_reader<ldind_u2_op_t>()(reader));
+        case opcode_t::LDIND_U4:
+            return decoder(op_reader<ldind_u4_op_t>()(reader));
+        case opcode_t::LDIND_U:
+            return decoder(op_reader<ldind_u_op_t>()(reader));
+        case opcode_t::LDIND_BR2:
+            return decoder(op_reader<ldind_br2_op_t>()(reader));
+        case opcode_t::LDIND_R4:
+            return decoder(op_reader<ldind_r4_op_t>()(reader));
+        case opcode_t::STIND_I1:
+            return decoder(op_reader<stind_i1_op_t>()(reader));
+        case opcode_t::STIND_I2:
+            return decoder(op_reader<stind_i2_op_t>()(reader));
+        case opcode_t::STIND_I4:
+            return decoder(op_reader<stind_i4_op_t>()(reader));
+        case opcode_t::STIND_I:
+            return decoder(op_reader<stind_i_op_t>()(reader));
+        case opcode_t::STIND_BR2:
+            return decoder(op_reader<stind_br2_op_t>()(reader));
+        case opcode_t::STIND_R4:
+            return decoder(op_reader<stind_r4_op_t>()(reader));
+        case opcode_t::LEA_GP:
+            return decoder(op_reader<lea_gp_op_t>()(reader));
+        case opcode_t::LEA_BUFFER:
+            return decoder(op_reader<lea_buffer_op_t>()(reader));
+        case opcode_t::LDELEM_I1:
+            return decoder(op_reader<ldelem_i1_op_t>()(reader));
+        case opcode_t::LDELEM_I2:
+            return decoder(op_reader<ldelem_i2_op_t>()(reader));
+        case opcode_t::LDELEM_I4:
+            return decoder(op_reader<ldelem_i4_op_t>()(reader));
+        case opcode_t::LDELEM_I:
+            return decoder(op_reader<ldelem_i_op_t>()(reader));
+        case opcode_t::LDELEM_U1:
+            return decoder(op_reader<ldelem_u1_op_t>()(reader));
+        case opcode_t::LDELEM_U2:
+            return decoder(op_reader<ldelem_u2_op_t>()(reader));
+        case opcode_t::LDELEM_U4:
+            return decoder(op_reader<ldelem_u4_op_t>()(reader));
+        case opcode_t::LDELEM_U:
+            return decoder(op_reader<ldelem_u_op_t>()(reader));
+        case opcode_t::LDELEM_BR2:
+            return decoder(op_reader<ldelem_br2_op_t>()(reader));
+        case opcode_t::LDELEM_R4:
+            return decoder(op_reader<ldelem_r4_op_t>()(reader));
+        case opcode_t::STELEM_I1:
+            return decoder(op_reader<stelem_i1_op_t>()(reader));
+        case opcode_t::STELEM_I2:
+            return decoder(op_reader<stelem_i2_op_t>()(reader));
+        case opcode_t::STELEM_I4:
+            return decoder(op_reader<stelem_i4_op_t>()(reader));
+        case opcode_t::STELEM_I:
+            return decoder(op_reader<stelem_i_op_t>()(reader));
+        case opcode_t::STELEM_BR2:
+            return decoder(op_reader<stelem_br2_op_t>()(reader));
+        case opcode_t::STELEM_R4:
+            return decoder(op_reader<stelem_r4_op_t>()(reader));
+        case opcode_t::LDARG:
+            return decoder(op_reader<ldarg_op_t>()(reader));
+        case opcode_t::LDARG_0:
+            return decoder(op_reader<ldarg_0_op_t>()(reader));
+        case opcode_t::LDARG_1:
+            return decoder(op_reader<ldarg_1_op_t>()(reader));
+        case opcode_t::LDARG_2:
+            return decoder(op_reader<ldarg_2_op_t>()(reader));
+        case opcode_t::LDARG_3:
+            return decoder(op_reader<ldarg_3_op_t>()(reader));
+        case opcode_t::LDARG_4:
+            return decoder(op_reader<ldarg_4_op_t>()(reader));
+        case opcode_t::LDARG_5:
+            return decoder(op_reader<ldarg_5_op_t>()(reader));
+        case opcode_t::STSHAPE:
+            return decoder(op_reader<stshape_op_t>()(reader));
+        case opcode_t::STPADDINGS:
+            return decoder(op_reader<stpaddings_op_t>()(reader));
+        case opcode_t::DUP:
+            return decoder(op_reader<dup_op_t>()(reader));
+        case opcode_t::POP:
+            return decoder(op_reader<pop_op_t>()(reader));
+        case opcode_t::NEG:
+            return decoder(op_reader<neg_op_t>()(reader));
+        case opcode_t::ADD:
+            return decoder(op_reader<add_op_t>()(reader));
+        case opcode_t::SUB:
+            return decoder(op_reader<sub_op_t>()(reader));
+        case opcode_t::MUL:
+            return decoder(op_reader<mul_op_t>()(reader));
+        case opcode_t::DIV:
+            return decoder(op_reader<div_op_t>()(reader));
+        case opcode_t::DIV_U:
+            return decoder(op_reader<div_u_op_t>()(reader));
+        case opcode_t::REM:
+            return decoder(op_reader<rem_op_t>()(reader));
+        case opcode_t::REM_U:
+            return decoder(op_reader<rem_u_op_t>()(reader));
+        case opcode_t::AND:
+            return decoder(op_reader<and_op_t>()(reader));
+        case opcode_t::OR:
+            return decoder(op_reader<or_op_t>()(reader));
+        case opcode_t::XOR:
+            return decoder(op_reader<xor_op_t>()(reader));
+        case opcode_t::NOT:
+            return decoder(op_reader<not_op_t>()(reader));
+        case opcode_t::SHL:
+            return decoder(op_reader<shl_op_t>()(reader));
+        case opcode_t::SHR:
+            return decoder(op_reader<shr_op_t>()(reader));
+        case opcode_t::SHR_U:
+            return decoder(op_reader<shr_u_op_t>()(reader));
+        case opcode_t::CLT:
+            return decoder(op_reader<clt_op_t>()(reader));
+        case opcode_t::CLT_U:
+            return decoder(op_reader<clt_u_op_t>()(reader));
+        case opcode_t::CLE:
+            return decoder(op_reader<cle_op_t>()(reader));
+        case opcode_t::CLE_U:
+            return decoder(op_reader<cle_u_op_t>()(reader));
+        case opcode_t::CEQ:
+            return decoder(op_reader<ceq_op_t>()(reader));
+        case opcode_t::CGE:
+            return decoder(op_reader<cge_op_t>()(reader));
+        case opcode_t::CGE_U:
+            return decoder(op_reader<cge_u_op_t>()(reader));
+        case opcode_t::CGT:
+            return decoder(op_reader<cgt_op_t>()(reader));
+        case opcode_t::CGT_U:
+            return decoder(op_reader<cgt_u_op_t>()(reader));
+        case opcode_t::CNE:
+            return decoder(op_reader<cne_op_t>()(reader));
+        case opcode_t::CONV_I1:
+            return decoder(op_reader<conv_i1_op_t>()(reader));
+        case opcode_t::CONV_I2:
+            return decoder(op_reader<conv_i2_op_t>()(reader));
+        case opcode_t::CONV_I4:
+            return decoder(op_reader<conv_i4_op_t>()(reader));
+        case opcode_t::CONV_I:
+            return decoder(op_reader<conv_i_op_t>()(reader));
+        case opcode_t::CONV_U1:
+            return decoder(op_reader<conv_u1_op_t>()(reader));
+        case opcode_t::CONV_U2:
+            return decoder(op_reader<conv_u2_op_t>()(reader));
+        case opcode_t::CONV_U4:
+            return decoder(op_reader<conv_u4_op_t>()(reader));
+        case opcode_t::CONV_U:
+            return decoder(op_reader<conv_u_op_t>()(reader));
+        case opcode_t::CONV_BR2:
+            return decoder(op_reader<conv_br2_op_t>()(reader));
+        case opcode_t::CONV_R4:
+            return decoder(op_reader<conv_r4_op_t>()(reader));
+        default:
+            break;
+        }
+    }
+
+    return err(nncase_errc::stackvm_illegal_instruction);
+}
+
 class NNCASE_API op_visitor
 {
 public:
@@ -1716,8 +2039,10 @@ public:
     virtual result<void> visit(NNCASE_UNUSED const tensor_gather_nd_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_hardmax_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_lut1d_op_t &op) noexcept { return ok(); }
+    virtual result<void> visit(NNCASE_UNUSED const tensor_matmul_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_onehot_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_pad_op_t &op) noexcept { return ok(); }
+    virtual result<void> visit(NNCASE_UNUSED const tensor_preprocess_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_quantize_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_random_normal_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_random_uniform_op_t &op) noexcept { return ok(); }
@@ -157,6 +157,7 @@ enum class tensor_function_t
     TRANSPOSE = 0x0020,
     TOPK = 0x0021,
     UNARY = 0x0022,
+    PREPROCESS = 0x0023,
 };
 
 // Instructions
@@ -1449,6 +1450,28 @@ struct tensor_lut1d_op_t
     }
 };
 
+struct tensor_matmul_op_t
+{
+    opcode_t opcode;
+    tensor_function_t funct;
+    datatype_t datatype;
+    uint8_t rshape_src1;
+    uint8_t rstride_src1;
+    uint8_t rshape_src2;
+    uint8_t rstride_src2;
+    uint8_t rstride_dest;
+    bool transpose_a;
+    bool transpose_b;
+    float fused_clamp_low;
+    float fused_clamp_high;
+
+    tensor_matmul_op_t(default_init_t) noexcept { }
+    explicit tensor_matmul_op_t(datatype_t datatype, uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rstride_dest, bool transpose_a, bool transpose_b, float fused_clamp_low, float fused_clamp_high) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::MATMUL), datatype(datatype), rshape_src1(rshape_src1), rstride_src1(rstride_src1), rshape_src2(rshape_src2), rstride_src2(rstride_src2), rstride_dest(rstride_dest), transpose_a(transpose_a), transpose_b(transpose_b), fused_clamp_low(fused_clamp_low), fused_clamp_high(fused_clamp_high)
+    {
+    }
+};
+
 struct tensor_onehot_op_t
 {
     opcode_t opcode;
@@ -1485,6 +1508,31 @@ struct tensor_pad_op_t
     }
 };
 
+struct tensor_preprocess_op_t
+{
+    opcode_t opcode;
+    tensor_function_t funct;
+    datatype_t datatype;
+    uint8_t rshape_src;
+    uint8_t rstride_src;
+    uint8_t rstride_dest;
+    uint8_t rpaddings;
+    bool input_nhwc;
+    bool output_nhwc;
+    bool swap_rb;
+    int32_t zero_point;
+    float scale;
+    int32_t resize_h;
+    int32_t resize_w;
+    float pad_value;
+
+    tensor_preprocess_op_t(default_init_t) noexcept { }
+    explicit tensor_preprocess_op_t(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest, uint8_t rpaddings, bool input_nhwc, bool output_nhwc, bool swap_rb, int32_t zero_point, float scale, int32_t resize_h, int32_t resize_w, float pad_value) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::PREPROCESS), datatype(datatype), rshape_src(rshape_src), rstride_src(rstride_src), rstride_dest(rstride_dest), rpaddings(rpaddings), input_nhwc(input_nhwc), output_nhwc(output_nhwc), swap_rb(swap_rb), zero_point(zero_point), scale(scale), resize_h(resize_h), resize_w(resize_w), pad_value(pad_value)
+    {
+    }
+};
+
 struct tensor_quantize_op_t
 {
     opcode_t opcode;
@@ -20,6 +20,9 @@ BEGIN_NS_NNCASE_RT_MODULE(stackvm)
 NNCASE_INLINE_VAR constexpr module_type_t stackvm_module_type = to_module_type("stackvm");
 NNCASE_INLINE_VAR constexpr uint32_t stackvm_module_version = 1;
 
+// General register which holds the current batch of a dynamic batch module
+NNCASE_INLINE_VAR constexpr uint8_t stackvm_batch_reg = 0;
+
 NNCASE_API result<std::unique_ptr<runtime_module>> create_stackvm_runtime_module();
 
 END_NS_NNCASE_RT_MODULE
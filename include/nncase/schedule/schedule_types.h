@@ -28,6 +28,7 @@ struct buffer_allocation
     size_t shared_module;
     size_t start;
     size_t size;
+    size_t parent_offset;
     ir::shape_t shape;
     ir::shape_t strides;
     ir::shape_t strides_shape;
@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <nncase/runtime/allocator.h>
 #include <nncase/runtime/datatypes.h>
 #include <span>
 #include <vector>
@@ -28,19 +29,39 @@ struct simulate_options
     std::filesystem::path output_path;
     std::filesystem::path dataset;
     std::string dataset_format;
+    std::filesystem::path dataset_cache;
     std::function<void(size_t cnt, size_t total)> progress;
+    size_t workers = 1;
+    bool concurrent_calls = false;
 
     std::string input_layout = "NCHW";
     float input_mean = 0.f;
     float input_std = 1.f;
 };
 
+struct simulate_stats
+{
+    size_t samples = 0;
+    size_t workers = 0;
+    size_t batch_size = 0;
+    double elapsed_seconds = 0;
+
+    // Run latency per batch, zero if no batch has run
+    double latency_p50_ms = 0;
+    double latency_p90_ms = 0;
+    double latency_p99_ms = 0;
+    double latency_max_ms = 0;
+
+    // Memory of a single interpreter
+    runtime::memory_usage memory;
+};
+
 class NNCASE_API simulator
 {
 public:
     static std::unique_ptr<simulator> create(std::vector<uint8_t> model, const simulate_options &options);
 
     virtual ~simulator();
-    virtual void run() = 0;
+    virtual simulate_stats run() = 0;
 };
 }
@@ -30,6 +30,7 @@ public:
     void register_quantize_passes(const module_type_t &type, ir::transforms::pass_manager &pass_mgr, datatype_t quant_type, std::string_view w_quant_type, bool use_mse_quant_w) override;
     void register_allocation_passes(const module_type_t &type, ir::transforms::pass_manager &pass_mgr) override;
     void add_quantization_broadcast(std::unordered_set<ir::node_opcode> &opcodes) override;
+    void add_inplace_ops(const module_type_t &type, std::unordered_set<ir::node_opcode> &opcodes) override;
 
 protected:
     void move_transpose_transform(ir::transforms::transform_pass &pass, bool add_constant_folding = true);
@@ -52,6 +52,9 @@ struct target_options
     uint32_t output_quantize_threshold;
     bool quantize_binary;
     bool is_fpga;
+    uint32_t max_batch = 1;
+    bool compress_sections = false;
+    bool share_constants = false;
 };
 
 struct target_attributes
@@ -84,6 +87,7 @@ public:
     virtual void register_allocation_passes(const module_type_t &type, ir::transforms::pass_manager &pass_mgr) = 0;
     virtual std::unique_ptr<codegen::module_builder> create_module_builder(const module_type_t &type, std::string_view module_name, const codegen::module_builder_params &params);
     virtual void add_quantization_broadcast(std::unordered_set<ir::node_opcode> &opcodes) = 0;
+    virtual void add_inplace_ops(const module_type_t &type, std::unordered_set<ir::node_opcode> &opcodes);
 
 protected:
     virtual std::unique_ptr<target_options> on_create_options() = 0;
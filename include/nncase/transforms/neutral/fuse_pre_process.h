@@ -0,0 +1,33 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../pass.h"
+
+namespace nncase::ir::transforms
+{
+/**
+ * Collapses the chain emitted by pre_process_transform (dequantize, transposes,
+ * swapRB slices/concat, letterbox resize/pad and normalize) into a single
+ * preprocess node, so the input frame is read once.
+ */
+class NNCASE_API fuse_pre_process_transform : public graph_pass
+{
+public:
+    using graph_pass::graph_pass;
+
+protected:
+    void run_core(graph &graph, nncase::target &target, const run_pass_options &options) override;
+};
+}
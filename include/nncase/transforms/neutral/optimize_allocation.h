@@ -121,6 +121,16 @@ class NNCASE_API alias_slice_buffer_pass : public graph_pass
 public:
     using graph_pass::graph_pass;
 
+protected:
+    void run_core(graph &graph, nncase::target &target, const run_pass_options &options) override;
+};
+
+// Lets an elementwise output reuse the buffer of an input that dies at the same node
+class NNCASE_API alias_inplace_buffer_pass : public graph_pass
+{
+public:
+    using graph_pass::graph_pass;
+
 protected:
     void run_core(graph &graph, nncase::target &target, const run_pass_options &options) override;
 };
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #pragma once
+#include "pass_profiler.h"
 #include "transform.h"
 #include <filesystem>
 #include <optional>
@@ -30,6 +31,7 @@ struct run_pass_options
     ir::quantizer *quantizer;
     schedule::function_schedule_context *schedule_context;
     std::optional<std::filesystem::path> dump_dir;
+    pass_profiler *profiler;
 };
 
 class NNCASE_API pass
@@ -50,6 +52,9 @@ public:
 protected:
     virtual void run_core(graph &graph, nncase::target &target, const run_pass_options &options) = 0;
 
+    // Rewrites done by the current run, reported to the profiler
+    size_t matches_ = 0;
+
 private:
     std::string dump_name_;
 };
@@ -92,7 +97,7 @@ class NNCASE_API pass_manager
 {
 public:
     pass_manager(graph &graph, nncase::target &target)
-        : graph_(graph), target_(target), quantizer_(nullptr), schedule_context_(nullptr) { }
+        : graph_(graph), target_(target), quantizer_(nullptr), schedule_context_(nullptr), profiler_(nullptr) { }
     pass_manager(pass_manager &) = delete;
 
     template <class TPass = transform_pass, class... TArgs>
@@ -106,6 +111,7 @@ public:
     void dump_dir(const std::filesystem::path &dir);
     void quantizer(ir::quantizer *q);
     void schedule_context(schedule::function_schedule_context *c);
+    void profiler(pass_profiler *p);
 
 private:
     std::vector<std::unique_ptr<pass>> passes_;
@@ -113,6 +119,7 @@ private:
     nncase::target &target_;
     ir::quantizer *quantizer_;
     schedule::function_schedule_context *schedule_context_;
+    pass_profiler *profiler_;
     std::optional<std::filesystem::path> dump_dir_;
 };
 }
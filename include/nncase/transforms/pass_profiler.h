@@ -0,0 +1,66 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <nncase/runtime/compiler_defs.h>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nncase::ir::transforms
+{
+struct pass_profile_entry
+{
+    std::string graph;
+    std::string pass;
+    std::string transform; // empty for the whole pass
+    std::thread::id thread;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::duration duration {};
+    size_t matches = 0;
+    // For a transform these are summed over its rewrites, so their difference is its net effect
+    size_t nodes_before = 0;
+    size_t nodes_after = 0;
+    // Process peak memory when it started and ended, it grew during the entry when they differ. For a transform
+    // these are summed over its sweeps. Graphs compiled concurrently share the process peak
+    size_t peak_memory_before = 0;
+    size_t peak_memory_after = 0;
+};
+
+class NNCASE_API pass_profiler
+{
+public:
+    pass_profiler() noexcept;
+
+    void record(pass_profile_entry entry);
+    std::vector<pass_profile_entry> entries() const;
+
+    // Totals per pass and transform over all graphs, slowest first
+    void dump_table(std::ostream &output) const;
+    // Chrome trace event format, viewable in chrome://tracing or Perfetto
+    void dump_trace(std::ostream &output) const;
+
+    // Peak resident size of the whole process so far in bytes
+    static size_t peak_memory() noexcept;
+
+private:
+    mutable std::mutex lock_;
+    std::chrono::steady_clock::time_point origin_;
+    std::vector<pass_profile_entry> entries_;
+};
+}
@@ -13,12 +13,17 @@
  * limitations under the License.
  */
 #pragma once
+#include <nncase/kernels/kernel_context.h>
 #include <nncase/kernels/kernel_utils.h>
 #include <nncase/runtime/k210/compiler_defs.h>
 #include <nncase/runtime/k210/runtime_op_utility.h>
 #include <nncase/runtime/k210/runtime_types.h>
 #include <nncase/runtime/result.h>
 #include <nncase/runtime/runtime_op_utility.h>
+#include <vector>
+#ifdef NNCASE_OPENMP
+#include <omp.h>
+#endif
 
 BEGIN_NS_NNCASE_KERNELS_K210
 
@@ -41,6 +46,79 @@ struct pool_partial_type<float>
 
 template <class T>
 using pool_partial_type_t = typename pool_partial_type<T>::type;
+
+/**
+ * @brief Precomputed form of a KPU activation table.
+ *
+ * Picks the last segment whose start_x is below the value, like the hardware does, then
+ * applies it with the rounding of carry_shift<int64_t, true>. Ascending tables are bisected
+ * and the rounding is computed without branches, so mixed segments do not stall the row.
+ */
+class kpu_activation_lookup
+{
+public:
+    explicit kpu_activation_lookup(const runtime::k210::kpu_activation_table_t &table) noexcept
+    {
+        for (size_t i = 0; i < table.size(); i++)
+        {
+            auto &seg = table[i];
+            starts_[i] = seg.start_x;
+            muls_[i] = seg.mul;
+            shifts_[i] = seg.shift;
+            adds_[i] = seg.add;
+            // Shift 0 keeps the value: nothing is masked and nothing reaches the half
+            masks_[i] = seg.shift > 0 ? runtime::bit_mask(seg.shift) : 0;
+            halves_[i] = seg.shift > 0 ? uint64_t(1) << (seg.shift - 1) : 1;
+            negative_shift_ |= seg.shift < 0;
+        }
+
+        ascending_ = std::is_sorted(starts_.begin() + 1, starts_.end());
+    }
+
+    uint8_t operator()(int64_t value) const noexcept
+    {
+        size_t index = 0;
+        if (ascending_)
+        {
+            for (size_t step = segments / 2; step; step /= 2)
+                index = value > starts_[index + step] ? index + step : index;
+        }
+        else
+        {
+            for (size_t i = 1; i < starts_.size(); i++)
+                index = value > starts_[i] ? i : index;
+        }
+
+        auto x = (value - starts_[index]) * muls_[index];
+        int64_t act_value;
+        if (negative_shift_)
+        {
+            act_value = runtime::carry_shift<int64_t, true>(x, shifts_[index]);
+        }
+        else
+        {
+            auto integral = x >> shifts_[index];
+            auto fractional = uint64_t(x) & masks_[index];
+            auto half = halves_[index];
+            auto round = (fractional > half) | ((fractional == half) & bool(integral & 1));
+            act_value = integral + (round ? (x < 0 ? -1 : 1) : 0);
+        }
+
+        return (uint8_t)kernels::detail::clamp(act_value + adds_[index], int64_t(0), int64_t(255));
+    }
+
+private:
+    static constexpr size_t segments = std::tuple_size_v<runtime::k210::kpu_activation_table_t>;
+
+    std::array<int64_t, segments> starts_;
+    std::array<int64_t, segments> muls_;
+    std::array<int32_t, segments> shifts_;
+    std::array<int64_t, segments> adds_;
+    std::array<uint64_t, segments> masks_;
+    std::array<uint64_t, segments> halves_;
+    bool ascending_;
+    bool negative_shift_ = false;
+};
 }
 
 result<void> kpu_upload(const uint8_t *src, uint8_t *dest, const runtime::k210::kpu_shape_t &in_shape, uint32_t dma_ch);
@@ -77,87 +155,150 @@ inline result<void> kpu_download(const uint8_t *src, uint8_t *dest, const runtim
     return ok();
 }
 
+/**
+ * @brief Scratch memory of kpu_conv2d, grown on demand and reused across calls.
+ */
+struct kpu_conv2d_workspace
+{
+    std::vector<uint8_t> padded_input;
+    std::vector<int32_t> channel_sums;
+    std::vector<int32_t> window_sums;
+    std::vector<int64_t> row_values;
+    std::vector<int32_t> row_sums;
+};
+
 template <bool IsDepthwise, int32_t FilterSize>
-void kpu_conv2d(const uint8_t *input, int64_t *workspace, uint8_t *output, const uint8_t *weights, int32_t in_h, int32_t in_w, int32_t in_channels, int32_t out_channels, uint8_t pad_value, int32_t arg_x,
-    int32_t shift_x, int32_t arg_w, int32_t shift_w, int64_t arg_add, const runtime::k210::kpu_batchnorm_segment *batchnorm, const runtime::k210::kpu_activation_table_t &activation)
+void kpu_conv2d(const uint8_t *input, kpu_conv2d_workspace &workspace, uint8_t *output, const uint8_t *weights, int32_t in_h, int32_t in_w, int32_t in_channels, int32_t out_channels, uint8_t pad_value, int32_t arg_x,
+    int32_t shift_x, int32_t arg_w, int32_t shift_w, int64_t arg_add, const runtime::k210::kpu_batchnorm_segment *batchnorm, const runtime::k210::kpu_activation_table_t &activation,
+    kernel_context &context = default_kernel_context())
 {
+    constexpr int32_t pad = FilterSize == 1 ? 0 : 1;
+    constexpr int32_t filter_area = FilterSize * FilterSize;
+    const auto g_ic = IsDepthwise ? 1 : in_channels;
+    const auto padded_h = in_h + pad * 2;
+    const auto padded_w = in_w + pad * 2;
+    const auto padded_size = size_t(padded_h) * padded_w;
     const auto channel_size = size_t(in_h) * in_w;
-    // conv
+    // Without padding a 1x1 filter sees each plane as one long row
+    const auto rows = FilterSize == 1 ? 1 : in_h;
+    const auto cols = FilterSize == 1 ? (int32_t)channel_size : in_w;
+    const auto num_threads = std::max(1, std::min((int32_t)context.num_threads, out_channels));
+
+    // Surround every input plane with pad_value, so the taps need no bounds checks
+    const uint8_t *planes = input;
+    if constexpr (pad != 0)
+    {
+        workspace.padded_input.resize(size_t(in_channels) * padded_size);
+        std::fill(workspace.padded_input.begin(), workspace.padded_input.end(), pad_value);
+        for (int32_t ic = 0; ic < in_channels; ic++)
+        {
+            for (int32_t y = 0; y < in_h; y++)
+            {
+                auto src = input + ic * channel_size + size_t(y) * in_w;
+                std::copy(src, src + in_w, workspace.padded_input.data() + ic * padded_size + size_t(y + pad) * padded_w + pad);
+            }
+        }
+
+        planes = workspace.padded_input.data();
+    }
+
+    // sum_x of a normal conv covers all input channels, so it is shared by every output channel
+    if constexpr (!IsDepthwise)
     {
-        auto out_it = workspace;
-        const auto pad = FilterSize == 1 ? 0 : 1;
-        const auto groups = IsDepthwise ? out_channels : 1;
-        const auto g_ic = IsDepthwise ? 1 : in_channels / groups;
-        const auto g_oc = IsDepthwise ? 1 : out_channels;
+        workspace.channel_sums.assign(padded_size, 0);
+        workspace.window_sums.assign(channel_size, 0);
+        auto channel_sums = workspace.channel_sums.data();
+        auto window_sums = workspace.window_sums.data();
+        for (int32_t ic = 0; ic < in_channels; ic++)
+        {
+            auto plane = planes + ic * padded_size;
+            for (size_t i = 0; i < padded_size; i++)
+                channel_sums[i] += plane[i];
+        }
 
-        for (int32_t og = 0; og < groups; og++)
+        for (int32_t oy = 0; oy < rows; oy++)
         {
-            const uint8_t *w_group_p = weights + (size_t)og * g_oc * g_ic * FilterSize * FilterSize;
+            auto sums = window_sums + size_t(oy) * cols;
+            for (int32_t ky = 0; ky < FilterSize; ky++)
+            {
+                auto row = channel_sums + size_t(oy + ky) * padded_w;
+                for (int32_t kx = 0; kx < FilterSize; kx++)
+                {
+                    for (int32_t ox = 0; ox < cols; ox++)
+                        sums[ox] += row[ox + kx];
+                }
+            }
+        }
+    }
 
-            for (int32_t oc = 0; oc < g_oc; oc++)
+    workspace.row_values.resize(size_t(num_threads) * cols);
+    if constexpr (IsDepthwise)
+        workspace.row_sums.resize(size_t(num_threads) * cols);
+
+    const detail::kpu_activation_lookup lookup(activation);
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(num_threads) schedule(static)
+#endif
+    for (int32_t oc = 0; oc < out_channels; oc++)
+    {
+#ifdef NNCASE_OPENMP
+        const auto tid = omp_get_thread_num();
+#else
+        const auto tid = 0;
+#endif
+        auto values = workspace.row_values.data() + size_t(tid) * cols;
+        auto row_sums = IsDepthwise ? workspace.row_sums.data() + size_t(tid) * cols : nullptr;
+        auto w_oc_p = weights + size_t(oc) * g_ic * filter_area;
+        auto in_oc_p = planes + (IsDepthwise ? oc * padded_size : 0);
+        auto out_p = output + oc * channel_size;
+        const auto &bn = batchnorm[oc];
+
+        // Padded taps still read their weight, so sum_w does not depend on the position
+        int64_t sum_w = 0;
+        for (int32_t i = 0; i < g_ic * filter_area; i++)
+            sum_w += w_oc_p[i];
+        const auto w_term = (arg_w * sum_w >> shift_w) + arg_add * g_ic;
+
+        for (int32_t oy = 0; oy < rows; oy++)
+        {
+            std::fill(values, values + cols, int64_t(0));
+            for (int32_t ic = 0; ic < g_ic; ic++)
             {
-                const uint8_t *w_oc_p = w_group_p + (size_t)oc * g_ic * FilterSize * FilterSize;
+                auto in_c_p = in_oc_p + ic * padded_size + size_t(oy) * padded_w;
+                int32_t w[filter_area];
+                std::copy(w_oc_p + ic * filter_area, w_oc_p + (ic + 1) * filter_area, w);
 
-                for (int32_t oy = 0; oy < in_h; oy++)
+                // All taps of a channel are summed in registers, one store per output
+                for (int32_t ox = 0; ox < cols; ox++)
                 {
-                    for (int32_t ox = 0; ox < in_w; ox++)
+                    int32_t value = 0, sum_x = 0;
+                    for (int32_t ky = 0; ky < FilterSize; ky++)
                     {
-                        const int32_t in_y_origin = oy - pad;
-                        const int32_t in_x_origin = ox - pad;
-                        int64_t value = 0;
-                        int64_t sum_x = 0, sum_w = 0;
-
-                        for (int32_t ic = 0; ic < g_ic; ic++)
+                        for (int32_t kx = 0; kx < FilterSize; kx++)
                         {
-                            const uint8_t *in_c_p = input + ((size_t)og * g_ic + ic) * in_h * in_w;
-                            const uint8_t *w_ic_p = w_oc_p + (size_t)ic * FilterSize * FilterSize;
-
-                            for (int32_t ky = 0; ky < FilterSize; ky++)
-                            {
-                                for (int32_t kx = 0; kx < FilterSize; kx++)
-                                {
-                                    const int32_t in_y = in_y_origin + ky;
-                                    const int32_t in_x = in_x_origin + kx;
-
-                                    uint8_t x;
-                                    if (in_x < 0 || in_x >= in_w
-                                        || in_y < 0 || in_y >= in_h)
-                                        x = pad_value;
-                                    else
-                                        x = in_c_p[in_y * in_w + in_x];
-
-                                    uint8_t w = w_ic_p[ky * FilterSize + kx];
-
-                                    sum_x += x;
-                                    sum_w += w;
-                                    value += (int32_t)x * w;
-                                }
-                            }
+                            const int32_t x = in_c_p[size_t(ky) * padded_w + ox + kx];
+                            value += x * w[ky * FilterSize + kx];
+                            if constexpr (IsDepthwise)
+                                sum_x += x;
                         }
-
-                        auto alu_out = value + (arg_x * sum_x >> shift_x) + (arg_w * sum_w >> shift_w) + arg_add * g_ic;
-                        assert(runtime::within_range<36>(alu_out));
-                        *out_it++ = alu_out;
                     }
+
+                    values[ox] += value;
+                    if constexpr (IsDepthwise)
+                        row_sums[ox] = sum_x;
                 }
             }
-        }
-    }
 
-    // bn act
-    {
-        auto src_it = workspace;
-        auto out_it = output;
-        for (int32_t oc = 0; oc < out_channels; oc++)
-        {
-            const auto &bn = batchnorm[oc];
-            for (size_t i = 0; i < channel_size; i++)
+            // bn act
+            const int32_t *sums = IsDepthwise ? row_sums : workspace.window_sums.data() + size_t(oy) * cols;
+            for (int32_t ox = 0; ox < cols; ox++)
             {
-                auto value = (*src_it++ * bn.mul >> bn.shift) + bn.add;
+                auto alu_out = values[ox] + (arg_x * int64_t(sums[ox]) >> shift_x) + w_term;
+                assert(runtime::within_range<36>(alu_out));
+                auto value = (alu_out * bn.mul >> bn.shift) + bn.add;
                 assert(runtime::within_range<36>(value));
-                auto &seg = *std::find_if(activation.rbegin(), activation.rend(), [value](const runtime::k210::kpu_activation_segment &seg) { return value > seg.start_x; });
-                auto act_value = runtime::carry_shift<int64_t, true>((value - seg.start_x) * seg.mul, seg.shift) + seg.add;
-                *out_it++ = (uint8_t)kernels::detail::clamp(act_value, int64_t(0), int64_t(255));
+                *out_p++ = lookup(value);
             }
         }
     }
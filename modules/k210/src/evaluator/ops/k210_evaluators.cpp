@@ -144,20 +144,17 @@ void ir::k210::register_k210_evaluators()
         auto pool_output_tmp = std::make_unique<uint8_t[]>(runtime::compute_size(out_shape));
         auto p_pool_output_tmp = pool_output_tmp.get();
 
-        const auto groups = rnode.is_depthwise() ? rnode.output_channels() : 1;
-        const auto g_oc = rnode.is_depthwise() ? 1 : rnode.output_channels();
-
         [[maybe_unused]] auto ret_dl = kernels::k210::kpu_download(p_input, p_download_output_tmp, kpu_in_shape);
 
 #define KPU_CONV2D_IMPL(is_depthwise_val, filter_size_val)                                                                                         \
     if (rnode.is_depthwise() == is_depthwise_val && runtime::k210::get_kpu_filter_size(rnode.filter_type()) == filter_size_val)                    \
     {                                                                                                                                              \
-        kernels::k210::kpu_conv2d<is_depthwise_val, filter_size_val>(p_download_output_tmp, workspace.get(), p_conv_ouput_tmp, weights_mem.data(), \
+        kernels::k210::kpu_conv2d<is_depthwise_val, filter_size_val>(p_download_output_tmp, workspace, p_conv_ouput_tmp, weights_mem.data(),       \
             in_shape[2], in_shape[3], in_shape[1], rnode.output_channels(), pad_value, quant_args.arg_x, quant_args.shift_x,                       \
             quant_args.arg_w, quant_args.shift_w, quant_args.arg_add, &bn[0], act);                                                                \
     }
 
-        auto workspace = std::make_unique<int64_t[]>(groups * g_oc * in_shape[2] * in_shape[3]);
+        kernels::k210::kpu_conv2d_workspace workspace;
         auto p_pool_output_tmp_base = p_pool_output_tmp;
         for (size_t n = 0; n < batch; n++)
         {
@@ -108,21 +108,19 @@ result<void> k210_runtime_function::visit(const kpu_conv2d_options &op) noexcept
     auto conv_out_fmap_size = kernels::detail::compute_size(conv_out_shape);
     auto out_fmap_size = kernels::detail::compute_size(out_shape);
 
-    auto input_tmp = std::make_unique<uint8_t[]>(in_fmap_size);
-    auto workspace = std::make_unique<int64_t[]>(conv_out_fmap_size);
-    auto conv_output_tmp = std::make_unique<uint8_t[]>(conv_out_fmap_size);
-    auto output_tmp = std::make_unique<uint8_t[]>(out_fmap_size);
+    kpu_input_tmp_.resize(in_fmap_size);
+    kpu_conv_output_tmp_.resize(conv_out_fmap_size);
+    kpu_output_tmp_.resize(out_fmap_size);
 
     auto batch = in_shape[0];
     auto in_size_per_batch = kernels::detail::compute_size(in_shape) / batch;
     auto conv_output_tmp_size_per_batch = conv_out_fmap_size / batch;
     auto out_size_per_batch = kernels::detail::compute_size(out_shape) / batch;
-    auto p_input = input_tmp.get();
-    auto p_workspace = workspace.get();
-    auto p_conv_ouput_tmp = conv_output_tmp.get();
-    auto p_output_tmp = output_tmp.get();
+    auto p_input = kpu_input_tmp_.data();
+    auto p_conv_ouput_tmp = kpu_conv_output_tmp_.data();
+    auto p_output_tmp = kpu_output_tmp_.data();
 
-    try_(kernels::k210::kpu_download(reinterpret_cast<const uint8_t *>(input.data()), input_tmp.get(), in_shape));
+    try_(kernels::k210::kpu_download(reinterpret_cast<const uint8_t *>(input.data()), kpu_input_tmp_.data(), in_shape));
     auto filter_size = get_kpu_filter_size((kpu_filter_type_t)layer.kernel_pool_type_cfg.data.kernel_type);
     auto pad_value = (uint8_t)layer.kernel_pool_type_cfg.data.pad_value;
     auto arg_x = (int32_t)kernels::detail::to_signed<24>(layer.conv_value.data.arg_x);
@@ -131,11 +129,11 @@ result<void> k210_runtime_function::visit(const kpu_conv2d_options &op) noexcept
     auto shift_w = (int32_t)layer.conv_value.data.shr_w;
     auto arg_add = kernels::detail::to_signed<40>(layer.conv_value2.data.arg_add);
 
-    auto batchnorm = std::make_unique<kpu_batchnorm_segment[]>(out_ch);
+    kpu_batchnorm_.resize(out_ch);
     for (size_t i = 0; i < out_ch; i++)
     {
         auto &src = batch_norm_data.as_span<const kpu_batchnorm_argument_t>()[i].batchnorm.data;
-        auto &dest = batchnorm[i];
+        auto &dest = kpu_batchnorm_[i];
         dest.mul = (int32_t)kernels::detail::to_signed<24>(src.norm_mul);
         dest.shift = (int32_t)src.norm_shift;
         dest.add = (int32_t)kernels::detail::to_signed<32>(src.norm_add);
@@ -157,10 +155,10 @@ result<void> k210_runtime_function::visit(const kpu_conv2d_options &op) noexcept
             dest.add = act_table.activate_para_bias1.data.result_bias[i - 8];
     }
 
-#define KPU_CONV2D_IMPL(is_depthwise_val, filter_size_val)                                                                                                  \
-    if (is_depthwise == is_depthwise_val && filter_size == filter_size_val)                                                                                 \
-    kernels::k210::kpu_conv2d<is_depthwise_val, filter_size_val>(p_input, p_workspace, p_conv_ouput_tmp, reinterpret_cast<const uint8_t *>(weights.data()), \
-        in_h, in_w, in_ch, out_ch, pad_value, arg_x, shift_x, arg_w, shift_w, arg_add, batchnorm.get(), activation)
+#define KPU_CONV2D_IMPL(is_depthwise_val, filter_size_val)                                                                                                            \
+    if (is_depthwise == is_depthwise_val && filter_size == filter_size_val)                                                                                           \
+    kernels::k210::kpu_conv2d<is_depthwise_val, filter_size_val>(p_input, kpu_conv2d_workspace_, p_conv_ouput_tmp, reinterpret_cast<const uint8_t *>(weights.data()), \
+        in_h, in_w, in_ch, out_ch, pad_value, arg_x, shift_x, arg_w, shift_w, arg_add, kpu_batchnorm_.data(), activation, module().kernel_context())
 
     for (size_t n = 0; n < batch; n++)
     {
@@ -172,16 +170,15 @@ result<void> k210_runtime_function::visit(const kpu_conv2d_options &op) noexcept
         kernels::k210::kpu_pool2d(p_conv_ouput_tmp, p_output_tmp, in_h, in_w, out_ch, (kpu_pool_type_t)layer.kernel_pool_type_cfg.data.pool_type);
 
         p_input += in_size_per_batch;
-        p_workspace += conv_output_tmp_size_per_batch;
         p_conv_ouput_tmp += conv_output_tmp_size_per_batch;
         p_output_tmp += out_size_per_batch;
     }
 
-    try_(kernels::k210::kpu_upload(output_tmp.get(), reinterpret_cast<uint8_t *>(kpu_out.data()), out_shape, 0));
+    try_(kernels::k210::kpu_upload(kpu_output_tmp_.data(), reinterpret_cast<uint8_t *>(kpu_out.data()), out_shape, 0));
     if (op.main_mem_output.size)
     {
         try_var(main_output, memory_at(op.main_mem_output));
-        std::copy(output_tmp.get(), output_tmp.get() + out_fmap_size, reinterpret_cast<uint8_t *>(main_output.data()));
+        std::copy(kpu_output_tmp_.begin(), kpu_output_tmp_.begin() + out_fmap_size, reinterpret_cast<uint8_t *>(main_output.data()));
     }
     return ok();
 #else
@@ -17,6 +17,9 @@
 #include <nncase/runtime/k210/op_reader.h>
 #include <nncase/runtime/k210/runtime_types.h>
 #include <nncase/runtime/runtime_function.h>
+#ifdef NNCASE_SIMULATOR
+#include <nncase/kernels/k210/k210_kernels.h>
+#endif
 
 BEGIN_NS_NNCASE_RT_MODULE(k210)
 
@@ -46,6 +49,14 @@ private:
 
 private:
     gsl::span<const gsl::byte> text_;
+#ifdef NNCASE_SIMULATOR
+    // Simulated layers reuse these instead of allocating per call
+    std::vector<uint8_t> kpu_input_tmp_;
+    std::vector<uint8_t> kpu_conv_output_tmp_;
+    std::vector<uint8_t> kpu_output_tmp_;
+    std::vector<kpu_batchnorm_segment> kpu_batchnorm_;
+    kernels::k210::kpu_conv2d_workspace kpu_conv2d_workspace_;
+#endif
 };
 
 END_NS_NNCASE_RT_MODULE
@@ -43,9 +43,7 @@ result<void> k210_runtime_module::initialize_before_functions(runtime_module_ini
     auto data_pool = mempool(mem_data);
     if (data_pool.size)
     {
-        data_.reset(new (std::nothrow) gsl::byte[data_pool.size]);
-        if (!data_)
-            return err(std::errc::not_enough_memory);
+        try_set(data_, memory_tracker().allocate_buffer(memory_category_t::data, data_pool.size));
     }
 
     rdata_ = context.section(".rdata");
@@ -57,6 +55,13 @@ result<void> k210_runtime_module::initialize_before_functions(runtime_module_ini
     return ok();
 }
 
+kernels::kernel_context &k210_runtime_module::kernel_context() noexcept
+{
+    // Follow the thread count of the default context, like the stackvm module
+    kernel_context_.num_threads = kernels::default_kernel_context().num_threads;
+    return kernel_context_;
+}
+
 gsl::span<gsl::byte> k210_runtime_module::data() const noexcept
 {
     return { data_.get(), mempool(mem_data).size };
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #pragma once
+#include <nncase/kernels/kernel_context.h>
 #include <nncase/runtime/k210/runtime_module.h>
 #include <nncase/runtime/k210/runtime_types.h>
 
@@ -21,6 +22,8 @@ BEGIN_NS_NNCASE_RT_MODULE(k210)
 class k210_runtime_module : public runtime_module
 {
 public:
+    kernels::kernel_context &kernel_context() noexcept;
+
     gsl::span<gsl::byte> data() const noexcept;
     gsl::span<const gsl::byte> rdata() const noexcept;
     gsl::span<gsl::byte> kpu_ram() noexcept;
@@ -37,9 +40,10 @@ protected:
     result<std::unique_ptr<runtime_function>> create_function() noexcept override;
 
 private:
-    std::unique_ptr<gsl::byte[]> data_;
+    allocation_tracker::buffer_t data_;
     gsl::span<const gsl::byte> rdata_;
     gsl::span<const gsl::byte> text_;
+    kernels::kernel_context kernel_context_;
 #ifdef NNCASE_SIMULATOR
     std::array<gsl::byte, KPU_RAM_SIZE> kpu_ram_;
 #else
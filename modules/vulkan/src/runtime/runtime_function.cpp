@@ -47,12 +47,12 @@ result<void> vulkan_runtime_function::initialize_core(runtime_function_init_cont
 
 result<runtime_tensor> vulkan_runtime_function::allocate_input_tensor(size_t index) noexcept
 {
-    return host_runtime_tensor::create(input_desc(index).datatype, input_shape(index));
+    return allocate_host_tensor(input_desc(index).datatype, input_shape(index));
 }
 
 result<runtime_tensor> vulkan_runtime_function::allocate_output_tensor(size_t index) noexcept
 {
-    return host_runtime_tensor::create(output_desc(index).datatype, output_shape(index));
+    return allocate_host_tensor(output_desc(index).datatype, output_shape(index));
 }
 
 result<void> vulkan_runtime_function::validate_input_tensor(NNCASE_UNUSED size_t index, runtime_tensor tensor) noexcept
@@ -1,4 +1,4 @@
-from typing import Any, List, BinaryIO
+from typing import Any, List, BinaryIO, Optional
 
 import numpy
 
@@ -24,6 +24,10 @@ class CompileOptions:
     input_layout: str
     output_layout: str
     letterbox_value: float
+    max_batch: int
+    compute_type: str
+    compress_sections: bool
+    share_constants: bool
     def __init__(self) -> None: ...
 
 
@@ -84,6 +88,19 @@ class RuntimeTensor:
     def shape(self) -> List[int]: ...
 
 
+class KernelTuner:
+    def __init__(self, tuning: bool = True) -> None: ...
+    def load(self, path: str) -> None: ...
+    def save(self, path: str) -> None: ...
+    @property
+    def tuning(self) -> bool: ...
+    @tuning.setter
+    def tuning(self, value: bool) -> None: ...
+    @property
+    def size(self) -> int: ...
+    cpu_model: str
+
+
 class Simulator:
     def __init__(self) -> None: ...
     def get_input_desc(self, index: int) -> MemoryRange: ...
@@ -95,6 +112,20 @@ class Simulator:
     def set_input_tensor(self, index: int, tensor: RuntimeTensor) -> None: ...
     def set_output_tensor(self, index: int, tensor: RuntimeTensor) -> None: ...
     @property
+    def batch(self) -> int: ...
+    @batch.setter
+    def batch(self, value: int) -> None: ...
+    @property
+    def concurrent_calls(self) -> bool: ...
+    @concurrent_calls.setter
+    def concurrent_calls(self, value: bool) -> None: ...
+    @property
+    def tuner(self) -> Optional[KernelTuner]: ...
+    @tuner.setter
+    def tuner(self, value: Optional[KernelTuner]) -> None: ...
+    @property
+    def max_batch(self) -> int: ...
+    @property
     def inputs_size(self) -> int: ...
     @property
     def outputs_size(self) -> int: ...
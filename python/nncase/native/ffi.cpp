@@ -22,6 +22,7 @@
 #include <nncase/ir/evaluator.h>
 #include <nncase/ir/graph.h>
 #include <nncase/runtime/interpreter.h>
+#include <nncase/runtime/kernel_tuner.h>
 #include <nncase/runtime/runtime_op_utility.h>
 #include <nncase/schedule/scheduler.h>
 #include <nncase/version.h>
@@ -155,11 +156,19 @@ PYBIND11_MODULE(_nncase, m)
         .def_readwrite("dump_quant_error", &compile_options::dump_quant_error)
         .def_readwrite("dump_import_op_range", &compile_options::dump_import_op_range)
         .def_readwrite("dump_dir", &compile_options::dump_dir)
-        .def_readwrite("benchmark_only", &compile_options::benchmark_only);
+        .def_readwrite("benchmark_only", &compile_options::benchmark_only)
+        .def_readwrite("max_batch", &compile_options::max_batch)
+        .def_readwrite("compute_type", &compile_options::compute_type)
+        .def_readwrite("compress_sections", &compile_options::compress_sections)
+        .def_readwrite("share_constants", &compile_options::share_constants)
+        .def_readwrite("compile_threads", &compile_options::compile_threads)
+        .def_readwrite("dump_pass_profile", &compile_options::dump_pass_profile)
+        .def_readwrite("dump_eval_profile", &compile_options::dump_eval_profile);
 
     py::class_<import_options>(m, "ImportOptions")
         .def(py::init())
-        .def_readwrite("output_arrays", &import_options::output_arrays);
+        .def_readwrite("output_arrays", &import_options::output_arrays)
+        .def_readwrite("model_dir", &import_options::model_dir);
 
     py::class_<ptq_tensor_options>(m, "PTQTensorOptions")
         .def(py::init())
@@ -212,11 +221,27 @@ PYBIND11_MODULE(_nncase, m)
 
 #include "runtime_tensor.inl"
 
+    py::class_<kernel_tuner>(m, "KernelTuner")
+        .def(py::init<bool>(), py::arg("tuning") = true)
+        .def_property(
+            "tuning", [](kernel_tuner &tuner) { return tuner.tuning(); }, [](kernel_tuner &tuner, bool value) { tuner.tuning(value); })
+        .def_property_readonly("size", &kernel_tuner::size)
+        .def_property_readonly_static("cpu_model", [](py::object) { return kernel_tuner::cpu_model(); })
+        .def("load", [](kernel_tuner &tuner, const std::string &path) { tuner.load(path.c_str()).unwrap_or_throw(); })
+        .def("save", [](kernel_tuner &tuner, const std::string &path) { tuner.save(path.c_str()).unwrap_or_throw(); });
+
     py::class_<interpreter>(m, "Simulator")
         .def(py::init())
         .def("load_model", [](interpreter &interp, gsl::span<const gsl::byte> buffer) { interp.load_model(buffer).unwrap_or_throw(); })
         .def_property_readonly("inputs_size", &interpreter::inputs_size)
         .def_property_readonly("outputs_size", &interpreter::outputs_size)
+        .def_property_readonly("max_batch", &interpreter::max_batch)
+        .def_property(
+            "batch", [](interpreter &interp) { return interp.batch(); }, [](interpreter &interp, size_t value) { interp.batch(value).unwrap_or_throw(); })
+        .def_property(
+            "concurrent_calls", [](interpreter &interp) { return interp.concurrent_calls(); }, [](interpreter &interp, bool value) { interp.concurrent_calls(value).unwrap_or_throw(); })
+        .def_property(
+            "tuner", [](interpreter &interp) { return interp.tuner(); }, py::cpp_function([](interpreter &interp, kernel_tuner *tuner) { interp.tuner(tuner); }, py::keep_alive<1, 2>()), py::return_value_policy::reference)
         .def("get_input_desc", &interpreter::input_desc)
         .def("get_output_desc", &interpreter::output_desc)
         .def("get_input_tensor", [](interpreter &interp, size_t index) { return interp.input_tensor(index).unwrap_or_throw(); })
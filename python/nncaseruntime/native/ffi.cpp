@@ -85,6 +85,9 @@ PYBIND11_MODULE(_nncaseruntime, m)
         .def("load_model", [](interpreter &interp, gsl::span<const gsl::byte> buffer) { interp.load_model(buffer).unwrap_or_throw(); })
         .def_property_readonly("inputs_size", &interpreter::inputs_size)
         .def_property_readonly("outputs_size", &interpreter::outputs_size)
+        .def_property_readonly("max_batch", &interpreter::max_batch)
+        .def_property(
+            "batch", [](interpreter &interp) { return interp.batch(); }, [](interpreter &interp, size_t value) { interp.batch(value).unwrap_or_throw(); })
         .def("get_input_desc", &interpreter::input_desc)
         .def("get_output_desc", &interpreter::output_desc)
         .def("get_input_tensor", [](interpreter &interp, size_t index) { return interp.input_tensor(index).unwrap_or_throw(); })
@@ -33,6 +33,7 @@ compile_command::compile_command(lyra::cli &cli)
                          .add_argument(lyra::opt(use_mse_quant_w_).name("--use-mse-quant-w").optional().help("use min mse algorithm to refine weights quantilization or not, default is " + std::to_string(use_mse_quant_w_)))
                          .add_argument(lyra::opt(dataset_, "dataset path").name("--dataset").optional().help("calibration dataset, used in post quantization"))
                          .add_argument(lyra::opt(dataset_format_, "dataset format").name("--dataset-format").optional().help("datset format: e.g. image|raw, default is " + dataset_format_))
+                         .add_argument(lyra::opt(dataset_cache_, "dataset cache").name("--dataset-cache").optional().help("directory to cache preprocessed dataset samples"))
                          .add_argument(lyra::opt(dump_range_dataset_, "dataset path").name("--dump-range-dataset").optional().help("dump import op range dataset"))
                          .add_argument(lyra::opt(dump_range_dataset_format_, "dataset format").name("--dump-range-dataset-format").optional().help("datset format: e.g. image|raw, default is " + dump_range_dataset_format_))
                          .add_argument(lyra::opt(calibrate_method_, "calibrate method").name("--calibrate-method").optional().help("calibrate method: e.g. no_clip|l2|kld_m0|kld_m1|kld_m2|cdf, default is " + calibrate_method_))
@@ -53,6 +54,13 @@ compile_command::compile_command(lyra::cli &cli)
                          .add_argument(lyra::opt(dump_quant_error_).name("--dump-quant-error").optional().help("dump quant error, default is " + std::to_string(dump_quant_error_)))
                          .add_argument(lyra::opt(dump_import_op_range_).name("--dump-import-op-range").optional().help("dump import op range, default is " + std::to_string(dump_import_op_range_)))
                          .add_argument(lyra::opt(dump_dir_, "dump directory").name("--dump-dir").optional().help("dump to directory"))
+                         .add_argument(lyra::opt(compute_type_, "compute type").name("--compute-type").optional().help("float compute type, e.g float32|float16|bfloat16, default is " + compute_type_))
+                         .add_argument(lyra::opt(max_batch_, "max batch").name("--max-batch").optional().help("max batch the kmodel can be run with at runtime, default is " + std::to_string(max_batch_)))
+                         .add_argument(lyra::opt(compress_sections_).name("--compress-sections").optional().help("compress kmodel sections, default is " + std::to_string(compress_sections_)))
+                         .add_argument(lyra::opt(share_constants_).name("--share-constants").optional().help("emit constant block hashes so loaded kmodels can share identical constants, default is " + std::to_string(share_constants_)))
+                         .add_argument(lyra::opt(compile_threads_, "compile threads").name("--compile-threads").optional().help("threads used to compile independent subgraphs, 0 means 1, default is " + std::to_string(compile_threads_)))
+                         .add_argument(lyra::opt(dump_pass_profile_).name("--dump-pass-profile").optional().help("dump time, rewrites, node counts and peak memory growth of every pass to dump directory, default is " + std::to_string(dump_pass_profile_)))
+                         .add_argument(lyra::opt(dump_eval_profile_).name("--dump-eval-profile").optional().help("dump time, FLOPs, bytes and roofline efficiency of every node evaluated during calibration to dump directory, default is " + std::to_string(dump_eval_profile_)))
                          .add_argument(lyra::opt(benchmark_only_).name("--benchmark-only").optional().help("compile kmodel only for benchmark use, default is " + std::to_string(benchmark_only_))));
 }
 
@@ -93,6 +101,13 @@ void compile_command::run()
     c_options.input_shape = input_shape_;
     c_options.w_quant_type = w_quant_type_;
     c_options.benchmark_only = benchmark_only_;
+    c_options.max_batch = max_batch_;
+    c_options.compute_type = compute_type_;
+    c_options.compress_sections = compress_sections_;
+    c_options.share_constants = share_constants_;
+    c_options.compile_threads = compile_threads_;
+    c_options.dump_pass_profile = dump_pass_profile_;
+    c_options.dump_eval_profile = dump_eval_profile_;
     c_options.preprocess = preprocess_;
     c_options.use_mse_quant_w = use_mse_quant_w_;
     c_options.input_layout = input_layout_;
@@ -132,6 +147,7 @@ void compile_command::run()
     }
 
     i_options.output_arrays = output_arrays;
+    i_options.model_dir = std::filesystem::path(input_filename_).parent_path();
 
     auto compiler = nncase::compiler::create(c_options);
     if (input_format_ == "tflite")
@@ -163,6 +179,7 @@ void compile_command::run()
         nncase::ptq_dataset_options ptq_options;
         ptq_options.dataset = dataset_;
         ptq_options.dataset_format = dataset_format_;
+        ptq_options.dataset_cache = dataset_cache_;
         ptq_options.calibrate_method = calibrate_method_;
         compiler->use_ptq(ptq_options);
     }
@@ -172,6 +189,7 @@ void compile_command::run()
         nncase::dump_range_dataset_options dump_range_options;
         dump_range_options.dataset = dump_range_dataset_;
         dump_range_options.dataset_format = dump_range_dataset_format_;
+        dump_range_options.dataset_cache = dataset_cache_;
         dump_range_options.calibrate_method = calibrate_method_;
         compiler->dump_range_options(dump_range_options);
     }
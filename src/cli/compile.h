@@ -64,6 +64,7 @@ private:
     std::string dump_dir_;
     std::string dataset_;
     std::string dataset_format_ = "image";
+    std::string dataset_cache_;
     std::string dump_range_dataset_;
     std::string dump_range_dataset_format_ = "image";
     std::string calibrate_method_ = "no_clip";
@@ -73,6 +74,7 @@ private:
     std::string w_quant_type_ = "uint8";
     std::string input_layout_ = "NCHW";
     std::string output_layout_ = "NCHW";
+    std::string compute_type_ = "float32";
     bool use_mse_quant_w_ = false;
     std::vector<float> mean_ = { 0.f, 0.f, 0.f };
     std::vector<float> std_ = { 1.f, 1.f, 1.f };
@@ -92,6 +94,12 @@ private:
     bool dump_import_op_range_ = false;
     bool is_fpga_ = false;
     bool benchmark_only_ = false;
+    bool compress_sections_ = false;
+    bool share_constants_ = false;
+    uint32_t compile_threads_ = 1;
+    bool dump_pass_profile_ = false;
+    bool dump_eval_profile_ = false;
     bool preprocess_ = false;
+    uint32_t max_batch_ = 1;
 };
 }
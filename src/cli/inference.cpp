@@ -14,6 +14,8 @@
  */
 #include "inference.h"
 #include "ProgressBar.hpp"
+#include <iomanip>
+#include <iostream>
 #include <nncase/io_utils.h>
 #include <nncase/simulator.h>
 
@@ -27,6 +29,9 @@ inference_command::inference_command(lyra::cli &cli)
                          .add_argument(lyra::arg(output_path_, "output path").required().help("output path"))
                          .add_argument(lyra::opt(dataset_, "dataset path").name("--dataset").required().help("dataset path"))
                          .add_argument(lyra::opt(dataset_format_, "dataset format").name("--dataset-format").optional().help("dataset format, e.g. image|raw, default is " + dataset_format_))
+                         .add_argument(lyra::opt(dataset_cache_, "dataset cache").name("--dataset-cache").optional().help("directory to cache preprocessed dataset samples"))
+                         .add_argument(lyra::opt(workers_, "workers").name("--workers").optional().help("interpreters running in parallel, default is " + std::to_string(workers_)))
+                         .add_argument(lyra::opt(concurrent_calls_).name("--concurrent-calls").optional().help("run independent module calls concurrently, default is " + std::to_string(concurrent_calls_)))
                          .add_argument(lyra::opt(input_layout_, "input layout").name("--input-layout").optional().help("input layout, e.g NCHW|NHWC, default is " + input_layout_)));
 }
 
@@ -35,9 +40,22 @@ void inference_command::run()
     simulate_options options;
     options.dataset = dataset_;
     options.dataset_format = dataset_format_;
+    options.dataset_cache = dataset_cache_;
     options.output_path = output_path_;
     options.input_layout = input_layout_;
+    options.workers = workers_;
+    options.concurrent_calls = concurrent_calls_;
 
     auto sim = simulator::create(read_file(model_filename_), options);
-    sim->run();
+    auto stats = sim->run();
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Inferred " << stats.samples << " samples in " << stats.elapsed_seconds << " s with " << stats.workers << " workers, "
+              << stats.samples / stats.elapsed_seconds << " samples/s" << std::endl
+              << "Run latency per batch of " << stats.batch_size << " (ms): p50 " << stats.latency_p50_ms << ", p90 " << stats.latency_p90_ms
+              << ", p99 " << stats.latency_p99_ms << ", max " << stats.latency_max_ms << std::endl;
+
+    auto &usage = stats.memory;
+    std::cout << "Memory per interpreter (bytes): data " << usage.data_bytes << ", sections " << usage.section_bytes
+              << ", tensors " << usage.tensor_bytes << ", peak scratch " << usage.peak_scratch_bytes << ", peak total " << usage.peak_bytes << std::endl;
 }
@@ -31,6 +31,9 @@ private:
     std::string output_path_;
     std::string dataset_;
     std::string dataset_format_ = "image";
+    std::string dataset_cache_;
     std::string input_layout_ = "NCHW";
+    size_t workers_ = 1;
+    bool concurrent_calls_ = false;
 };
 }
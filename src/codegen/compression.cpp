@@ -0,0 +1,138 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <nncase/codegen/compression.h>
+
+using namespace nncase;
+using namespace nncase::codegen;
+
+namespace
+{
+constexpr size_t min_match = 4;
+// lz4 requires the last 5 bytes to be literals and the last match to start 12 bytes before the end
+constexpr size_t last_literals = 5;
+constexpr size_t match_find_limit = 12;
+constexpr size_t max_offset = 65535;
+constexpr size_t hash_log = 16;
+
+uint32_t read32(const uint8_t *ptr) noexcept
+{
+    uint32_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+size_t hash32(uint32_t value) noexcept
+{
+    return (value * 2654435761U) >> (32 - hash_log);
+}
+
+class lz4_block_writer
+{
+public:
+    lz4_block_writer(std::span<const uint8_t> input)
+        : input_(input)
+    {
+        output_.reserve(input.size() + input.size() / 255 + 16);
+    }
+
+    void write_sequence(size_t literal_start, size_t literal_end, size_t offset, size_t match_length)
+    {
+        auto literals = literal_end - literal_start;
+        auto match = match_length - min_match;
+        output_.push_back((uint8_t)((std::min(literals, (size_t)15) << 4) | std::min(match, (size_t)15)));
+        write_literals(literal_start, literals);
+        output_.push_back((uint8_t)(offset & 0xFF));
+        output_.push_back((uint8_t)(offset >> 8));
+        if (match >= 15)
+            write_length(match - 15);
+    }
+
+    void write_last_literals(size_t literal_start)
+    {
+        auto literals = input_.size() - literal_start;
+        output_.push_back((uint8_t)(std::min(literals, (size_t)15) << 4));
+        write_literals(literal_start, literals);
+    }
+
+    std::vector<uint8_t> &output() noexcept { return output_; }
+
+private:
+    void write_literals(size_t start, size_t literals)
+    {
+        if (literals >= 15)
+            write_length(literals - 15);
+        output_.insert(output_.end(), input_.begin() + start, input_.begin() + start + literals);
+    }
+
+    void write_length(size_t length)
+    {
+        while (length >= 255)
+        {
+            output_.push_back(255);
+            length -= 255;
+        }
+
+        output_.push_back((uint8_t)length);
+    }
+
+private:
+    std::span<const uint8_t> input_;
+    std::vector<uint8_t> output_;
+};
+}
+
+std::vector<uint8_t> codegen::compress_section(std::span<const uint8_t> input)
+{
+    lz4_block_writer writer(input);
+    auto data = input.data();
+    size_t anchor = 0;
+
+    if (input.size() > match_find_limit)
+    {
+        constexpr auto no_pos = std::numeric_limits<size_t>::max();
+        std::vector<size_t> table(size_t(1) << hash_log, no_pos);
+        auto pos_limit = input.size() - match_find_limit;
+        auto match_limit = input.size() - last_literals;
+
+        size_t pos = 0;
+        while (pos < pos_limit)
+        {
+            auto sequence = read32(data + pos);
+            auto &slot = table[hash32(sequence)];
+            auto candidate = slot;
+            slot = pos;
+
+            if (candidate != no_pos && pos - candidate <= max_offset && read32(data + candidate) == sequence)
+            {
+                auto match_end = pos + min_match;
+                while (match_end < match_limit && data[match_end] == data[candidate + match_end - pos])
+                    match_end++;
+
+                writer.write_sequence(anchor, pos, pos - candidate, match_end - pos);
+                pos = anchor = match_end;
+            }
+            else
+            {
+                pos++;
+            }
+        }
+    }
+
+    writer.write_last_literals(anchor);
+    return std::move(writer.output());
+}
@@ -15,6 +15,7 @@
 #include <nncase/codegen/model_builder.h>
 #include <nncase/ir/op_utils.h>
 #include <nncase/runtime/model.h>
+#include <nncase/runtime/stackvm/runtime_module.h>
 #include <nncase/targets/target.h>
 
 using namespace nncase;
@@ -51,9 +52,19 @@ build_model_result model_builder::build(std::ostream &output)
     auto header_pos = writer.position();
     writer.skip(sizeof(header));
 
+    auto max_batch = std::max(target_.options().max_batch, 1U);
+    if (max_batch > 1)
+    {
+        for (auto &mod_sched : sched_.modules)
+        {
+            if (mod_sched.type != runtime::stackvm::stackvm_module_type)
+                throw std::runtime_error("Dynamic batch is only supported by stackvm modules, but got module " + std::string(mod_sched.type.data()));
+        }
+    }
+
     for (auto &mod_sched : sched_.modules)
     {
-        module_builder_params params { sched_, mod_sched };
+        module_builder_params params { sched_, mod_sched, max_batch, target_.options().compress_sections, target_.options().share_constants };
         auto builder = target_.create_module_builder(mod_sched.type, mod_sched.type.data(), params);
         builder->config_dump(dump_dir_ / mod_sched.type.data(), dump_asm_);
         builder->build(writer);
@@ -12,7 +12,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <fstream>
+#include <nncase/codegen/compression.h>
 #include <nncase/codegen/module_builder.h>
 #include <nncase/io_utils.h>
 #include <nncase/ir/debug.h>
@@ -22,6 +24,7 @@
 #include <nncase/ir/visitor.h>
 #include <nncase/runtime/bitio.h>
 #include <nncase/runtime/model.h>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -35,6 +38,14 @@ using namespace nncase::runtime;
 namespace
 {
 std::unordered_set<node_opcode> non_runtime_opcodes { op_input_node, op_output_node, op_uninitialized, op_ignore_node, op_constant };
+
+uint64_t fnv1a_hash(std::span<const uint8_t> data) noexcept
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    for (auto b : data)
+        hash = (hash ^ b) * 0x100000001b3;
+    return hash;
+}
 }
 
 module_builder::module_builder(uint32_t alignment, std::string_view module_name, const module_builder_params &params)
@@ -54,6 +65,9 @@ void module_builder::config_dump(const std::filesystem::path &dump_dir, bool dum
 
 const schedule::buffer_allocation &module_builder::allocation(ir::output_connector &conn) const
 {
+    auto it = rdata_allocations_.find(&conn);
+    if (it != rdata_allocations_.end())
+        return it->second;
     return params_.module_sched.allocations.at(&conn);
 }
 
@@ -88,6 +102,9 @@ std::vector<nncase::ir::node *> module_builder::generate_current_runtime_ops()
 
 size_t module_builder::max_usage(memory_location_t location) const
 {
+    if (location == mem_rdata)
+        return rdata_usage_;
+
     auto it = params_.module_sched.max_usages.find(location);
     if (it != params_.module_sched.max_usages.end())
         return it->second;
@@ -101,27 +118,81 @@ void module_builder::emit(ir::node &node)
 
 void module_builder::write_constants()
 {
-    auto it = params_.module_sched.max_usages.find(mem_rdata);
-    if (it != params_.module_sched.max_usages.end())
+    if (!params_.module_sched.max_usages.contains(mem_rdata))
+        return;
+
+    // Constants with the same content (e.g. embedded into several subgraphs) share one copy
+    auto &rdata_writer = writer(".rdata");
+    std::unordered_multimap<size_t, std::pair<std::span<const std::byte>, size_t>> written_constants;
+    std::unordered_map<size_t, size_t> constant_starts;
+    for (auto &func_sched : params_.module_sched.functions)
     {
-        auto constants = std::make_unique<std::byte[]>(it->second);
-        for (auto &func_sched : params_.module_sched.functions)
+        for (auto &&node : func_sched.compute_sequence)
         {
-            for (auto &&node : func_sched.compute_sequence)
+            if (auto con = node_cast<constant>(*node))
             {
-                if (auto con = node_cast<constant>(*node))
+                if (con->output().memory_location() == mem_rdata)
                 {
-                    if (con->output().memory_location() == mem_rdata)
+                    auto &alloc = params_.module_sched.allocations.at(&con->output());
+                    auto data = con->data();
+                    auto hash = std::hash<std::string_view>()({ reinterpret_cast<const char *>(data.data()), data.size_bytes() });
+
+                    std::optional<size_t> start;
+                    auto range = written_constants.equal_range(hash);
+                    for (auto it = range.first; it != range.second; ++it)
+                    {
+                        auto &written = it->second;
+                        if (written.first.size_bytes() == data.size_bytes()
+                            && written.second % con->alignment() == 0
+                            && std::equal(data.begin(), data.end(), written.first.begin()))
+                        {
+                            start = written.second;
+                            break;
+                        }
+                    }
+
+                    if (!start)
                     {
-                        auto &alloc = allocation(con->output());
-                        auto data = con->data();
-                        std::memcpy(constants.get() + alloc.start, data.data(), data.size_bytes());
+                        rdata_writer.align_position(con->alignment());
+                        start = (size_t)rdata_writer.position();
+                        rdata_writer.write_array(data);
+                        written_constants.emplace(hash, std::make_pair(data, *start));
+                        rdata_blocks_.emplace_back(*start, data.size_bytes());
                     }
+
+                    constant_starts.emplace(alloc.start, *start);
                 }
             }
         }
+    }
+
+    rdata_usage_ = (size_t)rdata_writer.position();
+    remap_rdata_allocations(constant_starts);
 
-        writer(".rdata").write_array(std::span<std::byte const>(constants.get(), it->second));
+    if (dump_asm_)
+    {
+        std::ofstream file(dump_dir_ / "rdata-dedup.txt");
+        file << "constants: " << constant_starts.size() << ", unique: " << written_constants.size() << std::endl;
+        file << "scheduled: " << params_.module_sched.max_usages.at(mem_rdata) << " bytes, written: " << rdata_usage_ << " bytes" << std::endl;
+    }
+}
+
+void module_builder::remap_rdata_allocations(const std::unordered_map<size_t, size_t> &constant_starts)
+{
+    for (auto &alloc_p : params_.module_sched.allocations)
+    {
+        auto &alloc = alloc_p.second;
+        if (alloc.memory_location == mem_rdata)
+        {
+            // Buffers in .rdata are constants or views into them
+            auto it = constant_starts.find(alloc.start - alloc.parent_offset);
+            if (it == constant_starts.end())
+                throw std::runtime_error("Cannot find the constant of .rdata buffer " + alloc_p.first->owner().name());
+
+            auto new_alloc = alloc;
+            new_alloc.start = it->second + alloc.parent_offset;
+            rdata_allocations_.emplace(alloc_p.first, new_alloc);
+        }
     }
 }
 
@@ -305,6 +376,60 @@ void module_builder::link()
     }
 }
 
+void module_builder::write_rdata_blocks()
+{
+    auto rdata_it = section_writer_.find(".rdata");
+    if (rdata_it == section_writer_.end() || rdata_it->second.body.empty())
+        return;
+
+    // Blocks are the unique constants and the sections merged into .rdata,
+    // other bytes are padding unless they are not zero
+    std::span<const uint8_t> rdata = rdata_it->second.body;
+    auto blocks = rdata_blocks_;
+    for (auto &merge_p : rdata_section_merges_)
+        blocks.emplace_back(merge_p.second.start, merge_p.second.size);
+    std::erase_if(blocks, [](auto &block) { return block.second == 0; });
+    std::sort(blocks.begin(), blocks.end());
+
+    std::vector<std::pair<size_t, size_t>> gaps;
+    size_t end = 0;
+    for (auto &block : blocks)
+    {
+        if (block.first > end)
+            gaps.emplace_back(end, block.first - end);
+        end = std::max(end, block.first + block.second);
+    }
+
+    if (rdata.size() > end)
+        gaps.emplace_back(end, rdata.size() - end);
+    for (auto &gap : gaps)
+    {
+        auto gap_data = rdata.subspan(gap.first, gap.second);
+        if (std::any_of(gap_data.begin(), gap_data.end(), [](uint8_t b) { return b != 0; }))
+            blocks.emplace_back(gap);
+    }
+
+    std::sort(blocks.begin(), blocks.end());
+    auto &blocks_section = section_writer_.emplace(".rdata_blocks", std::in_place).first->second;
+    for (auto &block : blocks)
+    {
+        rdata_block_desc desc {};
+        desc.hash = fnv1a_hash(rdata.subspan(block.first, block.second));
+        desc.start = (uint32_t)block.first;
+        desc.size = (uint32_t)block.second;
+        blocks_section.writer.write(desc);
+    }
+
+    blocks_section.body = read_stream(blocks_section.stream);
+
+    if (dump_asm_)
+    {
+        std::ofstream file(dump_dir_ / "rdata-blocks.txt");
+        for (auto &block : blocks)
+            file << block.first << "+" << block.second << std::endl;
+    }
+}
+
 void module_builder::write_binary(binary_writer &writer)
 {
     // Skip module header
@@ -316,7 +441,7 @@ void module_builder::write_binary(binary_writer &writer)
     {
         mempool_desc desc {};
         desc.location = mem.first;
-        desc.size = mem.second;
+        desc.size = (uint32_t)max_usage(mem.first);
         writer.write(desc);
     }
 
@@ -330,18 +455,36 @@ void module_builder::write_binary(binary_writer &writer)
         section_header header {};
         strncpy(header.name, section.first.c_str(), std::size(header.name) - 1);
 
+        std::span<const uint8_t> body = section.second.body;
+        std::vector<uint8_t> compressed_body;
         auto merge_it = rdata_section_merges_.find(section.first);
         if (merge_it == rdata_section_merges_.end())
         {
             header.flags = 0;
             header.body_start = 0;
-            header.body_size = (uint32_t)section.second.body.size();
+            header.memory_size = (uint32_t)body.size();
+
+            // Only keep the compressed body if it saves at least 1/8,
+            // shared constants always need it so the runtime owns .rdata until it is split into blocks
+            auto share_rdata = params_.share_constants && section.first == ".rdata";
+            if ((params_.compress_sections || share_rdata) && !body.empty())
+            {
+                compressed_body = compress_section(body);
+                if (share_rdata || compressed_body.size() < body.size() - body.size() / 8)
+                {
+                    header.flags |= SECTION_COMPRESSED;
+                    body = compressed_body;
+                }
+            }
+
+            header.body_size = (uint32_t)body.size();
         }
         else
         {
             header.flags = SECTION_MERGED_INTO_RDATA;
             header.body_start = merge_it->second.start;
             header.body_size = merge_it->second.size;
+            header.memory_size = merge_it->second.size;
         }
 
         // Skip section header
@@ -352,7 +495,7 @@ void module_builder::write_binary(binary_writer &writer)
         {
             header.body_start = (uint32_t)writer.align_position(alignment_);
             // write content
-            writer.write_array(std::span<uint8_t const>(section.second.body));
+            writer.write_array(body);
         }
 
         // write section header
@@ -449,6 +592,8 @@ void module_builder::build(binary_writer &writer)
 {
     compile();
     link();
+    if (params_.share_constants)
+        write_rdata_blocks();
     write_binary(writer);
 }
 
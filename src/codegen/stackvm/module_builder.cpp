@@ -13,8 +13,11 @@
  * limitations under the License.
  */
 #include "module_builder.h"
+#include <nncase/ir/debug.h>
+#include <nncase/ir/visitor.h>
 #include <nncase/runtime/stackvm/opcode.h>
 #include <nncase/runtime/stackvm/runtime_module.h>
+#include <numeric>
 
 using namespace nncase;
 using namespace nncase::codegen;
@@ -49,9 +52,31 @@ section_writer &stackvm_module_builder::text_writer()
     return writer(".text");
 }
 
-void stackvm_module_builder::begin_emit_function([[maybe_unused]] const schedule::function_schedule_result &function)
+void stackvm_module_builder::begin_emit_function(const schedule::function_schedule_result &function)
 {
     set_current_entry_point(text_writer().position());
+    if (dynamic_batch())
+        mark_batch_allocations(function);
+}
+
+void stackvm_module_builder::mark_batch_allocations(const schedule::function_schedule_result &function)
+{
+    std::unordered_set<const output_connector *> batch_outputs;
+    auto visitor = make_relay_ir_visitor([&](node &node) {
+        auto on_batch_path = node.runtime_opcode() == op_input_node
+            || std::any_of(node.inputs().begin(), node.inputs().end(), [&](input_connector *in) { return batch_outputs.contains(in->connection()); });
+        if (!on_batch_path)
+            return;
+
+        for (auto out : node.outputs())
+        {
+            batch_outputs.emplace(out);
+            auto &alloc = allocation(*out);
+            if (alloc.memory_location != mem_rdata && !alloc.shape.empty())
+                batch_allocations_.emplace(&alloc);
+        }
+    });
+    visitor.visit(*function.graph);
 }
 
 void stackvm_module_builder::end_emit_function([[maybe_unused]] const schedule::function_schedule_result &function)
@@ -59,9 +84,15 @@ void stackvm_module_builder::end_emit_function([[maybe_unused]] const schedule::
     set_current_function_text_end(text_writer().position());
 }
 
+void stackvm_module_builder::begin_emit_module()
+{
+    if (dynamic_batch())
+        writer(".batch").write((uint32_t)max_batch());
+}
+
 void stackvm_module_builder::emit(ir::node &node)
 {
-    stackvm_op_builder builder(node, text_writer());
+    stackvm_op_builder builder(node, text_writer(), dynamic_batch() ? &batch_allocations_ : nullptr);
 #define DEFINE_OP(op)                          \
     if (node.runtime_opcode() == op::opcode()) \
         return emit(static_cast<op &>(node), builder);
@@ -70,6 +101,21 @@ void stackvm_module_builder::emit(ir::node &node)
     module_builder::emit(node);
 }
 
+stackvm_op_builder::stackvm_op_builder(ir::node &node, section_writer &writer, const std::unordered_set<const schedule::buffer_allocation *> *batch_allocations)
+    : op_builder(node, writer), node_(node), batch_allocations_(batch_allocations)
+{
+}
+
+bool stackvm_op_builder::is_batch_major(const schedule::buffer_allocation &alloc) const
+{
+    // Buffers off the batch path (e.g. computed from constants) are compiled statically
+    if (!batch_allocations_ || !batch_allocations_->contains(&alloc))
+        return false;
+    if (alloc.shape[0] != 1)
+        throw std::runtime_error("Dynamic batch requires batch 1 as the leading dim of the activations derived from inputs, but got " + ir::to_string(alloc.shape));
+    return true;
+}
+
 void stackvm_op_builder::stshape(uint8_t rshape, const ir::shape_t &shape)
 {
     assert(shape.size() <= std::numeric_limits<uint8_t>::max());
@@ -78,6 +124,42 @@ void stackvm_op_builder::stshape(uint8_t rshape, const ir::shape_t &shape)
     stshape_(rshape, (uint8_t)shape.size());
 }
 
+void stackvm_op_builder::stshape(uint8_t rshape, const schedule::buffer_allocation &alloc)
+{
+    if (!is_batch_major(alloc))
+        return stshape(rshape, alloc.shape);
+
+    auto &shape = alloc.shape;
+    assert(shape.size() <= std::numeric_limits<uint8_t>::max());
+
+    // dim 0 is the batch, load it from the batch register
+    lea_gp_(stackvm_batch_reg, 0);
+    for (size_t i = 1; i < shape.size(); i++)
+        ldc_i4_((int32_t)shape[i]);
+    stshape_(rshape, (uint8_t)shape.size());
+}
+
+void stackvm_op_builder::ststrides(uint8_t rstrides, const schedule::buffer_allocation &alloc)
+{
+    if (!is_batch_major(alloc))
+        return stshape(rstrides, alloc.strides);
+
+    auto &strides = alloc.strides;
+    assert(strides.size() <= std::numeric_limits<uint8_t>::max());
+
+    // stride of dim 0 is the size of one batch in the parent buffer,
+    // or 0 when batch is 1 to keep the strides contiguous
+    auto batch_stride = std::accumulate(alloc.strides_shape.begin() + 1, alloc.strides_shape.end(), (size_t)1, std::multiplies<size_t>());
+    ldc_i4_((int32_t)batch_stride);
+    lea_gp_(stackvm_batch_reg, 0);
+    ldc_i4_1_();
+    cgt_u_();
+    mul_();
+    for (size_t i = 1; i < strides.size(); i++)
+        ldc_i4_((int32_t)strides[i]);
+    stshape_(rstrides, (uint8_t)strides.size());
+}
+
 void stackvm_op_builder::staxis(uint8_t rshape, const ir::axis_t &axis)
 {
     assert(axis.size() <= std::numeric_limits<uint8_t>::max());
@@ -96,7 +178,23 @@ void stackvm_op_builder::stpaddings(uint8_t rpaddings, std::span<padding const>
 
 void stackvm_op_builder::lea_buffer(const schedule::buffer_allocation &alloc)
 {
-    lea_buffer_(alloc.memory_location, 0, (uint32_t)alloc.start);
+    if (batch_allocations_ && alloc.memory_location != mem_rdata && alloc.parent_offset)
+    {
+        // Only the physical buffer is scaled by batch, a sub buffer keeps its offset in batch 0
+        lea_buffer_(alloc.memory_location, 0, (uint32_t)(alloc.start - alloc.parent_offset));
+        ldc_i4_((int32_t)alloc.parent_offset);
+        add_();
+    }
+    else
+    {
+        lea_buffer_(alloc.memory_location, 0, (uint32_t)alloc.start);
+    }
+}
+
+void stackvm_op_builder::check_batch_axis(bool touches_batch) const
+{
+    if (batch_allocations_ && touches_batch)
+        throw std::runtime_error("Dynamic batch doesn't support " + node_.name() + "[" + std::string(node_.runtime_opcode().name) + "] which operates on the batch axis");
 }
 
 void stackvm_op_builder::ldpadding(const padding &pad)
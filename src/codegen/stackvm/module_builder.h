@@ -27,8 +27,10 @@
 #include <nncase/ir/ops/gather.h>
 #include <nncase/ir/ops/gather_nd.h>
 #include <nncase/ir/ops/hardmax.h>
+#include <nncase/ir/ops/matmul.h>
 #include <nncase/ir/ops/onehot.h>
 #include <nncase/ir/ops/pad.h>
+#include <nncase/ir/ops/preprocess.h>
 #include <nncase/ir/ops/quantize.h>
 #include <nncase/ir/ops/random_normal.h>
 #include <nncase/ir/ops/random_uniform.h>
@@ -45,20 +47,30 @@
 #include <nncase/ir/ops/unary.h>
 #include <nncase/ir/placeholders.h>
 #include <nncase/schedule/scheduler.h>
+#include <unordered_set>
 
 namespace nncase::codegen::stackvm
 {
 class stackvm_op_builder : public op_builder
 {
 public:
-    using op_builder::op_builder;
+    stackvm_op_builder(ir::node &node, section_writer &writer, const std::unordered_set<const schedule::buffer_allocation *> *batch_allocations);
 
     void stshape(uint8_t rshape, const ir::shape_t &shape);
+    void stshape(uint8_t rshape, const schedule::buffer_allocation &alloc);
+    void ststrides(uint8_t rstrides, const schedule::buffer_allocation &alloc);
     void staxis(uint8_t rshape, const ir::axis_t &axis);
     void stpaddings(uint8_t rpaddings, std::span<padding const> paddings);
     void lea_buffer(const schedule::buffer_allocation &alloc);
     void ldpadding(const padding &pad);
     void ldscalar(const scalar &value);
+
+    bool is_batch_major(const schedule::buffer_allocation &alloc) const;
+    void check_batch_axis(bool touches_batch) const;
+
+private:
+    ir::node &node_;
+    const std::unordered_set<const schedule::buffer_allocation *> *batch_allocations_;
 };
 
 class stackvm_module_builder : public module_builder
@@ -74,11 +86,18 @@ protected:
 
     void begin_emit_function(const schedule::function_schedule_result &function) override;
     void end_emit_function(const schedule::function_schedule_result &function) override;
+    void begin_emit_module() override;
     void emit(ir::node &node) override;
 
 private:
+    void mark_batch_allocations(const schedule::function_schedule_result &function);
+
 #define DEFINE_OP(op_) void emit(ir::op_ &op, stackvm_op_builder &builder);
 #include "ops.def"
 #undef DEFINE_OP
+
+private:
+    // Buffers reachable from the inputs, only they are rebatched
+    std::unordered_set<const schedule::buffer_allocation *> batch_allocations_;
 };
 }
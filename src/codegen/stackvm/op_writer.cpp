@@ -563,6 +563,11 @@ void op_builder::tensor_lut1d_(datatype_t datatype, uint8_t rshape_src, uint8_t
     op_writer<tensor_lut1d_op_t>()(tensor_lut1d_op_t(datatype, rshape_src, rstride_src, rstride_dest, table_len), writer_);
 }
 
+void op_builder::tensor_matmul_(datatype_t datatype, uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rstride_dest, bool transpose_a, bool transpose_b, float fused_clamp_low, float fused_clamp_high)
+{
+    op_writer<tensor_matmul_op_t>()(tensor_matmul_op_t(datatype, rshape_src1, rstride_src1, rshape_src2, rstride_src2, rstride_dest, transpose_a, transpose_b, fused_clamp_low, fused_clamp_high), writer_);
+}
+
 void op_builder::tensor_onehot_(datatype_t datatype, uint8_t rshape_indices, uint8_t rshape_dest, uint8_t rstride_dest, uint8_t axis, onehot_mode_t onehot_mode)
 {
     op_writer<tensor_onehot_op_t>()(tensor_onehot_op_t(datatype, rshape_indices, rshape_dest, rstride_dest, axis, onehot_mode), writer_);
@@ -573,6 +578,11 @@ void op_builder::tensor_pad_(datatype_t datatype, uint8_t rshape_src, uint8_t rs
     op_writer<tensor_pad_op_t>()(tensor_pad_op_t(datatype, rshape_src, rstride_src, rstride_dest, rpaddings, pad_mode), writer_);
 }
 
+void op_builder::tensor_preprocess_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest, uint8_t rpaddings, bool input_nhwc, bool output_nhwc, bool swap_rb, int32_t zero_point, float scale, int32_t resize_h, int32_t resize_w, float pad_value)
+{
+    op_writer<tensor_preprocess_op_t>()(tensor_preprocess_op_t(datatype, rshape_src, rstride_src, rstride_dest, rpaddings, input_nhwc, output_nhwc, swap_rb, zero_point, scale, resize_h, resize_w, pad_value), writer_);
+}
+
 void op_builder::tensor_quantize_(datatype_t in_datatype, datatype_t dst_datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest)
 {
     op_writer<tensor_quantize_op_t>()(tensor_quantize_op_t(in_datatype, dst_datatype, rshape_src, rstride_src, rstride_dest), writer_);
@@ -26,9 +26,9 @@ void stackvm_module_builder::emit(batch_to_space &node, stackvm_op_builder &buil
     builder.lea_buffer(input);
     builder.lea_buffer(output);
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
-    builder.stshape(2, output.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.ststrides(2, output);
     builder.stshape(3, shape_t { (size_t)node.block_size_h(), (size_t)node.block_size_w() });
     builder.stpaddings(0, std::vector<padding> { padding { node.crop_h()[0], node.crop_h()[1] }, padding { node.crop_w()[0], node.crop_w()[1] } });
     builder.tensor_batch_to_space_(node.input().type(), 0, 1, 2, 3, 0);
@@ -28,10 +28,10 @@ void stackvm_module_builder::emit(binary &node, stackvm_op_builder &builder)
     builder.lea_buffer(input_b);
     builder.lea_buffer(output);
 
-    builder.stshape(0, input_a.shape);
-    builder.stshape(1, input_a.strides);
-    builder.stshape(2, input_b.shape);
-    builder.stshape(3, input_b.strides);
-    builder.stshape(4, output.strides);
+    builder.stshape(0, input_a);
+    builder.ststrides(1, input_a);
+    builder.stshape(2, input_b);
+    builder.ststrides(3, input_b);
+    builder.ststrides(4, output);
     builder.tensor_binary_(node.input_a().type(), 0, 1, 2, 3, 4, node.binary_op(), node.fused_activation().min, node.fused_activation().max);
 }
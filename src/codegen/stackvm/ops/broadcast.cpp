@@ -26,9 +26,9 @@ void stackvm_module_builder::emit(broadcast &node, stackvm_op_builder &builder)
     builder.lea_buffer(input);
     builder.lea_buffer(output);
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
-    builder.stshape(2, output.shape);
-    builder.stshape(3, output.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.stshape(2, output);
+    builder.ststrides(3, output);
     builder.tensor_broadcast_(node.input().type(), 0, 1, 2, 3);
 }
@@ -29,9 +29,9 @@ void stackvm_module_builder::emit(call &node, stackvm_op_builder &builder)
         auto &input = allocation(*in);
         builder.lea_buffer(input);
         builder.ldc_i4_((uint8_t)input.type);
-        builder.stshape(rshape, input.shape);
+        builder.stshape(rshape, input);
         builder.ldc_i4_(rshape++);
-        builder.stshape(rshape, input.strides);
+        builder.ststrides(rshape, input);
         builder.ldc_i4_(rshape++);
     }
 
@@ -40,9 +40,9 @@ void stackvm_module_builder::emit(call &node, stackvm_op_builder &builder)
         auto &output = allocation(*out);
         builder.lea_buffer(output);
         builder.ldc_i4_((uint8_t)output.type);
-        builder.stshape(rshape, output.shape);
+        builder.stshape(rshape, output);
         builder.ldc_i4_(rshape++);
-        builder.stshape(rshape, output.strides);
+        builder.ststrides(rshape, output);
         builder.ldc_i4_(rshape++);
     }
 
@@ -32,12 +32,12 @@ void stackvm_module_builder::emit(conv2d &node, stackvm_op_builder &builder)
     builder.ldpadding(node.padding_h());
     builder.ldpadding(node.padding_w());
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
-    builder.stshape(2, weights.shape);
-    builder.stshape(3, weights.strides);
-    builder.stshape(4, bias.strides);
-    builder.stshape(5, output.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.stshape(2, weights);
+    builder.ststrides(3, weights);
+    builder.ststrides(4, bias);
+    builder.ststrides(5, output);
     builder.tensor_conv2d_(node.input().type(), 0, 1, 2, 3, 4, 5, (uint16_t)node.groups(), (uint16_t)node.stride_h(), (uint16_t)node.stride_w(),
         (uint16_t)node.dilation_h(), (uint16_t)node.dilation_w(), node.fused_activation().min, node.fused_activation().max);
 }
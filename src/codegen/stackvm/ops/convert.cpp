@@ -26,8 +26,8 @@ void stackvm_module_builder::emit(convert &node, stackvm_op_builder &builder)
     builder.lea_buffer(input);
     builder.lea_buffer(output);
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
-    builder.stshape(2, output.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.ststrides(2, output);
     builder.tensor_convert_(node.input().type(), node.output().type(), 0, 1, 2);
 }
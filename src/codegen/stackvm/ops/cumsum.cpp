@@ -23,8 +23,9 @@ void stackvm_module_builder::emit(cumsum &node, stackvm_op_builder &builder)
 {
     auto &input = allocation(node.input());
     auto &output = allocation(node.output());
+    builder.check_batch_axis(builder.is_batch_major(input) && node.axis() == 0);
     builder.lea_buffer(input);
     builder.lea_buffer(output);
-    builder.stshape(0, input.shape);
+    builder.stshape(0, input);
     builder.tensor_cumsum_(node.input().type(), 0, node.axis(), node.exclusive(), node.reverse());
 }
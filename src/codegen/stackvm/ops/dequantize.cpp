@@ -26,9 +26,9 @@ void stackvm_module_builder::emit(dequantize &node, stackvm_op_builder &builder)
     builder.lea_buffer(input);
     builder.lea_buffer(output);
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
-    builder.stshape(2, output.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.ststrides(2, output);
 
     // TODO: by axis
     builder.ldc_r4_(node.quant_param().scale);
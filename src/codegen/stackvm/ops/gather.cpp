@@ -24,15 +24,16 @@ void stackvm_module_builder::emit(gather &node, stackvm_op_builder &builder)
     auto &input = allocation(node.input());
     auto &output = allocation(node.output());
     auto &indices = allocation(node.indices());
+    builder.check_batch_axis(builder.is_batch_major(input) && node.axis() == 0);
     builder.lea_buffer(input);
     builder.lea_buffer(output);
     builder.lea_buffer(indices);
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, output.shape);
-    builder.stshape(2, input.strides);
-    builder.stshape(3, output.strides);
-    builder.stshape(4, indices.shape);
+    builder.stshape(0, input);
+    builder.stshape(1, output);
+    builder.ststrides(2, input);
+    builder.ststrides(3, output);
+    builder.stshape(4, indices);
 
     builder.tensor_gather_(node.input().type(), 0, 1, 2, 3, 4, (uint8_t)node.axis());
 }
\ No newline at end of file
@@ -28,11 +28,11 @@ void stackvm_module_builder::emit(gather_nd &node, stackvm_op_builder &builder)
     builder.lea_buffer(output);
     builder.lea_buffer(indices);
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, output.shape);
-    builder.stshape(2, input.strides);
-    builder.stshape(3, output.strides);
-    builder.stshape(4, indices.shape);
+    builder.stshape(0, input);
+    builder.stshape(1, output);
+    builder.ststrides(2, input);
+    builder.ststrides(3, output);
+    builder.stshape(4, indices);
 
     builder.tensor_gather_nd_(node.input().type(), 0, 1, 2, 3, 4, (uint8_t)node.batch_dims());
 }
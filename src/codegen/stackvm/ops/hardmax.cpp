@@ -23,9 +23,10 @@ void stackvm_module_builder::emit(hardmax &node, stackvm_op_builder &builder)
 {
     auto &input = allocation(node.input());
     auto &output = allocation(node.output());
+    builder.check_batch_axis(builder.is_batch_major(input) && node.axis() == 0);
     builder.lea_buffer(input);
     builder.lea_buffer(output);
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
     builder.tensor_hardmax_(node.input().type(), 0, 1, node.axis());
 }
@@ -32,8 +32,8 @@ void stackvm_module_builder::emit(onehot &node, stackvm_op_builder &builder)
     builder.lea_buffer(off_value);
     builder.lea_buffer(output);
 
-    builder.stshape(0, indices.shape);
-    builder.stshape(1, output.shape);
-    builder.stshape(2, output.strides);
+    builder.stshape(0, indices);
+    builder.stshape(1, output);
+    builder.ststrides(2, output);
     builder.tensor_onehot_(node.depth().type(), 0, 1, 2, node.axis(), node.mode());
 }
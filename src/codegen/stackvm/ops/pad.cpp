@@ -27,9 +27,9 @@ void stackvm_module_builder::emit(pad &node, stackvm_op_builder &builder)
     builder.lea_buffer(output);
     builder.ldscalar(node.pad_value());
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
-    builder.stshape(2, output.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.ststrides(2, output);
     builder.stpaddings(0, node.paddings());
     builder.tensor_pad_(node.input().type(), 0, 1, 2, 0, node.pad_mode());
 }
@@ -0,0 +1,39 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../module_builder.h"
+
+using namespace nncase;
+using namespace nncase::codegen;
+using namespace nncase::codegen::stackvm;
+using namespace nncase::ir;
+
+void stackvm_module_builder::emit(preprocess &node, stackvm_op_builder &builder)
+{
+    auto &input = allocation(node.input());
+    auto &mean = allocation(node.mean());
+    auto &std = allocation(node.std());
+    auto &output = allocation(node.output());
+    builder.lea_buffer(input);
+    builder.lea_buffer(mean);
+    builder.lea_buffer(std);
+    builder.lea_buffer(output);
+
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.ststrides(2, output);
+    builder.stpaddings(0, node.paddings());
+    builder.tensor_preprocess_(node.input().type(), 0, 1, 2, 0, node.input_nhwc(), node.output_nhwc(), node.swap_rb(),
+        node.dequant().zero_point, node.dequant().scale, node.resize_shape()[0], node.resize_shape()[1], node.pad_value());
+}
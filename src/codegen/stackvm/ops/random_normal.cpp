@@ -23,6 +23,6 @@ void stackvm_module_builder::emit(random_normal &node, stackvm_op_builder &build
 {
     auto &output = allocation(node.output());
     builder.lea_buffer(output);
-    builder.stshape(0, output.shape);
+    builder.stshape(0, output);
     builder.tensor_random_normal_(node.output().type(), 0, node.mean(), node.std(), node.seed());
 }
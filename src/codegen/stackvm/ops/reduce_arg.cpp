@@ -23,12 +23,13 @@ void stackvm_module_builder::emit(reduce_arg &node, stackvm_op_builder &builder)
 {
     auto &input = allocation(node.input());
     auto &output = allocation(node.output());
+    builder.check_batch_axis(builder.is_batch_major(input) && node.axis() == 0);
     builder.lea_buffer(input);
     builder.lea_buffer(output);
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
-    builder.stshape(2, output.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.ststrides(2, output);
     axis_t axes { node.axis() };
     builder.staxis(3, axes);
     builder.tensor_reduce_arg_(node.input().type(), 0, 1, node.output().type(), 2, node.reduce_arg_op(), 3, node.keep_dims(), node.select_last_index());
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include "../module_builder.h"
+#include <algorithm>
 
 using namespace nncase;
 using namespace nncase::codegen;
@@ -23,12 +24,13 @@ void stackvm_module_builder::emit(reduce_prod &node, stackvm_op_builder &builder
 {
     auto &input = allocation(node.input());
     auto &output = allocation(node.output());
+    builder.check_batch_axis(builder.is_batch_major(input) && std::find(node.axis().begin(), node.axis().end(), 0) != node.axis().end());
     builder.lea_buffer(input);
     builder.lea_buffer(output);
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
-    builder.stshape(2, output.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.ststrides(2, output);
     builder.staxis(3, node.axis());
     builder.tensor_reduce_prod_(0, 1, 2, 3, node.keep_dims());
 }
@@ -32,8 +32,8 @@ void stackvm_module_builder::emit(resize_image &node, stackvm_op_builder &builde
     builder.lea_buffer(input);
     builder.lea_buffer(output);
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
-    builder.stshape(2, output.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.ststrides(2, output);
     builder.tensor_resize_image_(node.input().type(), 0, 1, 2, node.align_corners(), node.half_pixel_centers(), node.mode());
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include "../module_builder.h"
+#include <nncase/runtime/stackvm/runtime_module.h>
 
 using namespace nncase;
 using namespace nncase::codegen;
@@ -26,11 +27,25 @@ void stackvm_module_builder::emit(slice &node, stackvm_op_builder &builder)
     builder.lea_buffer(input);
     builder.lea_buffer(output);
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
-    builder.stshape(2, output.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.ststrides(2, output);
     builder.staxis(3, node.begin());
-    builder.staxis(4, node.end());
+    if (builder.is_batch_major(input))
+    {
+        auto &end = node.end();
+        builder.check_batch_axis(node.begin()[0] != 0 || node.strides()[0] != 1);
+
+        // The whole batch is kept, load the end of dim 0 from the batch register
+        builder.lea_gp_(runtime::stackvm::stackvm_batch_reg, 0);
+        for (size_t i = 1; i < end.size(); i++)
+            builder.ldc_i4_(end[i]);
+        builder.stshape_(4, (uint8_t)end.size());
+    }
+    else
+    {
+        builder.staxis(4, node.end());
+    }
     builder.staxis(5, node.strides());
     builder.tensor_slice_(node.input().type(), 0, 1, 2, 3, 4, 5);
 }
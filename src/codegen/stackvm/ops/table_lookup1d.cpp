@@ -30,8 +30,8 @@ void stackvm_module_builder::emit(table_lookup1d &node, stackvm_op_builder &buil
     builder.ldscalar((uint8_t)0);
     builder.ldscalar((uint8_t)255);
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
-    builder.stshape(2, output.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.ststrides(2, output);
     builder.tensor_lut1d_(node.input().type(), 0, 1, 2, (uint16_t)table.shape[0]);
 }
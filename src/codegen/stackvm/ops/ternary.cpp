@@ -30,12 +30,12 @@ void stackvm_module_builder::emit(ternary &node, stackvm_op_builder &builder)
     builder.lea_buffer(input_c);
     builder.lea_buffer(output);
 
-    builder.stshape(0, input_a.shape);
-    builder.stshape(1, input_a.strides);
-    builder.stshape(2, input_b.shape);
-    builder.stshape(3, input_b.strides);
-    builder.stshape(4, input_c.shape);
-    builder.stshape(5, input_c.strides);
-    builder.stshape(6, output.strides);
+    builder.stshape(0, input_a);
+    builder.ststrides(1, input_a);
+    builder.stshape(2, input_b);
+    builder.ststrides(3, input_b);
+    builder.stshape(4, input_c);
+    builder.ststrides(5, input_c);
+    builder.ststrides(6, output);
     builder.tensor_ternary_(node.input_b().type(), 0, 1, 2, 3, 4, 5, 6);
 }
@@ -25,16 +25,17 @@ void stackvm_module_builder::emit(topk &node, stackvm_op_builder &builder)
     auto &output_a = allocation(node.output_a());
     auto &output_b = allocation(node.output_b());
 
+    builder.check_batch_axis(builder.is_batch_major(input) && node.axis() == 0);
     builder.lea_buffer(input);
     builder.lea_buffer(output_a);
     builder.lea_buffer(output_b);
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
-    builder.stshape(2, output_a.shape);
-    builder.stshape(3, output_a.strides);
-    builder.stshape(4, output_b.shape);
-    builder.stshape(5, output_b.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.stshape(2, output_a);
+    builder.ststrides(3, output_a);
+    builder.stshape(4, output_b);
+    builder.ststrides(5, output_b);
 
     builder.tensor_topk_(node.input().type(), 0, 1, 2, 3, 4, 5, node.k(), node.axis(), node.largest(), node.sorted());
 }
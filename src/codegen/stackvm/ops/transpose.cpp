@@ -23,12 +23,13 @@ void stackvm_module_builder::emit(transpose &node, stackvm_op_builder &builder)
 {
     auto &input = allocation(node.input());
     auto &output = allocation(node.output());
+    builder.check_batch_axis(builder.is_batch_major(input) && node.perm()[0] != 0);
     builder.lea_buffer(input);
     builder.lea_buffer(output);
 
-    builder.stshape(0, input.shape);
-    builder.stshape(1, input.strides);
-    builder.stshape(2, output.strides);
+    builder.stshape(0, input);
+    builder.ststrides(1, input);
+    builder.ststrides(2, output);
     builder.staxis(3, node.perm());
     builder.tensor_transpose_(node.input().type(), 0, 1, 2, 3);
 }
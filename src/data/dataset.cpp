@@ -12,16 +12,161 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <condition_variable>
+#include <cstring>
+#include <exception>
 #include <fstream>
+#include <mutex>
 #include <nncase/data/dataset.h>
+#include <nncase/runtime/debug.h>
 #include <opencv2/core.hpp>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
+#include <sstream>
 #include <string>
+#include <thread>
 
 using namespace nncase;
 using namespace nncase::data;
 
+// Decodes the samples of [first, end) into a ring of depth batches, each worker takes one sample at a time
+class dataset::prefetcher
+{
+public:
+    using sample_loader = std::function<void(size_t index, uint8_t *dest)>;
+
+    prefetcher(size_t first, size_t end, size_t batch_size, datatype_t type, size_t sample_bytes, size_t workers, size_t depth, sample_loader loader)
+        : first_(first), end_(end), batch_size_(batch_size), type_(type), sample_bytes_(sample_bytes), loader_(std::move(loader)), scheduled_(first), slots_(depth)
+    {
+        for (size_t i = 0; i < slots_.size(); i++)
+        {
+            slots_[i].data.resize(batch_size_ * sample_bytes_);
+            reset_slot(i, i);
+        }
+
+        workers_.reserve(workers);
+        for (size_t i = 0; i < workers; i++)
+            workers_.emplace_back([this] { work(); });
+    }
+
+    ~prefetcher()
+    {
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            exit_ = true;
+        }
+
+        schedule_cv_.notify_all();
+        for (auto &worker : workers_)
+            worker.join();
+    }
+
+    bool can_take(size_t from, datatype_t type, size_t sample_bytes) const noexcept
+    {
+        return from == first_ + consumed_ * batch_size_ && from < end_ && type == type_ && sample_bytes == sample_bytes_;
+    }
+
+    void take(uint8_t *dest, size_t samples)
+    {
+        auto &slot = slots_[consumed_ % slots_.size()];
+        {
+            std::unique_lock<std::mutex> lock(lock_);
+            ready_cv_.wait(lock, [&] { return slot.pending == 0; });
+        }
+
+        std::exception_ptr error = slot.error;
+        if (!error)
+            std::memcpy(dest, slot.data.data(), samples * sample_bytes_);
+
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            reset_slot(consumed_ % slots_.size(), consumed_ + slots_.size());
+            consumed_++;
+        }
+
+        schedule_cv_.notify_all();
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+private:
+    struct slot
+    {
+        std::vector<uint8_t> data;
+        size_t pending;
+        std::exception_ptr error;
+    };
+
+    size_t batch_samples(size_t batch) const noexcept
+    {
+        auto from = first_ + batch * batch_size_;
+        return from < end_ ? std::min(batch_size_, end_ - from) : 0;
+    }
+
+    void reset_slot(size_t index, size_t batch)
+    {
+        auto &s = slots_[index];
+        s.pending = batch_samples(batch);
+        s.error = nullptr;
+    }
+
+    void work()
+    {
+        while (true)
+        {
+            size_t index;
+            slot *target;
+            {
+                std::unique_lock<std::mutex> lock(lock_);
+                schedule_cv_.wait(lock, [this] {
+                    return exit_ || scheduled_ == end_ || (scheduled_ - first_) / batch_size_ < consumed_ + slots_.size();
+                });
+                if (exit_ || scheduled_ == end_)
+                    return;
+                index = scheduled_++;
+                target = &slots_[(index - first_) / batch_size_ % slots_.size()];
+            }
+
+            std::exception_ptr error;
+            try
+            {
+                loader_(index, target->data.data() + (index - first_) % batch_size_ * sample_bytes_);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            bool ready;
+            {
+                std::lock_guard<std::mutex> lock(lock_);
+                if (error && !target->error)
+                    target->error = error;
+                ready = --target->pending == 0;
+            }
+
+            if (ready)
+                ready_cv_.notify_all();
+        }
+    }
+
+private:
+    size_t first_;
+    size_t end_;
+    size_t batch_size_;
+    datatype_t type_;
+    size_t sample_bytes_;
+    sample_loader loader_;
+    std::mutex lock_;
+    std::condition_variable schedule_cv_;
+    std::condition_variable ready_cv_;
+    size_t scheduled_;
+    size_t consumed_ = 0;
+    bool exit_ = false;
+    std::vector<slot> slots_;
+    std::vector<std::thread> workers_;
+};
+
 dataset::dataset(const std::filesystem::path &path, std::function<bool(const std::filesystem::path &)> file_filter, xt::dynamic_shape<size_t> input_shape, std::string input_layout)
     : input_shape_(std::move(input_shape)), input_layout_(input_layout)
 {
@@ -39,13 +184,97 @@ dataset::dataset(const std::filesystem::path &path, std::function<bool(const std
             filenames_.emplace_back(path);
     }
 
-    size_t samples = (filenames_.size() / batch_size()) * batch_size();
-    filenames_.resize(samples);
-
     if (filenames_.empty())
         throw std::invalid_argument("Invalid dataset, should contain one file at least");
 }
 
+dataset::~dataset()
+{
+}
+
+void dataset::batch_size(size_t value)
+{
+    if (value == 0)
+        throw std::invalid_argument("Invalid dataset batch size, should be greater than 0");
+    prefetcher_.reset();
+    batch_size_ = value;
+}
+
+void dataset::prefetch(size_t workers, size_t depth)
+{
+    prefetcher_.reset();
+    prefetch_workers_ = workers;
+    prefetch_depth_ = std::max(depth, (size_t)1);
+}
+
+void dataset::cache_dir(std::filesystem::path path)
+{
+    prefetcher_.reset();
+    if (!path.empty())
+        std::filesystem::create_directories(path);
+    cache_dir_ = std::move(path);
+}
+
+void dataset::load_batch(size_t from, size_t samples, uint8_t *dest, datatype_t type, size_t sample_bytes, sample_decoder decoder)
+{
+    if (!prefetch_workers_)
+    {
+        for (size_t i = 0; i < samples; i++)
+            load_sample(from + i, dest + i * sample_bytes, type, sample_bytes, decoder);
+        return;
+    }
+
+    // A new pass or a different element type restarts the pipeline from this batch
+    if (!prefetcher_ || !prefetcher_->can_take(from, type, sample_bytes))
+    {
+        prefetcher_.reset();
+        prefetcher_ = std::make_unique<prefetcher>(from, filenames_.size(), batch_size_, type, sample_bytes, prefetch_workers_, prefetch_depth_,
+            [this, type, sample_bytes, decoder = std::move(decoder)](size_t index, uint8_t *dest) { load_sample(index, dest, type, sample_bytes, decoder); });
+    }
+
+    prefetcher_->take(dest, samples);
+}
+
+void dataset::load_sample(size_t index, uint8_t *dest, datatype_t type, size_t sample_bytes, const sample_decoder &decoder)
+{
+    auto &filename = filenames_[index];
+    std::filesystem::path cache_filename;
+    if (!cache_dir_.empty() && do_cache())
+    {
+        std::ostringstream key;
+        key << std::filesystem::absolute(filename).string() << '|' << std::filesystem::file_size(filename) << '|'
+            << std::filesystem::last_write_time(filename).time_since_epoch().count() << '|' << datatype_names(type) << '|' << input_layout_;
+        for (auto dim : input_shape_)
+            key << '|' << dim;
+
+        std::ostringstream name;
+        name << std::hex << std::hash<std::string>()(key.str()) << ".bin";
+        cache_filename = cache_dir_ / name.str();
+
+        std::ifstream ifs(cache_filename, std::ios::binary);
+        if (ifs && ifs.read(reinterpret_cast<char *>(dest), (std::streamsize)sample_bytes) && ifs.peek() == std::char_traits<char>::eof())
+            return;
+    }
+
+    decoder(read_file(filename), dest);
+
+    if (!cache_filename.empty())
+    {
+        // Write aside and rename, so a concurrent or interrupted writer never leaves a partial entry
+        auto temp_filename = cache_filename;
+        temp_filename += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+        {
+            std::ofstream ofs(temp_filename, std::ios::binary | std::ios::trunc);
+            ofs.write(reinterpret_cast<const char *>(dest), (std::streamsize)sample_bytes);
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temp_filename, cache_filename, ec);
+        if (ec)
+            std::filesystem::remove(temp_filename, ec);
+    }
+}
+
 image_dataset::image_dataset(const std::filesystem::path &path, xt::dynamic_shape<size_t> input_shape, std::string input_layout)
     : dataset(
         path, [](const std::filesystem::path &filename) { return cv::haveImageReader(filename.string()); },
@@ -122,8 +122,8 @@ void record_range_and_buffers(gsl::span<T> buffer, eval_step step, size_t stage,
 void function_evaluate_context::evaluate(eval_step step = nncase::ir::eval_step::after_import, size_t stage = 0, bool record_output_buffers = false)
 {
     using clock = chrono::high_resolution_clock;
-    chrono::nanoseconds total_duration = {};
     auto quantizer = module().quantizer();
+    auto profiler = module().model().profiler();
 
     for (auto &&node : sched_.compute_sequence)
     {
@@ -132,7 +132,8 @@ void function_evaluate_context::evaluate(eval_step step = nncase::ir::eval_step:
         auto start = clock::now();
         evaluator(*node, *this);
         auto duration = clock::now() - start;
-        total_duration += duration;
+        if (profiler)
+            profiler->record(*node, chrono::duration_cast<chrono::nanoseconds>(duration));
 
         if (quantizer)
         {
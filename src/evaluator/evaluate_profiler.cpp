@@ -0,0 +1,220 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <iomanip>
+#include <nncase/ir/evaluate_profiler.h>
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/conv2d_transpose.h>
+#include <nncase/ir/ops/fused_unary.h>
+#include <nncase/ir/ops/matmul.h>
+#include <nncase/ir/ops/reduce_window2d.h>
+#include <nncase/ir/visitor.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+namespace chrono = std::chrono;
+
+namespace
+{
+using clock_type = chrono::steady_clock;
+
+double seconds_since(clock_type::time_point start)
+{
+    return chrono::duration<double>(clock_type::now() - start).count();
+}
+
+double measure_gflops()
+{
+    // Built with the same flags as the evaluator kernels, so this is the peak they can reach on this host
+    // rather than the datasheet one. Independent chains keep FMA latency and reassociation out of the way.
+    constexpr size_t chains = 64;
+    constexpr size_t iters = 1 << 16;
+    alignas(64) float acc[chains];
+    std::fill_n(acc, chains, 1.f);
+    volatile float a_src = 0.999999f, b_src = 1e-6f;
+    const float a = a_src, b = b_src;
+
+    double best = 0;
+    for (int rep = 0; rep < 5; rep++)
+    {
+        auto start = clock_type::now();
+        for (size_t i = 0; i < iters; i++)
+        {
+            for (size_t j = 0; j < chains; j++)
+                acc[j] = acc[j] * a + b;
+        }
+
+        best = std::max(best, 2.0 * chains * iters / seconds_since(start) * 1e-9);
+    }
+
+    volatile float sink = 0;
+    for (auto v : acc)
+        sink = sink + v;
+    return best;
+}
+
+double measure_gbps()
+{
+    // Well beyond the last level cache of the hosts we compile on
+    constexpr size_t count = 8 * 1024 * 1024;
+    std::vector<float> src(count, 1.f), dest(count);
+
+    double best = 0;
+    for (int rep = 0; rep < 5; rep++)
+    {
+        auto start = clock_type::now();
+        std::copy(src.begin(), src.end(), dest.begin());
+        best = std::max(best, 2.0 * count * sizeof(float) / seconds_since(start) * 1e-9);
+        src[rep] = dest[count - 1 - rep];
+    }
+
+    return best;
+}
+
+uint64_t elements(const shape_t &shape)
+{
+    return xt::compute_size(shape);
+}
+
+uint64_t compute_flops(node &n)
+{
+    if (auto conv = node_cast<conv2d>(n))
+    {
+        return 2 * elements(conv->output().shape()) * (conv->input_channels() / conv->groups()) * conv->filter_h() * conv->filter_w();
+    }
+    else if (auto tconv = node_cast<conv2d_transpose>(n))
+    {
+        return 2 * elements(tconv->input().shape()) * (tconv->output_channels() / tconv->groups()) * tconv->filter_h() * tconv->filter_w();
+    }
+    else if (auto mm = node_cast<matmul>(n))
+    {
+        auto &a_shape = mm->input_a().shape();
+        auto k = mm->transpose_a() ? a_shape[a_shape.size() - 2] : a_shape.back();
+        return 2 * elements(mm->output().shape()) * k;
+    }
+    else if (auto rw = node_cast<reduce_window2d>(n))
+    {
+        return elements(rw->output().shape()) * rw->filter_h() * rw->filter_w();
+    }
+    else if (auto fu = node_cast<fused_unary>(n))
+    {
+        auto ops = std::count_if(fu->subgraph().begin(), fu->subgraph().end(), [](const fused_unary_op &op) {
+            return op.opcode == fu_unary || op.opcode == fu_binary || op.opcode == fu_clamp;
+        });
+        return elements(fu->output().shape()) * (uint64_t)ops;
+    }
+
+    auto &opcode = n.runtime_opcode();
+    if (opcode == op_binary || opcode == op_unary || opcode == op_clamp)
+        return elements(n.output_at(0).shape());
+    else if (opcode == op_reduce || opcode == op_reduce_prod || opcode == op_reduce_arg)
+        return elements(n.input_at(0).shape());
+
+    // Data movement, or target ops whose cost is not modeled here
+    return 0;
+}
+
+bool is_profiled(node &n)
+{
+    auto &opcode = n.runtime_opcode();
+    return opcode != op_input_node && opcode != op_output_node && opcode != op_constant
+        && opcode != op_ignore_node && opcode != op_uninitialized;
+}
+}
+
+const machine_peak &nncase::ir::measure_machine_peak()
+{
+    static const machine_peak peak { measure_gflops(), measure_gbps() };
+    return peak;
+}
+
+node_cost nncase::ir::estimate_cost(node &n)
+{
+    node_cost cost;
+    cost.flops = compute_flops(n);
+    for (auto in : n.inputs())
+        cost.bytes += get_bytes(in->type(), in->shape());
+    for (auto out : n.outputs())
+        cost.bytes += get_bytes(out->type(), out->shape());
+    return cost;
+}
+
+void evaluate_profiler::record(node &n, chrono::nanoseconds duration)
+{
+    if (!is_profiled(n))
+        return;
+
+    auto it = indices_.find(&n);
+    if (it == indices_.end())
+    {
+        it = indices_.emplace(&n, entries_.size()).first;
+        entries_.push_back({ n.name(), std::string(n.runtime_opcode().name), estimate_cost(n) });
+    }
+
+    auto &entry = entries_[it->second];
+    entry.runs++;
+    entry.duration += duration;
+}
+
+void evaluate_profiler::dump(std::ostream &output, const machine_peak &peak) const
+{
+    std::vector<const node_eval_profile *> sorted;
+    chrono::nanoseconds total_duration {};
+    double total_avg_seconds = 0;
+    size_t name_width = 4;
+    for (auto &e : entries_)
+    {
+        sorted.emplace_back(&e);
+        total_duration += e.duration;
+        total_avg_seconds += chrono::duration<double>(e.duration).count() / std::max(e.runs, size_t(1));
+        name_width = std::max(name_width, e.name.size());
+    }
+
+    std::stable_sort(sorted.begin(), sorted.end(), [](auto a, auto b) { return a->duration > b->duration; });
+
+    auto ridge = peak.gbps > 0 ? peak.gflops / peak.gbps : 0.0;
+    output << std::fixed << std::setprecision(2);
+    output << "Machine peak: " << peak.gflops << " GFLOP/s, " << peak.gbps << " GB/s, ridge point " << ridge << " FLOP/B" << std::endl;
+    output << std::left << std::setw(name_width + 2) << "Node" << std::setw(20) << "Op" << std::right
+           << std::setw(6) << "Runs" << std::setw(12) << "Avg(us)" << std::setw(8) << "%"
+           << std::setw(12) << "MFLOP" << std::setw(10) << "MB" << std::setw(10) << "GFLOP/s" << std::setw(10) << "GB/s"
+           << std::setw(10) << "FLOP/B" << std::setw(9) << "Bound" << std::setw(8) << "Roof%" << std::endl;
+
+    for (auto e : sorted)
+    {
+        auto avg_seconds = chrono::duration<double>(e->duration).count() / std::max(e->runs, size_t(1));
+        auto gflops = avg_seconds > 0 ? e->cost.flops / avg_seconds * 1e-9 : 0.0;
+        auto gbps = avg_seconds > 0 ? e->cost.bytes / avg_seconds * 1e-9 : 0.0;
+        auto intensity = e->cost.bytes ? (double)e->cost.flops / e->cost.bytes : 0.0;
+        auto compute_bound = e->cost.flops && intensity >= ridge;
+
+        // Attainable performance is min(peak compute, intensity * peak bandwidth)
+        double roof = 0;
+        if (e->cost.flops)
+            roof = gflops / std::min(peak.gflops, intensity * peak.gbps);
+        else if (peak.gbps > 0)
+            roof = gbps / peak.gbps;
+        auto percent = total_duration.count() ? (double)e->duration.count() / total_duration.count() * 100 : 0.0;
+
+        output << std::left << std::setw(name_width + 2) << e->name << std::setw(20) << e->opcode << std::right
+               << std::setw(6) << e->runs << std::setw(12) << avg_seconds * 1e6 << std::setw(8) << percent
+               << std::setw(12) << e->cost.flops * 1e-6 << std::setw(10) << e->cost.bytes * 1e-6
+               << std::setw(10) << gflops << std::setw(10) << gbps << std::setw(10) << intensity
+               << std::setw(9) << (compute_bound ? "compute" : "memory") << std::setw(8) << roof * 100 << std::endl;
+    }
+
+    output << std::left << std::setw(name_width + 2) << "Total" << std::right << std::setw(38) << total_avg_seconds * 1e6 << std::endl;
+}
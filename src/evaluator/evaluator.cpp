@@ -56,6 +56,11 @@ void evaluator::end_collect_distribution(const std::function<void(size_t cnt, si
     model_eval_.end_collect_distribution(progress);
 }
 
+void evaluator::profiler(evaluate_profiler *profiler) noexcept
+{
+    model_eval_.profiler(profiler);
+}
+
 evaluate_tensor evaluator::memory_at(const output_connector &conn)
 {
     return model_eval_.memory_at(conn);
@@ -33,6 +33,7 @@
 #include <nncase/ir/ops/matmul.h>
 #include <nncase/ir/ops/onehot.h>
 #include <nncase/ir/ops/pad.h>
+#include <nncase/ir/ops/preprocess.h>
 #include <nncase/ir/ops/quantize.h>
 #include <nncase/ir/ops/random_normal.h>
 #include <nncase/ir/ops/random_uniform.h>
@@ -77,6 +78,22 @@ using namespace nncase::runtime;
         throw std::runtime_error("Not supported element type"); \
     }
 
+#define FLOAT_TYPE_IMPL(type, KERNEL)                         \
+    switch (type)                                             \
+    {                                                         \
+    case dt_float32:                                          \
+        KERNEL(float);                                        \
+        break;                                                \
+    case dt_float16:                                          \
+        KERNEL(half);                                         \
+        break;                                                \
+    case dt_bfloat16:                                         \
+        KERNEL(bfloat16);                                     \
+        break;                                                \
+    default:                                                  \
+        throw std::runtime_error("Not supported float type"); \
+    }
+
 namespace
 {
 void nop_evaluator(ir::node &, function_evaluate_context &)
@@ -109,16 +126,19 @@ void register_neutral_evaluators()
     register_evaluator(op_binary, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<binary &>(node);
 
-        assert(rnode.input_a().type() == dt_float32);
-        assert(rnode.input_b().type() == dt_float32);
+        assert(rnode.input_a().type() == rnode.input_b().type());
 
         auto input_a = context.memory_at(rnode.input_a());
         auto input_b = context.memory_at(rnode.input_b());
         auto output = context.memory_at(rnode.output());
-        kernels::binary(rnode.binary_op(), input_a.buffer().as_span<float>().data(), input_b.buffer().as_span<float>().data(),
-            output.buffer().as_span<float>().data(), input_a.shape(), input_a.strides(), input_b.shape(), input_b.strides(), output.strides(),
-            rnode.fused_activation())
-            .unwrap_or_throw();
+#define BINARY_KERNEL(T)                                                                                                                     \
+    kernels::binary(rnode.binary_op(), input_a.buffer().as_span<T>().data(), input_b.buffer().as_span<T>().data(),                          \
+        output.buffer().as_span<T>().data(), input_a.shape(), input_a.strides(), input_b.shape(), input_b.strides(), output.strides(), \
+        rnode.fused_activation())                                                                                                            \
+        .unwrap_or_throw()
+
+        FLOAT_TYPE_IMPL(rnode.input_a().type(), BINARY_KERNEL);
+#undef BINARY_KERNEL
     });
 
     register_evaluator(op_broadcast, [](ir::node &node, function_evaluate_context &context) {
@@ -153,21 +173,19 @@ void register_neutral_evaluators()
     register_evaluator(op_conv2d, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<conv2d &>(node);
 
-        assert(rnode.input().type() == dt_float32);
-
         auto input = context.memory_at(rnode.input());
         auto weights = context.memory_at(rnode.weights());
         auto bias = context.memory_at(rnode.bias());
         auto output = context.memory_at(rnode.output());
-        auto input_mem = input.buffer().as_span<float>();
-        auto weights_mem = weights.buffer().as_span<float>();
-        auto bias_mem = bias.buffer().as_span<float>();
-        auto output_mem = output.buffer().as_span<float>();
+#define CONV2D_KERNEL(T)                                                                                                                                \
+    kernels::conv2d(input.buffer().as_span<T>().data(), weights.buffer().as_span<T>().data(), bias.buffer().as_span<T>().data(),                       \
+        output.buffer().as_span<T>().data(), input.shape(), input.strides(), weights.shape(), weights.strides(), bias.strides(), output.strides(), \
+        rnode.padding_h(), rnode.padding_w(), rnode.groups(), rnode.stride_h(), rnode.stride_w(), rnode.dilation_h(), rnode.dilation_w(),              \
+        rnode.fused_activation())                                                                                                                       \
+        .unwrap_or_throw()
 
-        kernels::conv2d(input_mem.data(), weights_mem.data(), bias_mem.data(), output_mem.data(), input.shape(), input.strides(),
-            weights.shape(), weights.strides(), bias.strides(), output.strides(), rnode.padding_h(), rnode.padding_w(),
-            rnode.groups(), rnode.stride_h(), rnode.stride_w(), rnode.dilation_h(), rnode.dilation_w(), rnode.fused_activation())
-            .unwrap_or_throw();
+        FLOAT_TYPE_IMPL(rnode.input().type(), CONV2D_KERNEL);
+#undef CONV2D_KERNEL
     });
 
     register_evaluator(op_conv2d_transpose, [](ir::node &node, function_evaluate_context &context) {
@@ -231,15 +249,15 @@ void register_neutral_evaluators()
 
         assert(rnode.input_a().type() == dt_float32);
         assert(rnode.input_b().type() == dt_float32);
-        auto input_a = context.memory_at(rnode.input_a()).buffer().as_span<float>();
-        auto input_b = context.memory_at(rnode.input_b()).buffer().as_span<float>();
+        auto input_a = context.memory_at(rnode.input_a());
+        auto input_b = context.memory_at(rnode.input_b());
         auto bias = context.memory_at(rnode.bias()).buffer().as_span<float>();
-        auto output = context.memory_at(rnode.output()).buffer().as_span<float>();
-
-        auto &a_shape = rnode.input_a().shape();
-        auto &b_shape = rnode.input_b().shape();
+        auto output = context.memory_at(rnode.output());
 
-        neutral::matmul(input_a.data(), input_b.data(), output.data(), bias.data(), (int32_t)a_shape[0], (int32_t)a_shape[1], (int32_t)b_shape[1], rnode.fused_activation());
+        kernels::matmul(input_a.buffer().as_span<float>().data(), input_b.buffer().as_span<float>().data(), bias.data(),
+            output.buffer().as_span<float>().data(), input_a.shape(), input_a.strides(), input_b.shape(), input_b.strides(),
+            output.strides(), rnode.transpose_a(), rnode.transpose_b(), rnode.fused_activation())
+            .unwrap_or_throw();
     });
 
     register_evaluator(op_pad, [](ir::node &node, function_evaluate_context &context) {
@@ -255,6 +273,21 @@ void register_neutral_evaluators()
             .unwrap_or_throw();
     });
 
+    register_evaluator(op_preprocess, [](ir::node &node, function_evaluate_context &context) {
+        auto &rnode = static_cast<preprocess &>(node);
+
+        auto input = context.memory_at(rnode.input());
+        auto output = context.memory_at(rnode.output());
+        auto mean = context.memory_at(rnode.mean()).buffer().as_span<float>();
+        auto std = context.memory_at(rnode.std()).buffer().as_span<float>();
+        auto &resize_shape = rnode.resize_shape();
+
+        kernels::preprocess(input.datatype(), input.buffer().data(), output.buffer().as_span<float>().data(), input.shape(),
+            input.strides(), output.strides(), rnode.input_nhwc(), rnode.output_nhwc(), rnode.swap_rb(), rnode.dequant(),
+            resize_shape[0], resize_shape[1], to(rnode.paddings()), rnode.pad_value(), mean.data(), std.data())
+            .unwrap_or_throw();
+    });
+
     register_evaluator(op_quantize, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<quantize &>(node);
         auto input = context.memory_at(rnode.input()).buffer().as_span<float>();
@@ -278,15 +311,15 @@ void register_neutral_evaluators()
     register_evaluator(op_reduce, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<reduce &>(node);
 
-        assert(rnode.input().type() == dt_float32);
         auto input = context.memory_at(rnode.input());
         auto output = context.memory_at(rnode.output());
-        auto input_mem = input.buffer().as_span<float>();
-        auto output_mem = output.buffer().as_span<float>();
+#define REDUCE_KERNEL(T)                                                                                                           \
+    kernels::reduce(rnode.reduce_op(), rnode.init_value(), input.buffer().as_span<T>().data(), output.buffer().as_span<T>().data(), \
+        input.shape(), to(rnode.axis()), input.strides(), output.strides(), rnode.keep_dims())                                     \
+        .unwrap_or_throw()
 
-        kernels::reduce(rnode.reduce_op(), rnode.init_value(), input_mem.data(), output_mem.data(), input.shape(),
-            to(rnode.axis()), input.strides(), output.strides(), rnode.keep_dims())
-            .unwrap_or_throw();
+        FLOAT_TYPE_IMPL(rnode.input().type(), REDUCE_KERNEL);
+#undef REDUCE_KERNEL
     });
 
     register_evaluator(op_reduce_arg, [](ir::node &node, function_evaluate_context &context) {
@@ -429,7 +462,21 @@ void register_neutral_evaluators()
     register_evaluator(op_unary, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<unary &>(node);
 
-        assert(rnode.input().type() == dt_float32);
+        if (rnode.input().type() != dt_float32)
+        {
+            // Lowered precision unary runs the runtime kernel
+            auto input = context.memory_at(rnode.input());
+            auto output = context.memory_at(rnode.output());
+#define UNARY_KERNEL(T)                                                                                                                             \
+    kernels::unary(rnode.unary_op(), input.buffer().as_span<T>().data(), output.buffer().as_span<T>().data(), input.shape(), input.strides(), \
+        output.strides())                                                                                                                           \
+        .unwrap_or_throw()
+
+            FLOAT_TYPE_IMPL(rnode.input().type(), UNARY_KERNEL);
+#undef UNARY_KERNEL
+            return;
+        }
+
         auto input = context.memory_at(rnode.input()).buffer().as_span<float>();
         auto output = context.memory_at(rnode.output()).buffer().as_span<float>();
 
@@ -28,7 +28,7 @@ void nncase::importer::import_tflite(ir::graph &graph, std::span<const uint8_t>
 
 void nncase::importer::import_onnx(ir::graph &graph, std::span<const uint8_t> model, const import_options &options, std::string &real_inlayout, std::string &real_outlayout)
 {
-    onnx_importer(model, graph).import(options, real_inlayout, real_outlayout);
+    onnx_importer(model, options.model_dir, graph).import(options, real_inlayout, real_outlayout);
 }
 
 void nncase::importer::import_caffe(ir::graph &graph, std::span<const uint8_t> model, std::span<const uint8_t> prototxt, std::string &real_inlayout, std::string &real_outlayout)
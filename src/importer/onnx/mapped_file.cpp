@@ -0,0 +1,109 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mapped_file.h"
+#include <stdexcept>
+#include <system_error>
+#ifdef WIN32
+#include <Windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#error "Unsupported platform"
+#endif
+
+using namespace nncase;
+using namespace nncase::importer;
+
+#ifdef WIN32
+mapped_file::mapped_file(const std::filesystem::path &path)
+{
+    auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::system_error(GetLastError(), std::system_category(), "Cannot open " + path.string());
+    file_ = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        auto err_code = GetLastError();
+        CloseHandle(file);
+        throw std::system_error(err_code, std::system_category(), "Cannot get size of " + path.string());
+    }
+    size_ = (size_t)size.QuadPart;
+    if (!size_)
+        return;
+
+    mapping_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    auto view = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view)
+    {
+        auto err_code = GetLastError();
+        if (mapping_)
+            CloseHandle(mapping_);
+        CloseHandle(file);
+        throw std::system_error(err_code, std::system_category(), "Cannot map " + path.string());
+    }
+    data_ = reinterpret_cast<const std::byte *>(view);
+}
+
+mapped_file::~mapped_file()
+{
+    if (data_)
+        UnmapViewOfFile(data_);
+    if (mapping_)
+        CloseHandle(mapping_);
+    CloseHandle(file_);
+}
+#else
+mapped_file::mapped_file(const std::filesystem::path &path)
+{
+    auto fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw std::system_error(errno, std::generic_category(), "Cannot open " + path.string());
+
+    struct stat st;
+    if (fstat(fd, &st) == -1)
+    {
+        auto err_code = errno;
+        close(fd);
+        throw std::system_error(err_code, std::generic_category(), "Cannot get size of " + path.string());
+    }
+
+    size_ = (size_t)st.st_size;
+    if (size_)
+    {
+        auto view = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED)
+        {
+            auto err_code = errno;
+            close(fd);
+            throw std::system_error(err_code, std::generic_category(), "Cannot map " + path.string());
+        }
+        data_ = reinterpret_cast<const std::byte *>(view);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+}
+
+mapped_file::~mapped_file()
+{
+    if (data_)
+        munmap(const_cast<std::byte *>(data_), size_);
+}
+#endif
@@ -0,0 +1,41 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace nncase::importer
+{
+// Read-only mapping of a whole file, used for ONNX external data so weights are paged in on demand
+class mapped_file
+{
+public:
+    explicit mapped_file(const std::filesystem::path &path);
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+    ~mapped_file();
+
+    std::span<const std::byte> data() const noexcept { return { data_, size_ }; }
+
+private:
+    const std::byte *data_ = nullptr;
+    size_t size_ = 0;
+#ifdef WIN32
+    void *file_ = nullptr;
+    void *mapping_ = nullptr;
+#endif
+};
+}
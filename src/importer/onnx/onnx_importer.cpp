@@ -21,6 +21,7 @@
 #include <nncase/importer/importer.h>
 #include <nncase/importer/util.h>
 #include <nncase/ir/graph.h>
+#include <nncase/runtime/runtime_op_utility.h>
 
 using namespace std;
 using namespace nncase;
@@ -104,21 +105,24 @@ float le_to_native(const unsigned char *data)
 }
 }
 
-onnx_importer::onnx_importer(std::span<const uint8_t> model, ir::graph &graph)
-    : graph_(graph)
+onnx_importer::onnx_importer(std::span<const uint8_t> model, const std::filesystem::path &model_dir, ir::graph &graph)
+    : graph_(graph), model_(std::make_shared<ModelProto>()), model_dir_(model_dir)
 {
     GOOGLE_PROTOBUF_VERIFY_VERSION;
 
-    if (!ParseProtoFromBytes(&model_, model.data(), model.size()))
+    if (!ParseProtoFromBytes(model_.get(), model.data(), model.size()))
         throw std::runtime_error("Invalid ONNX model");
+
+    for (const auto &tensor : model_->graph().initializer())
+        initializers_.emplace(tensor.name(), &tensor);
 }
 
 void onnx_importer::import(const struct import_options &options, std::string &real_inlayout, std::string &real_outlayout)
 {
-    for (auto &opset : model_.opset_import())
+    for (auto &opset : model_->opset_import())
         opset_map_.emplace(opset.domain(), opset.version());
 
-    const auto &graph = model_.graph();
+    const auto &graph = model_->graph();
 
     for (const auto &node : graph.node())
         convert_op(node);
@@ -190,10 +194,10 @@ void onnx_importer::import(const struct import_options &options, std::string &re
     // try to find and create initializers for not yet connected inputs
     for (auto &&in : dangling_inputs)
     {
-        auto init_node = emplace_constant(get_initializer(in.second));
+        auto initializer = get_initializer(in.second);
 
-        if (init_node)
-            in.first->connect(init_node->output());
+        if (initializer)
+            in.first->connect(emplace_constant(*initializer)->output());
         else
             throw std::runtime_error("Cannot find associated output node, graph input or initializer for input " + in.second);
     }
@@ -231,15 +235,15 @@ int64_t onnx_importer::get_opset_version(std::string domain) const
 
 optional<ValueInfoProto> onnx_importer::find_value_info(const string &value) const
 {
-    auto value_info = extract(model_.graph().input(), value);
+    auto value_info = extract(model_->graph().input(), value);
     if (value_info)
         return value_info;
 
-    value_info = extract(model_.graph().value_info(), value);
+    value_info = extract(model_->graph().value_info(), value);
     if (value_info)
         return value_info;
 
-    value_info = extract(model_.graph().output(), value);
+    value_info = extract(model_->graph().output(), value);
 
     return value_info;
 }
@@ -254,7 +258,7 @@ shape_t onnx_importer::get_shape(const string &value) const
 
     const auto initializer = get_initializer(value);
     if (initializer)
-        return get_shape(initializer.value());
+        return get_shape(*initializer);
 
     if (oit != std::end(output_tensors_))
     {
@@ -323,7 +327,7 @@ optional<datatype_t> onnx_importer::get_datatype(const string &value) const
 
     const auto initializer = get_initializer(value);
     if (initializer)
-        return get_datatype(initializer.value());
+        return get_datatype(*initializer);
 
     return optional<datatype_t> {};
 }
@@ -637,22 +641,72 @@ optional<axis_t> onnx_importer::get_attribute<axis_t>(const onnx::NodeProto &nod
     return result;
 }
 
-optional<TensorProto> onnx_importer::get_initializer(const string &value) const
+const TensorProto *onnx_importer::get_initializer(const string &value) const
+{
+    const auto it = initializers_.find(value);
+    return it != initializers_.end() ? it->second : nullptr;
+}
+
+std::span<const std::byte> onnx_importer::get_raw_data(const TensorProto &tensor, std::shared_ptr<const void> &owner) const
 {
-    const auto &graph = model_.graph();
-    const auto &initializer = extract(graph.initializer(), value);
+    if (tensor.data_location() != TensorProto_DataLocation_EXTERNAL)
+    {
+        owner = model_;
+        return std::as_bytes(std::span<const char>(tensor.raw_data()));
+    }
+
+    string location;
+    size_t offset = 0;
+    optional<size_t> length;
+    for (const auto &entry : tensor.external_data())
+    {
+        if (entry.key() == "location")
+            location = entry.value();
+        else if (entry.key() == "offset")
+            offset = stoull(entry.value());
+        else if (entry.key() == "length")
+            length = stoull(entry.value());
+    }
+
+    if (location.empty())
+        throw runtime_error("External data location of tensor \"" + tensor.name() + "\" is missing");
+
+    // Each external file is mapped once and shared by all the tensors stored in it
+    auto &file = external_files_[location];
+    if (!file)
+        file = make_shared<mapped_file>(model_dir_ / filesystem::path(u8string(location.begin(), location.end())));
+
+    const auto data = file->data();
+    if (offset > data.size() || (length && length.value() > data.size() - offset))
+        throw runtime_error("External data of tensor \"" + tensor.name() + "\" is out of the range of " + location);
+
+    const auto payload = data.subspan(offset, length.value_or(data.size() - offset));
+
+    // The payload is read in place as an array of its element type, so an offset that breaks
+    // the element alignment gets an owned, suitably aligned copy instead of the mapping
+    const auto type = get_datatype(tensor);
+    const auto alignment = type ? runtime::get_bytes(type.value()) : alignof(std::max_align_t);
+    if (reinterpret_cast<uintptr_t>(payload.data()) % alignment)
+    {
+        auto copy = make_shared<vector<std::byte>>(payload.begin(), payload.end());
+        owner = copy;
+        return *copy;
+    }
 
-    return initializer;
+    owner = file;
+    return payload;
 }
 
 template <typename T, typename S>
-vector<T> onnx_importer::raw_to_vector(const onnx::TensorProto &tensor)
+vector<T> onnx_importer::raw_to_vector(const onnx::TensorProto &tensor) const
 {
     typedef T target_type;
     typedef S storage_type;
 
-    const storage_type *const ptr = reinterpret_cast<const storage_type *>(tensor.raw_data().data());
-    const size_t size = tensor.raw_data().size() / sizeof(storage_type);
+    std::shared_ptr<const void> owner;
+    const auto raw_data = get_raw_data(tensor, owner);
+    const storage_type *const ptr = reinterpret_cast<const storage_type *>(raw_data.data());
+    const size_t size = raw_data.size() / sizeof(storage_type);
 
     std::vector<target_type> data;
     data.reserve(size);
@@ -676,13 +730,13 @@ vector<T> onnx_importer::raw_to_vector(const onnx::TensorProto &tensor)
 }
 
 template <typename T, typename S>
-xt::xarray<T> onnx_importer::raw_to(const onnx::TensorProto &tensor)
+xt::xarray<T> onnx_importer::raw_to(const onnx::TensorProto &tensor) const
 {
     return xt::adapt(raw_to_vector<T, S>(tensor), get_shape(tensor));
 }
 
 template <>
-float onnx_importer::to<float>(const onnx::TensorProto &tensor)
+float onnx_importer::to<float>(const onnx::TensorProto &tensor) const
 {
     // assert(tensor.data_type() == tensor_type<float>);
     if (!(tensor.float_data_size() > 0))
@@ -692,7 +746,7 @@ float onnx_importer::to<float>(const onnx::TensorProto &tensor)
 }
 
 template <>
-uint8_t onnx_importer::to<uint8_t>(const onnx::TensorProto &tensor)
+uint8_t onnx_importer::to<uint8_t>(const onnx::TensorProto &tensor) const
 {
     // assert(tensor.data_type() == tensor_type<uint8_t>);
     assert(tensor.uint64_data_size() > 0);
@@ -701,7 +755,7 @@ uint8_t onnx_importer::to<uint8_t>(const onnx::TensorProto &tensor)
 }
 
 template <>
-axis_t onnx_importer::to<axis_t>(const onnx::TensorProto &tensor)
+axis_t onnx_importer::to<axis_t>(const onnx::TensorProto &tensor) const
 {
     // assert(tensor.data_type() == tensor_type<std::uint8_t> || tensor.data_type() == tensor_type<std::int8_t> || tensor.data_type() == tensor_type<std::int16_t> || tensor.data_type() == tensor_type<std::uint16_t> || tensor.data_type() == tensor_type<std::int32_t> || tensor.data_type() == tensor_type<std::int64_t>);
 
@@ -752,7 +806,7 @@ axis_t onnx_importer::to<axis_t>(const onnx::TensorProto &tensor)
 }
 
 template <>
-xt::xarray<float> onnx_importer::to<xt::xarray<float>>(const onnx::TensorProto &tensor)
+xt::xarray<float> onnx_importer::to<xt::xarray<float>>(const onnx::TensorProto &tensor) const
 {
     // assert(tensor.data_type() == tensor_type<float>);
 
@@ -767,7 +821,7 @@ xt::xarray<float> onnx_importer::to<xt::xarray<float>>(const onnx::TensorProto &
 }
 
 template <>
-xt::xarray<uint8_t> onnx_importer::to<xt::xarray<uint8_t>>(const onnx::TensorProto &tensor)
+xt::xarray<uint8_t> onnx_importer::to<xt::xarray<uint8_t>>(const onnx::TensorProto &tensor) const
 {
     // assert(tensor.data_type() == tensor_type<uint8_t>);
 
@@ -778,14 +832,16 @@ xt::xarray<uint8_t> onnx_importer::to<xt::xarray<uint8_t>>(const onnx::TensorPro
     else
     {
         typedef uint8_t target_type;
-        const target_type *const ptr { reinterpret_cast<const target_type *>(tensor.raw_data().data()) };
-        const size_t size { tensor.raw_data().size() / sizeof(target_type) };
+        std::shared_ptr<const void> owner;
+        const auto raw_data = get_raw_data(tensor, owner);
+        const target_type *const ptr { reinterpret_cast<const target_type *>(raw_data.data()) };
+        const size_t size { raw_data.size() / sizeof(target_type) };
         return xt::adapt(vector<target_type> { ptr, ptr + size }, get_shape(tensor));
     }
 }
 
 template <>
-xt::xarray<int32_t> onnx_importer::to<xt::xarray<int32_t>>(const onnx::TensorProto &tensor)
+xt::xarray<int32_t> onnx_importer::to<xt::xarray<int32_t>>(const onnx::TensorProto &tensor) const
 {
     if (!tensor.int32_data().empty())
     {
@@ -798,7 +854,7 @@ xt::xarray<int32_t> onnx_importer::to<xt::xarray<int32_t>>(const onnx::TensorPro
 }
 
 template <>
-xt::xarray<int64_t> onnx_importer::to<xt::xarray<int64_t>>(const onnx::TensorProto &tensor)
+xt::xarray<int64_t> onnx_importer::to<xt::xarray<int64_t>>(const onnx::TensorProto &tensor) const
 {
     if (!tensor.int64_data().empty())
     {
@@ -811,7 +867,7 @@ xt::xarray<int64_t> onnx_importer::to<xt::xarray<int64_t>>(const onnx::TensorPro
 }
 
 template <>
-std::vector<int32_t> onnx_importer::to<std::vector<int32_t>>(const onnx::TensorProto &tensor)
+std::vector<int32_t> onnx_importer::to<std::vector<int32_t>>(const onnx::TensorProto &tensor) const
 {
     if (!tensor.int32_data().empty())
     {
@@ -824,7 +880,7 @@ std::vector<int32_t> onnx_importer::to<std::vector<int32_t>>(const onnx::TensorP
 }
 
 template <>
-std::vector<int64_t> onnx_importer::to<std::vector<int64_t>>(const onnx::TensorProto &tensor)
+std::vector<int64_t> onnx_importer::to<std::vector<int64_t>>(const onnx::TensorProto &tensor) const
 {
     if (!tensor.int64_data().empty())
     {
@@ -837,7 +893,7 @@ std::vector<int64_t> onnx_importer::to<std::vector<int64_t>>(const onnx::TensorP
 }
 
 template <>
-std::vector<float> onnx_importer::to<std::vector<float>>(const onnx::TensorProto &tensor)
+std::vector<float> onnx_importer::to<std::vector<float>>(const onnx::TensorProto &tensor) const
 {
     if (!tensor.float_data().empty())
     {
@@ -850,7 +906,7 @@ std::vector<float> onnx_importer::to<std::vector<float>>(const onnx::TensorProto
 }
 
 template <>
-std::vector<uint8_t> onnx_importer::to<std::vector<uint8_t>>(const onnx::TensorProto &tensor)
+std::vector<uint8_t> onnx_importer::to<std::vector<uint8_t>>(const onnx::TensorProto &tensor) const
 {
     if (!tensor.int32_data().empty())
     {
@@ -863,7 +919,7 @@ std::vector<uint8_t> onnx_importer::to<std::vector<uint8_t>>(const onnx::TensorP
 }
 
 template <>
-std::vector<int8_t> onnx_importer::to<std::vector<int8_t>>(const onnx::TensorProto &tensor)
+std::vector<int8_t> onnx_importer::to<std::vector<int8_t>>(const onnx::TensorProto &tensor) const
 {
     if (!tensor.int32_data().empty())
     {
@@ -876,7 +932,7 @@ std::vector<int8_t> onnx_importer::to<std::vector<int8_t>>(const onnx::TensorPro
 }
 
 template <>
-xt::xarray<float> onnx_importer::convert_to<xt::xarray<float>>(const onnx::TensorProto &tensor)
+xt::xarray<float> onnx_importer::convert_to<xt::xarray<float>>(const onnx::TensorProto &tensor) const
 {
     if (tensor.data_type() == TensorProto_DataType_FLOAT)
         return to<xt::xarray<float>>(tensor);
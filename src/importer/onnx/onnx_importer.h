@@ -15,7 +15,10 @@
 
 #pragma once
 
+#include "mapped_file.h"
 #include <cstdint>
+#include <filesystem>
+#include <memory>
 #include <nncase/importer/util.h>
 #include <nncase/ir/connectors.h>
 #include <nncase/ir/ir_types.h>
@@ -32,7 +35,7 @@ namespace nncase::importer
 class onnx_importer
 {
 public:
-    onnx_importer(std::span<const std::uint8_t> model, ir::graph &graph);
+    onnx_importer(std::span<const std::uint8_t> model, const std::filesystem::path &model_dir, ir::graph &graph);
 
     void import(const struct import_options &options, std::string &real_inlayout, std::string &real_outlayout);
 
@@ -75,15 +78,17 @@ private:
     static std::string to_string(const onnx::AttributeProto_AttributeType type);
     template <typename T>
     static std::optional<T> get_attribute(const onnx::NodeProto &node, const std::string &name);
-    std::optional<onnx::TensorProto> get_initializer(const std::string &name) const;
+    const onnx::TensorProto *get_initializer(const std::string &name) const;
+    // owner keeps the returned span alive, it may be the only reference to a copy
+    std::span<const std::byte> get_raw_data(const onnx::TensorProto &tensor, std::shared_ptr<const void> &owner) const;
     template <typename T, typename S = T>
-    static std::vector<T> raw_to_vector(const onnx::TensorProto &tensor);
+    std::vector<T> raw_to_vector(const onnx::TensorProto &tensor) const;
     template <typename T, typename S>
-    static xt::xarray<T> raw_to(const onnx::TensorProto &tensor);
+    xt::xarray<T> raw_to(const onnx::TensorProto &tensor) const;
     template <typename T>
-    static T to(const onnx::TensorProto &tensor);
+    T to(const onnx::TensorProto &tensor) const;
     template <typename T>
-    static T convert_to(const onnx::TensorProto &tensor);
+    T convert_to(const onnx::TensorProto &tensor) const;
 
     static constexpr std::size_t real_axis(const int axis, const std::size_t count) noexcept
     {
@@ -120,8 +125,8 @@ private:
         typename std::enable_if<(std::is_integral<T>::value && std::is_integral<S>::value) || (std::is_floating_point<T>::value && std::is_floating_point<S>::value)>::type * = nullptr>
     std::vector<T> get_constant_value(const std::string &name);
 
-    template <typename T>
-    ir::constant *emplace_constant(const std::optional<T> &v);
+    // tensor must be owned by model_, the constant may keep referencing its payload
+    ir::constant *emplace_constant(const onnx::TensorProto &tensor);
 
     template <class Cont>
     static xtl::span<const std::uint8_t> span_from(const Cont &data);
@@ -131,7 +136,10 @@ private:
     int64_t get_opset_version(std::string domain = "") const;
 
     ir::graph &graph_;
-    onnx::ModelProto model_;
+    std::shared_ptr<onnx::ModelProto> model_;
+    std::filesystem::path model_dir_;
+    std::unordered_map<std::string, const onnx::TensorProto *> initializers_;
+    mutable std::unordered_map<std::string, std::shared_ptr<mapped_file>> external_files_;
     std::unordered_map<std::string, int64_t> opset_map_;
     std::unordered_map<ir::input_connector *, std::string> input_tensors_;
     std::unordered_map<std::string, ir::output_connector *> output_tensors_;
@@ -202,10 +210,10 @@ template <typename T, typename S,
 std::vector<T> onnx_importer::get_constant_value(const std::string &name)
 {
     std::vector<S> vec_storage;
-    const auto &initializer = get_initializer(name);
+    const auto initializer = get_initializer(name);
     if (initializer)
     {
-        vec_storage = to<std::vector<S>>(initializer.value());
+        vec_storage = to<std::vector<S>>(*initializer);
     }
     else
     {
@@ -244,8 +252,6 @@ xtl::span<const std::uint8_t> onnx_importer::span_from(const Cont &data)
     };
 }
 
-template <>
-ir::constant *onnx_importer::emplace_constant<onnx::TensorProto>(const std::optional<onnx::TensorProto> &v);
 template <>
 std::optional<float> onnx_importer::get_attribute<float>(const onnx::NodeProto &node, const std::string &name);
 template <>
@@ -266,23 +272,23 @@ template <>
 std::optional<ir::axis_t> onnx_importer::get_attribute<ir::axis_t>(const onnx::NodeProto &node, const std::string &name);
 
 template <>
-float onnx_importer::to<float>(const onnx::TensorProto &tensor);
+float onnx_importer::to<float>(const onnx::TensorProto &tensor) const;
 template <>
-std::uint8_t onnx_importer::to<std::uint8_t>(const onnx::TensorProto &tensor);
+std::uint8_t onnx_importer::to<std::uint8_t>(const onnx::TensorProto &tensor) const;
 template <>
-ir::axis_t onnx_importer::to<ir::axis_t>(const onnx::TensorProto &tensor);
+ir::axis_t onnx_importer::to<ir::axis_t>(const onnx::TensorProto &tensor) const;
 template <>
-xt::xarray<float> onnx_importer::to<xt::xarray<float>>(const onnx::TensorProto &tensor);
+xt::xarray<float> onnx_importer::to<xt::xarray<float>>(const onnx::TensorProto &tensor) const;
 template <>
-xt::xarray<std::uint8_t> onnx_importer::to<xt::xarray<std::uint8_t>>(const onnx::TensorProto &tensor);
+xt::xarray<std::uint8_t> onnx_importer::to<xt::xarray<std::uint8_t>>(const onnx::TensorProto &tensor) const;
 template <>
-xt::xarray<std::int32_t> onnx_importer::to<xt::xarray<std::int32_t>>(const onnx::TensorProto &tensor);
+xt::xarray<std::int32_t> onnx_importer::to<xt::xarray<std::int32_t>>(const onnx::TensorProto &tensor) const;
 template <>
-xt::xarray<std::int64_t> onnx_importer::to<xt::xarray<std::int64_t>>(const onnx::TensorProto &tensor);
+xt::xarray<std::int64_t> onnx_importer::to<xt::xarray<std::int64_t>>(const onnx::TensorProto &tensor) const;
 template <>
-std::vector<std::int64_t> onnx_importer::to<std::vector<std::int64_t>>(const onnx::TensorProto &tensor);
+std::vector<std::int64_t> onnx_importer::to<std::vector<std::int64_t>>(const onnx::TensorProto &tensor) const;
 template <>
-std::vector<float> onnx_importer::to<std::vector<float>>(const onnx::TensorProto &tensor);
+std::vector<float> onnx_importer::to<std::vector<float>>(const onnx::TensorProto &tensor) const;
 template <>
-xt::xarray<float> onnx_importer::convert_to<xt::xarray<float>>(const onnx::TensorProto &tensor);
+xt::xarray<float> onnx_importer::convert_to<xt::xarray<float>>(const onnx::TensorProto &tensor) const;
 }
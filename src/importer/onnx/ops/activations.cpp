@@ -98,7 +98,7 @@ void onnx_importer::convert_op_PRelu(const NodeProto &node)
     if (init)
     {
         // slope is initializer
-        auto slope_value = to<std::vector<float>>(init.value());
+        auto slope_value = to<std::vector<float>>(*init);
         alpha = graph_.emplace<constant>(get_datatype<float>(), slope_shape, slope_value);
         alpha->name(op_name + ".alpha(PRelu)");
     }
@@ -14,6 +14,7 @@
  */
 
 #include "../onnx_importer.h"
+#include <algorithm>
 #include <cassert>
 #include <nncase/ir/graph.h>
 #include <nncase/ir/ops/constant.h>
@@ -23,18 +24,34 @@ using namespace nncase::importer;
 using namespace nncase::ir;
 using namespace onnx;
 
-template <>
-constant *onnx_importer::emplace_constant<TensorProto>(const std::optional<TensorProto> &value)
+constant *onnx_importer::emplace_constant(const TensorProto &v)
 {
-    if (!value)
-        return nullptr;
-
-    const auto &v = value.value();
     shape_t shape = get_shape(v);
     const auto value_dt = get_datatype(v);
 
     TensorProto_DataType tensor_element_type { v.data_type() };
 
+    // Little-endian raw payloads already have the layout of the constant, so they are referenced
+    // from the model or the mapped external file instead of being copied
+    if (!NATIVE_IS_BIG_ENDIAN && (v.data_location() == TensorProto_DataLocation_EXTERNAL || v.has_raw_data()))
+    {
+        switch (tensor_element_type)
+        {
+        case TensorProto_DataType_UINT8:
+        case TensorProto_DataType_BOOL:
+        case TensorProto_DataType_FLOAT:
+        case TensorProto_DataType_INT32:
+        case TensorProto_DataType_INT64:
+        {
+            std::shared_ptr<const void> owner;
+            const auto data = get_raw_data(v, owner);
+            return graph_.emplace<constant>(value_dt.value(), shape, data, std::move(owner));
+        }
+        default:
+            break;
+        }
+    }
+
     switch (tensor_element_type)
     {
     case TensorProto_DataType_UINT8:
@@ -85,9 +102,11 @@ void onnx_importer::convert_op_Constant(const NodeProto &node)
     const auto &output = node.output()[0];
 
     ir::constant *op = nullptr;
-    if (const auto value = get_attribute<TensorProto>(node, "value"))
+    const auto value_attr = std::find_if(node.attribute().begin(), node.attribute().end(),
+        [](const AttributeProto &attr) { return attr.name() == "value"; });
+    if (value_attr != node.attribute().end())
     {
-        op = emplace_constant(value);
+        op = emplace_constant(value_attr->t());
     }
     else if (const auto value = get_attribute<float>(node, "value_float"))
     {
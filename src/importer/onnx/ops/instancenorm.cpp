@@ -43,7 +43,7 @@ void onnx_importer::convert_op_InstanceNormalization(const NodeProto &node)
 
     std::vector<float> scale_value;
     auto scale_initializer = get_initializer(scale);
-    scale_value = scale_initializer ? to<std::vector<float>>(scale_initializer.value()) : get_constant_input_data<float>(scale).value();
+    scale_value = scale_initializer ? to<std::vector<float>>(*scale_initializer) : get_constant_input_data<float>(scale).value();
     auto scale_shape = get_shape(scale);
     auto scale_new_shape = broadcast_shape(scale_shape, input_shape);
     auto scale_constant = graph_.emplace<constant>(get_datatype<float>(), scale_new_shape, scale_value);
@@ -51,7 +51,7 @@ void onnx_importer::convert_op_InstanceNormalization(const NodeProto &node)
 
     std::vector<float> bias_value;
     auto bias_initializer = get_initializer(bias);
-    bias_value = bias_initializer ? to<std::vector<float>>(bias_initializer.value()) : get_constant_input_data<float>(bias).value();
+    bias_value = bias_initializer ? to<std::vector<float>>(*bias_initializer) : get_constant_input_data<float>(bias).value();
     auto bias_shape = get_shape(bias);
     auto bias_new_shape = broadcast_shape(bias_shape, input_shape);
     auto bias_constant = graph_.emplace<constant>(get_datatype<float>(), bias_new_shape, bias_value);
@@ -16,6 +16,7 @@
 #include "../onnx_importer.h"
 #include <cassert>
 #include <nncase/ir/graph.h>
+#include <nncase/ir/ops/bitcast.h>
 #include <nncase/ir/ops/matmul.h>
 
 using namespace nncase;
@@ -34,16 +35,61 @@ void onnx_importer::convert_op_MatMul(const NodeProto &node)
     auto &&input_a_shape = get_shape(input_a);
     auto &&input_b_shape = get_shape(input_b);
 
-    std::vector<float> bias_value(input_b_shape.back(), 0.f);
-    shape_t bias_shape = { input_b_shape.back() };
+    // 1-D operands are promoted to matrices (numpy semantics), the extra dim is removed from the output
+    auto mm_a_shape = input_a_shape;
+    auto mm_b_shape = input_b_shape;
+    if (input_a_shape.size() == 1)
+        mm_a_shape.insert(mm_a_shape.begin(), 1);
+    if (input_b_shape.size() == 1)
+        mm_b_shape.push_back(1);
+
+    std::vector<float> bias_value(mm_b_shape.back(), 0.f);
+    shape_t bias_shape = { mm_b_shape.back() };
     auto bias = graph_.emplace<constant>(dt_float32, bias_shape, bias_value);
     bias->name(op_name + ".bias(MatMul)");
 
-    auto mmul = graph_.emplace<matmul>(std::move(input_a_shape), std::move(input_b_shape), value_range<float>::full());
+    auto mmul = graph_.emplace<matmul>(mm_a_shape, mm_b_shape, value_range<float>::full());
     mmul->name(op_name + ".matmul(MatMul)");
     mmul->bias().connect(bias->output());
 
-    input_tensors_.emplace(&mmul->input_a(), input_a);
-    input_tensors_.emplace(&mmul->input_b(), input_b);
-    output_tensors_.emplace(output, &mmul->output());
+    if (input_a_shape.size() == 1)
+    {
+        auto bc_a = graph_.emplace<bitcast>(dt_float32, input_a_shape, mm_a_shape);
+        bc_a->name(op_name + ".bitcast_a(MatMul)");
+        mmul->input_a().connect(bc_a->output());
+        input_tensors_.emplace(&bc_a->input(), input_a);
+    }
+    else
+    {
+        input_tensors_.emplace(&mmul->input_a(), input_a);
+    }
+
+    if (input_b_shape.size() == 1)
+    {
+        auto bc_b = graph_.emplace<bitcast>(dt_float32, input_b_shape, mm_b_shape);
+        bc_b->name(op_name + ".bitcast_b(MatMul)");
+        mmul->input_b().connect(bc_b->output());
+        input_tensors_.emplace(&bc_b->input(), input_b);
+    }
+    else
+    {
+        input_tensors_.emplace(&mmul->input_b(), input_b);
+    }
+
+    if (input_a_shape.size() == 1 || input_b_shape.size() == 1)
+    {
+        auto out_shape = mmul->output().shape();
+        if (input_b_shape.size() == 1)
+            out_shape.erase(out_shape.end() - 1);
+        if (input_a_shape.size() == 1)
+            out_shape.erase(out_shape.end() - 1);
+        auto bc_out = graph_.emplace<bitcast>(dt_float32, mmul->output().shape(), out_shape);
+        bc_out->name(op_name + ".bitcast_out(MatMul)");
+        bc_out->input().connect(mmul->output());
+        output_tensors_.emplace(output, &bc_out->output());
+    }
+    else
+    {
+        output_tensors_.emplace(output, &mmul->output());
+    }
 }
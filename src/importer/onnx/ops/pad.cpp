@@ -101,20 +101,20 @@ void onnx_importer::convert_op_Pad(const NodeProto &node)
         if (node.input().size() == 3)
         {
             const auto &constant_value = node.input()[2];
-            const auto &constant_initializer = get_initializer(constant_value);
+            const auto constant_initializer = get_initializer(constant_value);
             switch (input_type)
             {
             case dt_float32:
             {
                 if (constant_initializer)
                 {
-                    if (constant_initializer.value().float_data_size() == 0)
+                    if (constant_initializer->float_data_size() == 0)
                     {
                         constant = 0.f;
                     }
                     else
                     {
-                        constant = to<float>(constant_initializer.value());
+                        constant = to<float>(*constant_initializer);
                     }
                 }
                 else
@@ -47,7 +47,7 @@ void onnx_importer::convert_op_Unsqueeze(const NodeProto &node)
         assert(node.input().size() == 2);
         auto axes_input = node.input()[1];
         auto initializer = get_initializer(axes_input);
-        axes = initializer ? to<axis_t>(initializer.value()) : get_constant_input_data<int>(axes_input).value();
+        axes = initializer ? to<axis_t>(*initializer) : get_constant_input_data<int>(axes_input).value();
     }
 
     size_t size = input_shape.size() + axes.size();
@@ -12,6 +12,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <nncase/ir/graph.h>
 #include <nncase/ir/ops/call.h>
 #include <nncase/ir/visitor.h>
@@ -28,15 +29,24 @@ std::unordered_set<char> char_need_escape = { '/', ':' };
 
 void add_reachable_graphs(graph &root, std::vector<graph *> &graphs)
 {
+    // Subgraphs are listed once each in visit order so callers get a stable order
     graphs.emplace_back(&root);
-    std::unordered_set<graph *> subgraphs;
+    std::vector<graph *> subgraphs;
     auto visitor = make_relay_ir_visitor([&](node &node) {
         if (auto c = node_cast<call>(node))
-            subgraphs.emplace(&c->target());
+        {
+            auto target = &c->target();
+            if (std::find(graphs.begin(), graphs.end(), target) == graphs.end()
+                && std::find(subgraphs.begin(), subgraphs.end(), target) == subgraphs.end())
+                subgraphs.emplace_back(target);
+        }
     });
     visitor.visit(root);
-    for (auto &g : subgraphs)
-        add_reachable_graphs(*g, graphs);
+    for (auto g : subgraphs)
+    {
+        if (std::find(graphs.begin(), graphs.end(), g) == graphs.end())
+            add_reachable_graphs(*g, graphs);
+    }
 }
 }
 
@@ -20,11 +20,16 @@ using namespace nncase;
 using namespace nncase::ir;
 
 binary::binary(binary_op_t binary_op, shape_t input_a_shape, shape_t input_b_shape, value_range<float> input_fused_activation)
+    : binary(dt_float32, binary_op, std::move(input_a_shape), std::move(input_b_shape), input_fused_activation)
+{
+}
+
+binary::binary(datatype_t input_type, binary_op_t binary_op, shape_t input_a_shape, shape_t input_b_shape, value_range<float> input_fused_activation)
     : binary_op_(binary_op), fused_activation_(input_fused_activation)
 {
-    add_input("input_a", dt_float32, input_a_shape);
-    add_input("input_b", dt_float32, input_b_shape);
-    add_output("output", dt_float32, get_binary_output_shape(input_a_shape, input_b_shape));
+    add_input("input_a", input_type, input_a_shape);
+    add_input("input_b", input_type, input_b_shape);
+    add_output("output", input_type, get_binary_output_shape(input_a_shape, input_b_shape));
 }
 
 bool binary::properties_equal(node &other) const
@@ -12,6 +12,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <nncase/ir/op_utils.h>
 #include <nncase/ir/ops/constant.h>
 
@@ -21,5 +22,5 @@ using namespace nncase::ir;
 bool constant::properties_equal(node &other) const
 {
     auto &r = static_cast<constant &>(other);
-    return datatype_ == r.datatype_ && data_ == r.data_ && this->output_at(0).shape() == other.output_at(0).shape();
+    return datatype_ == r.datatype_ && std::equal(data_.begin(), data_.end(), r.data_.begin(), r.data_.end()) && this->output_at(0).shape() == other.output_at(0).shape();
 }
@@ -19,12 +19,17 @@ using namespace nncase;
 using namespace nncase::ir;
 
 conv2d::conv2d(shape_t input_shape, shape_t weighs_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation)
+    : conv2d(dt_float32, std::move(input_shape), std::move(weighs_shape), groups, padding_h, padding_w, stride_h, stride_w, dilation_h, dilation_w, fused_activation)
+{
+}
+
+conv2d::conv2d(datatype_t input_type, shape_t input_shape, shape_t weighs_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation)
     : groups_(groups), padding_h_(padding_h), padding_w_(padding_w), stride_h_(stride_h), stride_w_(stride_w), dilation_h_(dilation_h), dilation_w_(dilation_w), fused_activation_(fused_activation)
 {
-    add_input("input", dt_float32, input_shape);
-    add_input("weights", dt_float32, weighs_shape);
-    add_input("bias", dt_float32, shape_t { (size_t)output_channels() });
-    add_output("output", dt_float32,
+    add_input("input", input_type, input_shape);
+    add_input("weights", input_type, weighs_shape);
+    add_input("bias", input_type, shape_t { (size_t)output_channels() });
+    add_output("output", input_type,
         shape_t {
             input_shape[0],
             (size_t)output_channels(),
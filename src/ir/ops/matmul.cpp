@@ -19,21 +19,18 @@
 using namespace nncase;
 using namespace nncase::ir;
 
-matmul::matmul(shape_t input_a_shape, shape_t input_b_shape, value_range<float> fused_activation)
-    : fused_activation_(fused_activation)
+matmul::matmul(shape_t input_a_shape, shape_t input_b_shape, value_range<float> fused_activation, bool transpose_a, bool transpose_b)
+    : fused_activation_(fused_activation), transpose_a_(transpose_a), transpose_b_(transpose_b)
 {
-    // if (input_a_shape.size() != 2 || input_b_shape.size() != 2)
-    //     throw std::invalid_argument("inputs must be 2 rank");
-    // if (input_a_shape[1] != input_b_shape[0])
-    //     throw std::invalid_argument("input a's cols must be equal to input b's rows");
+    auto out_shape = get_matmul_output_shape(input_a_shape, input_b_shape, transpose_a, transpose_b);
     add_input("input_a", dt_float32, input_a_shape);
     add_input("input_b", dt_float32, input_b_shape);
-    add_input("bias", dt_float32, shape_t { input_b_shape[1] });
-    add_output("output", dt_float32, shape_t { input_a_shape[0], input_b_shape[1] });
+    add_input("bias", dt_float32, shape_t { out_shape.back() });
+    add_output("output", dt_float32, out_shape);
 }
 
 bool matmul::properties_equal(node &other) const
 {
     auto &r = static_cast<matmul &>(other);
-    return fused_activation() == r.fused_activation();
+    return fused_activation() == r.fused_activation() && transpose_a() == r.transpose_a() && transpose_b() == r.transpose_b();
 }
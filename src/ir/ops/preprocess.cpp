@@ -0,0 +1,49 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/preprocess.h>
+#include <xtensor/xarray.hpp>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+preprocess::preprocess(datatype_t input_type, shape_t input_shape, bool input_nhwc, bool output_nhwc, bool swap_rb, quant_param_t dequant,
+    std::array<int32_t, 2> resize_shape, xt::svector<padding> paddings, float pad_value)
+    : input_nhwc_(input_nhwc), output_nhwc_(output_nhwc), swap_rb_(swap_rb), dequant_(dequant), resize_shape_(resize_shape), paddings_(std::move(paddings)), pad_value_(pad_value)
+{
+    if (input_shape.size() != 4)
+        throw std::invalid_argument("Preprocess input must be 4D");
+    if (paddings_.size() != 2)
+        throw std::invalid_argument("Preprocess paddings must have 2 entries (H, W)");
+
+    auto channels = input_nhwc ? input_shape[3] : input_shape[1];
+    shape_t output_shape { input_shape[0], channels,
+        size_t(resize_shape_[0] + paddings_[0].sum()), size_t(resize_shape_[1] + paddings_[1].sum()) };
+    if (output_nhwc)
+        output_shape = { output_shape[0], output_shape[2], output_shape[3], output_shape[1] };
+
+    add_input("input", input_type, input_shape);
+    add_input("mean", dt_float32, shape_t { channels });
+    add_input("std", dt_float32, shape_t { channels });
+    add_output("output", dt_float32, output_shape);
+}
+
+bool preprocess::properties_equal(node &other) const
+{
+    auto &r = static_cast<preprocess &>(other);
+    return input_nhwc() == r.input_nhwc() && output_nhwc() == r.output_nhwc() && swap_rb() == r.swap_rb()
+        && dequant() == r.dequant() && resize_shape() == r.resize_shape() && paddings() == r.paddings()
+        && pad_value() == r.pad_value();
+}
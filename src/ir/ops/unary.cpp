@@ -20,10 +20,15 @@ using namespace nncase;
 using namespace nncase::ir;
 
 unary::unary(unary_op_t unary_op, shape_t input_shape)
+    : unary(dt_float32, unary_op, std::move(input_shape))
+{
+}
+
+unary::unary(datatype_t input_type, unary_op_t unary_op, shape_t input_shape)
     : unary_op_(unary_op)
 {
-    add_input("input", dt_float32, input_shape);
-    add_output("output", dt_float32, input_shape);
+    add_input("input", input_type, input_shape);
+    add_output("output", input_type, input_shape);
 }
 
 bool unary::properties_equal(node &other) const
@@ -15,32 +15,150 @@
 #include <nncase/kernels/convolution.h>
 #include <nncase/kernels/cpu/optimized/tensor_compute.h>
 #include <nncase/kernels/cpu/reference/convolution.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/kernels/tensor_compute.h>
 #include <nncase/runtime/runtime_op_utility.h>
 using namespace nncase;
 using namespace nncase::runtime;
 using namespace nncase::kernels;
 
-result<void> kernels::conv2d(const float *input, const float *weights, const float *bias, float *output,
+namespace
+{
+template <class T>
+result<void> widen(const T *input, float *output, const runtime_shape_t &shape, const runtime_shape_t &strides, kernel_context &context) noexcept
+{
+    return kernels::convert(to_datatype<T>(), dt_float32, reinterpret_cast<const gsl::byte *>(input), reinterpret_cast<gsl::byte *>(output),
+        shape, strides, get_default_strides(shape), context);
+}
+
+// 16bit tensors run the float kernel one image at a time: the image is widened into float, convolved, and narrowed
+// back, so scratch stays at one image while the weights are widened once per call
+template <class T>
+result<void> conv2d_widened(const T *input, const T *weights, const T *bias, T *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
     const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
-    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,
+    conv2d_float_kernel_t kernel, kernel_context &context) noexcept
+{
+    const runtime_shape_t image_shape { 1, in_shape[1], in_shape[2], in_shape[3] };
+    const runtime_shape_t out_image_shape { 1, w_shape[0],
+        kernels::detail::get_windowed_output_size(in_shape[2], (int32_t)w_shape[2], stride_h, dilation_h, padding_h),
+        kernels::detail::get_windowed_output_size(in_shape[3], (int32_t)w_shape[3], stride_w, dilation_w, padding_w) };
+    const runtime_shape_t bias_shape { w_shape[0] };
+
+    try_var(w_float, scratch_buffer<float>::allocate(context, compute_size(w_shape)));
+    try_var(bias_float, scratch_buffer<float>::allocate(context, w_shape[0]));
+    try_var(in_float, scratch_buffer<float>::allocate(context, compute_size(image_shape)));
+    try_var(out_float, scratch_buffer<float>::allocate(context, compute_size(out_image_shape)));
+    try_(widen(weights, w_float.data(), w_shape, w_strides, context));
+    try_(widen(bias, bias_float.data(), bias_shape, bias_strides, context));
+
+    const auto in_image_strides = get_default_strides(image_shape);
+    const auto out_image_strides = get_default_strides(out_image_shape);
+    for (size_t n = 0; n < in_shape[0]; n++)
+    {
+        try_(widen(input + n * in_strides[0], in_float.data(), image_shape, in_strides, context));
+        try_(kernel(in_float.data(), w_float.data(), bias_float.data(), out_float.data(), image_shape, in_image_strides, w_shape,
+            get_default_strides(w_shape), runtime_shape_t { 1 }, out_image_strides, padding_h, padding_w, groups, stride_h, stride_w,
+            dilation_h, dilation_w, fused_activation, context));
+        try_(kernels::convert(dt_float32, to_datatype<T>(), reinterpret_cast<const gsl::byte *>(out_float.data()),
+            reinterpret_cast<gsl::byte *>(output + n * out_strides[0]), out_image_shape, out_image_strides, out_strides, context));
+    }
+
+    return ok();
+}
+}
+
+#define INSTANTIATE_CONV2D(T)                                                                                                                 \
+    template result<void> kernels::conv2d<T>(const T *input, const T *weights, const T *bias, T *output,                                      \
+        const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides, \
+        const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,          \
+        int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,      \
+        kernel_context &context) noexcept;                                                                                                    \
+    template result<void> kernels::conv2d<T>(const T *input, const T *weights, const T *bias, T *output,                                      \
+        const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides, \
+        const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,          \
+        int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,      \
+        const conv2d_plan &plan, kernel_context &context) noexcept;
+
+INSTANTIATE_CONV2D(float)
+INSTANTIATE_CONV2D(half)
+INSTANTIATE_CONV2D(bfloat16)
+
+#undef INSTANTIATE_CONV2D
+
+conv2d_plan kernels::plan_conv2d(datatype_t type, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape,
+    const padding &padding_h, const padding &padding_w, int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w) noexcept
 {
-    if (dilation_h == 1 && dilation_w == 1)
+    if ((type == dt_float32 || type == dt_float16 || type == dt_bfloat16) && dilation_h == 1 && dilation_w == 1)
     {
-        if (cpu::optimized::conv2d(input, weights, bias, output,
+        // 16bit inputs reach the kernel widened into a contiguous float image
+        auto plan = cpu::optimized::select_conv2d(in_shape, type == dt_float32 ? in_strides : get_default_strides(in_shape), w_shape, padding_h, padding_w, groups, stride_h, stride_w);
+        if (plan.kernel)
+            return plan;
+    }
+
+    return { nullptr, "reference" };
+}
+
+std::vector<conv2d_candidate> kernels::conv2d_candidates(const conv2d_plan &plan, uint32_t num_threads)
+{
+    // Without a specialized kernel there is nothing to pick from
+    if (!plan.kernel)
+        return { { plan, 0, plan.name } };
+
+    std::vector<conv2d_candidate> candidates;
+    num_threads = std::max(num_threads, 1u);
+    for (auto threads = num_threads; threads; threads /= 2)
+        candidates.push_back({ plan, threads == num_threads ? 0 : threads, std::string(plan.name) + "@" + std::to_string(threads) });
+    candidates.push_back({ { nullptr, "reference" }, 0, "reference" });
+    return candidates;
+}
+
+template <class T>
+result<void> kernels::conv2d(const T *input, const T *weights, const T *bias, T *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,
+    const conv2d_plan &plan, kernel_context &context) noexcept
+{
+    if (plan.kernel)
+    {
+        if constexpr (std::is_same_v<T, float>)
+        {
+            return plan.kernel(input, weights, bias, output,
                 in_shape, in_strides, w_shape,
                 w_strides, bias_strides, out_strides,
                 padding_h, padding_w, groups, stride_h,
-                stride_w, dilation_h, dilation_w, fused_activation, context)
-                .is_ok())
+                stride_w, dilation_h, dilation_w, fused_activation, context);
+        }
+        else
         {
-            return ok();
+            return conv2d_widened(input, weights, bias, output,
+                in_shape, in_strides, w_shape,
+                w_strides, bias_strides, out_strides,
+                padding_h, padding_w, groups, stride_h,
+                stride_w, dilation_h, dilation_w, fused_activation, plan.kernel, context);
         }
     }
-    // general conv
+    // general conv, 16bit floats are accumulated in float
     return cpu::reference::conv2d(input, weights, bias, output,
         in_shape, in_strides, w_shape,
         w_strides, bias_strides, out_strides,
         padding_h, padding_w, groups, stride_h,
         stride_w, dilation_h, dilation_w, fused_activation, context);
 }
+
+template <class T>
+result<void> kernels::conv2d(const T *input, const T *weights, const T *bias, T *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    auto plan = plan_conv2d(to_datatype<T>(), in_shape, in_strides, w_shape, padding_h, padding_w, groups, stride_h, stride_w, dilation_h, dilation_w);
+    return kernels::conv2d(input, weights, bias, output,
+        in_shape, in_strides, w_shape,
+        w_strides, bias_strides, out_strides,
+        padding_h, padding_w, groups, stride_h,
+        stride_w, dilation_h, dilation_w, fused_activation, plan, context);
+}
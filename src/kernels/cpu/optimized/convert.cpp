@@ -0,0 +1,149 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+// Rows longer than this are split so a single large tensor still spreads over the threads
+constexpr size_t chunk_size = 16384;
+
+template <class TInput, class TOutput>
+void convert_contiguous(const TInput *CXX_RESTRICT input, TOutput *CXX_RESTRICT output, size_t count) noexcept
+{
+    if constexpr (std::is_same_v<TInput, float> && std::is_same_v<TOutput, bfloat16>)
+    {
+        // Branchless round to nearest even, NaN is squashed to a quiet NaN like bfloat16::round_to_bfloat16
+        auto out = reinterpret_cast<uint16_t *>(output);
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, input + i, sizeof(bits));
+            auto rounded = (uint16_t)((bits + 0x7fff + ((bits >> 16) & 1)) >> 16);
+            out[i] = (bits & 0x7fffffff) > 0x7f800000 ? bfloat16::nan().raw() : rounded;
+        }
+    }
+    else if constexpr (std::is_same_v<TInput, bfloat16> && std::is_same_v<TOutput, float>)
+    {
+        auto in = reinterpret_cast<const uint16_t *>(input);
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32_t bits = (uint32_t)in[i] << 16;
+            std::memcpy(output + i, &bits, sizeof(bits));
+        }
+    }
+    else if constexpr (std::is_same_v<TInput, float> && std::is_same_v<TOutput, half>)
+    {
+        size_t i = 0;
+#if NNCASE_HALF_F16C
+        for (; i + 8 <= count; i += 8)
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), _mm256_cvtps_ph(_mm256_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+        for (; i < count; i++)
+            output[i] = half::round_to_half(input[i]);
+    }
+    else if constexpr (std::is_same_v<TInput, half> && std::is_same_v<TOutput, float>)
+    {
+        size_t i = 0;
+#if NNCASE_HALF_F16C
+        for (; i + 8 <= count; i += 8)
+            _mm256_storeu_ps(output + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i))));
+#endif
+        for (; i < count; i++)
+            output[i] = (float)input[i];
+    }
+    else if constexpr (std::is_integral_v<TOutput> && !std::is_integral_v<TInput>)
+    {
+        for (size_t i = 0; i < count; i++)
+            output[i] = kernels::detail::saturate_cast<TOutput>((float)input[i]);
+    }
+    else
+    {
+        for (size_t i = 0; i < count; i++)
+            output[i] = static_cast<TOutput>(input[i]);
+    }
+}
+
+template <class TInput, class TOutput>
+result<void> convert_impl(const TInput *input, TOutput *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, NNCASE_UNUSED kernel_context &context) noexcept
+{
+    size_t outer_dims, row_size;
+    if (!kernels::detail::get_contiguous_rows(in_shape, in_strides, out_strides, outer_dims, row_size))
+        return err(std::errc::not_supported);
+
+    const auto rows = row_size ? compute_size(in_shape) / row_size : 0;
+    const auto chunks = (row_size + chunk_size - 1) / chunk_size;
+    const auto tasks = rows * chunks;
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(std::max<size_t>(1, std::min<size_t>(context.num_threads, tasks))) schedule(static)
+#endif
+    for (size_t t = 0; t < tasks; t++)
+    {
+        size_t in_offset, out_offset;
+        kernels::detail::get_row_offsets(t / chunks, in_shape, outer_dims, in_strides, out_strides, in_offset, out_offset);
+        const auto begin = t % chunks * chunk_size;
+        convert_contiguous(input + in_offset + begin, output + out_offset + begin, std::min(chunk_size, row_size - begin));
+    }
+
+    return ok();
+}
+}
+
+#define CONVERT_IMPL_LV2(input_t, output_t)  \
+    if (out_type == to_datatype<output_t>()) \
+    return convert_impl(reinterpret_cast<const input_t *>(input), reinterpret_cast<output_t *>(output), in_shape, in_strides, out_strides, context)
+
+#define CONVERT_IMPL_LV1(input_t)            \
+    if (in_type == to_datatype<input_t>())   \
+    {                                        \
+        CONVERT_IMPL_LV2(input_t, uint8_t);  \
+        CONVERT_IMPL_LV2(input_t, uint16_t); \
+        CONVERT_IMPL_LV2(input_t, uint32_t); \
+        CONVERT_IMPL_LV2(input_t, uint64_t); \
+        CONVERT_IMPL_LV2(input_t, int8_t);   \
+        CONVERT_IMPL_LV2(input_t, int16_t);  \
+        CONVERT_IMPL_LV2(input_t, int32_t);  \
+        CONVERT_IMPL_LV2(input_t, int64_t);  \
+        CONVERT_IMPL_LV2(input_t, float);    \
+    }
+
+result<void> optimized::convert(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context) noexcept
+{
+    if (in_type == dt_float32 && out_type == dt_bfloat16)
+        return convert_impl(reinterpret_cast<const float *>(input), reinterpret_cast<bfloat16 *>(output), in_shape, in_strides, out_strides, context);
+    if (in_type == dt_float32 && out_type == dt_float16)
+        return convert_impl(reinterpret_cast<const float *>(input), reinterpret_cast<half *>(output), in_shape, in_strides, out_strides, context);
+    CONVERT_IMPL_LV1(uint8_t);
+    CONVERT_IMPL_LV1(uint16_t);
+    CONVERT_IMPL_LV1(uint32_t);
+    CONVERT_IMPL_LV1(uint64_t);
+    CONVERT_IMPL_LV1(int8_t);
+    CONVERT_IMPL_LV1(int16_t);
+    CONVERT_IMPL_LV1(int32_t);
+    CONVERT_IMPL_LV1(int64_t);
+    CONVERT_IMPL_LV1(bfloat16);
+    CONVERT_IMPL_LV1(half);
+    CONVERT_IMPL_LV1(float);
+    return err(std::errc::not_supported);
+}
@@ -31,30 +31,30 @@
                   padding_h, padding_w, groups, stride_h, \
                   stride_w, dilation_h, dilation_w, fused_activation, context
 
-#define CONV2D_NXM_S1_S2(n, m)                           \
-    if (filter_h == n && filter_w == m)                  \
-    {                                                    \
-        if (stride_h == 1 && stride_w == 1)              \
-        {                                                \
-            return conv2d_nxm<8, n, m, 1, 1>(CONV_ARGS); \
-        }                                                \
-        else if (stride_h == 2 && stride_w == 2)         \
-        {                                                \
-            return conv2d_nxm<8, n, m, 2, 2>(CONV_ARGS); \
-        }                                                \
+#define CONV2D_NXM_S1_S2(n, m)                                               \
+    if (filter_h == n && filter_w == m)                                      \
+    {                                                                        \
+        if (stride_h == 1 && stride_w == 1)                                  \
+        {                                                                    \
+            return { conv2d_nxm<8, n, m, 1, 1>, "conv2d_" #n "x" #m "_s1" }; \
+        }                                                                    \
+        else if (stride_h == 2 && stride_w == 2)                             \
+        {                                                                    \
+            return { conv2d_nxm<8, n, m, 2, 2>, "conv2d_" #n "x" #m "_s2" }; \
+        }                                                                    \
     }
 
-#define CONV2D_DEPTHWISE_NXM_S1_S2(n, m)                           \
-    if (filter_h == n && filter_w == m)                            \
-    {                                                              \
-        if (stride_h == 1 && stride_w == 1)                        \
-        {                                                          \
-            return conv2d_depthwise_nxm<8, n, m, 1, 1>(CONV_ARGS); \
-        }                                                          \
-        else if (stride_h == 2 && stride_w == 2)                   \
-        {                                                          \
-            return conv2d_depthwise_nxm<8, n, m, 2, 2>(CONV_ARGS); \
-        }                                                          \
+#define CONV2D_DEPTHWISE_NXM_S1_S2(n, m)                                                         \
+    if (filter_h == n && filter_w == m)                                                          \
+    {                                                                                            \
+        if (stride_h == 1 && stride_w == 1)                                                      \
+        {                                                                                        \
+            return { conv2d_depthwise_nxm<8, n, m, 1, 1>, "conv2d_depthwise_" #n "x" #m "_s1" }; \
+        }                                                                                        \
+        else if (stride_h == 2 && stride_w == 2)                                                 \
+        {                                                                                        \
+            return { conv2d_depthwise_nxm<8, n, m, 2, 2>, "conv2d_depthwise_" #n "x" #m "_s2" }; \
+        }                                                                                        \
     }
 
 using namespace nncase;
@@ -517,7 +517,10 @@ result<void> conv2d_depthwise_nxm(const float *input, const float *weights, cons
 
 #endif
 
-result<void> optimized::conv2d(const float *input, const float *weights, const float *bias, float *output,
+#ifdef NNCASE_HALIDE
+namespace
+{
+result<void> conv2d_halide(const float *input, const float *weights, const float *bias, float *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
     const runtime_shape_t &w_shape, NNCASE_UNUSED const runtime_shape_t &w_strides,
     NNCASE_UNUSED const runtime_shape_t &bias_strides, NNCASE_UNUSED const runtime_shape_t &out_strides,
@@ -528,8 +531,7 @@ result<void> optimized::conv2d(const float *input, const float *weights, const f
     const auto filter_h = w_shape[2];
     const auto filter_w = w_shape[3];
 
-#ifdef NNCASE_HALIDE
-    if (groups == 1 && runtime::is_contiguous(in_shape, in_strides))
+    if (groups == 1)
     {
         // clang-format off
         HALIDE_CONV2D_NXM_S1_S2(1, 1)
@@ -538,8 +540,7 @@ result<void> optimized::conv2d(const float *input, const float *weights, const f
         else HALIDE_CONV2D_NXM_S1_S2(7, 7)
         // clang-format on
     }
-
-    if ((size_t)groups == in_shape[1] && (size_t)groups == w_shape[0] && runtime::is_contiguous(in_shape, in_strides))
+    else
     {
         // clang-format off
         HALIDE_CONV2D_DEPTHWISE_NXM_S1_S2(1, 1)
@@ -549,6 +550,27 @@ result<void> optimized::conv2d(const float *input, const float *weights, const f
         // clang-format on
     }
 
+    return err(std::errc::not_supported);
+}
+}
+#endif
+
+conv2d_plan optimized::select_conv2d(const runtime_shape_t &in_shape, NNCASE_UNUSED const runtime_shape_t &in_strides, const runtime_shape_t &w_shape,
+    NNCASE_UNUSED const padding &padding_h, NNCASE_UNUSED const padding &padding_w, int32_t groups, int32_t stride_h, int32_t stride_w) noexcept
+{
+    const auto filter_h = w_shape[2];
+    const auto filter_w = w_shape[3];
+
+#ifdef NNCASE_HALIDE
+    if (filter_h == filter_w && (filter_h == 1 || filter_h == 3 || filter_h == 5 || filter_h == 7)
+        && stride_h == stride_w && (stride_h == 1 || stride_h == 2) && runtime::is_contiguous(in_shape, in_strides))
+    {
+        if (groups == 1)
+            return { conv2d_halide, "halide_conv2d" };
+        if ((size_t)groups == in_shape[1] && (size_t)groups == w_shape[0])
+            return { conv2d_halide, "halide_conv2d_depthwise" };
+    }
+
 #else
     if (groups == 1 && padding_h.before == 0 && padding_h.after == 0 && padding_w.before == 0 && padding_w.after == 0)
     {
@@ -556,11 +578,11 @@ result<void> optimized::conv2d(const float *input, const float *weights, const f
         {
             if (stride_h == 1 && stride_w == 1)
             {
-                return conv2d_1x1_s1(CONV_ARGS);
+                return { conv2d_1x1_s1, "conv2d_1x1_s1" };
             }
             else if (stride_h == 2 && stride_w == 2)
             {
-                return conv2d_1x1_s2(CONV_ARGS);
+                return { conv2d_1x1_s2, "conv2d_1x1_s2" };
             }
         }
         // clang-format off
@@ -583,5 +605,19 @@ result<void> optimized::conv2d(const float *input, const float *weights, const f
         // clang-format on
     }
 #endif
-    return err(std::errc::not_supported);
-}
\ No newline at end of file
+    return { nullptr, nullptr };
+}
+
+result<void> optimized::conv2d(const float *input, const float *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides,
+    const padding &padding_h, const padding &padding_w, int32_t groups,
+    int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w,
+    value_range<float> fused_activation, kernels::kernel_context &context) noexcept
+{
+    auto plan = select_conv2d(in_shape, in_strides, w_shape, padding_h, padding_w, groups, stride_h, stride_w);
+    if (!plan.kernel)
+        return err(std::errc::not_supported);
+    return plan.kernel(CONV_ARGS);
+}
@@ -24,7 +24,10 @@ using namespace nncase::kernels::cpu::optimized;
 
 namespace impl
 {
+// Rows longer than this are split so a single large tensor still spreads over the threads
+constexpr size_t chunk_size = 16384;
 
+#if __riscv
 template <class TQ>
 void riscv_dequantize(const TQ *CXX_RESTRICT input, float *CXX_RESTRICT output, size_t count, float scale, float bias)
 {
@@ -45,9 +48,10 @@ void riscv_dequantize(const TQ *CXX_RESTRICT input, float *CXX_RESTRICT output,
     if (count % 2)
         output[count - 1] = input[count - 1] * scale + bias;
 }
+#endif
 
 template <class TQint>
-result<void> dequantize(const TQint *CXX_RESTRICT input, float *CXX_RESTRICT output, size_t count, float scale, float bias)
+void dequantize_contiguous(const TQint *CXX_RESTRICT input, float *CXX_RESTRICT output, size_t count, float scale, float bias)
 {
 #if __riscv
     riscv_dequantize(input, output, count, scale, bias);
@@ -57,18 +61,43 @@ result<void> dequantize(const TQint *CXX_RESTRICT input, float *CXX_RESTRICT out
         output[i] = input[i] * scale + bias;
     }
 #endif
+}
+
+template <class TQint>
+result<void> dequantize(const TQint *input, float *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &out_strides, float scale, float bias, NNCASE_UNUSED kernel_context &context)
+{
+    size_t outer_dims, row_size;
+    if (!kernels::detail::get_contiguous_rows(in_shape, in_strides, out_strides, outer_dims, row_size))
+        return err(std::errc::not_supported);
+
+    const auto rows = row_size ? compute_size(in_shape) / row_size : 0;
+    const auto chunks = (row_size + chunk_size - 1) / chunk_size;
+    const auto tasks = rows * chunks;
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(std::max<size_t>(1, std::min<size_t>(context.num_threads, tasks))) schedule(static)
+#endif
+    for (size_t t = 0; t < tasks; t++)
+    {
+        size_t in_offset, out_offset;
+        kernels::detail::get_row_offsets(t / chunks, in_shape, outer_dims, in_strides, out_strides, in_offset, out_offset);
+        const auto begin = t % chunks * chunk_size;
+        dequantize_contiguous(input + in_offset + begin, output + out_offset + begin, std::min(chunk_size, row_size - begin), scale, bias);
+    }
+
     return ok();
 }
 } // namespace impl
 
-#define DEQUANTIZE_IMPL(qint_t, float_t)                                                                                                            \
-    if (in_type == to_datatype<qint_t>() && out_type == to_datatype<float_t>())                                                                     \
-    {                                                                                                                                               \
-        return impl::dequantize(reinterpret_cast<const qint_t *>(input), reinterpret_cast<float_t *>(output), compute_size(in_shape), scale, bias); \
+#define DEQUANTIZE_IMPL(qint_t, float_t)                                                                                                                      \
+    if (in_type == to_datatype<qint_t>() && out_type == to_datatype<float_t>())                                                                               \
+    {                                                                                                                                                         \
+        return impl::dequantize(reinterpret_cast<const qint_t *>(input), reinterpret_cast<float_t *>(output), in_shape, in_strides, out_strides, scale, bias, \
+            context);                                                                                                                                         \
     }
 
 result<void> optimized::dequantize(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
-    const runtime_shape_t &in_shape, NNCASE_UNUSED const runtime_shape_t &in_strides, NNCASE_UNUSED const runtime_shape_t &out_strides, float scale, float bias, NNCASE_UNUSED kernel_context &context) noexcept
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, float scale, float bias, kernel_context &context) noexcept
 {
     DEQUANTIZE_IMPL(uint8_t, float)
     DEQUANTIZE_IMPL(int8_t, float)
@@ -32,22 +32,36 @@ result<void> gather_impl(const T *input, T *output, const runtime_shape_t &in_sh
     size_t outer_count = std::accumulate(in_shape.begin(), in_shape.begin() + axis, 1, std::multiplies<size_t> {});
     auto indices_count = compute_size(indices_shape);
     size_t block_size = std::accumulate(in_shape.begin() + axis + 1, in_shape.end(), 1, std::multiplies<size_t> {});
+    auto axis_dim = in_shape[axis];
 
-    auto *in_ptr = input;
-    auto *out_ptr = output;
-    for (size_t o = 0; o < outer_count; ++o)
+    if (!kernels::detail::check_gather_indices(indices, indices_count, &axis_dim, 1))
+        return err(std::errc::result_out_of_range);
+
+    // One output row per (outer, index) pair, each a contiguous block of the input
+    auto rows = outer_count * indices_count;
+    if (block_size == 1)
+    {
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(context.num_threads)
+#endif
+        for (size_t r = 0; r < rows; ++r)
+        {
+            auto o = r / indices_count;
+            auto index = kernels::detail::normalize_gather_index(indices[r % indices_count], axis_dim);
+            output[r] = input[o * axis_dim + index];
+        }
+    }
+    else
     {
 #ifdef NNCASE_OPENMP
 #pragma omp parallel for num_threads(context.num_threads)
 #endif
-        for (size_t i = 0; i < indices_count; ++i)
+        for (size_t r = 0; r < rows; ++r)
         {
-            auto *o_ptr = out_ptr + i * block_size;
-            auto indices_ptr = indices[i];
-            memcpy(o_ptr, in_ptr + (indices_ptr * block_size), block_size * sizeof(T));
+            auto o = r / indices_count;
+            auto index = kernels::detail::normalize_gather_index(indices[r % indices_count], axis_dim);
+            memcpy(output + r * block_size, input + (o * axis_dim + index) * block_size, block_size * sizeof(T));
         }
-        in_ptr += in_shape[axis] * block_size;
-        out_ptr += indices_count * block_size;
     }
     return ok();
 }
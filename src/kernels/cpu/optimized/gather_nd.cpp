@@ -32,36 +32,31 @@ result<void> gather_nd_impl(const T *input, T *output, const runtime_shape_t &in
     auto last_indices_index = indices_shape.size() - 1;
     auto indices_list_size = indices_shape[last_indices_index];
     size_t indices_block_count = std::accumulate(indices_shape.begin() + batch_dims, indices_shape.end() - 1, 1, std::multiplies<size_t> {});
-
-    size_t block_size = std::accumulate(in_shape.begin() + indices_shape[last_indices_index] + batch_dims, in_shape.end(), 1, std::multiplies<size_t> {});
-
+    size_t block_size = std::accumulate(in_shape.begin() + indices_list_size + batch_dims, in_shape.end(), 1, std::multiplies<size_t> {});
     size_t batch_size = std::accumulate(in_shape.begin(), in_shape.begin() + batch_dims, 1, std::multiplies<size_t> {});
-
     size_t input_batch_block_size = std::accumulate(in_shape.begin() + batch_dims, in_shape.end(), 1, std::multiplies<size_t> {});
-    size_t output_batch_block_size = std::accumulate(out_shape.begin() + batch_dims, out_shape.end(), 1, std::multiplies<size_t> {});
-    size_t indices_batch_block_size = std::accumulate(indices_shape.begin() + batch_dims, indices_shape.end(), 1, std::multiplies<size_t> {});
-    for (size_t i = 0; i < batch_size; ++i)
-    {
+
+    const auto *indexed_dims = in_shape.data() + batch_dims;
+    const auto *indexed_strides = in_strides.data() + batch_dims;
+    auto rows = batch_size * indices_block_count;
+    if (!kernels::detail::check_gather_indices(indices, rows * indices_list_size, indexed_dims, indices_list_size))
+        return err(std::errc::result_out_of_range);
+
+    // Each row resolves its index tuple once and copies the contiguous trailing block
 #ifdef NNCASE_OPENMP
 #pragma omp parallel for num_threads(context.num_threads)
 #endif
-        for (size_t j = 0; j < indices_block_count; ++j)
-        {
-            const auto *indices_ptr = indices + j * indices_list_size;
-            auto *out_ptr = output + j * block_size;
-            auto *batch_begin_input = input;
-            // set batch_dims value used for select input
+    for (size_t r = 0; r < rows; ++r)
+    {
+        const auto *indices_ptr = indices + r * indices_list_size;
+        auto *in_ptr = input + (r / indices_block_count) * input_batch_block_size;
+        for (size_t k = 0; k < indices_list_size; ++k)
+            in_ptr += kernels::detail::normalize_gather_index(indices_ptr[k], indexed_dims[k]) * indexed_strides[k];
 
-            // get offset
-            for (size_t k = 0; k < indices_list_size; ++k)
-            {
-                batch_begin_input += indices_ptr[k] * in_strides[k + batch_dims];
-            }
-            memcpy(out_ptr, batch_begin_input, block_size * sizeof(T));
-        }
-        input += input_batch_block_size;
-        output += output_batch_block_size;
-        indices += indices_batch_block_size;
+        if (block_size == 1)
+            output[r] = *in_ptr;
+        else
+            memcpy(output + r * block_size, in_ptr, block_size * sizeof(T));
     }
     return ok();
 }
@@ -0,0 +1,235 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+#ifdef NNCASE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+// Register tile of the micro kernel and the cache blocks around it:
+// a packed A block (mc x kc) stays in L2, a packed B panel (kc x nr) in L1
+constexpr size_t mr = 4;
+constexpr size_t nr = 16;
+constexpr size_t mc = 64;
+constexpr size_t kc = 256;
+constexpr size_t nc = 128;
+
+struct matrix_view
+{
+    const float *data;
+    size_t row_stride;
+    size_t col_stride;
+};
+
+// Packs rows [i0, i0 + rows) x cols [p0, p0 + depth) of A into mr-row panels laid out [panel][p][mr], padding with zeros
+void pack_a(const matrix_view &a, size_t i0, size_t rows, size_t p0, size_t depth, float *CXX_RESTRICT packed) noexcept
+{
+    for (size_t i = 0; i < rows; i += mr)
+    {
+        const auto panel_rows = std::min(mr, rows - i);
+        for (size_t p = 0; p < depth; p++)
+        {
+            auto src = a.data + (i0 + i) * a.row_stride + (p0 + p) * a.col_stride;
+            size_t r = 0;
+            for (; r < panel_rows; r++)
+                packed[r] = src[r * a.row_stride];
+            for (; r < mr; r++)
+                packed[r] = 0.f;
+            packed += mr;
+        }
+    }
+}
+
+// Packs cols [j0, j0 + nr) of all k rows of B into one panel laid out [p][nr], padding with zeros
+void pack_b_panel(const matrix_view &b, size_t k, size_t j0, size_t cols, float *CXX_RESTRICT packed) noexcept
+{
+    for (size_t p = 0; p < k; p++)
+    {
+        auto src = b.data + p * b.row_stride + j0 * b.col_stride;
+        size_t c = 0;
+        if (b.col_stride == 1)
+        {
+            std::copy_n(src, cols, packed);
+            c = cols;
+        }
+        for (; c < cols; c++)
+            packed[c] = src[c * b.col_stride];
+        for (; c < nr; c++)
+            packed[c] = 0.f;
+        packed += nr;
+    }
+}
+
+// C[rows x cols] (+)= A panel * B panel, the first depth block starts from the bias and the last one applies the activation
+void micro_kernel(size_t depth, const float *CXX_RESTRICT a, const float *CXX_RESTRICT b, float *CXX_RESTRICT c, size_t ldc,
+    size_t rows, size_t cols, const float *bias, bool first, bool last, value_range<float> fused_activation) noexcept
+{
+    float acc[mr][nr] = {};
+    for (size_t p = 0; p < depth; p++)
+    {
+        for (size_t i = 0; i < mr; i++)
+        {
+            const auto a_value = a[i];
+            for (size_t j = 0; j < nr; j++)
+                acc[i][j] += a_value * b[j];
+        }
+
+        a += mr;
+        b += nr;
+    }
+
+    for (size_t i = 0; i < rows; i++)
+    {
+        auto c_row = c + i * ldc;
+        for (size_t j = 0; j < cols; j++)
+        {
+            auto value = acc[i][j] + (first ? (bias ? bias[j] : 0.f) : c_row[j]);
+            c_row[j] = last ? kernels::detail::apply_activation(value, fused_activation) : value;
+        }
+    }
+}
+
+// Linear index of the B matrix used by a batch of the output, broadcast dims of B map to 0
+size_t get_b_batch(size_t batch, const runtime_shape_t &out_shape, const runtime_shape_t &in_b_shape) noexcept
+{
+    const auto batch_rank = (int32_t)out_shape.size() - 2;
+    const auto b_ext = batch_rank - ((int32_t)in_b_shape.size() - 2);
+    size_t b_batch = 0, b_scale = 1;
+    for (int32_t i = batch_rank - 1; i >= b_ext; i--)
+    {
+        const auto index = batch % out_shape[i];
+        batch /= out_shape[i];
+        const auto dim = in_b_shape[i - b_ext];
+        if (dim != 1)
+            b_batch += index * b_scale;
+        b_scale *= dim;
+    }
+
+    return b_batch;
+}
+}
+
+result<void> optimized::matmul(const float *input_a, const float *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, bool transpose_a, bool transpose_b,
+    value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    runtime_shape_t out_shape;
+    if (!kernels::detail::get_matmul_output_shape(in_a_shape, in_b_shape, transpose_a, transpose_b, out_shape))
+        return err(std::errc::invalid_argument);
+
+    const auto a_rank = in_a_shape.size(), b_rank = in_b_shape.size(), out_rank = out_shape.size();
+    const auto m = out_shape[out_rank - 2];
+    const auto n = out_shape[out_rank - 1];
+    const auto k = in_a_shape[a_rank - (transpose_a ? 2 : 1)];
+    if (!m || !n)
+        return ok();
+
+    const auto a_rs = in_a_strides[a_rank - (transpose_a ? 1 : 2)], a_cs = in_a_strides[a_rank - (transpose_a ? 2 : 1)];
+    const auto b_rs = in_b_strides[b_rank - (transpose_b ? 1 : 2)], b_cs = in_b_strides[b_rank - (transpose_b ? 2 : 1)];
+    const auto ldc = out_strides[out_rank - 2];
+    const auto batches = compute_size(out_shape) / (m * n);
+
+    // Every distinct B matrix is packed once, so B broadcast over the batch (weights) is not repacked per batch
+    const auto b_batches = compute_size(in_b_shape) / (k * n ? k * n : 1);
+    const auto n_panels = (n + nr - 1) / nr;
+    const auto b_packed_size = k * n_panels * nr;
+    try_var(b_packed, scratch_buffer<float>::allocate(context, b_batches * b_packed_size));
+
+    const auto m_blocks = (m + mc - 1) / mc;
+    const auto n_blocks = (n + nc - 1) / nc;
+    const auto tiles = batches * m_blocks * n_blocks;
+#ifdef NNCASE_OPENMP
+    auto threads = std::max<size_t>(1, std::min<size_t>(context.num_threads, std::max(tiles, b_batches * n_panels)));
+#else
+    size_t threads = 1;
+#endif
+    const auto a_packed_size = std::min(kc, k) * ((std::min(mc, m) + mr - 1) / mr * mr);
+    try_var(a_packed, scratch_buffer<float>::allocate(context, threads * a_packed_size));
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(threads) schedule(static)
+#endif
+    for (size_t t = 0; t < b_batches * n_panels; t++)
+    {
+        const auto b_batch = t / n_panels;
+        const auto panel = t % n_panels;
+        size_t b_offset = 0, rest = b_batch;
+        for (int32_t i = (int32_t)b_rank - 3; i >= 0; i--)
+        {
+            b_offset += rest % in_b_shape[i] * in_b_strides[i];
+            rest /= in_b_shape[i];
+        }
+
+        const auto j0 = panel * nr;
+        pack_b_panel({ input_b + b_offset, b_rs, b_cs }, k, j0, std::min(nr, n - j0), b_packed.data() + b_batch * b_packed_size + panel * k * nr);
+    }
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(threads) schedule(static)
+#endif
+    for (size_t t = 0; t < tiles; t++)
+    {
+#ifdef NNCASE_OPENMP
+        auto a_block = a_packed.data() + omp_get_thread_num() * a_packed_size;
+#else
+        auto a_block = a_packed.data();
+#endif
+        const auto batch = t / (m_blocks * n_blocks);
+        const auto i0 = t / n_blocks % m_blocks * mc;
+        const auto j0 = t % n_blocks * nc;
+        const auto rows = std::min(mc, m - i0);
+        const auto cols = std::min(nc, n - j0);
+
+        size_t a_offset, b_offset, out_offset;
+        kernels::detail::get_matmul_batch_offsets(batch, out_shape, out_strides, in_a_shape, in_a_strides, in_b_shape, in_b_strides,
+            a_offset, b_offset, out_offset);
+        const matrix_view a { input_a + a_offset, a_rs, a_cs };
+        const auto b_panels = b_packed.data() + get_b_batch(batch, out_shape, in_b_shape) * b_packed_size;
+        const auto c = output + out_offset;
+
+        // An empty reduction still has to write bias and activation
+        const auto depth_blocks = std::max<size_t>(1, (k + kc - 1) / kc);
+        for (size_t kb = 0; kb < depth_blocks; kb++)
+        {
+            const auto p0 = kb * kc;
+            const auto depth = std::min(kc, k - p0);
+            pack_a(a, i0, rows, p0, depth, a_block);
+
+            for (size_t j = 0; j < cols; j += nr)
+            {
+                const auto b_panel = b_panels + (j0 + j) / nr * k * nr + p0 * nr;
+                for (size_t i = 0; i < rows; i += mr)
+                {
+                    micro_kernel(depth, a_block + i * depth, b_panel, c + (i0 + i) * ldc + j0 + j, ldc,
+                        std::min(mr, rows - i), std::min(nr, cols - j), bias ? bias + j0 + j : nullptr,
+                        kb == 0, kb + 1 == depth_blocks, fused_activation);
+                }
+            }
+        }
+    }
+
+    return ok();
+}
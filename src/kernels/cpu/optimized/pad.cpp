@@ -0,0 +1,159 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+// Maps an output index to the input index it reads, returns false if it takes the constant pad value
+bool get_source_index(size_t index, int32_t before, size_t dim, pad_mode_t mode, size_t &source) noexcept
+{
+    auto i = (int32_t)index - before;
+    auto n = (int32_t)dim;
+    if (i >= 0 && i < n)
+    {
+        source = (size_t)i;
+        return true;
+    }
+
+    switch (mode)
+    {
+    case pad_reflect:
+        i = i < 0 ? -i : 2 * n - 2 - i;
+        break;
+    case pad_symmetric:
+        i = i < 0 ? -i - 1 : 2 * n - 1 - i;
+        break;
+    case pad_edge:
+        i = i < 0 ? 0 : n - 1;
+        break;
+    default:
+        return false;
+    }
+
+    source = (size_t)i;
+    return true;
+}
+
+template <class T>
+void pad_row(const T *CXX_RESTRICT input, T *CXX_RESTRICT output, size_t width, const padding &padding, pad_mode_t mode, T pad_value) noexcept
+{
+    const auto before = (size_t)padding.before;
+    const auto after = (size_t)padding.after;
+    std::memcpy(output + before, input, width * sizeof(T));
+    if (mode == pad_constant)
+    {
+        std::fill_n(output, before, pad_value);
+        std::fill_n(output + before + width, after, pad_value);
+    }
+    else
+    {
+        size_t source;
+        for (size_t i = 0; i < before; i++)
+        {
+            get_source_index(i, padding.before, width, mode, source);
+            output[i] = input[source];
+        }
+
+        for (size_t i = before + width; i < before + width + after; i++)
+        {
+            get_source_index(i, padding.before, width, mode, source);
+            output[i] = input[source];
+        }
+    }
+}
+
+template <class T>
+result<void> pad_impl(const T *input, T *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &out_strides, const runtime_paddings_t &paddings, pad_mode_t mode, T pad_value, NNCASE_UNUSED kernel_context &context) noexcept
+{
+    if (in_shape.empty())
+    {
+        *output = *input;
+        return ok();
+    }
+
+    const auto rank = in_shape.size();
+    runtime_shape_t out_shape(rank);
+    for (size_t i = 0; i < rank; i++)
+        out_shape[i] = in_shape[i] + paddings[i].sum();
+
+    const auto width = in_shape.back();
+    const auto out_width = out_shape.back();
+    const auto out_size = compute_size(out_shape);
+    if (!out_size)
+        return ok();
+    const auto rows = out_size / out_width;
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(std::max<size_t>(1, std::min<size_t>(context.num_threads, rows))) schedule(static)
+#endif
+    for (size_t row = 0; row < rows; row++)
+    {
+        size_t in_offset = 0, out_offset = 0;
+        bool pad_row_value = false;
+        auto r = row;
+        for (size_t i = rank - 1; i-- > 0;)
+        {
+            const auto index = r % out_shape[i];
+            r /= out_shape[i];
+            size_t source;
+            if (get_source_index(index, paddings[i].before, in_shape[i], mode, source))
+                in_offset += source * in_strides[i];
+            else
+                pad_row_value = true;
+            out_offset += index * out_strides[i];
+        }
+
+        if (pad_row_value)
+            std::fill_n(output + out_offset, out_width, pad_value);
+        else
+            pad_row(input + in_offset, output + out_offset, width, paddings.back(), mode, pad_value);
+    }
+
+    return ok();
+}
+}
+
+result<void> optimized::pad(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const runtime_paddings_t &paddings, pad_mode_t mode, const scalar &pad_value, kernel_context &context) noexcept
+{
+    if (!kernels::detail::is_row_padding(in_shape, in_strides, out_strides, paddings))
+        return err(std::errc::not_supported);
+
+    switch (runtime::get_bytes(type))
+    {
+    case 1:
+        return pad_impl(reinterpret_cast<const uint8_t *>(input), reinterpret_cast<uint8_t *>(output), in_shape, in_strides, out_strides,
+            paddings, mode, pad_value.as<uint8_t>(), context);
+    case 2:
+        return pad_impl(reinterpret_cast<const uint16_t *>(input), reinterpret_cast<uint16_t *>(output), in_shape, in_strides, out_strides,
+            paddings, mode, pad_value.as<uint16_t>(), context);
+    case 4:
+        return pad_impl(reinterpret_cast<const uint32_t *>(input), reinterpret_cast<uint32_t *>(output), in_shape, in_strides, out_strides,
+            paddings, mode, pad_value.as<uint32_t>(), context);
+    default:
+        return err(std::errc::not_supported);
+    }
+}
@@ -0,0 +1,182 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+struct image_layout
+{
+    size_t c_stride;
+    size_t y_stride;
+    size_t x_stride;
+};
+
+image_layout get_layout(bool nhwc, size_t channels, size_t height, size_t width) noexcept
+{
+    if (nhwc)
+        return { 1, width * channels, channels };
+    return { height * width, width, 1 };
+}
+
+void fill_columns(float *CXX_RESTRICT output, size_t count, size_t x_stride, float value) noexcept
+{
+    for (size_t i = 0; i < count; i++)
+        output[i * x_stride] = value;
+}
+
+// Dequantize and normalize are folded into one multiply-add per channel,
+// each output row is produced in one pass with the bilinear taps precomputed per column
+template <class T>
+result<void> preprocess_impl(const T *input, float *output, const runtime_shape_t &in_shape, bool input_nhwc, bool output_nhwc,
+    bool swap_rb, const quant_param_t &dequant, int32_t resize_h, int32_t resize_w, const runtime_paddings_t &paddings, float pad_value,
+    const float *mean, const float *std, kernel_context &context) noexcept
+{
+    const runtime_shape_t nchw_shape = input_nhwc ? runtime_shape_t { in_shape[0], in_shape[3], in_shape[1], in_shape[2] } : in_shape;
+    const auto channels = nchw_shape[1];
+    const auto in_h = nchw_shape[2];
+    const auto in_w = nchw_shape[3];
+    const auto out_h = (size_t)(paddings[0].before + resize_h + paddings[0].after);
+    const auto out_w = (size_t)(paddings[1].before + resize_w + paddings[1].after);
+    const auto pad_top = paddings[0].before;
+    const auto pad_left = (size_t)paddings[1].before;
+    const auto pad_right = (size_t)paddings[1].after;
+    const auto in_layout = get_layout(input_nhwc, channels, in_h, in_w);
+    const auto out_layout = get_layout(output_nhwc, channels, out_h, out_w);
+    const auto identity = (size_t)resize_h == in_h && (size_t)resize_w == in_w;
+
+    try_var(coeffs, scratch_buffer<float>::allocate(context, channels * 3));
+    auto scale = coeffs.data();
+    auto bias = scale + channels;
+    auto pad = bias + channels;
+    for (size_t c = 0; c < channels; c++)
+    {
+        scale[c] = dequant.scale / std[c];
+        bias[c] = -(dequant.zero_point * dequant.scale + mean[c]) / std[c];
+        pad[c] = (pad_value - mean[c]) / std[c];
+    }
+
+    auto scales = kernels::detail::get_resize_scales(nchw_shape, resize_h, resize_w, false);
+    try_var(x_taps, scratch_buffer<size_t>::allocate(context, identity ? 0 : (size_t)resize_w * 2));
+    try_var(x_weights, scratch_buffer<float>::allocate(context, identity ? 0 : (size_t)resize_w));
+    if (!identity)
+    {
+        for (int32_t rx = 0; rx < resize_w; rx++)
+        {
+            float in_x;
+            int32_t in_x0, in_x1;
+            kernels::detail::set_resize_bilinear(rx, scales.second, true, in_w, in_x, in_x0, in_x1);
+            x_taps[rx * 2] = in_x0 * in_layout.x_stride;
+            x_taps[rx * 2 + 1] = in_x1 * in_layout.x_stride;
+            x_weights[rx] = in_x - in_x0;
+        }
+    }
+
+    const auto rows = nchw_shape[0] * out_h;
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(context.num_threads)
+#endif
+    for (size_t row = 0; row < rows; row++)
+    {
+        auto batch = row / out_h;
+        auto oy = row % out_h;
+        auto in_batch = input + batch * channels * in_h * in_w;
+        auto out_row = output + batch * channels * out_h * out_w + oy * out_layout.y_stride;
+        auto ry = (int32_t)oy - pad_top;
+
+        if (ry < 0 || ry >= resize_h)
+        {
+            for (size_t oc = 0; oc < channels; oc++)
+                fill_columns(out_row + oc * out_layout.c_stride, out_w, out_layout.x_stride, pad[oc]);
+            continue;
+        }
+
+        size_t in_y0 = ry, in_y1 = ry;
+        float wy = 0.f;
+        if (!identity)
+        {
+            float in_y;
+            int32_t y0, y1;
+            kernels::detail::set_resize_bilinear(ry, scales.first, true, in_h, in_y, y0, y1);
+            in_y0 = y0;
+            in_y1 = y1;
+            wy = in_y - y0;
+        }
+
+        for (size_t oc = 0; oc < channels; oc++)
+        {
+            auto ic = swap_rb && channels == 3 ? 2 - oc : oc;
+            auto out_c = out_row + oc * out_layout.c_stride;
+            fill_columns(out_c, pad_left, out_layout.x_stride, pad[oc]);
+            fill_columns(out_c + (pad_left + resize_w) * out_layout.x_stride, pad_right, out_layout.x_stride, pad[oc]);
+
+            float *CXX_RESTRICT dest = out_c + pad_left * out_layout.x_stride;
+            auto r0 = in_batch + ic * in_layout.c_stride + in_y0 * in_layout.y_stride;
+            auto r1 = in_batch + ic * in_layout.c_stride + in_y1 * in_layout.y_stride;
+            const auto k = scale[oc];
+            const auto b = bias[oc];
+            if (identity)
+            {
+                for (size_t rx = 0; rx < (size_t)resize_w; rx++)
+                    dest[rx * out_layout.x_stride] = (float)r0[rx * in_layout.x_stride] * k + b;
+            }
+            else
+            {
+                auto taps = x_taps.data();
+                auto weights = x_weights.data();
+                for (size_t rx = 0; rx < (size_t)resize_w; rx++)
+                {
+                    auto x0 = taps[rx * 2];
+                    auto x1 = taps[rx * 2 + 1];
+                    auto wx = weights[rx];
+                    auto top = (float)r0[x0] + ((float)r0[x1] - (float)r0[x0]) * wx;
+                    auto bottom = (float)r1[x0] + ((float)r1[x1] - (float)r1[x0]) * wx;
+                    dest[rx * out_layout.x_stride] = (top + (bottom - top) * wy) * k + b;
+                }
+            }
+        }
+    }
+
+    return ok();
+}
+}
+
+#define PREPROCESS_IMPL(type)                                                                                               \
+    return preprocess_impl(reinterpret_cast<const type *>(input), output, in_shape, input_nhwc, output_nhwc, swap_rb, dequant, \
+        resize_h, resize_w, paddings, pad_value, mean, std, context)
+
+result<void> optimized::preprocess(datatype_t type, const gsl::byte *input, float *output, const runtime_shape_t &in_shape,
+    NNCASE_UNUSED const runtime_shape_t &in_strides, NNCASE_UNUSED const runtime_shape_t &out_strides, bool input_nhwc, bool output_nhwc,
+    bool swap_rb, const quant_param_t &dequant, int32_t resize_h, int32_t resize_w, const runtime_paddings_t &paddings, float pad_value,
+    const float *mean, const float *std, kernel_context &context) noexcept
+{
+    switch (type)
+    {
+    case dt_uint8:
+        PREPROCESS_IMPL(uint8_t);
+    case dt_int8:
+        PREPROCESS_IMPL(int8_t);
+    case dt_float32:
+        PREPROCESS_IMPL(float);
+    default:
+        return err(std::errc::not_supported);
+    }
+}
@@ -24,6 +24,9 @@ using namespace nncase::kernels::cpu::optimized;
 
 namespace impl
 {
+// Rows longer than this are split so a single large tensor still spreads over the threads
+constexpr size_t chunk_size = 16384;
+
 #if __riscv
 template <class TQ>
 void riscv_quantize(const float *CXX_RESTRICT input, TQ *CXX_RESTRICT output, size_t count, float scale, float bias)
@@ -56,32 +59,64 @@ void riscv_quantize(const float *CXX_RESTRICT input, TQ *CXX_RESTRICT output, si
 #endif
 
 template <class TQ>
-result<void> quantize(const float *CXX_RESTRICT input, TQ *CXX_RESTRICT output, size_t count, float scale, float bias)
+void quantize_contiguous(const float *CXX_RESTRICT input, TQ *CXX_RESTRICT output, size_t count, float scale, float bias)
 {
 #if __riscv
     riscv_quantize(input, output, count, scale, bias);
 #else
+    // Clamp first (NaN becomes 0), then round to nearest even by adding and removing 1.5 * 2^23, both steps vectorize
+    constexpr float round_magic = 12582912.f;
+    constexpr auto lo = (float)std::numeric_limits<TQ>::lowest();
+    constexpr auto hi = (float)std::numeric_limits<TQ>::max();
     for (size_t i = 0; i < count; i++)
     {
-        auto qvalue = (int32_t)std::nearbyintf(input[i] * scale + bias);
-        output[i] = (TQ)kernels::detail::clamp(qvalue, (int32_t)std::numeric_limits<TQ>::lowest(), (int32_t)std::numeric_limits<TQ>::max());
+        auto value = input[i] * scale + bias;
+        value = value != value ? 0.f : value;
+        value = value > lo ? value : lo;
+        value = value < hi ? value : hi;
+        output[i] = (TQ)(int32_t)((value + round_magic) - round_magic);
     }
 #endif
+}
+
+template <class TQ>
+result<void> quantize(const float *input, TQ *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &out_strides, float scale, float bias, NNCASE_UNUSED kernel_context &context)
+{
+    size_t outer_dims, row_size;
+    if (!kernels::detail::get_contiguous_rows(in_shape, in_strides, out_strides, outer_dims, row_size))
+        return err(std::errc::not_supported);
+
+    const auto rows = row_size ? compute_size(in_shape) / row_size : 0;
+    const auto chunks = (row_size + chunk_size - 1) / chunk_size;
+    const auto tasks = rows * chunks;
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(std::max<size_t>(1, std::min<size_t>(context.num_threads, tasks))) schedule(static)
+#endif
+    for (size_t t = 0; t < tasks; t++)
+    {
+        size_t in_offset, out_offset;
+        kernels::detail::get_row_offsets(t / chunks, in_shape, outer_dims, in_strides, out_strides, in_offset, out_offset);
+        const auto begin = t % chunks * chunk_size;
+        quantize_contiguous(input + in_offset + begin, output + out_offset + begin, std::min(chunk_size, row_size - begin), scale, bias);
+    }
+
     return ok();
 }
 
 } // namespace impl
 
-#define QUANTIZE_IMPL(float_t, qint_t)                                                                                                            \
-    if (in_type == to_datatype<float_t>() && out_type == to_datatype<qint_t>())                                                                   \
-    {                                                                                                                                             \
-        return impl::quantize(reinterpret_cast<const float_t *>(input), reinterpret_cast<qint_t *>(output), compute_size(in_shape), scale, bias); \
+#define QUANTIZE_IMPL(float_t, qint_t)                                                                                                                      \
+    if (in_type == to_datatype<float_t>() && out_type == to_datatype<qint_t>())                                                                             \
+    {                                                                                                                                                       \
+        return impl::quantize(reinterpret_cast<const float_t *>(input), reinterpret_cast<qint_t *>(output), in_shape, in_strides, out_strides, scale, bias, \
+            context);                                                                                                                                       \
     }
 
 result<void> optimized::quantize(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
-    const runtime_shape_t &in_shape, NNCASE_UNUSED const runtime_shape_t &in_strides, NNCASE_UNUSED const runtime_shape_t &out_strides, float scale, float bias, NNCASE_UNUSED kernel_context &context) noexcept
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, float scale, float bias, kernel_context &context) noexcept
 {
     QUANTIZE_IMPL(float, uint8_t)
     QUANTIZE_IMPL(float, int8_t)
     return err(std::errc::not_supported);
-}
\ No newline at end of file
+}
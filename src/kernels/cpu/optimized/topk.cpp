@@ -0,0 +1,200 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+#ifdef NNCASE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+// Rows scanned with a bounded heap when k is at most 1/8 of the axis, fully selected otherwise
+constexpr size_t heap_k_ratio = 8;
+constexpr size_t filter_chunk = 16;
+
+template <class T>
+struct topk_entry
+{
+    T value;
+    int64_t index;
+};
+
+template <bool Largest, class T>
+bool beats(T value, T threshold) noexcept
+{
+    return Largest ? value > threshold : value < threshold;
+}
+
+// Strict weak order putting the best entry first; ties go to the lower index
+template <bool Largest, class T>
+struct better
+{
+    bool operator()(const topk_entry<T> &a, const topk_entry<T> &b) const noexcept
+    {
+        return beats<Largest>(a.value, b.value) || (a.value == b.value && a.index < b.index);
+    }
+};
+
+// Replaces the worst entry (heap top) and restores the heap property
+template <bool Largest, class T>
+void replace_top(topk_entry<T> *heap, size_t k, topk_entry<T> entry) noexcept
+{
+    better<Largest, T> comp;
+    size_t i = 0;
+    while (true)
+    {
+        auto child = i * 2 + 1;
+        if (child >= k)
+            break;
+        if (child + 1 < k && comp(heap[child], heap[child + 1]))
+            child++;
+        if (!comp(entry, heap[child]))
+            break;
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = entry;
+}
+
+template <bool Largest, size_t Stride, class T>
+void heap_select(const T *row, size_t stride, size_t n, size_t k, topk_entry<T> *heap) noexcept
+{
+    better<Largest, T> comp;
+    auto at = [&](size_t i) { return row[i * (Stride ? Stride : stride)]; };
+
+    for (size_t i = 0; i < k; i++)
+        heap[i] = { at(i), (int64_t)i };
+    std::make_heap(heap, heap + k, comp);
+
+    auto threshold = heap[0].value;
+    size_t i = k;
+    for (; i + filter_chunk <= n; i += filter_chunk)
+    {
+        // Most chunks hold no candidate once the heap has warmed up; this test vectorizes
+        bool any = false;
+        for (size_t j = 0; j < filter_chunk; j++)
+            any |= beats<Largest>(at(i + j), threshold);
+        if (!any)
+            continue;
+
+        for (size_t j = 0; j < filter_chunk; j++)
+        {
+            auto value = at(i + j);
+            if (beats<Largest>(value, heap[0].value))
+                replace_top<Largest>(heap, k, { value, int64_t(i + j) });
+        }
+        threshold = heap[0].value;
+    }
+
+    for (; i < n; i++)
+    {
+        auto value = at(i);
+        if (beats<Largest>(value, heap[0].value))
+            replace_top<Largest>(heap, k, { value, (int64_t)i });
+    }
+}
+
+template <bool Largest, class T>
+void topk_row(const T *row, size_t stride, size_t n, size_t k, bool sorted, topk_entry<T> *buffer) noexcept
+{
+    better<Largest, T> comp;
+    if (k * heap_k_ratio <= n)
+    {
+        if (stride == 1)
+            heap_select<Largest, 1>(row, stride, n, k, buffer);
+        else
+            heap_select<Largest, 0>(row, stride, n, k, buffer);
+        if (sorted)
+            std::sort_heap(buffer, buffer + k, comp);
+    }
+    else
+    {
+        for (size_t i = 0; i < n; i++)
+            buffer[i] = { row[i * stride], (int64_t)i };
+        if (k < n)
+            std::nth_element(buffer, buffer + k - 1, buffer + n, comp);
+        if (sorted)
+            std::sort(buffer, buffer + k, comp);
+    }
+}
+}
+
+template result<void> optimized::topk<float>(const float *input, float *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, const int64_t k, const int32_t axis, const bool largest, const bool sorted,
+    kernel_context &context) noexcept;
+
+template <typename T>
+result<void> optimized::topk(const T *input, T *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, const int64_t k, const int32_t axis, const bool largest, const bool sorted,
+    NNCASE_UNUSED kernel_context &context) noexcept
+{
+    auto n = in_shape[axis];
+    if (k < 0 || (size_t)k > n)
+        return err(std::errc::invalid_argument);
+    if (k == 0)
+        return ok();
+
+    size_t outer = std::accumulate(in_shape.begin(), in_shape.begin() + axis, 1, std::multiplies<size_t> {});
+    size_t inner = std::accumulate(in_shape.begin() + axis + 1, in_shape.end(), 1, std::multiplies<size_t> {});
+    auto rows = outer * inner;
+    auto kk = (size_t)k;
+    auto capacity = kk * heap_k_ratio <= n ? kk : n;
+
+    // One buffer per thread, reused for every row it processes
+#ifdef NNCASE_OPENMP
+    auto threads = std::max<size_t>(1, std::min<size_t>(context.num_threads, rows));
+#else
+    size_t threads = 1;
+#endif
+    try_var(buffer, scratch_buffer<topk_entry<T>>::allocate(context, threads * capacity));
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(threads) schedule(static)
+#endif
+    for (size_t r = 0; r < rows; r++)
+    {
+#ifdef NNCASE_OPENMP
+        auto row_buffer = buffer.data() + omp_get_thread_num() * capacity;
+#else
+        auto row_buffer = buffer.data();
+#endif
+        auto o = r / inner;
+        auto i = r % inner;
+        auto row = input + o * n * inner + i;
+        if (largest)
+            topk_row<true>(row, inner, n, kk, sorted, row_buffer);
+        else
+            topk_row<false>(row, inner, n, kk, sorted, row_buffer);
+
+        auto out_values = output_values + o * kk * inner + i;
+        auto out_indices = output_indices + o * kk * inner + i;
+        for (size_t j = 0; j < kk; j++)
+        {
+            out_values[j * inner] = row_buffer[j].value;
+            out_indices[j * inner] = row_buffer[j].index;
+        }
+    }
+
+    return ok();
+}
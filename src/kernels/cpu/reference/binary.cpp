@@ -25,8 +25,8 @@ using namespace nncase::kernels::cpu::reference;
 
 namespace
 {
-template <class TOp>
-result<void> binary_impl(TOp &&op, const float *input_a, const float *input_b, float *output,
+template <class T, class TOp>
+result<void> binary_impl(TOp &&op, const T *input_a, const T *input_b, T *output,
     const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
     const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, value_range<float> fused_activation, NNCASE_UNUSED kernel_context &context) noexcept
 {
@@ -34,9 +34,9 @@ result<void> binary_impl(TOp &&op, const float *input_a, const float *input_b, f
     return apply(out_shape, [&](const runtime_shape_t &index) -> result<void> {
         const auto in_a_index = kernels::detail::get_reduced_offset(index, in_a_shape);
         const auto in_b_index = kernels::detail::get_reduced_offset(index, in_b_shape);
-        const auto a = input_a[offset(in_a_strides, in_a_index)];
-        const auto b = input_b[offset(in_b_strides, in_b_index)];
-        output[offset(out_strides, index)] = kernels::detail::apply_activation(op(a, b), fused_activation);
+        const auto a = (float)input_a[offset(in_a_strides, in_a_index)];
+        const auto b = (float)input_b[offset(in_b_strides, in_b_index)];
+        output[offset(out_strides, index)] = kernels::detail::from_float<T>(kernels::detail::apply_activation((float)op(a, b), fused_activation));
         return ok();
     });
 }
@@ -46,7 +46,18 @@ result<void> binary_impl(TOp &&op, const float *input_a, const float *input_b, f
     case op:                   \
         return binary_impl(funct, input_a, input_b, output, in_a_shape, in_a_strides, in_b_shape, in_b_strides, out_strides, fused_activation, context)
 
-result<void> reference::binary(binary_op_t op, const float *input_a, const float *input_b, float *output,
+template result<void> reference::binary<float>(binary_op_t op, const float *input_a, const float *input_b, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, value_range<float> fused_activation, kernel_context &context) noexcept;
+template result<void> reference::binary<half>(binary_op_t op, const half *input_a, const half *input_b, half *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, value_range<float> fused_activation, kernel_context &context) noexcept;
+template result<void> reference::binary<bfloat16>(binary_op_t op, const bfloat16 *input_a, const bfloat16 *input_b, bfloat16 *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, value_range<float> fused_activation, kernel_context &context) noexcept;
+
+template <class T>
+result<void> reference::binary(binary_op_t op, const T *input_a, const T *input_b, T *output,
     const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
     const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, value_range<float> fused_activation,
     NNCASE_UNUSED kernel_context &context) noexcept
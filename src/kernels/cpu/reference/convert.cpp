@@ -30,7 +30,10 @@ result<void> convert_impl(const TInput *input, TOutput *output, const runtime_sh
 {
     return apply(in_shape, [&](const runtime_shape_t &index) -> result<void> {
         auto value = input[offset(in_strides, index)];
-        output[offset(out_strides, index)] = static_cast<TOutput>(value);
+        if constexpr (std::is_integral_v<TOutput> && !std::is_integral_v<TInput>)
+            output[offset(out_strides, index)] = kernels::detail::saturate_cast<TOutput>((float)value);
+        else
+            output[offset(out_strides, index)] = static_cast<TOutput>(value);
         return ok();
     });
 }
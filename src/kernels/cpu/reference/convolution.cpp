@@ -21,7 +21,19 @@ using namespace nncase::kernels;
 using namespace nncase::kernels::cpu;
 using namespace nncase::kernels::cpu::reference;
 
-result<void> reference::conv2d(const float *input, const float *weights, const float *bias, float *output,
+#define CONV2D_INSTANCE(T)                                                                                                                         \
+    template result<void> reference::conv2d<T>(const T *input, const T *weights, const T *bias, T *output,                                          \
+        const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,      \
+        const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,               \
+        int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,           \
+        kernel_context &context) noexcept;
+
+CONV2D_INSTANCE(float)
+CONV2D_INSTANCE(half)
+CONV2D_INSTANCE(bfloat16)
+
+template <class T>
+result<void> reference::conv2d(const T *input, const T *weights, const T *bias, T *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
     const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
     int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,
@@ -59,7 +71,7 @@ result<void> reference::conv2d(const float *input, const float *weights, const f
                         const int32_t filter_y_end = (int32_t)std::min(filter_h, ((int32_t)in_shape[2] - in_y_origin + dilation_h - 1) / dilation_h);
                         const int32_t filter_x_start = (int32_t)std::max(0, (-in_x_origin + dilation_w - 1) / dilation_w);
                         const int32_t filter_x_end = (int32_t)std::min(filter_w, ((int32_t)in_shape[3] - in_x_origin + dilation_w - 1) / dilation_w);
-                        float value = bias[offset(bias_strides, bias_index)];
+                        auto value = (float)bias[offset(bias_strides, bias_index)];
 
                         for (size_t ic = 0; ic < g_ic; ic++)
                         {
@@ -82,7 +94,7 @@ result<void> reference::conv2d(const float *input, const float *weights, const f
                             }
                         }
 
-                        output[offset(out_strides, out_index)] = kernels::detail::apply_activation(value, fused_activation);
+                        output[offset(out_strides, out_index)] = kernels::detail::from_float<T>(kernels::detail::apply_activation(value, fused_activation));
                     }
                 }
             }
@@ -29,6 +29,10 @@ result<void> gather_impl(const T *input, T *output, const runtime_shape_t &in_sh
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const int32_t *indices, const runtime_shape_t &indices_shape, size_t axis,
     NNCASE_UNUSED kernel_context &context) noexcept
 {
+    auto axis_dim = in_shape[axis];
+    if (!kernels::detail::check_gather_indices(indices, compute_size(indices_shape), &axis_dim, 1))
+        return err(std::errc::result_out_of_range);
+
     return apply(out_shape, [&](const runtime_shape_t &out_index) -> result<void> {
         // select batch
         // [out_index.begin(), out_index.begin() + axis]
@@ -43,7 +47,7 @@ result<void> gather_impl(const T *input, T *output, const runtime_shape_t &in_sh
         runtime_shape_t indices_index(out_index.begin() + axis, out_index.begin() + axis + indices_shape.size());
         auto indices_offset = offset(get_default_strides(indices_shape), indices_index);
         // select sub block in dim axis
-        in_index[i_index] = indices[indices_offset];
+        in_index[i_index] = kernels::detail::normalize_gather_index(indices[indices_offset], axis_dim);
         ++i_index;
 
         // select position in sub block
@@ -24,44 +24,47 @@ using namespace nncase::kernels::cpu::reference;
 
 namespace
 {
+template <class Callable>
+result<void> apply_or_once(const runtime_shape_t &shape, Callable &&callable) noexcept
+{
+    if (shape.empty())
+        return callable(runtime_shape_t {});
+    return apply(shape, std::forward<Callable>(callable));
+}
+
 template <class T>
 result<void> gather_nd_impl(const T *input, T *output, const runtime_shape_t &in_shape, const runtime_shape_t &out_shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const int32_t *indices, const runtime_shape_t &indices_shape, size_t batch_dims,
     NNCASE_UNUSED kernel_context &context) noexcept
 {
-    return apply(out_shape, [&](const runtime_shape_t &out_index) -> result<void> {
-        size_t last_indices_index = indices_shape.size() - 1;
-        size_t i_index = 0, o_index = 0;
-        runtime_shape_t in_index(in_shape.size());
-        runtime_shape_t indices_index(indices_shape.size());
-        for (; i_index < batch_dims; i_index++, o_index++)
-        {
-            // 0-batch_dims
-            indices_index[i_index] = out_index[o_index];
-            in_index[i_index] = out_index[o_index];
-        }
-        for (; o_index < last_indices_index; ++o_index)
-        {
-            // batch_dims - last_indices
-            indices_index[o_index] = out_index[o_index];
-        }
+    size_t last_indices_index = indices_shape.size() - 1;
+    size_t indices_list_size = indices_shape[last_indices_index];
+    if (!kernels::detail::check_gather_indices(indices, compute_size(indices_shape), in_shape.data() + batch_dims, indices_list_size))
+        return err(std::errc::result_out_of_range);
 
-        auto indices_begin = indices + offset(get_default_strides(indices_shape), indices_index);
-        for (size_t i = 0; i < indices_shape[last_indices_index]; ++i_index, ++i)
-        {
-            // batch_dims-indices_last
-            in_index[i_index] = indices_begin[i];
-        }
+    // output = [batch dims, indices dims, block dims]; the index tuple is resolved once per row
+    runtime_shape_t row_shape(out_shape.begin(), out_shape.begin() + last_indices_index);
+    runtime_shape_t block_shape(out_shape.begin() + last_indices_index, out_shape.end());
+    runtime_shape_t in_block_strides(in_strides.begin() + batch_dims + indices_list_size, in_strides.end());
+    runtime_shape_t out_block_strides(out_strides.begin() + last_indices_index, out_strides.end());
+    auto indices_strides = get_default_strides(indices_shape);
 
-        // out last value is used in block
-        // in_shape == [s1 ...] and indices shape is [in_shape.size()], output size will be 1
-        // if not judge i_index, i_index will bigger than in_index.size()
-        for (; o_index < out_index.size() && i_index < in_index.size(); ++o_index, ++i_index)
+    return apply_or_once(row_shape, [&](const runtime_shape_t &row_index) -> result<void> {
+        size_t in_offset = 0, out_offset = 0, indices_offset = 0;
+        for (size_t i = 0; i < row_index.size(); i++)
         {
-            in_index[i_index] = out_index[o_index];
+            out_offset += row_index[i] * out_strides[i];
+            indices_offset += row_index[i] * indices_strides[i];
         }
-        output[offset(out_strides, out_index)] = input[offset(in_strides, in_index)];
-        return ok();
+        for (size_t i = 0; i < batch_dims; i++)
+            in_offset += row_index[i] * in_strides[i];
+        for (size_t k = 0; k < indices_list_size; k++)
+            in_offset += kernels::detail::normalize_gather_index(indices[indices_offset + k], in_shape[batch_dims + k]) * in_strides[batch_dims + k];
+
+        return apply_or_once(block_shape, [&](const runtime_shape_t &block_index) -> result<void> {
+            output[out_offset + offset(out_block_strides, block_index)] = input[in_offset + offset(in_block_strides, block_index)];
+            return ok();
+        });
     });
 }
 }
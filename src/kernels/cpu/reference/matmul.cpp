@@ -0,0 +1,66 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::reference;
+
+result<void> reference::matmul(const float *input_a, const float *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, bool transpose_a, bool transpose_b,
+    value_range<float> fused_activation, NNCASE_UNUSED kernel_context &context) noexcept
+{
+    runtime_shape_t out_shape;
+    if (!kernels::detail::get_matmul_output_shape(in_a_shape, in_b_shape, transpose_a, transpose_b, out_shape))
+        return err(std::errc::invalid_argument);
+
+    const auto a_rank = in_a_shape.size(), b_rank = in_b_shape.size(), out_rank = out_shape.size();
+    const auto m = out_shape[out_rank - 2];
+    const auto n = out_shape[out_rank - 1];
+    const auto k = in_a_shape[a_rank - (transpose_a ? 2 : 1)];
+    // Row/column strides of the matrices, transposes just swap them
+    const auto a_rs = in_a_strides[a_rank - (transpose_a ? 1 : 2)], a_cs = in_a_strides[a_rank - (transpose_a ? 2 : 1)];
+    const auto b_rs = in_b_strides[b_rank - (transpose_b ? 1 : 2)], b_cs = in_b_strides[b_rank - (transpose_b ? 2 : 1)];
+    const auto out_rs = out_strides[out_rank - 2], out_cs = out_strides[out_rank - 1];
+    const auto batches = m * n ? compute_size(out_shape) / (m * n) : 0;
+
+    for (size_t batch = 0; batch < batches; batch++)
+    {
+        size_t a_offset, b_offset, out_offset;
+        kernels::detail::get_matmul_batch_offsets(batch, out_shape, out_strides, in_a_shape, in_a_strides, in_b_shape, in_b_strides,
+            a_offset, b_offset, out_offset);
+        const auto a = input_a + a_offset;
+        const auto b = input_b + b_offset;
+        const auto out = output + out_offset;
+
+        for (size_t i = 0; i < m; i++)
+        {
+            for (size_t j = 0; j < n; j++)
+            {
+                auto value = bias ? bias[j] : 0.f;
+                for (size_t p = 0; p < k; p++)
+                    value += a[i * a_rs + p * a_cs] * b[p * b_rs + j * b_cs];
+                out[i * out_rs + j * out_cs] = kernels::detail::apply_activation(value, fused_activation);
+            }
+        }
+    }
+
+    return ok();
+}
@@ -152,26 +152,26 @@ result<void> reference::pad(datatype_t type, const gsl::byte *input, gsl::byte *
         auto out_shape = get_padded_shape(in_shape, padding_cfg);
         auto out_size = compute_size(out_shape);
         auto strides = get_default_strides(out_shape);
-        std::vector<uint8_t> v(out_size * unit, 0);
+        try_var(interior, scratch_buffer<uint8_t>::allocate(context, out_size * unit));
 
         switch (unit)
         {
         case 1:
         {
-            NNCASE_UNUSED auto ret = interior_pad_impl(reinterpret_cast<const uint8_t *>(input), reinterpret_cast<uint8_t *>(v.data()), in_shape, out_shape,
+            NNCASE_UNUSED auto ret = interior_pad_impl(reinterpret_cast<const uint8_t *>(input), reinterpret_cast<uint8_t *>(interior.data()), in_shape, out_shape,
                 in_strides, strides, padding_cfg, pad_value.as<uint8_t>(), context);
             break;
         }
 
         case 2:
         {
-            NNCASE_UNUSED auto ret = interior_pad_impl(reinterpret_cast<const uint16_t *>(input), reinterpret_cast<uint16_t *>(v.data()), in_shape, out_shape,
+            NNCASE_UNUSED auto ret = interior_pad_impl(reinterpret_cast<const uint16_t *>(input), reinterpret_cast<uint16_t *>(interior.data()), in_shape, out_shape,
                 in_strides, strides, padding_cfg, pad_value.as<uint16_t>(), context);
             break;
         }
         case 4:
         {
-            NNCASE_UNUSED auto ret = interior_pad_impl(reinterpret_cast<const uint32_t *>(input), reinterpret_cast<uint32_t *>(v.data()), in_shape, out_shape,
+            NNCASE_UNUSED auto ret = interior_pad_impl(reinterpret_cast<const uint32_t *>(input), reinterpret_cast<uint32_t *>(interior.data()), in_shape, out_shape,
                 in_strides, strides, padding_cfg, pad_value.as<uint32_t>(), context);
             break;
         }
@@ -190,15 +190,15 @@ result<void> reference::pad(datatype_t type, const gsl::byte *input, gsl::byte *
         switch (unit)
         {
         case 1:
-            return pad_impl(reinterpret_cast<const uint8_t *>(v.data()), reinterpret_cast<uint8_t *>(output), out_shape, out_shape2,
+            return pad_impl(reinterpret_cast<const uint8_t *>(interior.data()), reinterpret_cast<uint8_t *>(output), out_shape, out_shape2,
                 strides, out_strides, padding_cfg, mode, pad_value.as<uint8_t>(), context);
 
         case 2:
-            return pad_impl(reinterpret_cast<const uint16_t *>(v.data()), reinterpret_cast<uint16_t *>(output), out_shape, out_shape2,
+            return pad_impl(reinterpret_cast<const uint16_t *>(interior.data()), reinterpret_cast<uint16_t *>(output), out_shape, out_shape2,
                 strides, out_strides, padding_cfg, mode, pad_value.as<uint16_t>(), context);
 
         case 4:
-            return pad_impl(reinterpret_cast<const uint32_t *>(v.data()), reinterpret_cast<uint32_t *>(output), out_shape, out_shape2,
+            return pad_impl(reinterpret_cast<const uint32_t *>(interior.data()), reinterpret_cast<uint32_t *>(output), out_shape, out_shape2,
                 strides, out_strides, padding_cfg, mode, pad_value.as<uint32_t>(), context);
         default:
             return err(std::errc::not_supported);
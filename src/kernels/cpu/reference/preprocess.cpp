@@ -0,0 +1,115 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::reference;
+
+namespace
+{
+// Same steps as the unfused chain: dequantize, layout change, swap RB, bilinear letterbox resize, pad and normalize
+template <class T>
+result<void> preprocess_impl(const T *input, float *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &out_strides, bool input_nhwc, bool output_nhwc, bool swap_rb, const quant_param_t &dequant,
+    int32_t resize_h, int32_t resize_w, const runtime_paddings_t &paddings, float pad_value, const float *mean, const float *std,
+    NNCASE_UNUSED kernel_context &context) noexcept
+{
+    const runtime_shape_t nchw_shape = input_nhwc ? runtime_shape_t { in_shape[0], in_shape[3], in_shape[1], in_shape[2] } : in_shape;
+    const auto channels = nchw_shape[1];
+    const auto out_h = (size_t)(paddings[0].before + resize_h + paddings[0].after);
+    const auto out_w = (size_t)(paddings[1].before + resize_w + paddings[1].after);
+    auto scales = kernels::detail::get_resize_scales(nchw_shape, resize_h, resize_w, false);
+    auto height_scale = scales.first;
+    auto width_scale = scales.second;
+
+    runtime_shape_t in_index(4), out_index(4);
+    auto get_input = [&](size_t c, int32_t y, int32_t x) {
+        in_index[input_nhwc ? 3 : 1] = c;
+        in_index[input_nhwc ? 1 : 2] = y;
+        in_index[input_nhwc ? 2 : 3] = x;
+        return ((float)input[offset(in_strides, in_index)] - dequant.zero_point) * dequant.scale;
+    };
+
+    for (size_t batch = 0; batch < nchw_shape[0]; batch++)
+    {
+        in_index[0] = batch;
+        out_index[0] = batch;
+        for (size_t oc = 0; oc < channels; oc++)
+        {
+            auto ic = swap_rb && channels == 3 ? 2 - oc : oc;
+            out_index[output_nhwc ? 3 : 1] = oc;
+            for (size_t oy = 0; oy < out_h; oy++)
+            {
+                out_index[output_nhwc ? 1 : 2] = oy;
+                auto ry = (int32_t)oy - paddings[0].before;
+                for (size_t ox = 0; ox < out_w; ox++)
+                {
+                    out_index[output_nhwc ? 2 : 3] = ox;
+                    auto rx = (int32_t)ox - paddings[1].before;
+                    float value = pad_value;
+                    if (ry >= 0 && ry < resize_h && rx >= 0 && rx < resize_w)
+                    {
+                        float in_y, in_x;
+                        int32_t in_y0, in_y1, in_x0, in_x1;
+                        kernels::detail::set_resize_bilinear(ry, height_scale, true, nchw_shape[2], in_y, in_y0, in_y1);
+                        kernels::detail::set_resize_bilinear(rx, width_scale, true, nchw_shape[3], in_x, in_x0, in_x1);
+
+                        auto v0 = get_input(ic, in_y0, in_x0);
+                        auto v1 = get_input(ic, in_y1, in_x0);
+                        auto v2 = get_input(ic, in_y0, in_x1);
+                        auto v3 = get_input(ic, in_y1, in_x1);
+
+                        auto a0 = (1 - (in_y - in_y0)) * (1 - (in_x - in_x0));
+                        auto a1 = (in_y - in_y0) * (1 - (in_x - in_x0));
+                        auto a2 = (1 - (in_y - in_y0)) * (in_x - in_x0);
+                        auto a3 = (in_y - in_y0) * (in_x - in_x0);
+                        value = v0 * a0 + v1 * a1 + v2 * a2 + v3 * a3;
+                    }
+
+                    output[offset(out_strides, out_index)] = (value - mean[oc]) / std[oc];
+                }
+            }
+        }
+    }
+
+    return ok();
+}
+}
+
+#define PREPROCESS_IMPL(type)                                                                                           \
+    return preprocess_impl(reinterpret_cast<const type *>(input), output, in_shape, in_strides, out_strides, input_nhwc, \
+        output_nhwc, swap_rb, dequant, resize_h, resize_w, paddings, pad_value, mean, std, context)
+
+result<void> reference::preprocess(datatype_t type, const gsl::byte *input, float *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool input_nhwc, bool output_nhwc, bool swap_rb,
+    const quant_param_t &dequant, int32_t resize_h, int32_t resize_w, const runtime_paddings_t &paddings, float pad_value,
+    const float *mean, const float *std, kernel_context &context) noexcept
+{
+    switch (type)
+    {
+    case dt_uint8:
+        PREPROCESS_IMPL(uint8_t);
+    case dt_int8:
+        PREPROCESS_IMPL(int8_t);
+    case dt_float32:
+        PREPROCESS_IMPL(float);
+    default:
+        return err(std::errc::not_supported);
+    }
+}
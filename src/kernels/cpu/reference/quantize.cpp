@@ -30,7 +30,9 @@ result<void> quantize_impl(const TFloat *input, TQint *output, const runtime_sha
 {
     return apply(in_shape, [&](const runtime_shape_t &index) -> result<void> {
         auto value = (float)input[offset(in_strides, index)];
+        // Saturate before rounding, out of range floats do not fit lrintf's result and NaN becomes 0
         value = value * scale + bias;
+        value = std::isnan(value) ? 0.f : kernels::detail::clamp(value, (float)std::numeric_limits<TQint>::lowest(), (float)std::numeric_limits<TQint>::max());
         auto qvalue = (int32_t)lrintf(value);
         qvalue = kernels::detail::clamp(qvalue, (int32_t)std::numeric_limits<TQint>::lowest(), (int32_t)std::numeric_limits<TQint>::max());
         output[offset(out_strides, index)] = (TQint)qvalue;
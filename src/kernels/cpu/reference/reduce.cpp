@@ -34,8 +34,8 @@ struct identity
 };
 
 template <class TReducer, class TPostProcess>
-result<void> reduce_impl(TReducer &&reducer, TPostProcess &&post_process, float init_value, const float *input, float *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
-    const runtime_shape_t &in_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, bool keep_dims, NNCASE_UNUSED kernel_context &context) noexcept
+result<void> reduce_accumulate(TReducer &&reducer, TPostProcess &&post_process, float init_value, const float *input, float *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, bool keep_dims) noexcept
 {
     try_(apply(out_shape, [&](const runtime_shape_t &index) -> result<void> {
         output[offset(out_strides, index)] = init_value;
@@ -55,18 +55,59 @@ result<void> reduce_impl(TReducer &&reducer, TPostProcess &&post_process, float
     }));
     return ok();
 }
+
+template <class T, class TReducer, class TPostProcess>
+result<void> reduce_impl(TReducer &&reducer, TPostProcess &&post_process, float init_value, const T *input, T *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, bool keep_dims) noexcept
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        return reduce_accumulate(reducer, post_process, init_value, input, output, in_shape, axis, in_strides, out_shape, out_strides, keep_dims);
+    }
+    else
+    {
+        // 16bit floats are accumulated in float one output element at a time, widening the inputs on the fly
+        runtime_shape_t outer_shape(in_shape);
+        runtime_shape_t block_shape(in_shape.size(), 1);
+        for (auto a : axis)
+        {
+            outer_shape[a] = 1;
+            block_shape[a] = in_shape[a];
+        }
+
+        return reference::apply(outer_shape, [&](const runtime_shape_t &outer_index) -> result<void> {
+            const auto in_base = input + offset(in_strides, outer_index);
+            auto acc = init_value;
+            try_(reference::apply(block_shape, [&](const runtime_shape_t &block_index) -> result<void> {
+                acc = reducer(acc, (float)in_base[offset(in_strides, block_index)]);
+                return ok();
+            }));
+            const auto out_index = kernels::detail::get_reduced_offset(outer_index, axis, keep_dims);
+            output[offset(out_strides, out_index)] = kernels::detail::from_float<T>(post_process(acc));
+            return ok();
+        });
+    }
+}
 }
 
 #define REDUCE_IMPL(op, reducer, post_process) \
     case op:                                   \
-        return reduce_impl(reducer, post_process, init_value, input, output, in_shape, axis, in_strides, out_shape, out_strides, keep_dims, context)
+        return reduce_impl(reducer, post_process, init_value, input, output, in_shape, axis, in_strides, out_shape, out_strides, keep_dims)
 
 #define REDUCE_IMPL_NO_POST(op, reducer) \
     case op:                             \
-        return reduce_impl(reducer, identity<float>(), init_value, input, output, in_shape, axis, in_strides, out_shape, out_strides, keep_dims, context)
+        return reduce_impl(reducer, identity<float>(), init_value, input, output, in_shape, axis, in_strides, out_shape, out_strides, keep_dims)
 
-result<void> reference::reduce(reduce_op_t op, float init_value, const float *input, float *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
-    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool keep_dims, kernel_context &context) noexcept
+template result<void> reference::reduce<float>(reduce_op_t op, float init_value, const float *input, float *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool keep_dims, kernel_context &context) noexcept;
+template result<void> reference::reduce<half>(reduce_op_t op, float init_value, const half *input, half *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool keep_dims, kernel_context &context) noexcept;
+template result<void> reference::reduce<bfloat16>(reduce_op_t op, float init_value, const bfloat16 *input, bfloat16 *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool keep_dims, kernel_context &context) noexcept;
+
+template <class T>
+result<void> reference::reduce(reduce_op_t op, float init_value, const T *input, T *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool keep_dims, NNCASE_UNUSED kernel_context &context) noexcept
 {
     auto out_shape = kernels::detail::get_reduced_shape(in_shape, axis, keep_dims);
     switch (op)
@@ -31,12 +31,12 @@ result<void> reduce_arg_impl(TReducer &&reducer, float init_value,
     const float *input, TOutput *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &out_shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides,
-    const runtime_shape_t &axes, bool keep_dims, bool select_last_idx, NNCASE_UNUSED kernel_context &context) noexcept
+    const runtime_shape_t &axes, bool keep_dims, bool select_last_idx, kernel_context &context) noexcept
 {
     const float epsilon = 0.000001f;
 
     // init with init_value
-    std::unique_ptr<float[]> ptr(new float[compute_size(out_shape)]);
+    try_var(ptr, scratch_buffer<float>::allocate(context, compute_size(out_shape)));
     try_(apply(out_shape, [&](const runtime_shape_t &index) -> result<void> {
         ptr[offset(out_strides, index)] = init_value;
         return ok();
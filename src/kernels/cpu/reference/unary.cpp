@@ -24,13 +24,13 @@ using namespace nncase::kernels::cpu::reference;
 
 namespace
 {
-template <class TOp>
-result<void> unary_impl(TOp &&op, const float *input, float *output, const runtime_shape_t &shape,
+template <class T, class TOp>
+result<void> unary_impl(TOp &&op, const T *input, T *output, const runtime_shape_t &shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, NNCASE_UNUSED kernel_context &context) noexcept
 {
     return apply(shape, [&](const runtime_shape_t &index) -> result<void> {
-        const auto v = input[offset(in_strides, index)];
-        output[offset(out_strides, index)] = op(v);
+        const auto v = (float)input[offset(in_strides, index)];
+        output[offset(out_strides, index)] = kernels::detail::from_float<T>((float)op(v));
         return ok();
     });
 }
@@ -40,7 +40,15 @@ result<void> unary_impl(TOp &&op, const float *input, float *output, const runti
     case op:                  \
         return unary_impl(funct, input, output, shape, in_strides, out_strides, context)
 
-result<void> reference::unary(unary_op_t op, const float *input, float *output, const runtime_shape_t &shape,
+template result<void> reference::unary<float>(unary_op_t op, const float *input, float *output, const runtime_shape_t &shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context) noexcept;
+template result<void> reference::unary<half>(unary_op_t op, const half *input, half *output, const runtime_shape_t &shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context) noexcept;
+template result<void> reference::unary<bfloat16>(unary_op_t op, const bfloat16 *input, bfloat16 *output, const runtime_shape_t &shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context) noexcept;
+
+template <class T>
+result<void> reference::unary(unary_op_t op, const T *input, T *output, const runtime_shape_t &shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context) noexcept
 {
     switch (op)
@@ -13,12 +13,14 @@
  * limitations under the License.
  */
 #include <nncase/kernels/kernel_context.h>
+#include <nncase/runtime/allocator.h>
 #ifdef NNCASE_OPENMP
 #include <omp.h>
 #endif
 
 using namespace nncase;
 using namespace nncase::kernels;
+using namespace nncase::runtime;
 
 namespace
 {
@@ -42,3 +44,24 @@ kernel_context &kernels::default_kernel_context()
     static default_kernel_context_holder holder;
     return holder.ctx;
 }
+
+result<gsl::span<gsl::byte>> kernels::detail::allocate_scratch(allocation_tracker *allocator, size_t bytes) noexcept
+{
+    if (allocator)
+        return allocator->allocate(memory_category_t::scratch, bytes);
+    if (!bytes)
+        return ok(gsl::span<gsl::byte>());
+
+    auto ptr = new (std::nothrow) gsl::byte[bytes];
+    if (!ptr)
+        return err(std::errc::not_enough_memory);
+    return ok(gsl::span<gsl::byte>(ptr, bytes));
+}
+
+void kernels::detail::free_scratch(allocation_tracker *allocator, gsl::span<gsl::byte> buffer) noexcept
+{
+    if (allocator)
+        allocator->free(memory_category_t::scratch, buffer);
+    else
+        delete[] buffer.data();
+}
@@ -14,6 +14,7 @@
  */
 #include <nncase/kernels/cpu/optimized/tensor_compute.h>
 #include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
 #include <nncase/kernels/tensor_compute.h>
 #include <nncase/runtime/runtime_op_utility.h>
 
@@ -51,51 +52,63 @@ result<void> kernels::concat(datatype_t type, gsl::span<const gsl::byte *const>
 result<void> kernels::convert(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context) noexcept
 {
+    size_t outer_dims, row_size;
+    if (kernels::detail::get_contiguous_rows(in_shape, in_strides, out_strides, outer_dims, row_size))
+        return cpu::optimized::convert(in_type, out_type, input, output, in_shape, in_strides, out_strides, context);
     return cpu::reference::convert(in_type, out_type, input, output, in_shape, in_strides, out_strides, context);
 }
 
-result<void> kernels::copy(datatype_t type, const gsl::byte *src, gsl::byte *dest,
-    const runtime_shape_t &shape, const runtime_shape_t &src_strides, const runtime_shape_t &dest_strides, kernel_context &context) noexcept
+copy_plan kernels::plan_copy(const runtime_shape_t &shape, const runtime_shape_t &src_strides, const runtime_shape_t &dest_strides) noexcept
 {
     const auto default_strides = get_default_strides(shape);
-    auto src_dims_offset = get_last_not_contiguous_index(src_strides, default_strides);
-    auto dest_dims_offset = get_last_not_contiguous_index(dest_strides, default_strides);
-
     auto src_continuous = src_strides == default_strides;
     auto dest_continuous = dest_strides == default_strides;
-    if (!src_continuous && !dest_continuous)
+    if (src_continuous && dest_continuous)
+        return { true, copy_impl_select::all_contiguous, -1, "copy_contiguous" };
+
+    if (src_continuous)
     {
-        return cpu::reference::copy(type, src, dest, shape, src_strides, dest_strides, context);
+        auto dest_dims_offset = get_last_not_contiguous_index(dest_strides, default_strides);
+        if (dest_dims_offset < 5)
+            return { true, copy_impl_select::src_contiguous, dest_dims_offset, "copy_src_contiguous" };
     }
-    else
+    else if (dest_continuous)
     {
-        copy_impl_select select = copy_impl_select::all_contiguous;
-        int dims_offset = -1;
-        if (src_continuous && dest_continuous)
-        {
-            select = copy_impl_select::all_contiguous;
-            dims_offset = -1;
-        }
-        else if (src_continuous && dest_dims_offset < 5)
-        {
-            select = copy_impl_select::src_contiguous;
-            dims_offset = dest_dims_offset;
-        }
-        else if (dest_continuous && src_dims_offset < 5)
-        {
-            select = copy_impl_select::dest_contiguous;
-            dims_offset = src_dims_offset;
-        }
-        return cpu::optimized::copy(type, src, dest, shape, src_strides, dest_strides, dims_offset, select, context);
+        auto src_dims_offset = get_last_not_contiguous_index(src_strides, default_strides);
+        if (src_dims_offset < 5)
+            return { true, copy_impl_select::dest_contiguous, src_dims_offset, "copy_dest_contiguous" };
     }
+
+    return { false, copy_impl_select::all_contiguous, -1, "reference" };
+}
+
+std::vector<copy_plan> kernels::copy_candidates(const copy_plan &plan)
+{
+    if (!plan.optimized)
+        return { plan };
+    return { plan, copy_plan { false, copy_impl_select::all_contiguous, -1, "reference" } };
+}
+
+result<void> kernels::copy(datatype_t type, const gsl::byte *src, gsl::byte *dest,
+    const runtime_shape_t &shape, const runtime_shape_t &src_strides, const runtime_shape_t &dest_strides, kernel_context &context) noexcept
+{
+    return copy(type, src, dest, shape, src_strides, dest_strides, plan_copy(shape, src_strides, dest_strides), context);
+}
+
+result<void> kernels::copy(datatype_t type, const gsl::byte *src, gsl::byte *dest, const runtime_shape_t &shape, const runtime_shape_t &src_strides,
+    const runtime_shape_t &dest_strides, const copy_plan &plan, kernel_context &context) noexcept
+{
+    if (plan.optimized)
+        return cpu::optimized::copy(type, src, dest, shape, src_strides, dest_strides, plan.dims_offset, plan.impl_select, context);
+    return cpu::reference::copy(type, src, dest, shape, src_strides, dest_strides, context);
 }
 
 result<void> kernels::dequantize(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, float scale, float bias,
     kernel_context &context) noexcept
 {
-
-    if (is_contiguous(in_shape, in_strides) && is_contiguous(in_shape, out_strides))
+    size_t outer_dims, row_size;
+    if (kernels::detail::get_contiguous_rows(in_shape, in_strides, out_strides, outer_dims, row_size))
     {
         return cpu::optimized::dequantize(in_type, out_type, input, output, in_shape, in_strides, out_strides, scale, bias, context);
     }
@@ -108,6 +121,24 @@ result<void> kernels::lut1d(datatype_t type, const gsl::byte *input, const gsl::
     return cpu::reference::lut1d(type, input, table, output, shape, in_strides, out_strides, min, max);
 }
 
+result<void> kernels::matmul(const float *input_a, const float *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, bool transpose_a, bool transpose_b,
+    value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    // Inputs of any layout are packed by the blocked kernel, only the output has to be dense
+    runtime_shape_t out_shape;
+    if (kernels::detail::get_matmul_output_shape(in_a_shape, in_b_shape, transpose_a, transpose_b, out_shape)
+        && is_contiguous(out_shape, out_strides))
+    {
+        return cpu::optimized::matmul(input_a, input_b, bias, output, in_a_shape, in_a_strides, in_b_shape, in_b_strides,
+            out_strides, transpose_a, transpose_b, fused_activation, context);
+    }
+
+    return cpu::reference::matmul(input_a, input_b, bias, output, in_a_shape, in_a_strides, in_b_shape, in_b_strides,
+        out_strides, transpose_a, transpose_b, fused_activation, context);
+}
+
 result<void> kernels::onehot(datatype_t type, const int32_t *indices, gsl::byte *output, const runtime_shape_t &indices_shape, const runtime_shape_t &out_shape,
     const runtime_shape_t &out_strides, gsl::byte *depth, gsl::byte *off_value, gsl::byte *on_value, size_t axis, onehot_mode_t mode, kernel_context &context) noexcept
 {
@@ -125,6 +156,8 @@ result<void> kernels::pad(datatype_t type, const gsl::byte *input, gsl::byte *ou
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const runtime_paddings_t &paddings, pad_mode_t mode,
     const scalar &pad_value, kernel_context &context) noexcept
 {
+    if (kernels::detail::is_row_padding(in_shape, in_strides, out_strides, paddings))
+        return cpu::optimized::pad(type, input, output, in_shape, in_strides, out_strides, paddings, mode, pad_value, context);
     return cpu::reference::pad(type, input, output, in_shape, in_strides, out_strides, paddings, mode, pad_value, context);
 }
 
@@ -132,7 +165,8 @@ result<void> kernels::quantize(datatype_t in_type, datatype_t out_type, const gs
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, float scale, float bias,
     kernel_context &context) noexcept
 {
-    if (is_contiguous(in_shape, in_strides) && is_contiguous(in_shape, out_strides))
+    size_t outer_dims, row_size;
+    if (kernels::detail::get_contiguous_rows(in_shape, in_strides, out_strides, outer_dims, row_size))
     {
         return cpu::optimized::quantize(in_type, out_type, input, output, in_shape, in_strides, out_strides, scale, bias, context);
     }
@@ -145,7 +179,21 @@ result<void> kernels::transpose(datatype_t type, const gsl::byte *src, gsl::byte
     return cpu::reference::transpose(type, src, dest, in_shape, perm, in_strides, out_strides, context);
 }
 
-result<void> kernels::binary(binary_op_t op, const float *input_a, const float *input_b, float *output,
+template result<void> kernels::binary<float>(binary_op_t op, const float *input_a, const float *input_b, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, value_range<float> fused_activation,
+    kernel_context &context) noexcept;
+template result<void> kernels::binary<half>(binary_op_t op, const half *input_a, const half *input_b, half *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, value_range<float> fused_activation,
+    kernel_context &context) noexcept;
+template result<void> kernels::binary<bfloat16>(binary_op_t op, const bfloat16 *input_a, const bfloat16 *input_b, bfloat16 *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, value_range<float> fused_activation,
+    kernel_context &context) noexcept;
+
+template <class T>
+result<void> kernels::binary(binary_op_t op, const T *input_a, const T *input_b, T *output,
     const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
     const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, value_range<float> fused_activation,
     kernel_context &context) noexcept
@@ -153,13 +201,29 @@ result<void> kernels::binary(binary_op_t op, const float *input_a, const float *
     return cpu::reference::binary(op, input_a, input_b, output, in_a_shape, in_a_strides, in_b_shape, in_b_strides, out_strides, fused_activation, context);
 }
 
-result<void> kernels::unary(unary_op_t op, const float *input, float *output, const runtime_shape_t &shape,
+template result<void> kernels::unary<float>(unary_op_t op, const float *input, float *output, const runtime_shape_t &shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context) noexcept;
+template result<void> kernels::unary<half>(unary_op_t op, const half *input, half *output, const runtime_shape_t &shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context) noexcept;
+template result<void> kernels::unary<bfloat16>(unary_op_t op, const bfloat16 *input, bfloat16 *output, const runtime_shape_t &shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context) noexcept;
+
+template <class T>
+result<void> kernels::unary(unary_op_t op, const T *input, T *output, const runtime_shape_t &shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context) noexcept
 {
     return cpu::reference::unary(op, input, output, shape, in_strides, out_strides, context);
 }
 
-result<void> kernels::reduce(reduce_op_t op, float init_value, const float *input, float *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
+template result<void> kernels::reduce<float>(reduce_op_t op, float init_value, const float *input, float *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool keep_dims, kernel_context &context) noexcept;
+template result<void> kernels::reduce<half>(reduce_op_t op, float init_value, const half *input, half *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool keep_dims, kernel_context &context) noexcept;
+template result<void> kernels::reduce<bfloat16>(reduce_op_t op, float init_value, const bfloat16 *input, bfloat16 *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool keep_dims, kernel_context &context) noexcept;
+
+template <class T>
+result<void> kernels::reduce(reduce_op_t op, float init_value, const T *input, T *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool keep_dims, kernel_context &context) noexcept
 {
     return cpu::reference::reduce(op, init_value, input, output, in_shape, axis, in_strides, out_strides, keep_dims, context);
@@ -193,6 +257,23 @@ result<void> kernels::reduce_prod(const T *input, T *output, const runtime_shape
     return cpu::reference::reduce_prod(input, output, in_shape, in_strides, out_strides, axes, keep_dims);
 }
 
+result<void> kernels::preprocess(datatype_t type, const gsl::byte *input, float *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool input_nhwc, bool output_nhwc, bool swap_rb,
+    const quant_param_t &dequant, int32_t resize_h, int32_t resize_w, const runtime_paddings_t &paddings, float pad_value,
+    const float *mean, const float *std, kernel_context &context) noexcept
+{
+    auto channels = in_shape[input_nhwc ? 3 : 1];
+    auto out_h = (size_t)(paddings[0].before + resize_h + paddings[0].after);
+    auto out_w = (size_t)(paddings[1].before + resize_w + paddings[1].after);
+    auto out_shape = output_nhwc ? runtime_shape_t { in_shape[0], out_h, out_w, channels } : runtime_shape_t { in_shape[0], channels, out_h, out_w };
+    if (is_contiguous(in_shape, in_strides) && is_contiguous(out_shape, out_strides))
+        return cpu::optimized::preprocess(type, input, output, in_shape, in_strides, out_strides, input_nhwc, output_nhwc, swap_rb,
+            dequant, resize_h, resize_w, paddings, pad_value, mean, std, context);
+    else
+        return cpu::reference::preprocess(type, input, output, in_shape, in_strides, out_strides, input_nhwc, output_nhwc, swap_rb,
+            dequant, resize_h, resize_w, paddings, pad_value, mean, std, context);
+}
+
 #define DISPATCH_RESIZE(resize_fun)                                                                                                                          \
     runtime_shape_t out_shape { in_shape[0], in_shape[1], static_cast<size_t>(out_h), static_cast<size_t>(out_w) };                                          \
     if (is_contiguous(in_shape, in_strides) && is_contiguous(out_shape, out_strides))                                                                        \
@@ -320,15 +401,18 @@ template result<void> kernels::topk<float>(const float *input, float *output_val
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
     const runtime_shape_t &output_values_shape, const runtime_shape_t &output_values_strides,
     const runtime_shape_t &output_indices_shape, const runtime_shape_t &output_indices_strides,
-    const int64_t k, const int32_t axis, const bool largest, const bool sorted) noexcept;
+    const int64_t k, const int32_t axis, const bool largest, const bool sorted, kernel_context &context) noexcept;
 
 template <typename T>
 result<void> kernels::topk(const T *input, T *output_values, int64_t *output_indices,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
     const runtime_shape_t &output_values_shape, const runtime_shape_t &output_values_strides,
     const runtime_shape_t &output_indices_shape, const runtime_shape_t &output_indices_strides,
-    const int64_t k, const int32_t axis, const bool largest, const bool sorted) noexcept
+    const int64_t k, const int32_t axis, const bool largest, const bool sorted, kernel_context &context) noexcept
 {
+    if (is_contiguous(in_shape, in_strides) && is_contiguous(output_values_shape, output_values_strides)
+        && is_contiguous(output_indices_shape, output_indices_strides))
+        return cpu::optimized::topk(input, output_values, output_indices, in_shape, k, axis, largest, sorted, context);
     return cpu::reference::topk(input, output_values, output_indices, in_shape, in_strides, output_values_shape, output_values_strides,
         output_indices_shape, output_indices_strides, k, axis, largest, sorted);
 }
\ No newline at end of file
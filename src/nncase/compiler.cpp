@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 #include "nncase/ir/quantizer.h"
+#include <atomic>
+#include <exception>
 #include <fstream>
 #include <magic_enum.hpp>
 #include <nncase/codegen/model_builder.h>
@@ -21,15 +23,23 @@
 #include <nncase/importer/importer.h>
 #include <nncase/ir/debug.h>
 #include <nncase/ir/evaluator.h>
+#include <nncase/ir/ops/call.h>
+#include <nncase/ir/visitor.h>
 #include <nncase/kernels/neutral/neutral_kernels.h>
 #include <nncase/runtime/datatypes.h>
 #include <nncase/runtime/debug.h>
 #include <nncase/transforms/neutral/add_quant_motion.h>
+#include <nncase/transforms/neutral/fold_constant.h>
+#include <nncase/transforms/neutral/fold_convert.h>
+#include <nncase/transforms/neutral/fuse_pre_process.h>
+#include <nncase/transforms/neutral/lower_float_precision.h>
 #include <nncase/transforms/neutral/optimize_allocation.h>
 #include <nncase/transforms/neutral/optimize_benchmark.h>
 #include <nncase/transforms/neutral/post_process_transform.h>
 #include <nncase/transforms/neutral/pre_process_setting.h>
 #include <nncase/transforms/pass.h>
+#include <thread>
+#include <unordered_map>
 #include <variant>
 
 using namespace nncase;
@@ -53,6 +63,79 @@ static float cosine(float *v1, float *v2, size_t size)
 }
 namespace
 {
+// Runs fn on every item with up to num_threads workers, the first failure in item order is rethrown
+template <class T, class Callable>
+void parallel_for_each(std::span<T> items, size_t num_threads, Callable &&fn)
+{
+    num_threads = std::min(num_threads, items.size());
+    if (num_threads <= 1)
+    {
+        for (auto &item : items)
+            fn(item);
+        return;
+    }
+
+    std::atomic<size_t> next = 0;
+    std::vector<std::exception_ptr> errors(items.size());
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < num_threads; w++)
+    {
+        workers.emplace_back([&] {
+            for (size_t i; (i = next++) < items.size();)
+            {
+                try
+                {
+                    fn(items[i]);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            }
+        });
+    }
+
+    for (auto &worker : workers)
+        worker.join();
+    for (auto &error : errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+size_t call_depth(ir::graph &graph, std::unordered_map<ir::graph *, size_t> &depths)
+{
+    if (auto it = depths.find(&graph); it != depths.end())
+        return it->second;
+
+    size_t depth = 0;
+    auto visitor = ir::make_relay_ir_visitor([&](ir::node &node) {
+        if (auto c = ir::node_cast<ir::call>(node))
+            depth = std::max(depth, call_depth(c->target(), depths) + 1);
+    });
+    visitor.visit(graph);
+    return depths[&graph] = depth;
+}
+
+// Splits graphs into levels where every graph comes after the graphs it calls. Constant folding evaluates the callee
+// of a call node, so a callee must not be rewritten while its callers run, only graphs of one level run concurrently
+std::vector<std::vector<ir::graph *>> callees_first(std::span<ir::graph *const> graphs)
+{
+    std::unordered_map<ir::graph *, size_t> depths;
+    std::vector<std::vector<ir::graph *>> levels;
+    for (auto graph : graphs)
+    {
+        auto depth = call_depth(*graph, depths);
+        if (levels.size() <= depth)
+            levels.resize(depth + 1);
+        levels[depth].emplace_back(graph);
+    }
+
+    std::erase_if(levels, [](const std::vector<ir::graph *> &level) { return level.empty(); });
+    return levels;
+}
+
 calibrate_method to_calibrate_method(std::string name)
 {
     if (name == "no_clip")
@@ -129,16 +212,20 @@ public:
         graph_.name("main");
         if (!options.dump_dir.empty())
             std::filesystem::create_directories(options.dump_dir);
+        // Only the cpu runtime has 16bit kernels, other targets would get ops their modules cannot run
+        if (options.compute_type != "float32" && options.target != "cpu")
+            throw std::invalid_argument("Compute type " + options.compute_type + " is only supported by the cpu target");
         set_target(options.target);
     }
 
     nncase::target &target() noexcept override { return *target_; }
 
-#define BEGIN_IMPORT()                              \
-    std::cout << "1. Import graph..." << std::endl; \
-                                                    \
-    importer::import_options imp_options;           \
-    imp_options.output_arrays = options.output_arrays;
+#define BEGIN_IMPORT()                                 \
+    std::cout << "1. Import graph..." << std::endl;    \
+                                                       \
+    importer::import_options imp_options;              \
+    imp_options.output_arrays = options.output_arrays; \
+    imp_options.model_dir = options.model_dir;
 
 #define END_IMPORT()                                                  \
     if (compile_options_.dump_ir)                                     \
@@ -250,12 +337,8 @@ public:
             if (compile_options_.dump_quant_error)
             {
                 std::cout << "4.4. Evaluate quantized graph..." << std::endl;
-                char target_name[MAX_MODULE_TYPE_LENGTH];
-                memset(target_name, '\0', sizeof(target_name));
-                char *p = const_cast<char *>(compile_options_.target.c_str());
-                strcpy(target_name, p);
-                if (strcmp(target_name, "cpu"))
-                    graph_.set_module_type(to_module_type(target_name));
+                if (compile_options_.target != "cpu")
+                    graph_.set_module_type(target_module_type());
 
                 auto quant_evaluator = run_calibration(graph_, nncase::ir::eval_step::after_quant);
                 quantizer *quant_eval_quantizer = quant_evaluator.quantizer(graph_.module_type());
@@ -290,6 +373,21 @@ public:
                 if (compile_options_.dump_ir)
                     f.close();
             }
+            else if (compile_options_.dump_eval_profile)
+            {
+                std::cout << "4.4. Evaluate quantized graph..." << std::endl;
+                auto module_type = graph_.module_type();
+                if (compile_options_.target != "cpu")
+                    graph_.set_module_type(target_module_type());
+                run_calibration(graph_, nncase::ir::eval_step::after_quant);
+                graph_.set_module_type(module_type);
+            }
+        }
+
+        if (compile_options_.compute_type != "float32")
+        {
+            std::cout << "4.6. Lower float precision to " << compile_options_.compute_type << "..." << std::endl;
+            lower_float_precision(graph_);
         }
 
         std::cout << "5. Optimize target dependent after quantization..." << std::endl;
@@ -301,6 +399,9 @@ public:
 
         if (compile_options_.benchmark_only)
             optimize_benchmark(graph_);
+
+        if (compile_options_.dump_pass_profile)
+            dump_pass_profile();
     }
 
     ir::graph &graph(uint32_t stage) override
@@ -353,6 +454,9 @@ private:
     {
         target_ = plugin_loader::create_target(type);
         target_->options().is_fpga = compile_options_.is_fpga;
+        target_->options().max_batch = compile_options_.max_batch;
+        target_->options().compress_sections = compile_options_.compress_sections;
+        target_->options().share_constants = compile_options_.share_constants;
         target_->register_evaluator_ops();
     }
 
@@ -360,7 +464,10 @@ private:
     {
         using namespace ir::transforms;
         run_passes("pre_process", graph, [&]([[maybe_unused]] const module_type_t &module_type, ir::transforms::pass_manager &pmgr) { pmgr.add_pass<pre_process_transform>(
-                                                                                                                                          cmp_options.mean, cmp_options.std, cmp_options.input_range, cmp_options.input_shape, cmp_options.swapRB, input_layout_, cmp_options.input_type, cmp_options.quant_type, real_inlayout_, cmp_options.letterbox_value); });
+                                                                                                                                          cmp_options.mean, cmp_options.std, cmp_options.input_range, cmp_options.input_shape, cmp_options.swapRB, input_layout_, cmp_options.input_type, cmp_options.quant_type, real_inlayout_, cmp_options.letterbox_value);
+            // Other targets fold the normalize into their first conv2d, which needs the chain unfused
+            if (compile_options_.target == "cpu")
+                pmgr.add_pass<fuse_pre_process_transform>(); });
     }
     void post_process(ir::graph &graph, compile_options &cmp_options)
     {
@@ -439,11 +546,40 @@ private:
         run_passes("target_dep_after_quant", graph, [&](const module_type_t &module_type, ir::transforms::pass_manager &pmgr) { target_->register_target_dependent_after_quantization_passes(module_type, pmgr); });
     }
 
+    void lower_float_precision(ir::graph &graph)
+    {
+        using namespace ir::transforms;
+
+        auto float_type = parse_datatype_str(compile_options_.compute_type);
+        if (float_type != dt_float16 && float_type != dt_bfloat16)
+            throw std::invalid_argument("Unsupported compute type: " + compile_options_.compute_type);
+
+        run_passes("lower_float_precision", graph, [&]([[maybe_unused]] const module_type_t &module_type, ir::transforms::pass_manager &pmgr) {
+            transform_pass p("lower_float_precision");
+            p.emplace<lower_binary_float_precision_transform>(float_type);
+            p.emplace<lower_unary_float_precision_transform>(float_type);
+            p.emplace<lower_reduce_float_precision_transform>(float_type);
+            p.emplace<lower_conv2d_float_precision_transform>(float_type);
+            p.emplace<fold_convert_transform>();
+            p.emplace<fold_nop_convert_transform>();
+            p.emplace<fold_constant_transform>();
+            pmgr.add_pass(std::move(p));
+        });
+    }
+
     void add_quantize_annotation(ir::graph &graph)
     {
         run_passes("quantize_annotation", graph, [&](const module_type_t &module_type, ir::transforms::pass_manager &pmgr) { target_->register_quantize_annotation_passes(module_type, pmgr); });
     }
 
+    module_type_t target_module_type() const
+    {
+        char target_name[MAX_MODULE_TYPE_LENGTH];
+        memset(target_name, '\0', sizeof(target_name));
+        strcpy(target_name, compile_options_.target.c_str());
+        return to_module_type(target_name);
+    }
+
     void quantize_graph(ir::graph &graph, ir::evaluator &evaluator)
     {
         auto graph_runner = [&](ir::graph &graph) {
@@ -464,14 +600,35 @@ private:
             pmgr.quantizer(quant);
             if (compile_options_.dump_ir)
                 pmgr.dump_dir(compile_options_.dump_dir);
+            if (compile_options_.dump_pass_profile)
+                pmgr.profiler(&pass_profiler_);
             target_->register_quantize_passes(graph.module_type(), pmgr, parse_datatype_str(compile_options_.quant_type), compile_options_.w_quant_type, compile_options_.use_mse_quant_w);
             pmgr.run();
             dump_graph(graph, "quantize");
         };
 
-        graph_runner(graph);
+        std::vector<ir::graph *> graphs { &graph };
         for (auto &subgraph : graph.subgraphs())
-            graph_runner(*subgraph);
+            graphs.emplace_back(subgraph.get());
+
+        for (auto &level : callees_first(graphs))
+        {
+            // Graphs of one module type share its quantizer, so only different module types run concurrently
+            std::vector<std::vector<ir::graph *>> groups;
+            for (auto g : level)
+            {
+                auto it = std::find_if(groups.begin(), groups.end(), [&](const std::vector<ir::graph *> &group) { return group.front()->module_type() == g->module_type(); });
+                if (it != groups.end())
+                    it->emplace_back(g);
+                else
+                    groups.push_back({ g });
+            }
+
+            parallel_for_each(std::span(groups), compile_threads(), [&](const std::vector<ir::graph *> &group) {
+                for (auto g : group)
+                    graph_runner(*g);
+            });
+        }
     }
 
     ir::evaluator run_calibration(ir::graph &graph, eval_step step)
@@ -486,6 +643,9 @@ private:
 
         auto sched_result = sched.schedule(true);
         ir::evaluator evaluator(sched_result);
+        ir::evaluate_profiler profiler;
+        if (compile_options_.dump_eval_profile)
+            evaluator.profiler(&profiler);
 
         if (step != eval_step::after_import)
         {
@@ -515,6 +675,8 @@ private:
                     ds = std::make_unique<raw_dataset>(options.dataset, dataset_in_shape);
                 else
                     throw std::runtime_error("Invalid calibration dataset format: " + options.dataset_format);
+                ds->prefetch(std::thread::hardware_concurrency());
+                ds->cache_dir(options.dataset_cache);
 
                 auto in_type = graph.inputs()[0]->output().type();
                 switch (in_type)
@@ -552,6 +714,8 @@ private:
                     ds = std::make_unique<raw_dataset>(options.dataset, dataset_in_shape);
                 else
                     throw std::runtime_error("Invalid calibration dataset format: " + options.dataset_format);
+                ds->prefetch(std::thread::hardware_concurrency());
+                ds->cache_dir(options.dataset_cache);
 
                 auto in_type = graph.inputs()[0]->output().type();
                 switch (in_type)
@@ -576,9 +740,22 @@ private:
             }
         }
 
+        if (compile_options_.dump_eval_profile)
+        {
+            evaluator.profiler(nullptr);
+            dump_eval_profile(profiler, step);
+        }
+
         return evaluator;
     }
 
+    void dump_eval_profile(const ir::evaluate_profiler &profiler, eval_step step)
+    {
+        auto step_name = step == nncase::ir::eval_step::after_import ? "after_import" : (step == nncase::ir::eval_step::after_calib ? "after_calibration" : "after_quantize");
+        std::ofstream file(compile_options_.dump_dir / ("eval_profile_" + std::string(step_name) + ".txt"));
+        profiler.dump(file, ir::measure_machine_peak());
+    }
+
     template <class T, class TOpt>
     void run_calibration_eval(TOpt &options, dataset &dataset, ir::evaluator &evaluator, eval_step step)
     {
@@ -661,13 +838,24 @@ private:
             ir::transforms::pass_manager pmgr(graph, *target_);
             if (compile_options_.dump_ir)
                 pmgr.dump_dir(compile_options_.dump_dir);
+            if (compile_options_.dump_pass_profile)
+                pmgr.profiler(&pass_profiler_);
             register_passes(graph.module_type(), pmgr);
             pmgr.run();
             dump_graph(graph, name);
         };
 
-        for (auto graph : root_graph.reachable_graphs())
-            graph_runner(*graph);
+        // Passes only rewrite the graph they run on and only read the graphs it calls
+        for (auto &level : callees_first(root_graph.reachable_graphs()))
+            parallel_for_each(std::span(level), compile_threads(), [&](ir::graph *graph) { graph_runner(*graph); });
+    }
+
+    size_t compile_threads() const noexcept
+    {
+        // IR dumps are numbered in pass order and shared between graphs, keep them deterministic
+        if (compile_options_.dump_ir)
+            return 1;
+        return std::max(1u, compile_options_.compile_threads);
     }
 
     void dump_graph(ir::graph &graph, std::string_view prefix)
@@ -716,6 +904,14 @@ private:
         file << "TOTAL: " << format_size(total_usage) << std::endl;
     }
 
+    void dump_pass_profile()
+    {
+        std::ofstream table(compile_options_.dump_dir / "pass_profile.txt");
+        pass_profiler_.dump_table(table);
+        std::ofstream trace(compile_options_.dump_dir / "pass_profile.json");
+        pass_profiler_.dump_trace(trace);
+    }
+
     size_t dump_memory_usage(codegen::model_builder &mod_builder, memory_location_t location, std::string_view name)
     {
         auto usage = mod_builder.max_usage(location);
@@ -731,6 +927,7 @@ private:
     std::variant<dump_range_dataset_options, dump_range_tensor_options> dump_range_options_;
     bool use_ptq_ = false;
     std::unique_ptr<nncase::target> target_;
+    ir::transforms::pass_profiler pass_profiler_;
     std::string real_inlayout_ = "";
     std::string real_outlayout_ = "";
 };
@@ -0,0 +1,149 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace nncase
+{
+template <class T>
+class blocking_queue
+{
+public:
+    explicit blocking_queue(size_t capacity)
+        : capacity_(capacity)
+    {
+    }
+
+    // Returns false if the queue has been closed
+    bool push(T value)
+    {
+        std::unique_lock<std::mutex> lock(lock_);
+        not_full_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+        if (closed_)
+            return false;
+        items_.push_back(std::move(value));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // Returns nullopt once the queue is closed and drained
+    std::optional<T> pop()
+    {
+        std::unique_lock<std::mutex> lock(lock_);
+        not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+        if (items_.empty())
+            return std::nullopt;
+        auto value = std::move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return value;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        closed_ = true;
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+private:
+    size_t capacity_;
+    std::mutex lock_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    std::deque<T> items_;
+    bool closed_ = false;
+};
+
+/**
+ * @brief Runs a producer, a pool of workers and a single writer connected by bounded queues.
+ *
+ * produce(push) runs on the calling thread and feeds inputs until push returns false.
+ * work(worker, input, emit) runs on the worker threads, emit passes outputs to write on the writer thread.
+ * The first exception thrown on any thread closes both queues and is rethrown once every thread has stopped.
+ */
+template <class TIn, class TOut, class TProduce, class TWork, class TWrite>
+void run_pipeline(size_t workers, size_t in_capacity, size_t out_capacity, TProduce &&produce, TWork &&work, TWrite &&write)
+{
+    blocking_queue<TIn> inputs(in_capacity);
+    blocking_queue<TOut> outputs(out_capacity);
+    std::mutex error_lock;
+    std::exception_ptr error;
+
+    auto fail = [&](std::exception_ptr e) {
+        {
+            std::lock_guard<std::mutex> lock(error_lock);
+            if (!error)
+                error = e;
+        }
+        inputs.close();
+        outputs.close();
+    };
+
+    std::thread writer([&] {
+        try
+        {
+            while (auto output = outputs.pop())
+                write(*output);
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        }
+    });
+
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < workers; w++)
+    {
+        threads.emplace_back([&, w] {
+            try
+            {
+                auto emit = [&](TOut output) { return outputs.push(std::move(output)); };
+                while (auto input = inputs.pop())
+                    work(w, *input, emit);
+            }
+            catch (...)
+            {
+                fail(std::current_exception());
+            }
+        });
+    }
+
+    try
+    {
+        produce([&](TIn input) { return inputs.push(std::move(input)); });
+    }
+    catch (...)
+    {
+        fail(std::current_exception());
+    }
+
+    inputs.close();
+    for (auto &thread : threads)
+        thread.join();
+    outputs.close();
+    writer.join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+}
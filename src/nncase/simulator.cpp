@@ -12,14 +12,20 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "pipeline.h"
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <iostream>
 #include <magic_enum.hpp>
+#include <mutex>
 #include <nncase/data/dataset.h>
 #include <nncase/io_utils.h>
 #include <nncase/ir/debug.h>
 #include <nncase/runtime/debug.h>
 #include <nncase/runtime/interpreter.h>
 #include <nncase/simulator.h>
+#include <thread>
 
 using namespace nncase;
 using namespace nncase::data;
@@ -27,24 +33,38 @@ using namespace nncase::runtime;
 
 namespace
 {
+struct sample_output
+{
+    std::filesystem::path filename;
+    std::vector<uint8_t> data;
+};
+
 class simulator_impl : public simulator
 {
 public:
     simulator_impl(std::vector<uint8_t> model, const simulate_options &options)
         : model_(std::move(model)), options_(options)
     {
-        interp_.load_model(gsl::as_bytes(gsl::make_span(model_))).unwrap_or_throw();
+        // All interpreters share the model bytes
+        interps_.resize(std::max(options_.workers, (size_t)1));
+        for (auto &interp : interps_)
+        {
+            interp = std::make_unique<interpreter>();
+            interp->load_model(gsl::as_bytes(gsl::make_span(model_))).unwrap_or_throw();
+            interp->concurrent_calls(options_.concurrent_calls).unwrap_or_throw();
+        }
     }
 
-    void run() override
+    simulate_stats run() override
     {
         if (!std::filesystem::exists(options_.output_path))
             std::filesystem::create_directories(options_.output_path);
 
-        if (interp_.inputs_size() != 1)
+        auto &interp = *interps_[0];
+        if (interp.inputs_size() != 1)
             throw std::invalid_argument("Simulator only support models that have single 1 input");
 
-        auto &in_shape = interp_.input_shape(0);
+        auto &in_shape = interp.input_shape(0);
         xt::dynamic_shape<size_t> dataset_in_shape(in_shape.begin(), in_shape.end());
         std::unique_ptr<dataset> ds;
         if (options_.dataset_format == "image")
@@ -54,18 +74,20 @@ public:
         else
             throw std::runtime_error("Invalid dataset format: " + options_.dataset_format);
 
-        auto in_type = interp_.input_desc(0).datatype;
+        // Models compiled with a max batch run the dataset in batches of that size
+        ds->batch_size(interp.max_batch());
+        ds->prefetch(std::thread::hardware_concurrency());
+        ds->cache_dir(options_.dataset_cache);
+
+        auto in_type = interp.input_desc(0).datatype;
         switch (in_type)
         {
         case dt_float32:
-            eval<float>(*ds);
-            break;
+            return eval<float>(*ds);
         case dt_uint8:
-            eval<uint8_t>(*ds);
-            break;
+            return eval<uint8_t>(*ds);
         case dt_int8:
-            eval<int8_t>(*ds);
-            break;
+            return eval<int8_t>(*ds);
         default:
             throw std::runtime_error("Unsupported input datatype: " + std::string(datatype_names(in_type)));
         }
@@ -73,48 +95,114 @@ public:
 
 private:
     template <class T>
-    void eval(dataset &dataset)
+    simulate_stats eval(dataset &dataset)
     {
-        size_t i = 0;
-        for (auto it = dataset.begin<T>(); it != dataset.end<T>(); ++it)
-        {
-            {
-                auto input_tensor = interp_.input_tensor(0).unwrap();
-                auto input_map = std::move(hrt::map(input_tensor, hrt::map_write).unwrap());
-                auto input_buffer = input_map.buffer();
-                auto &tensor = it->tensor;
-                std::memcpy(input_buffer.data(), tensor.data(), input_buffer.size_bytes());
-            }
+        // Batches are sharded to the interpreters through a queue, outputs are written by a single writer thread
+        std::vector<std::vector<double>> latencies(interps_.size());
+        std::mutex log_lock;
+        size_t written = 0;
 
-            auto r = interp_.run();
-            if (r.is_ok())
-            {
-                std::filesystem::path out_filename(options_.output_path / it->filenames[0].filename());
-                out_filename.replace_extension(".bin");
-
-                std::ofstream of(out_filename, std::ios::binary | std::ios::out);
-                for (size_t i = 0; i < interp_.outputs_size(); i++)
+        auto start = std::chrono::steady_clock::now();
+        run_pipeline<data_batch<T>, sample_output>(
+            interps_.size(), interps_.size() * 2, interps_.size() * dataset.batch_size() * 4,
+            [&](auto &&push) {
+                for (auto it = dataset.begin<T>(); it != dataset.end<T>(); ++it)
                 {
-                    auto output_tensor = interp_.output_tensor(i).unwrap();
-                    auto output_map = std::move(hrt::map(output_tensor, hrt::map_read).unwrap());
-                    auto output_buffer = output_map.buffer();
-                    of.write(reinterpret_cast<const char *>(output_buffer.data()), output_buffer.size());
+                    if (!push(std::move(*it)))
+                        break;
                 }
-            }
-            else
+            },
+            [&](size_t worker, data_batch<T> &batch, auto &&emit) { eval_batch(*interps_[worker], batch, emit, latencies[worker], log_lock); },
+            [&](const sample_output &output) {
+                std::ofstream of(output.filename, std::ios::binary | std::ios::out);
+                of.write(reinterpret_cast<const char *>(output.data.data()), output.data.size());
+                if (options_.progress)
+                    options_.progress(written++, dataset.total_size());
+            });
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return make_stats(dataset.total_size(), elapsed, latencies);
+    }
+
+    template <class T, class TEmit>
+    void eval_batch(interpreter &interp, data_batch<T> &batch, TEmit &&emit, std::vector<double> &latencies, std::mutex &log_lock)
+    {
+        auto samples = batch.filenames.size();
+        interp.batch(samples).unwrap_or_throw();
+
+        {
+            auto input_tensor = interp.input_tensor(0).unwrap_or_throw();
+            auto input_map = std::move(hrt::map(input_tensor, hrt::map_write).unwrap_or_throw());
+            auto input_buffer = input_map.buffer();
+            std::memcpy(input_buffer.data(), batch.tensor.data(), input_buffer.size_bytes());
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto r = interp.run();
+        latencies.emplace_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        if (r.is_err())
+        {
+            std::lock_guard<std::mutex> lock(log_lock);
+            std::cerr << "Eval " << batch.filenames[0].filename() << " failed: " << r.unwrap_err().message() << std::endl;
+            return;
+        }
+
+        std::vector<sample_output> results(samples);
+        for (size_t s = 0; s < samples; s++)
+        {
+            results[s].filename = options_.output_path / batch.filenames[s].filename();
+            results[s].filename.replace_extension(".bin");
+        }
+
+        // Outputs are stacked on the batch dim, so each sample owns an equal slice of every output
+        for (size_t i = 0; i < interp.outputs_size(); i++)
+        {
+            auto output_tensor = interp.output_tensor(i).unwrap_or_throw();
+            auto output_map = std::move(hrt::map(output_tensor, hrt::map_read).unwrap_or_throw());
+            auto output_buffer = output_map.buffer();
+            auto sample_size = output_buffer.size() / samples;
+            for (size_t s = 0; s < samples; s++)
             {
-                std::cerr << "Eval " << it->filenames[0].filename() << " failed: " << r.unwrap_err().message() << std::endl;
+                auto begin = reinterpret_cast<const uint8_t *>(output_buffer.data()) + s * sample_size;
+                results[s].data.insert(results[s].data.end(), begin, begin + sample_size);
             }
+        }
 
-            if (options_.progress)
-                options_.progress(i, dataset.total_size());
+        for (auto &result : results)
+        {
+            if (!emit(std::move(result)))
+                break;
+        }
+    }
+
+    simulate_stats make_stats(size_t samples, double elapsed, const std::vector<std::vector<double>> &worker_latencies)
+    {
+        simulate_stats stats;
+        stats.samples = samples;
+        stats.workers = interps_.size();
+        stats.batch_size = interps_[0]->max_batch();
+        stats.elapsed_seconds = elapsed;
+        stats.memory = interps_[0]->memory_stats().unwrap_or_throw().usage;
+
+        std::vector<double> latencies;
+        for (auto &l : worker_latencies)
+            latencies.insert(latencies.end(), l.begin(), l.end());
+        if (!latencies.empty())
+        {
+            std::sort(latencies.begin(), latencies.end());
+            auto percentile = [&](double p) { return latencies[std::min(latencies.size() - 1, (size_t)(p / 100 * latencies.size()))]; };
+            stats.latency_p50_ms = percentile(50);
+            stats.latency_p90_ms = percentile(90);
+            stats.latency_p99_ms = percentile(99);
+            stats.latency_max_ms = latencies.back();
         }
+
+        return stats;
     }
 
 private:
     std::vector<uint8_t> model_;
     simulate_options options_;
-    interpreter interp_;
+    std::vector<std::unique_ptr<interpreter>> interps_;
 };
 }
 
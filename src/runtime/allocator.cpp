@@ -13,10 +13,38 @@
  * limitations under the License.
  */
 #include <nncase/runtime/allocator.h>
+#include <nncase/runtime/dbg.h>
 
 using namespace nncase;
 using namespace nncase::runtime;
 
+namespace
+{
+class default_host_allocator_impl : public host_allocator
+{
+public:
+    gsl::span<gsl::byte> allocate(NNCASE_UNUSED allocation_state &state, size_t bytes) override
+    {
+        auto ptr = new (std::nothrow) gsl::byte[bytes];
+        if (!ptr)
+            return {};
+        return { ptr, bytes };
+    }
+
+    void free(NNCASE_UNUSED allocation_state &state, gsl::span<gsl::byte> buffer) noexcept override
+    {
+        delete[] buffer.data();
+    }
+};
+
+void update_peak(std::atomic<size_t> &peak, size_t value) noexcept
+{
+    auto old = peak.load(std::memory_order_relaxed);
+    while (value > old && !peak.compare_exchange_weak(old, value, std::memory_order_relaxed))
+        ;
+}
+}
+
 allocation_state::~allocation_state()
 {
 }
@@ -24,3 +52,86 @@ allocation_state::~allocation_state()
 host_allocator::~host_allocator()
 {
 }
+
+void host_allocator::free(NNCASE_UNUSED allocation_state &state, NNCASE_UNUSED gsl::span<gsl::byte> buffer) noexcept
+{
+}
+
+host_allocator &runtime::default_host_allocator() noexcept
+{
+    static default_host_allocator_impl allocator;
+    return allocator;
+}
+
+allocation_tracker::allocation_tracker(host_allocator &allocator) noexcept
+    : root_(*this), allocator_(allocator)
+{
+}
+
+allocation_tracker::allocation_tracker(std::shared_ptr<allocation_tracker> parent) noexcept
+    : parent_(std::move(parent)), root_(parent_->root_), allocator_(parent_->allocator_)
+{
+}
+
+result<gsl::span<gsl::byte>> allocation_tracker::allocate(memory_category_t category, size_t bytes) noexcept
+{
+    if (!bytes)
+        return ok(gsl::span<gsl::byte>());
+
+    gsl::span<gsl::byte> buffer;
+    try
+    {
+        buffer = allocator_.allocate(root_, bytes);
+    }
+    catch (...)
+    {
+    }
+
+    // The whole span is kept, the allocator gets back what it returned when it is freed
+    CHECK_WITH_ERR(buffer.size_bytes() >= bytes, std::errc::not_enough_memory);
+    for (auto tracker = this; tracker; tracker = tracker->parent_.get())
+        tracker->add(category, buffer.size_bytes());
+    return ok(buffer);
+}
+
+void allocation_tracker::free(memory_category_t category, gsl::span<gsl::byte> buffer) noexcept
+{
+    if (buffer.empty())
+        return;
+
+    allocator_.free(root_, buffer);
+    for (auto tracker = this; tracker; tracker = tracker->parent_.get())
+        tracker->sub(category, buffer.size_bytes());
+}
+
+result<allocation_tracker::buffer_t> allocation_tracker::allocate_buffer(memory_category_t category, size_t bytes) noexcept
+{
+    try_var(buffer, allocate(category, bytes));
+    return ok(buffer_t(buffer.data(), deleter { shared_from_this(), category, bytes, buffer.size_bytes() }));
+}
+
+memory_usage allocation_tracker::usage() const noexcept
+{
+    memory_usage usage;
+    usage.data_bytes = bytes_[(size_t)memory_category_t::data];
+    usage.section_bytes = bytes_[(size_t)memory_category_t::section];
+    usage.tensor_bytes = bytes_[(size_t)memory_category_t::tensor];
+    usage.scratch_bytes = bytes_[(size_t)memory_category_t::scratch];
+    usage.peak_scratch_bytes = peak_scratch_bytes_;
+    usage.peak_bytes = peak_bytes_;
+    return usage;
+}
+
+void allocation_tracker::add(memory_category_t category, size_t bytes) noexcept
+{
+    auto category_bytes = bytes_[(size_t)category].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (category == memory_category_t::scratch)
+        update_peak(peak_scratch_bytes_, category_bytes);
+    update_peak(peak_bytes_, total_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+}
+
+void allocation_tracker::sub(memory_category_t category, size_t bytes) noexcept
+{
+    bytes_[(size_t)category].fetch_sub(bytes, std::memory_order_relaxed);
+    total_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+}
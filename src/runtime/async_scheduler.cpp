@@ -0,0 +1,196 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <nncase/runtime/async_scheduler.h>
+#include <nncase/runtime/dbg.h>
+#include <thread>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+
+struct async_scheduler::state
+{
+    enum class task_stage
+    {
+        copy_inputs,
+        copy_outputs
+    };
+
+    struct copy_item
+    {
+        task_stage stage;
+        task t;
+    };
+
+    std::mutex lock;
+    std::condition_variable copy_cv;
+    std::condition_variable compute_cv;
+    std::condition_variable idle_cv;
+    std::deque<copy_item> copy_queue;
+    std::deque<task> compute_queue;
+    size_t in_flight = 0;
+    bool exit = false;
+    std::thread copy_thread;
+    std::vector<std::thread> compute_threads;
+
+    void copy_worker();
+    void compute_worker();
+    void complete(task &t, result<void> result);
+};
+
+async_scheduler::async_scheduler(size_t compute_workers)
+    : state_(std::make_unique<state>())
+{
+    auto &s = *state_;
+    s.copy_thread = std::thread([&s] { s.copy_worker(); });
+    s.compute_threads.reserve(std::max(compute_workers, (size_t)1));
+    for (size_t i = 0; i < std::max(compute_workers, (size_t)1); i++)
+        s.compute_threads.emplace_back([&s] { s.compute_worker(); });
+}
+
+async_scheduler::~async_scheduler()
+{
+    auto &s = *state_;
+    wait_idle();
+    {
+        std::lock_guard<std::mutex> lock(s.lock);
+        s.exit = true;
+    }
+
+    s.copy_cv.notify_all();
+    s.compute_cv.notify_all();
+    s.copy_thread.join();
+    for (auto &thread : s.compute_threads)
+        thread.join();
+}
+
+async_scheduler &async_scheduler::default_scheduler()
+{
+    static async_scheduler scheduler;
+    return scheduler;
+}
+
+result<void> async_scheduler::post(task t) noexcept
+{
+    CHECK_WITH_ERR(t.copy_inputs && t.compute && t.copy_outputs, std::errc::invalid_argument);
+    auto &s = *state_;
+    try
+    {
+        std::lock_guard<std::mutex> lock(s.lock);
+        s.copy_queue.push_back({ state::task_stage::copy_inputs, std::move(t) });
+        s.in_flight++;
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+
+    s.copy_cv.notify_one();
+    return ok();
+}
+
+void async_scheduler::wait_idle()
+{
+    auto &s = *state_;
+    std::unique_lock<std::mutex> lock(s.lock);
+    s.idle_cv.wait(lock, [&s] { return s.in_flight == 0; });
+}
+
+void async_scheduler::state::copy_worker()
+{
+    while (true)
+    {
+        copy_item item;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            copy_cv.wait(guard, [this] { return exit || !copy_queue.empty(); });
+            if (copy_queue.empty())
+                return;
+            item = std::move(copy_queue.front());
+            copy_queue.pop_front();
+        }
+
+        if (item.stage == task_stage::copy_inputs)
+        {
+            auto r = item.t.copy_inputs();
+            if (r.is_err())
+            {
+                complete(item.t, std::move(r));
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                compute_queue.push_back(std::move(item.t));
+            }
+            compute_cv.notify_one();
+        }
+        else
+        {
+            complete(item.t, item.t.copy_outputs());
+        }
+    }
+}
+
+void async_scheduler::state::compute_worker()
+{
+    while (true)
+    {
+        task t;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            compute_cv.wait(guard, [this] { return exit || !compute_queue.empty(); });
+            if (compute_queue.empty())
+                return;
+            t = std::move(compute_queue.front());
+            compute_queue.pop_front();
+        }
+
+        auto r = t.compute();
+        if (r.is_err())
+        {
+            complete(t, std::move(r));
+            continue;
+        }
+
+        {
+            // Outputs go first to release the finished sessions as soon as possible
+            std::lock_guard<std::mutex> guard(lock);
+            copy_queue.push_front({ task_stage::copy_outputs, std::move(t) });
+        }
+        copy_cv.notify_one();
+    }
+}
+
+void async_scheduler::state::complete(task &t, result<void> result)
+{
+    // The task leaves the scheduler before its callback runs, so a callback
+    // may wait for the scheduler to drain
+    bool idle;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        idle = --in_flight == 0;
+    }
+
+    if (idle)
+        idle_cv.notify_all();
+
+    if (t.callback)
+        t.callback(std::move(result));
+}
@@ -0,0 +1,179 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <nncase/runtime/constant_registry.h>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+
+namespace
+{
+struct registry_entry
+{
+    size_t size;
+    std::weak_ptr<const gsl::byte> block;
+};
+
+// Models may be loaded on several threads even without the async runtime, so the lock
+// is a spin lock on an atomic flag that needs no thread support from the platform.
+// It is only held to look up and update the entries
+class spin_lock
+{
+public:
+    void lock() noexcept
+    {
+        while (flag_.test_and_set(std::memory_order_acquire))
+            ;
+    }
+
+    void unlock() noexcept
+    {
+        flag_.clear(std::memory_order_release);
+    }
+
+private:
+    std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
+};
+
+struct registry_state
+{
+    spin_lock lock;
+    std::unordered_multimap<uint64_t, registry_entry> entries;
+    std::atomic<size_t> blocks = 0;
+    std::atomic<size_t> bytes = 0;
+    std::atomic<size_t> hits = 0;
+    std::atomic<size_t> misses = 0;
+};
+
+// Never destroyed, blocks may be released by modules destroyed at exit
+registry_state &state() noexcept
+{
+    static auto instance = new registry_state();
+    return *instance;
+}
+
+struct block_deleter
+{
+    size_t size;
+
+    void operator()(const gsl::byte *ptr) const noexcept
+    {
+        auto &s = state();
+        s.blocks--;
+        s.bytes -= size;
+        delete[] ptr;
+    }
+};
+
+result<constant_registry::block_t> create_block(gsl::span<const gsl::byte> data) noexcept
+{
+    auto ptr = new (std::nothrow) gsl::byte[data.size_bytes()];
+    if (!ptr)
+        return err(std::errc::not_enough_memory);
+    std::memcpy(ptr, data.data(), data.size_bytes());
+
+    try
+    {
+        constant_registry::block_t block(ptr, block_deleter { data.size_bytes() });
+        auto &s = state();
+        s.blocks++;
+        s.bytes += data.size_bytes();
+        return ok(std::move(block));
+    }
+    catch (...)
+    {
+        delete[] ptr;
+        return err(std::errc::not_enough_memory);
+    }
+}
+}
+
+result<constant_registry::block_t> constant_registry::acquire(uint64_t hash, gsl::span<const gsl::byte> data) noexcept
+{
+    auto &s = state();
+
+    // The lock only guards the entries, blocks are compared and created outside it. Entries added
+    // while it was released are compared on the next round before a new block is registered
+    try
+    {
+        std::vector<block_t> candidates, compared;
+        block_t created;
+        while (true)
+        {
+            {
+                std::lock_guard<spin_lock> lock(s.lock);
+
+                // Expired entries are removed when their hash is looked up again
+                auto range = s.entries.equal_range(hash);
+                for (auto it = range.first; it != range.second;)
+                {
+                    auto &entry = it->second;
+                    auto block = entry.block.lock();
+                    if (!block)
+                    {
+                        it = s.entries.erase(it);
+                        continue;
+                    }
+
+                    if (entry.size == data.size_bytes()
+                        && std::none_of(compared.begin(), compared.end(), [&](const block_t &b) { return b == block; }))
+                        candidates.emplace_back(std::move(block));
+                    ++it;
+                }
+
+                if (candidates.empty() && created)
+                {
+                    s.entries.emplace(hash, registry_entry { data.size_bytes(), created });
+                    s.misses++;
+                    return ok(std::move(created));
+                }
+            }
+
+            for (auto &block : candidates)
+            {
+                if (std::equal(data.begin(), data.end(), block.get()))
+                {
+                    s.hits++;
+                    return ok(std::move(block));
+                }
+            }
+
+            compared.insert(compared.end(), candidates.begin(), candidates.end());
+            candidates.clear();
+            if (!created)
+                try_set(created, create_block(data));
+        }
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+}
+
+constant_registry_stats constant_registry::stats() noexcept
+{
+    auto &s = state();
+    constant_registry_stats stats;
+    stats.blocks = s.blocks;
+    stats.bytes = s.bytes;
+    stats.hits = s.hits;
+    stats.misses = s.misses;
+    return stats;
+}
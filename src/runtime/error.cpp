@@ -48,6 +48,8 @@ public:
             return "Shape mismatch";
         case nncase_errc::invalid_memory_location:
             return "Invalid memory location";
+        case nncase_errc::invalid_section_data:
+            return "Invalid section data";
         case nncase_errc::stackvm_illegal_instruction:
             return "StackVM illegal instruction";
         case nncase_errc::stackvm_illegal_target:
@@ -14,6 +14,9 @@
  */
 #include <cassert>
 #include <iostream>
+#ifdef NNCASE_ASYNC_RUNTIME
+#include <nncase/runtime/async_scheduler.h>
+#endif
 #include <nncase/runtime/dbg.h>
 #include <nncase/runtime/error.h>
 #include <nncase/runtime/interpreter.h>
@@ -24,10 +27,17 @@ using namespace nncase;
 using namespace nncase::runtime;
 
 interpreter::interpreter() noexcept
-    : entry_function_(nullptr)
+    : entry_function_(nullptr), allocator_(&default_host_allocator()), concurrent_calls_(false), tuner_(nullptr)
 {
 }
 
+result<void> interpreter::allocator(host_allocator &allocator) noexcept
+{
+    CHECK_WITH_ERR(modules_.empty(), std::errc::operation_not_permitted);
+    allocator_ = &allocator;
+    return ok();
+}
+
 result<void> interpreter::load_model(gsl::span<const gsl::byte> buffer) noexcept
 {
     span_reader reader(buffer);
@@ -41,6 +51,7 @@ result<void> interpreter::load_model(gsl::span<const gsl::byte> buffer) noexcept
     // 2. Load modules
     try
     {
+        memory_tracker_ = std::make_shared<allocation_tracker>(*allocator_);
         modules_.resize(header->modules);
     }
     catch (...)
@@ -114,17 +125,122 @@ result<void> interpreter::output_tensor(size_t index, runtime_tensor tensor) noe
     return entry_function_->output_tensor(index, tensor);
 }
 
+size_t interpreter::max_batch() const noexcept
+{
+    return entry_function_->max_batch();
+}
+
+size_t interpreter::batch() const noexcept
+{
+    return entry_function_->batch();
+}
+
+result<void> interpreter::batch(size_t value) noexcept
+{
+    return entry_function_->batch(value);
+}
+
 result<void> interpreter::run() noexcept
 {
     return entry_function_->invoke();
 }
 
+result<void> interpreter::run_async(run_callback_t callback) noexcept
+{
+#ifdef NNCASE_ASYNC_RUNTIME
+    try
+    {
+        return run_async(async_scheduler::default_scheduler(), std::move(callback));
+    }
+    catch (...)
+    {
+        return err(std::errc::resource_unavailable_try_again);
+    }
+#else
+    return err(std::errc::not_supported);
+#endif
+}
+
+result<void> interpreter::run_async(NNCASE_UNUSED async_scheduler &scheduler, NNCASE_UNUSED run_callback_t callback) noexcept
+{
+#ifdef NNCASE_ASYNC_RUNTIME
+    auto func = entry_function_;
+    async_scheduler::task task;
+    try
+    {
+        task.copy_inputs = [=] { return func->copy_inputs(); };
+        task.compute = [=] { return func->compute(); };
+        task.copy_outputs = [=] { return func->copy_outputs(); };
+        task.callback = std::move(callback);
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+
+    return scheduler.post(std::move(task));
+#else
+    return err(std::errc::not_supported);
+#endif
+}
+
+kernel_tuner *interpreter::tuner() const noexcept
+{
+    return tuner_;
+}
+
+void interpreter::tuner(kernel_tuner *tuner) noexcept
+{
+    tuner_ = tuner;
+}
+
+bool interpreter::concurrent_calls() const noexcept
+{
+    return concurrent_calls_;
+}
+
+result<void> interpreter::concurrent_calls(NNCASE_UNUSED bool value) noexcept
+{
+#ifdef NNCASE_ASYNC_RUNTIME
+    concurrent_calls_ = value;
+    return ok();
+#else
+    return err(std::errc::not_supported);
+#endif
+}
+
 result<runtime_module *> interpreter::find_module_by_id(size_t index) noexcept
 {
     CHECK_WITH_ERR(index < modules_.size(), std::errc::result_out_of_range);
     return ok(modules_[index].get());
 }
 
+const std::shared_ptr<allocation_tracker> &interpreter::memory_tracker() const noexcept
+{
+    return memory_tracker_;
+}
+
+result<runtime_memory_stats> interpreter::memory_stats() const noexcept
+{
+    CHECK_WITH_ERR(memory_tracker_, std::errc::invalid_argument);
+    runtime_memory_stats stats;
+    for (auto &mod : modules_)
+    {
+        try_var(mod_stats, mod->memory_stats());
+        try
+        {
+            stats.modules.emplace_back(std::move(mod_stats));
+        }
+        catch (...)
+        {
+            return err(std::errc::not_enough_memory);
+        }
+    }
+
+    stats.usage = memory_tracker_->usage();
+    return ok(std::move(stats));
+}
+
 options_dict &interpreter::options() noexcept
 {
     return options_;
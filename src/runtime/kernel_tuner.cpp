@@ -0,0 +1,268 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <nncase/runtime/dbg.h>
+#include <nncase/runtime/kernel_tuner.h>
+#ifdef NNCASE_ASYNC_RUNTIME
+#include <mutex>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+using namespace nncase;
+using namespace nncase::runtime;
+
+namespace
+{
+// Each candidate is run once to warm up, then timed this many times and the best run counts
+constexpr size_t timed_runs = 3;
+
+std::string trim(const std::string &value)
+{
+    auto begin = value.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos)
+        return {};
+    auto end = value.find_last_not_of(" \t\r\n");
+    return value.substr(begin, end - begin + 1);
+}
+
+std::string read_cpu_model()
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    uint32_t brand[12] = {};
+    for (uint32_t i = 0; i < 3; i++)
+    {
+#if defined(_M_X64) || defined(_M_IX86)
+        __cpuid(reinterpret_cast<int *>(brand + i * 4), 0x80000002 + i);
+#else
+        if (!__get_cpuid(0x80000002 + i, brand + i * 4, brand + i * 4 + 1, brand + i * 4 + 2, brand + i * 4 + 3))
+            break;
+#endif
+    }
+
+    auto model = trim(std::string(reinterpret_cast<const char *>(brand), strnlen(reinterpret_cast<const char *>(brand), sizeof(brand))));
+    if (!model.empty())
+        return model;
+#endif
+
+#ifdef __linux__
+    // Arm and RISC-V kernels report the core by different keys
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line, implementer, part;
+    while (std::getline(cpuinfo, line))
+    {
+        auto colon = line.find(':');
+        if (colon == std::string::npos)
+            continue;
+        auto key = trim(line.substr(0, colon));
+        auto value = trim(line.substr(colon + 1));
+        if (key == "model name" || key == "uarch")
+            return value;
+        else if (key == "CPU implementer" && implementer.empty())
+            implementer = value;
+        else if (key == "CPU part" && part.empty())
+            part = value;
+    }
+
+    if (!implementer.empty())
+        return "arm " + implementer + ":" + part;
+#endif
+    return "unknown";
+}
+
+double time_candidate(size_t index, const kernel_tuner::run_candidate_t &run, result<void> &status)
+{
+    using clock = std::chrono::steady_clock;
+    status = run(index);
+    if (status.is_err())
+        return 0;
+
+    auto best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < timed_runs; i++)
+    {
+        auto start = clock::now();
+        status = run(index);
+        if (status.is_err())
+            return 0;
+        best = std::min(best, std::chrono::duration<double>(clock::now() - start).count());
+    }
+
+    return best;
+}
+}
+
+struct kernel_tuner::state
+{
+#ifdef NNCASE_ASYNC_RUNTIME
+    std::mutex lock;
+#endif
+    bool tuning;
+    // Keyed by cpu model and signature, ordered so saved files diff well
+    std::map<std::pair<std::string, std::string>, std::string> choices;
+};
+
+#ifdef NNCASE_ASYNC_RUNTIME
+#define TUNER_LOCK(s) std::lock_guard<std::mutex> guard((s).lock)
+#else
+#define TUNER_LOCK(s)
+#endif
+
+kernel_tuner::kernel_tuner(bool tuning)
+    : state_(std::make_unique<state>())
+{
+    state_->tuning = tuning;
+}
+
+kernel_tuner::~kernel_tuner()
+{
+}
+
+bool kernel_tuner::tuning() const noexcept
+{
+    TUNER_LOCK(*state_);
+    return state_->tuning;
+}
+
+void kernel_tuner::tuning(bool value) noexcept
+{
+    TUNER_LOCK(*state_);
+    state_->tuning = value;
+}
+
+size_t kernel_tuner::size() const noexcept
+{
+    TUNER_LOCK(*state_);
+    return state_->choices.size();
+}
+
+const std::string &kernel_tuner::cpu_model() noexcept
+{
+    static const std::string model = read_cpu_model();
+    return model;
+}
+
+result<void> kernel_tuner::load(const char *path) noexcept
+{
+    try
+    {
+        std::ifstream file(path);
+        if (!file)
+            return ok();
+
+        // One tab separated entry per line: cpu model, signature, choice
+        std::string line;
+        TUNER_LOCK(*state_);
+        while (std::getline(file, line))
+        {
+            auto first = line.find('\t');
+            auto second = first == std::string::npos ? first : line.find('\t', first + 1);
+            if (second == std::string::npos)
+                continue;
+            state_->choices[{ line.substr(0, first), line.substr(first + 1, second - first - 1) }] = trim(line.substr(second + 1));
+        }
+
+        return ok();
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+}
+
+result<void> kernel_tuner::save(const char *path) const noexcept
+{
+    try
+    {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file)
+            return err(std::errc::permission_denied);
+
+        TUNER_LOCK(*state_);
+        for (auto &choice : state_->choices)
+            file << choice.first.first << '\t' << choice.first.second << '\t' << choice.second << '\n';
+        file.flush();
+        if (!file)
+            return err(std::errc::io_error);
+        return ok();
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+}
+
+result<size_t> kernel_tuner::select(const std::string &signature, gsl::span<const std::string> candidates, const run_candidate_t &run) noexcept
+{
+    CHECK_WITH_ERR(!candidates.empty(), std::errc::invalid_argument);
+
+    try
+    {
+        std::pair<std::string, std::string> key { cpu_model(), signature };
+        bool tuning;
+        {
+            TUNER_LOCK(*state_);
+            tuning = state_->tuning;
+            auto it = state_->choices.find(key);
+            if (it != state_->choices.end())
+            {
+                auto cached = std::find(candidates.begin(), candidates.end(), it->second);
+                // A choice this build does not offer is tuned again
+                if (cached != candidates.end())
+                    return ok((size_t)(cached - candidates.begin()));
+            }
+        }
+
+        if (!tuning || candidates.size() == 1)
+            return ok(size_t(0));
+
+        // Run outside the lock, interpreters sharing the tuner may tune other ops meanwhile
+        size_t best_index = 0;
+        auto best_time = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < candidates.size(); i++)
+        {
+            result<void> status = ok();
+            auto time = time_candidate(i, run, status);
+            // Candidates that reject the op are skipped, the static choice must run
+            if (status.is_err())
+            {
+                if (i == 0)
+                    return err(std::move(status.unwrap_err()));
+                continue;
+            }
+
+            if (time < best_time)
+            {
+                best_time = time;
+                best_index = i;
+            }
+        }
+
+        TUNER_LOCK(*state_);
+        state_->choices[std::move(key)] = candidates[best_index];
+        return ok(best_index);
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+}
@@ -15,7 +15,10 @@
 #include "section.h"
 #include <nncase/runtime/dbg.h>
 #include <nncase/runtime/error.h>
+#include <nncase/runtime/host_runtime_tensor.h>
 #include <nncase/runtime/runtime_function.h>
+#include <nncase/runtime/runtime_module.h>
+#include <nncase/runtime/runtime_op_utility.h>
 #include <nncase/runtime/span_reader.h>
 
 using namespace nncase;
@@ -112,23 +115,24 @@ result<void> runtime_function::initialize(gsl::span<const gsl::byte> payload, ru
         return err(std::errc::not_enough_memory);
     }
 
-    auto read_shape = [&](runtime_shape_t &shape) {
-        shape.resize(reader.read<uint32_t>());
-        for (auto &dim : shape)
+    auto read_shape = [&](inout_tensor_info &info) {
+        info.base_shape.resize(reader.read<uint32_t>());
+        for (auto &dim : info.base_shape)
             dim = reader.read<uint32_t>();
+        info.shape = info.base_shape;
     };
 
     // inputs
     for (auto &in : input_tensors_)
         reader.read(in.range);
     for (auto &in : input_tensors_)
-        read_shape(in.shape);
+        read_shape(in);
 
     // outputs
     for (auto &out : output_tensors_)
         reader.read(out.range);
     for (auto &out : output_tensors_)
-        read_shape(out.shape);
+        read_shape(out);
 
     runtime_function_init_context_impl init_context(header_, module_init_context, reader.read_avail());
     return initialize_core(init_context);
@@ -168,6 +172,14 @@ result<runtime_tensor> runtime_function::output_tensor(size_t index) noexcept
     }                                                                               \
     return ok(info.bind_tensor);
 
+result<runtime_tensor> runtime_function::allocate_host_tensor(datatype_t datatype, const runtime_shape_t &shape) noexcept
+{
+    auto bytes = runtime::get_bytes(datatype, shape);
+    try_var(buffer, module().memory_tracker().allocate_buffer(memory_category_t::tensor, bytes));
+    auto deleter = buffer.get_deleter();
+    return hrt::create(datatype, shape, { buffer.release(), bytes }, std::move(deleter));
+}
+
 result<runtime_tensor> runtime_function::device_input_tensor(size_t index) noexcept
 {
     DEV_INOUT_TENSOR_GETTER_IMPL(input);
@@ -196,7 +208,7 @@ result<void> runtime_function::input_tensor(size_t index, runtime_tensor tensor)
                 try_var(device_tensor, allocate_input_tensor(index));
             if (!tensor.can_copy_to_without_staging(device_tensor))
             {
-                try_set(info.staging_tensor, host_runtime_tensor::create(info.range.datatype, info.shape));
+                try_set(info.staging_tensor, allocate_host_tensor(info.range.datatype, info.shape));
             }
             else
             {
@@ -235,7 +247,7 @@ result<void> runtime_function::output_tensor(size_t index, runtime_tensor tensor
                 try_var(device_tensor, allocate_output_tensor(index));
             if (!device_tensor.can_copy_to_without_staging(tensor))
             {
-                try_set(info.staging_tensor, host_runtime_tensor::create(info.range.datatype, info.shape));
+                try_set(info.staging_tensor, allocate_host_tensor(info.range.datatype, info.shape));
             }
             else
             {
@@ -256,7 +268,57 @@ result<void> runtime_function::output_tensor(size_t index, runtime_tensor tensor
     return ok();
 }
 
+size_t runtime_function::batch() const noexcept
+{
+    return batch_;
+}
+
+size_t runtime_function::max_batch() const noexcept
+{
+    return 1;
+}
+
+result<void> runtime_function::batch(size_t value) noexcept
+{
+    CHECK_WITH_ERR(value >= 1 && value <= max_batch(), std::errc::invalid_argument);
+    if (value == batch_)
+        return ok();
+
+    try_(batch_core(value));
+    batch_ = value;
+
+    // Dim 0 of every input and output is the batch dim, the old bindings are invalidated
+    auto rebatch = [&](inout_tensor_info &info) {
+        info.shape = info.base_shape;
+        if (!info.shape.empty())
+            info.shape[0] *= value;
+        info.bind_tensor.reset();
+        info.staging_tensor.reset();
+        info.device_tensor.reset();
+    };
+
+    for (auto &in : input_tensors_)
+        rebatch(in);
+    for (auto &out : output_tensors_)
+        rebatch(out);
+    return ok();
+}
+
+result<void> runtime_function::batch_core(size_t value) noexcept
+{
+    if (value == 1)
+        return ok();
+    return err(std::errc::not_supported);
+}
+
 result<void> runtime_function::invoke() noexcept
+{
+    try_(copy_inputs());
+    try_(compute());
+    return copy_outputs();
+}
+
+result<void> runtime_function::copy_inputs() noexcept
 {
     // 1. Ensure bindings
     for (size_t i = 0; i < input_tensors_.size(); i++)
@@ -288,10 +350,16 @@ result<void> runtime_function::invoke() noexcept
         }
     }
 
-    // 3. Run
-    try_(invoke_core());
+    return ok();
+}
 
-    // 4. Copy outputs
+result<void> runtime_function::compute() noexcept
+{
+    return invoke_core();
+}
+
+result<void> runtime_function::copy_outputs() noexcept
+{
     for (auto &out : output_tensors_)
     {
         if (out.staging_tensor.empty())
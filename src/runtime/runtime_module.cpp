@@ -15,6 +15,7 @@
 #include "section.h"
 #include <nncase/runtime/dbg.h>
 #include <nncase/runtime/error.h>
+#include <nncase/runtime/interpreter.h>
 #include <nncase/runtime/runtime_module.h>
 #include <nncase/runtime/span_reader.h>
 
@@ -26,8 +27,8 @@ namespace
 class runtime_module_init_context_impl : public runtime_module_init_context
 {
 public:
-    runtime_module_init_context_impl(const module_header &header, interpreter &interp, gsl::span<const gsl::byte> sections) noexcept
-        : header_(header), interp_(interp), sections_(sections)
+    runtime_module_init_context_impl(const module_header &header, interpreter &interp, gsl::span<const gsl::byte> sections, allocation_tracker &memory_tracker, std::vector<allocation_tracker::buffer_t> &section_cache) noexcept
+        : header_(header), interp_(interp), sections_(sections), memory_tracker_(memory_tracker), section_cache_(section_cache)
     {
     }
 
@@ -48,13 +49,87 @@ public:
 
     gsl::span<const gsl::byte> section(const char *name) noexcept override
     {
-        return find_section(name, sections_);
+        auto view = find_section(name, sections_);
+        if (!view.header)
+            return {};
+
+        if (view.header->flags & SECTION_MERGED_INTO_RDATA)
+        {
+            auto rdata = section(".rdata");
+            if (rdata.size() < (size_t)view.header->body_start + view.header->body_size)
+                return {};
+            return rdata.subspan(view.header->body_start, view.header->body_size);
+        }
+
+        if (view.header->flags & SECTION_COMPRESSED)
+            return decompressed(*view.header, view.body);
+        return view.body;
+    }
+
+    result<allocation_tracker::buffer_t> take_compressed_section(const char *name) noexcept override
+    {
+        auto view = find_section(name, sections_);
+        if (!view.header || !(view.header->flags & SECTION_COMPRESSED))
+            return ok(allocation_tracker::buffer_t(nullptr, allocation_tracker::deleter { nullptr, memory_category_t::section, 0, 0 }));
+
+        try_var(buffer, memory_tracker_.allocate_buffer(memory_category_t::section, view.header->memory_size));
+        try_(decompress_section(view.body, { buffer.get(), view.header->memory_size }));
+        return ok(std::move(buffer));
+    }
+
+    result<void> status() const noexcept
+    {
+        if (status_)
+            return err(status_);
+        return ok();
+    }
+
+private:
+    // Compressed sections are decompressed on the first request, the module owns the buffers
+    gsl::span<const gsl::byte> decompressed(const section_header &header, gsl::span<const gsl::byte> body) noexcept
+    {
+        for (auto &entry : decompressed_)
+        {
+            if (entry.first == &header)
+                return entry.second;
+        }
+
+        auto r = decompress(header, body);
+        if (r.is_ok())
+            return std::move(r).unwrap();
+
+        if (!status_)
+            status_ = std::move(r).unwrap_err();
+        return {};
+    }
+
+    result<gsl::span<const gsl::byte>> decompress(const section_header &header, gsl::span<const gsl::byte> body) noexcept
+    {
+        try_var(buffer, memory_tracker_.allocate_buffer(memory_category_t::section, header.memory_size));
+        gsl::span<const gsl::byte> memory(buffer.get(), header.memory_size);
+        try_(decompress_section(body, { buffer.get(), header.memory_size }));
+
+        try
+        {
+            section_cache_.emplace_back(std::move(buffer));
+            decompressed_.emplace_back(&header, memory);
+        }
+        catch (...)
+        {
+            return err(std::errc::not_enough_memory);
+        }
+
+        return ok(memory);
     }
 
 private:
     const module_header &header_;
     interpreter &interp_;
     gsl::span<const gsl::byte> sections_;
+    allocation_tracker &memory_tracker_;
+    std::vector<allocation_tracker::buffer_t> &section_cache_;
+    std::vector<std::pair<const section_header *, gsl::span<const gsl::byte>>> decompressed_;
+    std::error_condition status_;
 };
 
 gsl::span<const gsl::byte> read_functions(span_reader &sr, size_t functions) noexcept
@@ -110,6 +185,7 @@ result<void> runtime_module::initialize(gsl::span<const gsl::byte> payload, inte
 
     try
     {
+        memory_tracker_ = std::make_shared<allocation_tracker>(interp.memory_tracker());
         mempools_.resize(header_.mempools);
         shared_mempools_.resize(header_.shared_mempools);
         functions_.resize(header_.functions);
@@ -128,7 +204,7 @@ result<void> runtime_module::initialize(gsl::span<const gsl::byte> payload, inte
         reader.read(desc);
 
     span_reader func_reader(read_functions(reader, header_.functions));
-    runtime_module_init_context_impl init_context(header_, interp, read_sections(reader, header_.sections));
+    runtime_module_init_context_impl init_context(header_, interp, read_sections(reader, header_.sections), *memory_tracker_, section_cache_);
     try_(initialize_before_functions(init_context));
 
     for (size_t i = 0; i < header_.functions; i++)
@@ -140,7 +216,8 @@ result<void> runtime_module::initialize(gsl::span<const gsl::byte> payload, inte
         functions_[i] = std::move(func);
     }
 
-    return initialize_after_functions(init_context);
+    try_(initialize_after_functions(init_context));
+    return init_context.status();
 }
 
 result<runtime_function *> runtime_module::find_function_by_id(size_t index) noexcept
@@ -149,6 +226,23 @@ result<runtime_function *> runtime_module::find_function_by_id(size_t index) noe
     return ok(functions_[index].get());
 }
 
+result<module_memory_stats> runtime_module::memory_stats() const noexcept
+{
+    module_memory_stats stats;
+    stats.type = header_.type;
+    try
+    {
+        stats.mempools = mempools_;
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+
+    stats.usage = memory_tracker_->usage();
+    return ok(std::move(stats));
+}
+
 result<void> runtime_module::initialize_before_functions(NNCASE_UNUSED runtime_module_init_context &context) noexcept
 {
     return ok();
@@ -13,12 +13,15 @@
  * limitations under the License.
  */
 #include "section.h"
+#include <cstring>
+#include <nncase/runtime/dbg.h>
+#include <nncase/runtime/error.h>
 #include <nncase/runtime/span_reader.h>
 
 using namespace nncase;
 using namespace nncase::runtime;
 
-gsl::span<const gsl::byte> runtime::find_section(const char *name, gsl::span<const gsl::byte> sections) noexcept
+section_view runtime::find_section(const char *name, gsl::span<const gsl::byte> sections) noexcept
 {
     span_reader reader(sections);
     while (!reader.empty())
@@ -26,18 +29,10 @@ gsl::span<const gsl::byte> runtime::find_section(const char *name, gsl::span<con
         auto header = reader.get_ref<section_header>();
         if (!strncmp(header->name, name, MAX_SECTION_NAME_LENGTH))
         {
-            gsl::span<const gsl::byte> result;
-            if (header->flags & SECTION_MERGED_INTO_RDATA)
-            {
-                auto rdata_span = find_section(".rdata", sections);
-                result = rdata_span.subspan(header->body_start, header->body_size);
-            }
-            else
-            {
-                result = reader.read_avail().subspan(header->body_start, header->body_size);
-            }
-
-            return result;
+            gsl::span<const gsl::byte> body;
+            if (!(header->flags & SECTION_MERGED_INTO_RDATA))
+                body = reader.read_avail().subspan(header->body_start, header->body_size);
+            return { header, body };
         }
         else
         {
@@ -46,7 +41,7 @@ gsl::span<const gsl::byte> runtime::find_section(const char *name, gsl::span<con
         }
     }
 
-    return {};
+    return { nullptr, {} };
 }
 
 gsl::span<const gsl::byte> runtime::read_sections(span_reader &sr, size_t sections) noexcept
@@ -69,3 +64,67 @@ gsl::span<const gsl::byte> runtime::read_sections(span_reader &sr, size_t sectio
 
     return sr.read_span(size);
 }
+
+result<void> runtime::decompress_section(gsl::span<const gsl::byte> input, gsl::span<gsl::byte> output) noexcept
+{
+    // lz4 block format: [token] [literal length+] [literals] [offset] [match length+]
+    auto src = reinterpret_cast<const uint8_t *>(input.data());
+    auto src_end = src + input.size();
+    auto dest_begin = reinterpret_cast<uint8_t *>(output.data());
+    auto dest = dest_begin;
+    auto dest_end = dest_begin + output.size();
+
+    while (src < src_end)
+    {
+        auto token = *src++;
+        size_t literals = token >> 4;
+        if (literals == 15)
+        {
+            uint8_t ext;
+            do
+            {
+                CHECK_WITH_ERR(src < src_end, nncase_errc::invalid_section_data);
+                ext = *src++;
+                literals += ext;
+            } while (ext == 255);
+        }
+
+        CHECK_WITH_ERR((size_t)(src_end - src) >= literals && (size_t)(dest_end - dest) >= literals, nncase_errc::invalid_section_data);
+        std::memcpy(dest, src, literals);
+        src += literals;
+        dest += literals;
+
+        // The last sequence has only literals
+        if (src == src_end)
+            break;
+
+        CHECK_WITH_ERR(src_end - src >= 2, nncase_errc::invalid_section_data);
+        size_t offset = (size_t)src[0] | ((size_t)src[1] << 8);
+        src += 2;
+        CHECK_WITH_ERR(offset && offset <= (size_t)(dest - dest_begin), nncase_errc::invalid_section_data);
+
+        size_t match = token & 15;
+        if (match == 15)
+        {
+            uint8_t ext;
+            do
+            {
+                CHECK_WITH_ERR(src < src_end, nncase_errc::invalid_section_data);
+                ext = *src++;
+                match += ext;
+            } while (ext == 255);
+        }
+
+        match += 4;
+        CHECK_WITH_ERR((size_t)(dest_end - dest) >= match, nncase_errc::invalid_section_data);
+
+        // Matches may overlap with the output, copy byte by byte
+        auto ref = dest - offset;
+        for (size_t i = 0; i < match; i++)
+            dest[i] = ref[i];
+        dest += match;
+    }
+
+    CHECK_WITH_ERR(dest == dest_end, nncase_errc::invalid_section_data);
+    return ok();
+}
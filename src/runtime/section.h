@@ -19,7 +19,20 @@
 
 BEGIN_NS_NNCASE_RUNTIME
 
-gsl::span<const gsl::byte> find_section(const char *name, gsl::span<const gsl::byte> sections) noexcept;
+struct section_view
+{
+    const section_header *header;
+    gsl::span<const gsl::byte> body;
+};
+
+/**
+ * @brief Find a section by name.
+ *
+ * The body is returned as it is stored, it's empty if the section is merged into .rdata.
+ * header is nullptr if the section is not found.
+ */
+section_view find_section(const char *name, gsl::span<const gsl::byte> sections) noexcept;
 gsl::span<const gsl::byte> read_sections(span_reader &sr, size_t sections) noexcept;
+NNCASE_API result<void> decompress_section(gsl::span<const gsl::byte> input, gsl::span<gsl::byte> output) noexcept;
 
 END_NS_NNCASE_RUNTIME
@@ -0,0 +1,153 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "call_scheduler.h"
+#include <algorithm>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+call_scheduler::~call_scheduler()
+{
+    (void)wait_all();
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        exit_ = true;
+    }
+
+    for (auto &w : workers_)
+    {
+        w->cv.notify_all();
+        w->thread.join();
+    }
+}
+
+bool call_scheduler::conflicts(const call &c) const noexcept
+{
+    auto overlaps = [](const std::vector<buffer_span> &a, const std::vector<buffer_span> &b) {
+        return std::any_of(a.begin(), a.end(), [&](const buffer_span &x) {
+            return std::any_of(b.begin(), b.end(), [&](const buffer_span &y) { return x.overlaps(y); });
+        });
+    };
+
+    auto module = &c.function->module();
+    return std::any_of(in_flight_.begin(), in_flight_.end(), [&](const in_flight_call &f) {
+        return f.module == module
+            || overlaps(c.reads, f.writes)
+            || overlaps(c.writes, f.reads)
+            || overlaps(c.writes, f.writes);
+    });
+}
+
+result<call_scheduler::worker *> call_scheduler::get_worker(runtime_module &module) noexcept
+{
+    for (auto &w : workers_)
+    {
+        if (w->module == &module)
+            return ok(w.get());
+    }
+
+    try
+    {
+        auto &w = workers_.emplace_back(std::make_unique<worker>());
+        w->module = &module;
+        try
+        {
+            w->thread = std::thread([this, w = w.get()] { work(*w); });
+        }
+        catch (...)
+        {
+            workers_.pop_back();
+            throw;
+        }
+
+        return ok(w.get());
+    }
+    catch (...)
+    {
+        return err(std::errc::resource_unavailable_try_again);
+    }
+}
+
+result<void> call_scheduler::post(call c) noexcept
+{
+    auto &module = c.function->module();
+    {
+        std::unique_lock<std::mutex> lock(lock_);
+        done_cv_.wait(lock, [&] { return error_ || !conflicts(c); });
+        if (error_)
+        {
+            lock.unlock();
+            return wait_all();
+        }
+    }
+
+    // The module has nothing in flight, so its function can be bound here
+    for (size_t i = 0; i < c.inputs.size(); i++)
+        try_(c.function->input_tensor(i, std::move(c.inputs[i])));
+    for (size_t i = 0; i < c.outputs.size(); i++)
+        try_(c.function->output_tensor(i, std::move(c.outputs[i])));
+
+    std::lock_guard<std::mutex> lock(lock_);
+    try_var(w, get_worker(module));
+    try
+    {
+        in_flight_.push_back({ &module, std::move(c.reads), std::move(c.writes) });
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+
+    w->job = c.function;
+    w->cv.notify_one();
+    return ok();
+}
+
+result<void> call_scheduler::wait_all() noexcept
+{
+    std::unique_lock<std::mutex> lock(lock_);
+    done_cv_.wait(lock, [this] { return in_flight_.empty(); });
+    if (error_)
+    {
+        auto error = error_;
+        error_.clear();
+        return err(error);
+    }
+
+    return ok();
+}
+
+void call_scheduler::work(worker &w)
+{
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true)
+    {
+        w.cv.wait(lock, [&] { return exit_ || w.job; });
+        if (!w.job)
+            return;
+
+        auto function = w.job;
+        lock.unlock();
+        auto r = function->invoke();
+        lock.lock();
+
+        w.job = nullptr;
+        if (r.is_err() && !error_)
+            error_ = r.unwrap_err();
+        in_flight_.erase(std::find_if(in_flight_.begin(), in_flight_.end(), [&](const in_flight_call &f) { return f.module == w.module; }));
+        done_cv_.notify_all();
+    }
+}
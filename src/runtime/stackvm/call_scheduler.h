@@ -0,0 +1,100 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <nncase/runtime/runtime_function.h>
+#include <thread>
+#include <vector>
+
+BEGIN_NS_NNCASE_RT_MODULE(stackvm)
+
+/**
+ * @brief Runs tensor calls into other modules on per module worker threads.
+ *
+ * A call is started as soon as no call in flight touches its module or writes
+ * memory it reads, reads memory it writes or writes memory it writes, so
+ * independent regions of a partitioned graph overlap while the calls still
+ * observe the program order of the caller.
+ */
+class NNCASE_API call_scheduler
+{
+public:
+    struct buffer_span
+    {
+        uintptr_t begin;
+        uintptr_t end;
+
+        bool overlaps(const buffer_span &other) const noexcept
+        {
+            return begin < other.end && other.begin < end;
+        }
+    };
+
+    struct call
+    {
+        runtime_function *function;
+        std::vector<runtime_tensor> inputs;
+        std::vector<runtime_tensor> outputs;
+        std::vector<buffer_span> reads;
+        std::vector<buffer_span> writes;
+    };
+
+    call_scheduler() = default;
+    call_scheduler(const call_scheduler &) = delete;
+    ~call_scheduler();
+    call_scheduler &operator=(const call_scheduler &) = delete;
+
+    /**
+     * @brief Waits for the calls it depends on, then starts it on the worker of its module.
+     */
+    result<void> post(call c) noexcept;
+
+    /**
+     * @brief Waits for all calls in flight, returns the first error of them.
+     */
+    result<void> wait_all() noexcept;
+
+private:
+    struct worker
+    {
+        runtime_module *module;
+        std::thread thread;
+        std::condition_variable cv;
+        runtime_function *job = nullptr;
+    };
+
+    struct in_flight_call
+    {
+        runtime_module *module;
+        std::vector<buffer_span> reads;
+        std::vector<buffer_span> writes;
+    };
+
+    bool conflicts(const call &c) const noexcept;
+    result<worker *> get_worker(runtime_module &module) noexcept;
+    void work(worker &w);
+
+private:
+    std::mutex lock_;
+    std::condition_variable done_cv_;
+    std::vector<std::unique_ptr<worker>> workers_;
+    std::vector<in_flight_call> in_flight_;
+    std::error_condition error_;
+    bool exit_ = false;
+};
+
+END_NS_NNCASE_RT_MODULE
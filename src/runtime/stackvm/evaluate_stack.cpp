@@ -51,7 +51,16 @@ result<stack_entry> evaluate_stack::pop() noexcept
 result<void> evaluate_stack::push(stack_entry entry) noexcept
 {
     if (full())
-        entries_.resize(entries_.size() + 1);
+    {
+        try
+        {
+            entries_.resize(entries_.size() * 2);
+        }
+        catch (...)
+        {
+            return err(nncase_errc::stackvm_stack_overflow);
+        }
+    }
 
     entries_[top_++] = entry;
     return ok();
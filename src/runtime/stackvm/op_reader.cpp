@@ -54,10 +54,14 @@ result<void> op_visitor::next() noexcept
             return visit(op_reader<tensor_hardmax_op_t>()(reader_));
         case tensor_function_t::LUT1D:
             return visit(op_reader<tensor_lut1d_op_t>()(reader_));
+        case tensor_function_t::MATMUL:
+            return visit(op_reader<tensor_matmul_op_t>()(reader_));
         case tensor_function_t::ONEHOT:
             return visit(op_reader<tensor_onehot_op_t>()(reader_));
         case tensor_function_t::PAD:
             return visit(op_reader<tensor_pad_op_t>()(reader_));
+        case tensor_function_t::PREPROCESS:
+            return visit(op_reader<tensor_preprocess_op_t>()(reader_));
         case tensor_function_t::QUANTIZE:
             return visit(op_reader<tensor_quantize_op_t>()(reader_));
         case tensor_function_t::RANDOM_NORMAL:
@@ -168,7 +168,7 @@ result<void> stackvm_runtime_function::visit(const lea_buffer_op_t &op) noexcept
         {
             try_var(tensor, device_input_tensor(id));
             try_var(tensor_map, hrt::map(tensor, hrt::map_read));
-            return stack_.push((uintptr_t)tensor_map.buffer().data() + offset);
+            return stack_.push((uintptr_t)tensor_map.buffer().data() + offset * batch());
         }
         else
         {
@@ -196,7 +196,7 @@ result<void> stackvm_runtime_function::visit(const lea_buffer_op_t &op) noexcept
         {
             try_var(tensor, device_output_tensor(id));
             try_var(tensor_map, hrt::map(tensor, hrt::map_read_write));
-            return stack_.push((uintptr_t)tensor_map.buffer().data() + offset);
+            return stack_.push((uintptr_t)tensor_map.buffer().data() + offset * batch());
         }
         else
         {
@@ -205,12 +205,13 @@ result<void> stackvm_runtime_function::visit(const lea_buffer_op_t &op) noexcept
     }
     else if (op.location == mem_rdata)
     {
-        auto buffer = module().rdata().subspan(op.offset);
-        return stack_.push((uintptr_t)buffer.data());
+        try_var(buffer, module().rdata_at(op.offset));
+        return stack_.push((uintptr_t)buffer);
     }
     else if (op.location == mem_data)
     {
-        auto buffer = module().data().subspan(op.offset);
+        // Buffers of dynamic batch functions are laid out for batch 1, scale them to the current batch
+        auto buffer = module().data().subspan((size_t)op.offset * module().batch());
         return stack_.push((uintptr_t)buffer.data());
     }
     else
@@ -24,12 +24,28 @@ result<void> stackvm_runtime_function::visit(const tensor_binary_op_t &op) noexc
     try_var(output, pop_addr());
     try_var(input_b, pop_addr());
     try_var(input_a, pop_addr());
-    try_var(in_a_shape, module().shape_reg(op.rshape_src1));
-    try_var(in_a_strides, module().shape_reg(op.rstride_src1));
-    try_var(in_b_shape, module().shape_reg(op.rshape_src2));
-    try_var(in_b_strides, module().shape_reg(op.rstride_src2));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    try_ref(in_a_shape, module().shape_reg(op.rshape_src1));
+    try_ref(in_a_strides, module().shape_reg(op.rstride_src1));
+    try_ref(in_b_shape, module().shape_reg(op.rshape_src2));
+    try_ref(in_b_strides, module().shape_reg(op.rstride_src2));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
 
-    return kernels::binary(op.binary_op, reinterpret_cast<const float *>(input_a), reinterpret_cast<const float *>(input_b),
-        reinterpret_cast<float *>(output), in_a_shape, in_a_strides, in_b_shape, in_b_strides, out_strides, { op.fused_clamp_low, op.fused_clamp_high }, module().kernel_context());
+#define BINARY_IMPL(type)                                                                                                    \
+    return kernels::binary(op.binary_op, reinterpret_cast<const type *>(input_a), reinterpret_cast<const type *>(input_b),   \
+        reinterpret_cast<type *>(output), in_a_shape, in_a_strides, in_b_shape, in_b_strides, out_strides, fused_activation, \
+        module().kernel_context())
+
+    value_range<float> fused_activation { op.fused_clamp_low, op.fused_clamp_high };
+    switch (op.datatype)
+    {
+    case dt_float32:
+        BINARY_IMPL(float);
+    case dt_float16:
+        BINARY_IMPL(half);
+    case dt_bfloat16:
+        BINARY_IMPL(bfloat16);
+    default:
+        return err(nncase_errc::datatype_mismatch);
+    }
+#undef BINARY_IMPL
 }
@@ -23,10 +23,10 @@ result<void> stackvm_runtime_function::visit(const tensor_broadcast_op_t &op) no
 {
     try_var(output, pop_addr());
     try_var(input, pop_addr());
-    try_var(in_shape, module().shape_reg(op.rshape_src));
-    try_var(in_strides, module().shape_reg(op.rstride_src));
-    try_var(out_shape, module().shape_reg(op.rshape_dest));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    try_ref(in_shape, module().shape_reg(op.rshape_src));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(out_shape, module().shape_reg(op.rshape_dest));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
 
     return kernels::broadcast(op.datatype, reinterpret_cast<const gsl::byte *>(input), reinterpret_cast<gsl::byte *>(output),
         in_shape, in_strides, out_shape, out_strides, module().kernel_context());
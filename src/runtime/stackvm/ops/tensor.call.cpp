@@ -25,28 +25,64 @@ result<void> stackvm_runtime_function::visit(const tensor_call_op_t &op) noexcep
 {
     try_var(mod, module().interp().find_module_by_id(op.module_id));
     try_var(func, mod->find_function_by_id(op.function_id));
+    try_(func->batch(batch()));
 
-    auto create_tensor = [&]() -> result<runtime_tensor> {
+    auto create_tensor = [&](uintptr_t &begin, uintptr_t &end) -> result<runtime_tensor> {
         try_var(rstrides, stack_.pop());
-        try_var(strides, module().shape_reg(rstrides.as_u4()));
+        try_ref(strides, module().shape_reg(rstrides.as_u4()));
         try_var(rshape, stack_.pop());
-        try_var(shape, module().shape_reg(rshape.as_u4()));
+        try_ref(shape, module().shape_reg(rshape.as_u4()));
         try_var(e_datatype, stack_.pop());
         try_var(addr, pop_addr());
 
         auto datatype = (datatype_t)e_datatype.as_u1();
+        begin = addr;
+        end = addr + runtime::get_bytes(datatype, shape, strides);
         return this->create_tensor(addr, datatype, shape, strides);
     };
 
+#ifdef NNCASE_ASYNC_RUNTIME
+    if (calls_)
+    {
+        call_scheduler::call c { func };
+        try
+        {
+            c.outputs.resize(op.num_dst);
+            c.writes.resize(op.num_dst);
+            c.inputs.resize(op.num_src);
+            c.reads.resize(op.num_src);
+        }
+        catch (...)
+        {
+            return err(std::errc::not_enough_memory);
+        }
+
+        for (uint8_t i = 0; i < op.num_dst; i++)
+        {
+            auto index = (size_t)op.num_dst - i - 1;
+            try_set(c.outputs[index], create_tensor(c.writes[index].begin, c.writes[index].end));
+        }
+
+        for (uint8_t i = 0; i < op.num_src; i++)
+        {
+            auto index = (size_t)op.num_src - i - 1;
+            try_set(c.inputs[index], create_tensor(c.reads[index].begin, c.reads[index].end));
+        }
+
+        return calls_->post(std::move(c));
+    }
+#endif
+
+    uintptr_t begin, end;
     for (uint8_t i = 0; i < op.num_dst; i++)
     {
-        try_var(tensor, create_tensor());
+        try_var(tensor, create_tensor(begin, end));
         try_(func->output_tensor((size_t)op.num_dst - i - 1, tensor));
     }
 
     for (uint8_t i = 0; i < op.num_src; i++)
     {
-        try_var(tensor, create_tensor());
+        try_var(tensor, create_tensor(begin, end));
         try_(func->input_tensor((size_t)op.num_src - i - 1, tensor));
     }
 
@@ -13,13 +13,20 @@
  * limitations under the License.
  */
 #include "../runtime_function.h"
+#include <array>
 #include <nncase/kernels/convolution.h>
+#include <nncase/runtime/kernel_tuner.h>
 
 using namespace nncase;
 using namespace nncase::runtime;
 using namespace nncase::runtime::stackvm;
 
 result<void> stackvm_runtime_function::visit(const tensor_conv2d_op_t &op) noexcept
+{
+    return visit(op, nullptr);
+}
+
+result<void> stackvm_runtime_function::visit(const tensor_conv2d_op_t &op, conv2d_binding *binding) noexcept
 {
     try_var(padding_w, pop_padding());
     try_var(padding_h, pop_padding());
@@ -27,16 +34,78 @@ result<void> stackvm_runtime_function::visit(const tensor_conv2d_op_t &op) noexc
     try_var(bias, pop_addr());
     try_var(weights, pop_addr());
     try_var(input, pop_addr());
-    try_var(in_shape, module().shape_reg(op.rshape_src));
-    try_var(in_strides, module().shape_reg(op.rstride_src));
-    try_var(w_shape, module().shape_reg(op.rshape_kernel));
-    try_var(w_strides, module().shape_reg(op.rstride_kernel));
-    try_var(bias_strides, module().shape_reg(op.rstride_bias));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
-
-    if (op.datatype != dt_float32)
-        return err(nncase_errc::datatype_mismatch);
-    return kernels::conv2d(reinterpret_cast<const float *>(input), reinterpret_cast<const float *>(weights),
-        reinterpret_cast<const float *>(bias), reinterpret_cast<float *>(output), in_shape, in_strides, w_shape, w_strides, bias_strides, out_strides,
-        padding_h, padding_w, op.groups, op.stride_h, op.stride_w, op.dilation_h, op.dilation_w, { op.fused_clamp_low, op.fused_clamp_high }, module().kernel_context());
+    try_ref(in_shape, module().shape_reg(op.rshape_src));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(w_shape, module().shape_reg(op.rshape_kernel));
+    try_ref(w_strides, module().shape_reg(op.rstride_kernel));
+    try_ref(bias_strides, module().shape_reg(op.rstride_bias));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
+
+    auto &context = module().kernel_context();
+#define CONV2D_IMPL(type)                                                                                                                            \
+    return kernels::conv2d(reinterpret_cast<const type *>(input), reinterpret_cast<const type *>(weights),                                           \
+        reinterpret_cast<const type *>(bias), reinterpret_cast<type *>(output), in_shape, in_strides, w_shape, w_strides, bias_strides, out_strides, \
+        padding_h, padding_w, op.groups, op.stride_h, op.stride_w, op.dilation_h, op.dilation_w, { op.fused_clamp_low, op.fused_clamp_high }, plan,  \
+        run_context)
+
+    auto run = [&](const kernels::conv2d_plan &plan, uint32_t num_threads) -> result<void> {
+        auto run_context = context;
+        if (num_threads)
+            run_context.num_threads = num_threads;
+
+        switch (op.datatype)
+        {
+        case dt_float32:
+            CONV2D_IMPL(float);
+        case dt_float16:
+            CONV2D_IMPL(half);
+        case dt_bfloat16:
+            CONV2D_IMPL(bfloat16);
+        default:
+            return err(nncase_errc::datatype_mismatch);
+        }
+    };
+#undef CONV2D_IMPL
+
+    if (!binding)
+        return run(kernels::plan_conv2d(op.datatype, in_shape, in_strides, w_shape, padding_h, padding_w, op.groups, op.stride_h, op.stride_w, op.dilation_h, op.dilation_w), 0);
+
+    if (binding->batch != module().batch())
+    {
+        binding->plan = kernels::plan_conv2d(op.datatype, in_shape, in_strides, w_shape, padding_h, padding_w, op.groups, op.stride_h, op.stride_w, op.dilation_h, op.dilation_w);
+        binding->num_threads = 0;
+        binding->batch = module().batch();
+
+        // The candidates are the thread counts of the specialized kernel and the reference kernel
+        if (context.tuner && binding->plan.kernel)
+        {
+            std::vector<kernels::conv2d_candidate> candidates;
+            std::vector<std::string> names;
+            std::string signature = "conv2d;";
+            try
+            {
+                candidates = kernels::conv2d_candidates(binding->plan, context.num_threads);
+                for (auto &candidate : candidates)
+                    names.emplace_back(candidate.name);
+
+                append_signature(signature, "type", std::array<uint32_t, 1> { (uint32_t)op.datatype });
+                append_signature(signature, "in", in_shape);
+                append_signature(signature, "in_strides", in_strides);
+                append_signature(signature, "w", w_shape);
+                append_signature(signature, "pad", std::array<int32_t, 4> { padding_h.before, padding_h.after, padding_w.before, padding_w.after });
+                append_signature(signature, "attrs", std::array<int32_t, 5> { op.groups, op.stride_h, op.stride_w, op.dilation_h, op.dilation_w });
+                append_signature(signature, "threads", std::array<uint32_t, 1> { context.num_threads });
+            }
+            catch (...)
+            {
+                return err(std::errc::not_enough_memory);
+            }
+
+            try_var(index, context.tuner->select(signature, names, [&](size_t i) { return run(candidates[i].plan, candidates[i].num_threads); }));
+            binding->plan = candidates[index].plan;
+            binding->num_threads = candidates[index].num_threads;
+        }
+    }
+
+    return run(binding->plan, binding->num_threads);
 }
@@ -13,8 +13,10 @@
  * limitations under the License.
  */
 #include "../runtime_function.h"
+#include <array>
 #include <nncase/kernels/tensor_compute.h>
 #include <nncase/runtime/interpreter.h>
+#include <nncase/runtime/kernel_tuner.h>
 #include <nncase/runtime/runtime_op_utility.h>
 
 using namespace nncase;
@@ -22,12 +24,55 @@ using namespace nncase::runtime;
 using namespace nncase::runtime::stackvm;
 
 result<void> stackvm_runtime_function::visit(const tensor_copy_op_t &op) noexcept
+{
+    return visit(op, nullptr);
+}
+
+result<void> stackvm_runtime_function::visit(const tensor_copy_op_t &op, copy_binding *binding) noexcept
 {
     try_var(output, pop_addr());
     try_var(input, pop_addr());
-    try_var(shape, module().shape_reg(op.rshape));
-    try_var(in_strides, module().shape_reg(op.rstride_src));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    try_ref(shape, module().shape_reg(op.rshape));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
+
+    if (!binding)
+        return kernels::copy(op.datatype, reinterpret_cast<const gsl::byte *>(input), reinterpret_cast<gsl::byte *>(output), shape, in_strides, out_strides, module().kernel_context());
+
+    if (binding->batch != module().batch())
+    {
+        binding->plan = kernels::plan_copy(shape, in_strides, out_strides);
+        binding->batch = module().batch();
+
+        auto &context = module().kernel_context();
+        if (context.tuner && binding->plan.optimized)
+        {
+            std::vector<kernels::copy_plan> plans;
+            std::vector<std::string> names;
+            std::string signature = "copy;";
+            try
+            {
+                plans = kernels::copy_candidates(binding->plan);
+                for (auto &plan : plans)
+                    names.emplace_back(plan.name);
+                append_signature(signature, "type", std::array<uint32_t, 1> { (uint32_t)op.datatype });
+                append_signature(signature, "shape", shape);
+                append_signature(signature, "src_strides", in_strides);
+                append_signature(signature, "dest_strides", out_strides);
+            }
+            catch (...)
+            {
+                return err(std::errc::not_enough_memory);
+            }
+
+            try_var(index, context.tuner->select(signature, names, [&](size_t i) {
+                return kernels::copy(op.datatype, reinterpret_cast<const gsl::byte *>(input), reinterpret_cast<gsl::byte *>(output), shape, in_strides, out_strides,
+                    plans[i], context);
+            }));
+            binding->plan = plans[index];
+        }
+    }
 
-    return kernels::copy(op.datatype, reinterpret_cast<const gsl::byte *>(input), reinterpret_cast<gsl::byte *>(output), shape, in_strides, out_strides, module().kernel_context());
+    return kernels::copy(op.datatype, reinterpret_cast<const gsl::byte *>(input), reinterpret_cast<gsl::byte *>(output), shape, in_strides, out_strides,
+        binding->plan, module().kernel_context());
 }
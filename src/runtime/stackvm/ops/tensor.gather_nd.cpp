@@ -27,11 +27,11 @@ result<void> stackvm_runtime_function::visit(const tensor_gather_nd_op_t &op) no
     try_var(output, pop_addr());
     try_var(input, pop_addr());
 
-    try_var(in_shape, module().shape_reg(op.rshape_src));
-    try_var(in_strides, module().shape_reg(op.rstride_src));
-    try_var(out_shape, module().shape_reg(op.rshape_dest));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
-    try_var(indices_shape, module().shape_reg(op.rshape_indices));
+    try_ref(in_shape, module().shape_reg(op.rshape_src));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(out_shape, module().shape_reg(op.rshape_dest));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
+    try_ref(indices_shape, module().shape_reg(op.rshape_indices));
 
     return kernels::gather_nd(op.datatype, reinterpret_cast<const gsl::byte *>(input), reinterpret_cast<gsl::byte *>(output), in_shape, out_shape,
         in_strides, out_strides, reinterpret_cast<const int32_t *>(indices), indices_shape, op.batch_dims);
@@ -25,8 +25,8 @@ result<void> stackvm_runtime_function::visit(const tensor_hardmax_op_t &op) noex
 {
     try_var(output, pop_addr());
     try_var(input, pop_addr());
-    try_var(in_shape, module().shape_reg(op.rshape_src));
-    try_var(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(in_shape, module().shape_reg(op.rshape_src));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
 
     switch (op.datatype)
     {
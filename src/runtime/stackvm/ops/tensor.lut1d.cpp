@@ -26,9 +26,9 @@ result<void> stackvm_runtime_function::visit(const tensor_lut1d_op_t &op) noexce
     try_var(output, pop_addr());
     try_var(table, pop_addr());
     try_var(input, pop_addr());
-    try_var(shape, module().shape_reg(op.rshape_src));
-    try_var(in_strides, module().shape_reg(op.rstride_src));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    try_ref(shape, module().shape_reg(op.rshape_src));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
 
     return kernels::lut1d(op.datatype, reinterpret_cast<const gsl::byte *>(input), reinterpret_cast<const gsl::byte *>(table),
         reinterpret_cast<gsl::byte *>(output), shape, in_strides, out_strides, min_value, max_value);
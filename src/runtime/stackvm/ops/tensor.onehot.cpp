@@ -30,9 +30,9 @@ result<void> stackvm_runtime_function::visit(const tensor_onehot_op_t &op) noexc
     try_var(depth, pop_addr());
     try_var(indices, pop_addr());
 
-    try_var(indices_shape, module().shape_reg(op.rshape_indices));
-    try_var(out_shape, module().shape_reg(op.rshape_dest));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    try_ref(indices_shape, module().shape_reg(op.rshape_indices));
+    try_ref(out_shape, module().shape_reg(op.rshape_dest));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
 
     return kernels::onehot(op.datatype, reinterpret_cast<const int32_t *>(indices), reinterpret_cast<gsl::byte *>(output),
         indices_shape, out_shape, out_strides, reinterpret_cast<gsl::byte *>(depth), reinterpret_cast<gsl::byte *>(off_value),
@@ -0,0 +1,36 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../runtime_function.h"
+#include <nncase/kernels/tensor_compute.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+result<void> stackvm_runtime_function::visit(const tensor_preprocess_op_t &op) noexcept
+{
+    try_var(output, pop_addr());
+    try_var(std, pop_addr());
+    try_var(mean, pop_addr());
+    try_var(input, pop_addr());
+    try_ref(shape, module().shape_reg(op.rshape_src));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
+    try_var(paddings, module().paddings_reg(op.rpaddings));
+
+    return kernels::preprocess(op.datatype, reinterpret_cast<const gsl::byte *>(input), reinterpret_cast<float *>(output), shape, in_strides, out_strides,
+        op.input_nhwc, op.output_nhwc, op.swap_rb, { op.zero_point, op.scale }, op.resize_h, op.resize_w, paddings, op.pad_value,
+        reinterpret_cast<const float *>(mean), reinterpret_cast<const float *>(std), module().kernel_context());
+}
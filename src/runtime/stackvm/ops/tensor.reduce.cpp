@@ -24,10 +24,24 @@ result<void> stackvm_runtime_function::visit(const tensor_reduce_op_t &op) noexc
     try_var(init_value, stack_.pop());
     try_var(output, pop_addr());
     try_var(input, pop_addr());
-    try_var(in_shape, module().shape_reg(op.rshape_src));
-    try_var(axis, module().shape_reg(op.rshape_axis));
-    try_var(in_strides, module().shape_reg(op.rstride_src));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    try_ref(in_shape, module().shape_reg(op.rshape_src));
+    try_ref(axis, module().shape_reg(op.rshape_axis));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
 
-    return kernels::reduce(op.reduce_op, init_value.as_r4(), reinterpret_cast<const float *>(input), reinterpret_cast<float *>(output), in_shape, axis, in_strides, out_strides, op.keep_dims, module().kernel_context());
+#define REDUCE_IMPL(type) \
+    return kernels::reduce(op.reduce_op, init_value.as_r4(), reinterpret_cast<const type *>(input), reinterpret_cast<type *>(output), in_shape, axis, in_strides, out_strides, op.keep_dims, module().kernel_context())
+
+    switch (op.datatype)
+    {
+    case dt_float32:
+        REDUCE_IMPL(float);
+    case dt_float16:
+        REDUCE_IMPL(half);
+    case dt_bfloat16:
+        REDUCE_IMPL(bfloat16);
+    default:
+        return err(nncase_errc::datatype_mismatch);
+    }
+#undef REDUCE_IMPL
 }
@@ -25,10 +25,10 @@ result<void> stackvm_runtime_function::visit(const tensor_reduce_arg_op_t &op) n
 {
     try_var(output, pop_addr());
     try_var(input, pop_addr());
-    try_var(in_shape, module().shape_reg(op.rshape_src));
-    try_var(axis, module().shape_reg(op.rshape_axis));
-    try_var(in_strides, module().shape_reg(op.rstride_src));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    try_ref(in_shape, module().shape_reg(op.rshape_src));
+    try_ref(axis, module().shape_reg(op.rshape_axis));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
 
     switch (op.datatype_dest)
     {
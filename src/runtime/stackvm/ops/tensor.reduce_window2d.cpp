@@ -26,9 +26,9 @@ result<void> stackvm_runtime_function::visit(const tensor_reduce_window2d_op_t &
     try_var(output, pop_addr());
     try_var(init_value, stack_.pop());
     try_var(input, pop_addr());
-    try_var(in_shape, module().shape_reg(op.rshape_src));
-    try_var(in_strides, module().shape_reg(op.rstride_src));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    try_ref(in_shape, module().shape_reg(op.rshape_src));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
 
     if (op.datatype != dt_float32)
         return err(nncase_errc::datatype_mismatch);
@@ -28,9 +28,9 @@ result<void> stackvm_runtime_function::visit(const tensor_resize_image_op_t &op)
 
     auto out_h = h.as_i4();
     auto out_w = w.as_i4();
-    try_var(in_shape, module().shape_reg(op.rshape_src));
-    try_var(in_strides, module().shape_reg(op.rstride_src));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    try_ref(in_shape, module().shape_reg(op.rshape_src));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
     if (op.image_resize_mode == image_resize_bilinear)
     {
         return kernels::resize_bilinear(op.datatype, reinterpret_cast<gsl::byte *>(input), reinterpret_cast<gsl::byte *>(output),
@@ -23,12 +23,12 @@ result<void> stackvm_runtime_function::visit(const tensor_slice_op_t &op) noexce
 {
     try_var(output, pop_addr());
     try_var(input, pop_addr());
-    try_var(shape, module().shape_reg(op.rshape_src));
-    try_var(in_strides, module().shape_reg(op.rstride_src));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
-    try_var(begins, module().shape_reg(op.rbegins));
-    try_var(ends, module().shape_reg(op.rends));
-    try_var(strides, module().shape_reg(op.rstrides));
+    try_ref(shape, module().shape_reg(op.rshape_src));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
+    try_ref(begins, module().shape_reg(op.rbegins));
+    try_ref(ends, module().shape_reg(op.rends));
+    try_ref(strides, module().shape_reg(op.rstrides));
 
     return kernels::slice(op.datatype, reinterpret_cast<const gsl::byte *>(input), reinterpret_cast<gsl::byte *>(output), shape, in_strides, out_strides, begins, as_runtime_axis(ends), as_runtime_axis(strides), module().kernel_context());
 }
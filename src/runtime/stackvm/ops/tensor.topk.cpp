@@ -26,18 +26,18 @@ result<void> stackvm_runtime_function::visit(const tensor_topk_op_t &op) noexcep
     try_var(output_b, pop_addr());
     try_var(output_a, pop_addr());
     try_var(input, pop_addr());
-    try_var(in_shape, module().shape_reg(op.rshape_src));
-    try_var(in_strides, module().shape_reg(op.rstride_src));
-    try_var(out_a_shape, module().shape_reg(op.rshape_dest1));
-    try_var(out_a_strides, module().shape_reg(op.rstride_dest1));
-    try_var(out_b_shape, module().shape_reg(op.rshape_dest2));
-    try_var(out_b_strides, module().shape_reg(op.rstride_dest2));
+    try_ref(in_shape, module().shape_reg(op.rshape_src));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(out_a_shape, module().shape_reg(op.rshape_dest1));
+    try_ref(out_a_strides, module().shape_reg(op.rstride_dest1));
+    try_ref(out_b_shape, module().shape_reg(op.rshape_dest2));
+    try_ref(out_b_strides, module().shape_reg(op.rstride_dest2));
 
     switch (op.datatype)
     {
     case dt_float32:
         return kernels::topk(reinterpret_cast<const float *>(input), reinterpret_cast<float *>(output_a), reinterpret_cast<int64_t *>(output_b),
-            in_shape, in_strides, out_a_shape, out_a_strides, out_b_shape, out_b_strides, op.k, op.axis, op.largest, op.sorted);
+            in_shape, in_strides, out_a_shape, out_a_strides, out_b_shape, out_b_strides, op.k, op.axis, op.largest, op.sorted, module().kernel_context());
         break;
     default:
         std::cerr << "unsupported dtype for ternary: " + std::string(datatype_names(op.datatype));
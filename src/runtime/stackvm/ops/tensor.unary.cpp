@@ -23,9 +23,23 @@ result<void> stackvm_runtime_function::visit(const tensor_unary_op_t &op) noexce
 {
     try_var(output, pop_addr());
     try_var(input, pop_addr());
-    try_var(shape, module().shape_reg(op.rshape_src));
-    try_var(in_strides, module().shape_reg(op.rstride_src));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    try_ref(shape, module().shape_reg(op.rshape_src));
+    try_ref(in_strides, module().shape_reg(op.rstride_src));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
 
-    return kernels::unary(op.unary_op, reinterpret_cast<const float *>(input), reinterpret_cast<float *>(output), shape, in_strides, out_strides, module().kernel_context());
+#define UNARY_IMPL(type) \
+    return kernels::unary(op.unary_op, reinterpret_cast<const type *>(input), reinterpret_cast<type *>(output), shape, in_strides, out_strides, module().kernel_context())
+
+    switch (op.datatype)
+    {
+    case dt_float32:
+        UNARY_IMPL(float);
+    case dt_float16:
+        UNARY_IMPL(half);
+    case dt_bfloat16:
+        UNARY_IMPL(bfloat16);
+    default:
+        return err(nncase_errc::datatype_mismatch);
+    }
+#undef UNARY_IMPL
 }
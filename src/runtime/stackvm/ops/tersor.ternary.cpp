@@ -27,13 +27,13 @@ result<void> stackvm_runtime_function::visit(const tensor_ternary_op_t &op) noex
     try_var(input_c, pop_addr());
     try_var(input_b, pop_addr());
     try_var(input_a, pop_addr());
-    try_var(in_a_shape, module().shape_reg(op.rshape_src1));
-    try_var(in_a_strides, module().shape_reg(op.rstride_src1));
-    try_var(in_b_shape, module().shape_reg(op.rshape_src2));
-    try_var(in_b_strides, module().shape_reg(op.rstride_src2));
-    try_var(in_c_shape, module().shape_reg(op.rshape_src3));
-    try_var(in_c_strides, module().shape_reg(op.rstride_src3));
-    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    try_ref(in_a_shape, module().shape_reg(op.rshape_src1));
+    try_ref(in_a_strides, module().shape_reg(op.rstride_src1));
+    try_ref(in_b_shape, module().shape_reg(op.rshape_src2));
+    try_ref(in_b_strides, module().shape_reg(op.rstride_src2));
+    try_ref(in_c_shape, module().shape_reg(op.rshape_src3));
+    try_ref(in_c_strides, module().shape_reg(op.rstride_src3));
+    try_ref(out_strides, module().shape_reg(op.rstride_dest));
 
     switch (op.datatype)
     {
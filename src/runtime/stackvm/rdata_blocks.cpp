@@ -0,0 +1,81 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "rdata_blocks.h"
+#include <algorithm>
+#include <nncase/runtime/dbg.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+result<void> rdata_blocks::reserve(size_t count) noexcept
+{
+    try
+    {
+        blocks_.reserve(count);
+        addrs_.reserve(count);
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+
+    return ok();
+}
+
+result<void> rdata_blocks::add(size_t start, size_t size, constant_registry::block_t data) noexcept
+{
+    CHECK_WITH_ERR(blocks_.empty() || start >= blocks_.back().start + blocks_.back().size, std::errc::invalid_argument);
+    auto addr = reinterpret_cast<uintptr_t>(data.get());
+    try
+    {
+        blocks_.push_back({ start, size, std::move(data) });
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+
+    try
+    {
+        auto it = std::upper_bound(addrs_.begin(), addrs_.end(), addr, [](uintptr_t value, const std::pair<uintptr_t, size_t> &b) { return value < b.first; });
+        addrs_.emplace(it, addr, size);
+    }
+    catch (...)
+    {
+        blocks_.pop_back();
+        return err(std::errc::not_enough_memory);
+    }
+
+    return ok();
+}
+
+result<const gsl::byte *> rdata_blocks::at(size_t offset) const noexcept
+{
+    auto it = std::upper_bound(blocks_.begin(), blocks_.end(), offset, [](size_t value, const block &b) { return value < b.start; });
+    CHECK_WITH_ERR(it != blocks_.begin(), std::errc::result_out_of_range);
+    --it;
+    CHECK_WITH_ERR(offset - it->start <= it->size, std::errc::result_out_of_range);
+    return ok(it->data.get() + (offset - it->start));
+}
+
+bool rdata_blocks::contains(uintptr_t addr) const noexcept
+{
+    auto it = std::upper_bound(addrs_.begin(), addrs_.end(), addr, [](uintptr_t value, const std::pair<uintptr_t, size_t> &b) { return value < b.first; });
+    if (it == addrs_.begin())
+        return false;
+    --it;
+    return addr - it->first < it->second;
+}
@@ -0,0 +1,56 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nncase/runtime/constant_registry.h>
+#include <nncase/runtime/result.h>
+#include <vector>
+
+BEGIN_NS_NNCASE_RT_MODULE(stackvm)
+
+/**
+ * @brief The .rdata of a module as constant blocks taken from the registry.
+ *
+ * Offsets into .rdata are mapped to the block holding them, and addresses of the
+ * shared blocks are recognized as .rdata.
+ */
+class NNCASE_API rdata_blocks
+{
+public:
+    bool empty() const noexcept { return blocks_.empty(); }
+
+    result<void> reserve(size_t count) noexcept;
+
+    /**
+     * @brief Blocks are added in ascending order of their offset and must not overlap.
+     */
+    result<void> add(size_t start, size_t size, constant_registry::block_t data) noexcept;
+
+    result<const gsl::byte *> at(size_t offset) const noexcept;
+    bool contains(uintptr_t addr) const noexcept;
+
+private:
+    struct block
+    {
+        size_t start;
+        size_t size;
+        constant_registry::block_t data;
+    };
+
+    std::vector<block> blocks_;
+    // Sorted by address, shared blocks are not in .rdata order
+    std::vector<std::pair<uintptr_t, size_t>> addrs_;
+};
+
+END_NS_NNCASE_RT_MODULE
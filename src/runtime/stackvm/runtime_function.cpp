@@ -13,8 +13,11 @@
  * limitations under the License.
  */
 #include "runtime_function.h"
+#include <cstring>
+#include <tuple>
 #include <nncase/runtime/dbg.h>
 #include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/interpreter.h>
 #include <nncase/runtime/runtime_op_utility.h>
 
 using namespace nncase;
@@ -29,17 +32,147 @@ stackvm_runtime_module &stackvm_runtime_function::module() const noexcept
 result<void> stackvm_runtime_function::initialize_core(runtime_function_init_context &context) noexcept
 {
     text_ = context.module_init_context().section(".text").subspan(context.header().entrypoint, context.header().text_size);
+    return build_plan();
+}
+
+result<void> stackvm_runtime_function::build_plan() noexcept
+{
+    std::vector<std::tuple<decltype(plan_step::invoke), size_t, void *>> steps;
+    span_reader reader(text_);
+    bool supported = true;
+    bool returned = false;
+    bool call_pending = false;
+
+    try
+    {
+        while (supported && !returned && !reader.empty())
+        {
+            auto decoded = decode_op(reader, [&](auto op) -> result<void> {
+                using op_t = decltype(op);
+                static_assert(std::is_trivially_copyable_v<op_t>);
+                if constexpr (std::is_same_v<op_t, br_op_t> || std::is_same_v<op_t, br_true_op_t>
+                    || std::is_same_v<op_t, br_false_op_t> || std::is_same_v<op_t, call_op_t>
+                    || std::is_same_v<op_t, ecall_op_t> || std::is_same_v<op_t, throw_op_t>
+                    || std::is_same_v<op_t, break_op_t>)
+                {
+                    supported = false;
+                }
+                else if constexpr (std::is_same_v<op_t, ret_op_t>)
+                {
+                    // Without calls, ret always leaves the function
+                    returned = true;
+                }
+                else if constexpr (!std::is_same_v<op_t, nop_op_t>)
+                {
+                    // Ops that only work on the stack or shape registers can't observe a call in flight
+                    constexpr bool touches_memory = !(std::is_same_v<op_t, tensor_call_op_t>
+                        || std::is_same_v<op_t, ldnull_op_t> || std::is_same_v<op_t, ldc_i4_op_t>
+                        || std::is_same_v<op_t, ldc_i4_0_op_t> || std::is_same_v<op_t, ldc_i4_1_op_t>
+                        || std::is_same_v<op_t, ldc_r4_op_t> || std::is_same_v<op_t, lea_gp_op_t>
+                        || std::is_same_v<op_t, lea_buffer_op_t> || std::is_same_v<op_t, stshape_op_t>
+                        || std::is_same_v<op_t, stpaddings_op_t> || std::is_same_v<op_t, dup_op_t>
+                        || std::is_same_v<op_t, pop_op_t>);
+                    if (call_pending && touches_memory)
+                    {
+                        steps.emplace_back(&join_calls_step, 0, nullptr);
+                        call_pending = false;
+                    }
+
+                    if constexpr (std::is_same_v<op_t, tensor_call_op_t>)
+                        call_pending = plan_has_calls_ = true;
+
+                    auto offset = (plan_ops_.size() + alignof(op_t) - 1) / alignof(op_t) * alignof(op_t);
+                    plan_ops_.resize(offset + sizeof(op_t));
+                    std::memcpy(plan_ops_.data() + offset, &op, sizeof(op_t));
+
+                    if constexpr (std::is_same_v<op_t, tensor_copy_op_t>)
+                        steps.emplace_back(&invoke_bound_step<op_t, copy_binding>, offset, &copy_bindings_.emplace_back());
+                    else if constexpr (std::is_same_v<op_t, tensor_conv2d_op_t>)
+                        steps.emplace_back(&invoke_bound_step<op_t, conv2d_binding>, offset, &conv2d_bindings_.emplace_back());
+                    else
+                        steps.emplace_back(&invoke_step<op_t>, offset, nullptr);
+                }
+
+                return ok();
+            });
+
+            // Leave invalid text to fail at invoke as before
+            if (decoded.is_err())
+                supported = false;
+        }
+
+        if (call_pending)
+            steps.emplace_back(&join_calls_step, 0, nullptr);
+
+        if (supported)
+        {
+            plan_.reserve(steps.size());
+            for (auto &[invoke, offset, binding] : steps)
+                plan_.push_back({ invoke, plan_ops_.data() + offset, binding });
+        }
+        else
+        {
+            plan_ops_.clear();
+            plan_has_calls_ = false;
+            copy_bindings_.clear();
+            conv2d_bindings_.clear();
+        }
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+
+    use_plan_ = supported;
+    return ok();
+}
+
+result<void> stackvm_runtime_function::run_plan() noexcept
+{
+    for (auto &step : plan_)
+    {
+        auto r = step.invoke(*this, step.op, step.binding);
+        if (r.is_err())
+        {
+#ifdef NNCASE_ASYNC_RUNTIME
+            // Calls in flight may still write to the buffers
+            if (calls_)
+                (void)calls_->wait_all();
+#endif
+            return r;
+        }
+    }
+
     return ok();
 }
 
+result<void> stackvm_runtime_function::join_calls_step(NNCASE_UNUSED stackvm_runtime_function &function, NNCASE_UNUSED const gsl::byte *op, NNCASE_UNUSED void *binding) noexcept
+{
+#ifdef NNCASE_ASYNC_RUNTIME
+    if (function.calls_)
+        return function.calls_->wait_all();
+#endif
+    return ok();
+}
+
+size_t stackvm_runtime_function::max_batch() const noexcept
+{
+    return module().max_batch();
+}
+
+result<void> stackvm_runtime_function::batch_core(size_t value) noexcept
+{
+    return module().batch(value);
+}
+
 result<runtime_tensor> stackvm_runtime_function::allocate_input_tensor(size_t index) noexcept
 {
-    return host_runtime_tensor::create(input_desc(index).datatype, input_shape(index));
+    return allocate_host_tensor(input_desc(index).datatype, input_shape(index));
 }
 
 result<runtime_tensor> stackvm_runtime_function::allocate_output_tensor(size_t index) noexcept
 {
-    return host_runtime_tensor::create(output_desc(index).datatype, output_shape(index));
+    return allocate_host_tensor(output_desc(index).datatype, output_shape(index));
 }
 
 result<void> stackvm_runtime_function::validate_input_tensor(NNCASE_UNUSED size_t index, runtime_tensor tensor) noexcept
@@ -59,6 +192,31 @@ result<void> stackvm_runtime_function::validate_output_tensor(NNCASE_UNUSED size
 result<void> stackvm_runtime_function::invoke_core() noexcept
 {
     call_depth_ = 0;
+    if (use_plan_)
+    {
+#ifdef NNCASE_ASYNC_RUNTIME
+        if (plan_has_calls_ && module().interp().concurrent_calls())
+        {
+            if (!calls_)
+            {
+                try
+                {
+                    calls_ = std::make_unique<call_scheduler>();
+                }
+                catch (...)
+                {
+                    return err(std::errc::not_enough_memory);
+                }
+            }
+        }
+        else
+        {
+            calls_.reset();
+        }
+#endif
+        return run_plan();
+    }
+
     return visit(text_);
 }
 
@@ -148,8 +306,7 @@ result<runtime_tensor> stackvm_runtime_function::create_tensor(uintptr_t addr, d
     {
         pool = hrt::pool_cpu_only;
     }
-    else if (addr >= reinterpret_cast<uintptr_t>(module().rdata().begin())
-        && addr < reinterpret_cast<uintptr_t>(module().rdata().end()))
+    else if (module().is_rdata(addr))
     {
         pool = hrt::pool_cpu_only;
     }
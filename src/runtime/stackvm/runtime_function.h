@@ -15,9 +15,15 @@
 #pragma once
 #include "evaluate_stack.h"
 #include "runtime_module.h"
+#include <deque>
+#include <nncase/kernels/convolution.h>
 #include <nncase/kernels/kernel_context.h>
+#include <nncase/kernels/tensor_compute.h>
 #include <nncase/runtime/runtime_function.h>
 #include <nncase/runtime/stackvm/op_reader.h>
+#ifdef NNCASE_ASYNC_RUNTIME
+#include "call_scheduler.h"
+#endif
 
 BEGIN_NS_NNCASE_RT_MODULE(stackvm)
 
@@ -27,6 +33,7 @@ public:
     using runtime_function::runtime_function;
 
     stackvm_runtime_module &module() const noexcept;
+    size_t max_batch() const noexcept override;
 
 protected:
     result<void> initialize_core(runtime_function_init_context &context) noexcept override;
@@ -35,6 +42,7 @@ protected:
     result<void> validate_input_tensor(size_t index, runtime_tensor tensor) noexcept override;
     result<void> validate_output_tensor(size_t index, runtime_tensor tensor) noexcept override;
     result<void> invoke_core() noexcept override;
+    result<void> batch_core(size_t value) noexcept override;
 
     using op_visitor::visit;
     result<void> visit(const nop_op_t &op) noexcept override;
@@ -150,8 +158,10 @@ protected:
     result<void> visit(const tensor_hardmax_op_t &op) noexcept override;
     result<void> visit(const tensor_gather_nd_op_t &op) noexcept override;
     result<void> visit(const tensor_lut1d_op_t &op) noexcept override;
+    result<void> visit(const tensor_matmul_op_t &op) noexcept override;
     result<void> visit(const tensor_onehot_op_t &op) noexcept override;
     result<void> visit(const tensor_pad_op_t &op) noexcept override;
+    result<void> visit(const tensor_preprocess_op_t &op) noexcept override;
     result<void> visit(const tensor_quantize_op_t &op) noexcept override;
     result<void> visit(const tensor_random_normal_op_t &op) noexcept override;
     result<void> visit(const tensor_random_uniform_op_t &op) noexcept override;
@@ -167,6 +177,66 @@ protected:
     result<void> visit(const tensor_unary_op_t &op) noexcept override;
 
 private:
+    /**
+     * @brief A pre-decoded op bound to its handler.
+     *
+     * Straight-line functions are executed as a flat array of steps, functions with
+     * branches or calls fall back to decoding the text.
+     */
+    struct plan_step
+    {
+        result<void> (*invoke)(stackvm_runtime_function &function, const gsl::byte *op, void *binding) noexcept;
+        const gsl::byte *op;
+        void *binding;
+    };
+
+    /**
+     * @brief Kernel plans bound to a step.
+     *
+     * A straight-line plan takes its shapes and paddings from immediates and the batch
+     * register only, so a plan made on the first run at a batch size holds until the
+     * batch changes. With a kernel tuner the plan is its pick among the variants that
+     * support the shapes.
+     */
+    struct copy_binding
+    {
+        size_t batch = 0; // 0 until the first run
+        kernels::copy_plan plan;
+    };
+
+    struct conv2d_binding
+    {
+        size_t batch = 0; // 0 until the first run
+        kernels::conv2d_plan plan;
+        uint32_t num_threads = 0; // 0 follows the module
+    };
+
+    template <class TOp>
+    static result<void> invoke_step(stackvm_runtime_function &function, const gsl::byte *op, NNCASE_UNUSED void *binding) noexcept
+    {
+        return function.stackvm_runtime_function::visit(*reinterpret_cast<const TOp *>(op));
+    }
+
+    /**
+     * @brief Waits for the tensor calls started by the steps before.
+     *
+     * It goes before the first step after a run of calls that may touch memory,
+     * so only consecutive calls overlap.
+     */
+    static result<void> join_calls_step(stackvm_runtime_function &function, NNCASE_UNUSED const gsl::byte *op, NNCASE_UNUSED void *binding) noexcept;
+
+    template <class TOp, class TBinding>
+    static result<void> invoke_bound_step(stackvm_runtime_function &function, const gsl::byte *op, void *binding) noexcept
+    {
+        return function.visit(*reinterpret_cast<const TOp *>(op), reinterpret_cast<TBinding *>(binding));
+    }
+
+    result<void> visit(const tensor_conv2d_op_t &op, conv2d_binding *binding) noexcept;
+    result<void> visit(const tensor_copy_op_t &op, copy_binding *binding) noexcept;
+
+    result<void> build_plan() noexcept;
+    result<void> run_plan() noexcept;
+
     uintptr_t pc() const noexcept;
     result<void> pc(uintptr_t value) noexcept;
     result<void> pc_relative(intptr_t offset) noexcept;
@@ -185,6 +255,15 @@ private:
 
 private:
     gsl::span<const gsl::byte> text_;
+    std::vector<plan_step> plan_;
+    std::vector<gsl::byte> plan_ops_;
+    std::deque<copy_binding> copy_bindings_;
+    std::deque<conv2d_binding> conv2d_bindings_;
+    bool use_plan_ = false;
+    bool plan_has_calls_ = false;
+#ifdef NNCASE_ASYNC_RUNTIME
+    std::unique_ptr<call_scheduler> calls_;
+#endif
     evaluate_stack stack_;
     size_t call_depth_;
 };
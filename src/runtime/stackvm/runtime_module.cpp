@@ -16,7 +16,9 @@
 #include "runtime_function.h"
 #include <nncase/runtime/dbg.h>
 #include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/interpreter.h>
 #include <nncase/runtime/runtime_op_utility.h>
+#include <nncase/runtime/span_reader.h>
 
 using namespace nncase;
 using namespace nncase::runtime;
@@ -24,7 +26,7 @@ using namespace nncase::runtime::stackvm;
 
 gsl::span<gsl::byte> stackvm_runtime_module::data() const noexcept
 {
-    return { data_.get(), mempool(mem_data).size };
+    return { data_.get(), mempool(mem_data).size * batch_ };
 }
 
 gsl::span<const gsl::byte> stackvm_runtime_module::rdata() const noexcept
@@ -32,18 +34,99 @@ gsl::span<const gsl::byte> stackvm_runtime_module::rdata() const noexcept
     return rdata_;
 }
 
+result<const gsl::byte *> stackvm_runtime_module::rdata_at(size_t offset) const noexcept
+{
+    if (!rdata_blocks_.empty())
+        return rdata_blocks_.at(offset);
+
+    CHECK_WITH_ERR(offset <= rdata_.size(), std::errc::result_out_of_range);
+    return ok(rdata_.data() + offset);
+}
+
+bool stackvm_runtime_module::is_rdata(uintptr_t addr) const noexcept
+{
+    if (!rdata_blocks_.empty())
+        return rdata_blocks_.contains(addr);
+
+    return addr >= reinterpret_cast<uintptr_t>(rdata_.data()) && addr < reinterpret_cast<uintptr_t>(rdata_.data() + rdata_.size());
+}
+
+// Constant blocks of .rdata are taken from the registry, so models built with the same constants share them
+result<void> stackvm_runtime_module::share_rdata_blocks(gsl::span<const gsl::byte> blocks, gsl::span<const gsl::byte> rdata) noexcept
+{
+    CHECK_WITH_ERR(blocks.size_bytes() % sizeof(rdata_block_desc) == 0, std::errc::invalid_argument);
+    try_(rdata_blocks_.reserve(blocks.size_bytes() / sizeof(rdata_block_desc)));
+
+    span_reader reader(blocks);
+    while (!reader.empty())
+    {
+        auto desc = reader.read<rdata_block_desc>();
+        CHECK_WITH_ERR((size_t)desc.start + desc.size <= rdata.size_bytes(), std::errc::invalid_argument);
+        try_var(block, constant_registry::acquire(desc.hash, rdata.subspan(desc.start, desc.size)));
+        try_(rdata_blocks_.add(desc.start, desc.size, std::move(block)));
+    }
+
+    return ok();
+}
+
 result<void> stackvm_runtime_module::initialize_before_functions(runtime_module_init_context &context) noexcept
 {
     assert(context.is_section_pinned());
     auto data_pool = mempool(mem_data);
     if (data_pool.size)
     {
-        data_.reset(new (std::nothrow) gsl::byte[data_pool.size]);
-        if (!data_)
-            return err(std::errc::not_enough_memory);
+        try_set(data_, memory_tracker().allocate_buffer(memory_category_t::data, data_pool.size));
+        data_capacity_ = data_pool.size;
+    }
+
+    auto rdata_blocks = context.section(".rdata_blocks");
+    if (!rdata_blocks.empty())
+    {
+        // The decompressed .rdata is only needed until its blocks are shared
+        try_var(rdata, context.take_compressed_section(".rdata"));
+        if (rdata)
+            try_(share_rdata_blocks(rdata_blocks, { rdata.get(), rdata.get_deleter().bytes }));
+    }
+
+    if (rdata_blocks_.empty())
+        rdata_ = context.section(".rdata");
+
+    auto batch_section = context.section(".batch");
+    if (!batch_section.empty())
+    {
+        span_reader reader(batch_section);
+        max_batch_ = reader.read<uint32_t>();
+    }
+
+    regs_[stackvm_batch_reg] = batch_;
+    kernel_context_.scratch_allocator = &memory_tracker();
+    return ok();
+}
+
+size_t stackvm_runtime_module::max_batch() const noexcept
+{
+    return max_batch_;
+}
+
+size_t stackvm_runtime_module::batch() const noexcept
+{
+    return batch_;
+}
+
+result<void> stackvm_runtime_module::batch(size_t value) noexcept
+{
+    CHECK_WITH_ERR(value >= 1 && value <= max_batch_, std::errc::invalid_argument);
+
+    auto data_size = (size_t)mempool(mem_data).size * value;
+    if (data_size > data_capacity_)
+    {
+        try_var(data, memory_tracker().allocate_buffer(memory_category_t::data, data_size));
+        data_ = std::move(data);
+        data_capacity_ = data_size;
     }
 
-    rdata_ = context.section(".rdata");
+    batch_ = value;
+    regs_[stackvm_batch_reg] = value;
     return ok();
 }
 
@@ -60,10 +143,10 @@ result<void> stackvm_runtime_module::reg(size_t id, uintptr_t value) noexcept
     return ok();
 }
 
-result<runtime_shape_t> stackvm_runtime_module::shape_reg(size_t id) const noexcept
+result<std::reference_wrapper<const runtime_shape_t>> stackvm_runtime_module::shape_reg(size_t id) const noexcept
 {
     CHECK_WITH_ERR(id < shape_regs_.size(), std::errc::result_out_of_range);
-    return ok(shape_regs_[id]);
+    return ok(std::cref(shape_regs_[id]));
 }
 
 result<void> stackvm_runtime_module::shape_reg(size_t id, runtime_shape_t value) noexcept
@@ -106,7 +189,10 @@ result<void> stackvm_runtime_module::paddings_reg(size_t id, runtime_paddings_t
 
 kernels::kernel_context &stackvm_runtime_module::kernel_context() noexcept
 {
-    return kernels::default_kernel_context();
+    // Follow the thread count of the default context, scratch is counted by this module
+    kernel_context_.num_threads = kernels::default_kernel_context().num_threads;
+    kernel_context_.tuner = interp().tuner();
+    return kernel_context_;
 }
 
 result<std::unique_ptr<runtime_function>> stackvm_runtime_module::create_function() noexcept
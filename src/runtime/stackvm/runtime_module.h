@@ -14,6 +14,7 @@
  */
 #pragma once
 #include "evaluate_stack.h"
+#include "rdata_blocks.h"
 #include <nncase/kernels/kernel_context.h>
 #include <nncase/runtime/stackvm/runtime_module.h>
 
@@ -28,11 +29,17 @@ public:
 
     gsl::span<gsl::byte> data() const noexcept;
     gsl::span<const gsl::byte> rdata() const noexcept;
+    result<const gsl::byte *> rdata_at(size_t offset) const noexcept;
+    bool is_rdata(uintptr_t addr) const noexcept;
+
+    size_t max_batch() const noexcept;
+    size_t batch() const noexcept;
+    result<void> batch(size_t value) noexcept;
 
     result<uintptr_t> reg(size_t id) const noexcept;
     result<void> reg(size_t id, uintptr_t value) noexcept;
 
-    result<runtime_shape_t> shape_reg(size_t id) const noexcept;
+    result<std::reference_wrapper<const runtime_shape_t>> shape_reg(size_t id) const noexcept;
     result<void> shape_reg(size_t id, runtime_shape_t value) noexcept;
 
     result<runtime_paddings_t> paddings_reg(size_t id) const noexcept;
@@ -43,11 +50,19 @@ protected:
     result<std::unique_ptr<runtime_function>> create_function() noexcept override;
 
 private:
-    std::unique_ptr<gsl::byte[]> data_;
+    result<void> share_rdata_blocks(gsl::span<const gsl::byte> blocks, gsl::span<const gsl::byte> rdata) noexcept;
+
+private:
+    allocation_tracker::buffer_t data_;
+    size_t data_capacity_ = 0;
     gsl::span<const gsl::byte> rdata_;
+    rdata_blocks rdata_blocks_;
+    size_t max_batch_ = 1;
+    size_t batch_ = 1;
     std::array<uintptr_t, MAX_GENERAL_REGS> regs_;
     std::vector<runtime_shape_t> shape_regs_;
     std::vector<runtime_paddings_t> paddings_regs_;
+    kernels::kernel_context kernel_context_;
 };
 
 END_NS_NNCASE_RT_MODULE
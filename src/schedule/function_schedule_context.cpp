@@ -191,6 +191,7 @@ void function_schedule_context::analyze_buffer_alias()
     pmgr.add_pass<alias_bitcast_buffer_pass>();
     pmgr.add_pass<alias_concat_buffer_pass>();
     pmgr.add_pass<alias_bitcast_buffer_pass>();
+    pmgr.add_pass<alias_inplace_buffer_pass>();
     pmgr.run();
 }
 
@@ -293,7 +294,8 @@ void function_schedule_context::assign_allocations()
             alloc.strides_shape = lbuf.strides_shape();
             alloc.strides = to_strides(alloc.strides_shape);
             alloc.start = memory.start;
-            alloc.start += *lbuf.absolute_offset();
+            alloc.parent_offset = *lbuf.absolute_offset();
+            alloc.start += alloc.parent_offset;
 
             module->allocations.emplace(out, alloc);
         }
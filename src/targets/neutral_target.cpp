@@ -189,9 +189,10 @@ void neutral_target::register_target_independent_passes(const module_type_t &typ
             p.emplace<lstm_transform>();
             pass_mgr.add_pass(std::move(p));
         }
-        //matmul to conv2d
+        //matmul to conv2d, only fully connected layers with constant weights, other matmuls run natively
         {
             transform_pass p("matmul_to_conv2d");
+            p.emplace<fold_constant_transform>();
             p.emplace<matmul_to_conv2d_transform>();
             pass_mgr.add_pass(std::move(p));
         }
@@ -283,3 +284,17 @@ void neutral_target::add_quantization_broadcast([[maybe_unused]] std::unordered_
     opcodes.emplace(op_slice);
     opcodes.emplace(op_reduce_window2d);
 }
+
+void neutral_target::add_inplace_ops(const module_type_t &type, std::unordered_set<ir::node_opcode> &opcodes)
+{
+    using namespace ir;
+
+    // StackVM kernels of these ops read each element before writing the same position
+    if (type == runtime::stackvm::stackvm_module_type)
+    {
+        opcodes.emplace(op_binary);
+        opcodes.emplace(op_convert);
+        opcodes.emplace(op_table_lookup1d);
+        opcodes.emplace(op_unary);
+    }
+}
@@ -44,6 +44,10 @@ void target::add_quantization_broadcast([[maybe_unused]] std::unordered_set<ir::
 {
 }
 
+void target::add_inplace_ops([[maybe_unused]] const module_type_t &type, [[maybe_unused]] std::unordered_set<ir::node_opcode> &opcodes)
+{
+}
+
 void target::register_target_dependent_after_quantization_passes([[maybe_unused]] const module_type_t &type, [[maybe_unused]] ir::transforms::pass_manager &pass_mgr)
 {
 }
@@ -28,23 +28,46 @@ using namespace nncase::schedule;
 namespace
 {
 std::unordered_set<node_opcode> dontfold_ops {};
+
+bool can_fold(node &node)
+{
+    return (node.attributes() & node_attr_skip_constant_folding) == 0
+        && dontfold_ops.find(node.runtime_opcode()) == dontfold_ops.end()
+        && node.inputs().size();
+}
 }
 
 bool fold_constant_transform::on_try_match(node &node, transform_context &context)
 {
-    if ((node.attributes() & node_attr_skip_constant_folding) == 0
-        && dontfold_ops.find(node.runtime_opcode()) == dontfold_ops.end()
-        && node.inputs().size() && std::all_of(node.inputs().begin(), node.inputs().end(), [](input_connector *in) { return in->connection()->owner().runtime_opcode() == op_constant; }))
+    if (can_fold(node)
+        && std::all_of(node.inputs().begin(), node.inputs().end(), [](input_connector *in) { return in->connection()->owner().runtime_opcode() == op_constant; }))
     {
-        for (auto &in : node.inputs())
-            context.inputs.emplace_back(in);
-        for (auto out : node.outputs())
-            context.outputs.emplace_back(out);
+        // Grow the match to every node computable from constants so the whole subgraph is evaluated at once
+        std::unordered_set<ir::node *> folded;
+        auto visitor = make_relay_ir_visitor([&](ir::node &n) {
+            if (can_fold(n)
+                && std::all_of(n.inputs().begin(), n.inputs().end(), [&](input_connector *in) {
+                       auto &owner = in->connection()->owner();
+                       return owner.runtime_opcode() == op_constant || folded.contains(&owner);
+                   }))
+            {
+                folded.emplace(&n);
+                context.matched_nodes.emplace_back(&n);
+            }
+        });
+        visitor.visit(context.graph);
 
-        context.matched_nodes.emplace_back(&node);
-        for (auto in : node.inputs())
-            context.matched_nodes.emplace_back(&in->connection()->owner());
-        return true;
+        // Only values used outside the subgraph need to be materialized
+        for (auto n : context.matched_nodes)
+        {
+            for (auto out : n->outputs())
+            {
+                if (std::any_of(out->connections().begin(), out->connections().end(), [&](input_connector *in) { return !folded.contains(&in->owner()); }))
+                    context.outputs.emplace_back(out);
+            }
+        }
+
+        return !context.outputs.empty();
     }
 
     return false;
@@ -52,19 +75,14 @@ bool fold_constant_transform::on_try_match(node &node, transform_context &contex
 
 void fold_constant_transform::process(transform_context &context)
 {
-    //auto &output = *context.inputs[0]->connection();
-    //auto inputs = context.outputs[0]->connections();
-
-    auto &old_op = *context.matched_nodes[0];
-
-    // 1. Construct new eval graph
+    // 1. Construct one eval graph for all the values leaving the constant subgraph
     graph new_graph;
     std::vector<output_node *> op_outputs;
     std::vector<constant *> output_values;
-    for (auto out : old_op.outputs())
+    for (auto out : context.outputs)
     {
         auto node = op_outputs.emplace_back(new_graph.emplace<output_node>(out->type(), out->shape()));
-        if (old_op.outputs().size() > 1)
+        if (out->owner().outputs().size() > 1)
             node->name(out->name() + "_F");
         else
             node->name(out->owner().name());
@@ -93,10 +111,9 @@ void fold_constant_transform::process(transform_context &context)
     for (auto &out : op_outputs)
         out->input().clear_connection();
 
-    for (size_t i = 0; i < old_op.outputs().size(); i++)
+    for (size_t i = 0; i < context.outputs.size(); i++)
     {
-        auto &out = old_op.outputs()[i];
-        for (auto &in : dup(out->connections()))
+        for (auto &in : dup(context.outputs[i]->connections()))
             in->connect(output_values[i]->output());
     }
 }
@@ -0,0 +1,211 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/ops/binary.h>
+#include <nncase/ir/ops/concat.h>
+#include <nncase/ir/ops/constant.h>
+#include <nncase/ir/ops/convert.h>
+#include <nncase/ir/ops/dequantize.h>
+#include <nncase/ir/ops/pad.h>
+#include <nncase/ir/ops/preprocess.h>
+#include <nncase/ir/ops/resize_image.h>
+#include <nncase/ir/ops/slice.h>
+#include <nncase/ir/ops/transpose.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/transforms/neutral/fuse_pre_process.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+namespace
+{
+template <class TNode>
+TNode *single_consumer(output_connector &output)
+{
+    auto conns = output.connections();
+    if (conns.size() == 1)
+        return node_cast<TNode>(conns[0]->owner());
+    return nullptr;
+}
+
+bool is_full_range(const value_range<float> &range)
+{
+    return range == value_range<float>::full();
+}
+
+// Reads a scalar or [1, C, 1, 1] float constant into a per-channel vector
+bool get_channel_values(input_connector &input, size_t channels, std::vector<float> &values)
+{
+    auto conn = input.connection();
+    if (!conn)
+        return false;
+    auto cnst = node_cast<constant>(conn->owner());
+    if (!cnst || cnst->output().type() != dt_float32)
+        return false;
+
+    auto data = cnst->data();
+    auto count = data.size() / sizeof(float);
+    auto src = reinterpret_cast<const float *>(data.data());
+    if (count == 1)
+        values.assign(channels, src[0]);
+    else if (count == channels && cnst->output().shape() == shape_t { 1, channels, 1, 1 })
+        values.assign(src, src + count);
+    else
+        return false;
+    return true;
+}
+
+// Matches the slice x 3 -> concat channel reversal emitted for swapRB
+concat *match_swap_rb(output_connector &output)
+{
+    auto conns = output.connections();
+    if (conns.size() != 3 || output.shape()[1] != 3)
+        return nullptr;
+
+    concat *cat = nullptr;
+    for (auto conn : conns)
+    {
+        auto sl = node_cast<slice>(conn->owner());
+        if (!sl || sl->output().connections().size() != 1)
+            return nullptr;
+        auto c = node_cast<concat>(sl->output().connections()[0]->owner());
+        if (!c || c->axis() != 1 || c->inputs().size() != 3 || (cat && cat != c))
+            return nullptr;
+        cat = c;
+
+        auto &in_shape = output.shape();
+        auto &begin = sl->begin();
+        auto &end = sl->end();
+        auto ch = begin[1];
+        if (ch < 0 || ch > 2 || sl->strides() != axis_t { 1, 1, 1, 1 } || sl->begin_mask() || sl->end_mask() || sl->ellipsis_mask() || sl->new_axis_mask()
+            || begin != axis_t { 0, ch, 0, 0 } || end != axis_t { (int32_t)in_shape[0], ch + 1, (int32_t)in_shape[2], (int32_t)in_shape[3] }
+            || c->input_at(2 - ch).connection() != &sl->output())
+            return nullptr;
+    }
+
+    return cat;
+}
+}
+
+void fuse_pre_process_transform::run_core(graph &graph, [[maybe_unused]] nncase::target &target, [[maybe_unused]] const run_pass_options &options)
+{
+    bool changed = false;
+    for (auto in_node : dup(graph.inputs()))
+    {
+        auto &in_out = in_node->output();
+        if (in_out.shape().size() != 4)
+            continue;
+
+        output_connector *mid_ptr = &in_out;
+        quant_param_t dequant { 0, 1.f };
+        bool input_nhwc = false, output_nhwc = false, swap_rb = false;
+        bool letterbox = false, normalize = false;
+
+        if (auto deq = single_consumer<dequantize>(*mid_ptr))
+        {
+            if (deq->output().type() != dt_float32)
+                continue;
+            dequant = deq->quant_param();
+            mid_ptr = &deq->output();
+        }
+
+        auto in_type = in_out.type();
+        if (mid_ptr->type() != dt_float32 || (in_type != dt_uint8 && in_type != dt_int8 && in_type != dt_float32))
+            continue;
+
+        if (auto tp = single_consumer<transpose>(*mid_ptr); tp && tp->perm() == axis_t { 0, 3, 1, 2 })
+        {
+            input_nhwc = true;
+            mid_ptr = &tp->output();
+        }
+
+        auto channels = mid_ptr->shape()[1];
+        if (auto cat = match_swap_rb(*mid_ptr))
+        {
+            swap_rb = true;
+            mid_ptr = &cat->output();
+        }
+
+        std::array<int32_t, 2> resize_shape { (int32_t)mid_ptr->shape()[2], (int32_t)mid_ptr->shape()[3] };
+        xt::svector<padding> paddings { padding::zero(), padding::zero() };
+        float pad_value = 0.f;
+        if (auto rs = single_consumer<resize_image>(*mid_ptr);
+            rs && rs->mode() == image_resize_bilinear && !rs->align_corners() && rs->half_pixel_centers())
+        {
+            auto pd = single_consumer<pad>(rs->output());
+            if (pd && pd->pad_mode() == pad_constant && pd->pad_value().type == dt_float32
+                && pd->paddings()[0] == padding::zero() && pd->paddings()[1] == padding::zero()
+                && pd->paddings()[2].interior == 0 && pd->paddings()[3].interior == 0
+                && pd->paddings()[2].before >= 0 && pd->paddings()[2].after >= 0
+                && pd->paddings()[3].before >= 0 && pd->paddings()[3].after >= 0)
+            {
+                letterbox = true;
+                resize_shape = rs->new_size();
+                paddings = { pd->paddings()[2], pd->paddings()[3] };
+                pad_value = pd->pad_value().as<float>();
+                mid_ptr = &pd->output();
+            }
+        }
+
+        std::vector<float> mean(channels, 0.f), std(channels, 1.f);
+        if (auto in_cvt = single_consumer<convert>(*mid_ptr); in_cvt && in_cvt->new_type() == dt_float32)
+        {
+            auto sub = single_consumer<binary>(in_cvt->output());
+            auto div = sub ? single_consumer<binary>(sub->output()) : nullptr;
+            auto out_cvt = div ? single_consumer<convert>(div->output()) : nullptr;
+            if (out_cvt && out_cvt->new_type() == dt_float32
+                && sub->binary_op() == binary_sub && is_full_range(sub->fused_activation()) && &sub->input_a() == in_cvt->output().connections()[0]
+                && div->binary_op() == binary_div && is_full_range(div->fused_activation()) && &div->input_a() == sub->output().connections()[0]
+                && get_channel_values(sub->input_b(), channels, mean) && get_channel_values(div->input_b(), channels, std))
+            {
+                normalize = true;
+                mid_ptr = &out_cvt->output();
+            }
+        }
+
+        if (auto tp = single_consumer<transpose>(*mid_ptr); tp && tp->perm() == axis_t { 0, 2, 3, 1 })
+        {
+            output_nhwc = true;
+            mid_ptr = &tp->output();
+        }
+
+        // A bare dequantize/transpose is better served by the quant and transpose motion passes
+        if (!swap_rb && !letterbox && !normalize)
+            continue;
+
+        shape_t out_shape { in_out.shape()[0], channels, size_t(resize_shape[0] + paddings[0].sum()), size_t(resize_shape[1] + paddings[1].sum()) };
+        if (output_nhwc)
+            out_shape = { out_shape[0], out_shape[2], out_shape[3], out_shape[1] };
+        if (out_shape != mid_ptr->shape())
+            continue;
+
+        auto pre = graph.emplace<preprocess>(in_type, in_out.shape(), input_nhwc, output_nhwc, swap_rb, dequant, resize_shape, paddings, pad_value);
+        auto mean_c = graph.emplace<constant>(dt_float32, shape_t { channels }, mean);
+        auto std_c = graph.emplace<constant>(dt_float32, shape_t { channels }, std);
+        mean_c->name("preprocess_mean");
+        std_c->name("preprocess_std");
+        pre->name("preprocess");
+        pre->mean().connect(mean_c->output());
+        pre->std().connect(std_c->output());
+
+        for (auto &in : dup(mid_ptr->connections()))
+            in->connect(pre->output());
+        pre->input().connect(in_out);
+        changed = true;
+    }
+
+    if (changed)
+        graph.dce();
+}
@@ -0,0 +1,171 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/ops/binary.h>
+#include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/convert.h>
+#include <nncase/ir/ops/reduce.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/transforms/neutral/lower_float_precision.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+namespace
+{
+// Narrows an input to the lowered float type, fold_convert merges it with the widening convert of the producer
+convert *narrow_input(transform_context &context, input_connector &old_input, datatype_t float_type)
+{
+    auto &output = *old_input.connection();
+    auto cvt = context.graph.emplace<convert>(output.type(), output.shape(), float_type);
+    cvt->name(output.owner().name() + "/" + datatype_names(float_type));
+    cvt->input().connect(output);
+    return cvt;
+}
+
+void widen_output(transform_context &context, output_connector &new_output, output_connector &old_output)
+{
+    auto inputs = old_output.connections();
+    auto cvt = context.graph.emplace<convert>(new_output.type(), new_output.shape(), dt_float32);
+    cvt->name(old_output.owner().name() + "/" + datatype_names(dt_float32));
+    cvt->input().connect(new_output);
+    for (auto &in : dup(inputs))
+        in->connect(cvt->output());
+}
+}
+
+bool lower_binary_float_precision_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto b = node_cast<binary>(node))
+    {
+        if (b->input_a().type() == dt_float32 && b->input_b().type() == dt_float32)
+        {
+            context.inputs.emplace_back(&b->input_a());
+            context.inputs.emplace_back(&b->input_b());
+            context.outputs.emplace_back(&b->output());
+
+            context.matched_nodes.emplace_back(b);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void lower_binary_float_precision_transform::process(transform_context &context)
+{
+    auto &old_b = static_cast<binary &>(*context.matched_nodes[0]);
+
+    auto a = narrow_input(context, *context.inputs[0], float_type_);
+    auto b = narrow_input(context, *context.inputs[1], float_type_);
+    auto new_b = context.graph.emplace<binary>(float_type_, old_b.binary_op(), a->output().shape(), b->output().shape(), old_b.fused_activation());
+    new_b->name(old_b.name());
+    new_b->input_a().connect(a->output());
+    new_b->input_b().connect(b->output());
+    widen_output(context, new_b->output(), *context.outputs[0]);
+}
+
+bool lower_unary_float_precision_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto u = node_cast<unary>(node))
+    {
+        if (u->input().type() == dt_float32)
+        {
+            context.inputs.emplace_back(&u->input());
+            context.outputs.emplace_back(&u->output());
+
+            context.matched_nodes.emplace_back(u);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void lower_unary_float_precision_transform::process(transform_context &context)
+{
+    auto &old_u = static_cast<unary &>(*context.matched_nodes[0]);
+
+    auto input = narrow_input(context, *context.inputs[0], float_type_);
+    auto new_u = context.graph.emplace<unary>(float_type_, old_u.unary_op(), input->output().shape());
+    new_u->name(old_u.name());
+    new_u->input().connect(input->output());
+    widen_output(context, new_u->output(), *context.outputs[0]);
+}
+
+bool lower_reduce_float_precision_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto r = node_cast<reduce>(node))
+    {
+        if (r->input().type() == dt_float32)
+        {
+            context.inputs.emplace_back(&r->input());
+            context.outputs.emplace_back(&r->output());
+
+            context.matched_nodes.emplace_back(r);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void lower_reduce_float_precision_transform::process(transform_context &context)
+{
+    auto &old_r = static_cast<reduce &>(*context.matched_nodes[0]);
+
+    auto input = narrow_input(context, *context.inputs[0], float_type_);
+    auto new_r = context.graph.emplace<reduce>(float_type_, old_r.reduce_op(), input->output().shape(), old_r.axis(), old_r.init_value(), old_r.keep_dims());
+    new_r->name(old_r.name());
+    new_r->input().connect(input->output());
+    widen_output(context, new_r->output(), *context.outputs[0]);
+}
+
+bool lower_conv2d_float_precision_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto conv = node_cast<conv2d>(node))
+    {
+        if (conv->input().type() == dt_float32)
+        {
+            context.inputs.emplace_back(&conv->input());
+            context.inputs.emplace_back(&conv->weights());
+            context.inputs.emplace_back(&conv->bias());
+            context.outputs.emplace_back(&conv->output());
+
+            context.matched_nodes.emplace_back(conv);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void lower_conv2d_float_precision_transform::process(transform_context &context)
+{
+    auto &old_conv = static_cast<conv2d &>(*context.matched_nodes[0]);
+
+    auto input = narrow_input(context, *context.inputs[0], float_type_);
+    auto weights = narrow_input(context, *context.inputs[1], float_type_);
+    auto bias = narrow_input(context, *context.inputs[2], float_type_);
+    auto new_conv = context.graph.emplace<conv2d>(float_type_, input->output().shape(), weights->output().shape(), old_conv.groups(),
+        old_conv.padding_h(), old_conv.padding_w(), old_conv.stride_h(), old_conv.stride_w(), old_conv.dilation_h(), old_conv.dilation_w(),
+        old_conv.fused_activation());
+    new_conv->name(old_conv.name());
+    new_conv->input().connect(input->output());
+    new_conv->weights().connect(weights->output());
+    new_conv->bias().connect(bias->output());
+    widen_output(context, new_conv->output(), *context.outputs[0]);
+}
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include <nncase/ir/ops/bitcast.h>
+#include <nncase/ir/ops/constant.h>
 #include <nncase/ir/ops/conv2d.h>
 #include <nncase/ir/ops/matmul.h>
 #include <nncase/ir/ops/pad.h>
@@ -27,7 +28,11 @@ using namespace nncase::ir::transforms;
 
 bool matmul_to_conv2d_transform::on_try_match(node &node, transform_context &context)
 {
-    if (auto mm = node_cast<matmul>(node))
+    // Only fully connected layers are lowered, batched or transposed matmuls stay native
+    if (auto mm = node_cast<matmul>(node);
+        mm && mm->input_a().shape().size() == 2 && mm->input_b().shape().size() == 2
+        && !mm->transpose_a() && !mm->transpose_b()
+        && try_get_direct_parent<constant>(*mm, 1))
     {
         context.inputs.emplace_back(&mm->input_a());
         context.inputs.emplace_back(&mm->input_b());
@@ -19,6 +19,7 @@
 #include <nncase/ir/ops/slice.h>
 #include <nncase/ir/visitor.h>
 #include <nncase/schedule/scheduler.h>
+#include <nncase/targets/target.h>
 #include <nncase/transforms/neutral/optimize_allocation.h>
 
 using namespace nncase;
@@ -345,3 +346,54 @@ void alias_slice_buffer_pass::run_core(graph &graph, [[maybe_unused]] nncase::ta
     });
     alias_visitor.visit(graph);
 }
+
+void alias_inplace_buffer_pass::run_core(graph &graph, nncase::target &target, const run_pass_options &options)
+{
+    auto &context = *options.schedule_context;
+    std::unordered_set<node_opcode> inplace_ops;
+    target.add_inplace_ops(graph.module_type(), inplace_ops);
+    if (inplace_ops.empty())
+        return;
+
+    // Buffers other buffers alias into must keep their contents
+    std::unordered_set<logical_buffer *> aliased;
+    for (auto &buf : context.logical_buffers())
+    {
+        if (buf.parent())
+            aliased.emplace(buf.parent()->parent);
+    }
+
+    std::unordered_set<logical_buffer *> inplace_buffers;
+    auto alias_visitor = make_relay_ir_visitor([&](node &node) {
+        if (!(node.attributes() & node_attr_action)
+            || node.outputs().size() != 1
+            || !inplace_ops.contains(node.runtime_opcode()))
+            return;
+
+        auto &output = node.output_at(0);
+        auto &out_buf = *context.logical_buffer_map().at(&output);
+        if (out_buf.memory_location() != mem_data || out_buf.parent())
+            return;
+
+        for (auto in : node.inputs())
+        {
+            auto &input = *in->connection();
+            auto &in_buf = *context.logical_buffer_map().at(&input);
+            auto conns = input.connections();
+            if (in_buf.memory_location() == mem_data
+                && (!in_buf.parent() || inplace_buffers.contains(&in_buf))
+                && !aliased.contains(&in_buf)
+                && input.type() == output.type() && input.shape() == output.shape()
+                && (input.attributes() & (cnctr_attr_buffer_slice | cnctr_attr_no_buffer_fusion)) == 0
+                && std::all_of(conns.begin(), conns.end(), [&](input_connector *conn) { return &conn->owner() == &node; }))
+            {
+                out_buf.parent() = { &in_buf, 0, output.shape() };
+                out_buf.strides_shape() = output.shape();
+                aliased.emplace(&in_buf);
+                inplace_buffers.emplace(&out_buf);
+                break;
+            }
+        }
+    });
+    alias_visitor.visit(graph);
+}
@@ -13,10 +13,16 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <filesystem>
 #include <nncase/ir/debug.h>
 #include <nncase/ir/visitor.h>
 #include <nncase/transforms/pass.h>
+#include <typeinfo>
+#if defined(__GNUC__) || defined(__clang__)
+#include <cxxabi.h>
+#endif
 
 using namespace nncase;
 using namespace nncase::ir;
@@ -24,6 +30,25 @@ using namespace nncase::ir::transforms;
 
 namespace
 {
+std::string get_transform_name(transforms::transform &transform)
+{
+    auto name = transform.name();
+    if (name != "noname")
+        return name;
+
+    name = typeid(transform).name();
+#if defined(__GNUC__) || defined(__clang__)
+    int status;
+    if (auto demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status))
+    {
+        name = demangled;
+        std::free(demangled);
+    }
+#endif
+    auto pos = name.rfind("::");
+    return pos == std::string::npos ? name : name.substr(pos + 2);
+}
+
 class transform_apply_visitor : public dfs_ir_post_order_visitor
 {
 public:
@@ -56,9 +81,31 @@ protected:
 
 void pass::run(graph &graph, target &target, const run_pass_options &options)
 {
+    pass_profile_entry entry;
+    if (options.profiler)
+    {
+        entry.nodes_before = graph.nodes().size();
+        entry.peak_memory_before = pass_profiler::peak_memory();
+        entry.start = std::chrono::steady_clock::now();
+    }
+
+    matches_ = 0;
     run_core(graph, target, options);
     graph.cse();
-    static int pass_index = 0;
+
+    if (options.profiler)
+    {
+        entry.duration = std::chrono::steady_clock::now() - entry.start;
+        entry.graph = graph.name();
+        entry.pass = dump_name_;
+        entry.thread = std::this_thread::get_id();
+        entry.matches = matches_;
+        entry.nodes_after = graph.nodes().size();
+        entry.peak_memory_after = pass_profiler::peak_memory();
+        options.profiler->record(std::move(entry));
+    }
+
+    static std::atomic<int> pass_index = 0;
     if (options.dump_dir)
     {
         auto pass_name = std::to_string(pass_index++) + "_" + dump_name_;
@@ -77,6 +124,9 @@ void transform_pass::run_core(graph &graph, target &target, const run_pass_optio
     visitor.quantizer = options.quantizer;
     bool next_pass = false;
 
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<pass_profile_entry> profiles(options.profiler ? transforms_.size() : 0);
+
     do
     {
         next_pass = false;
@@ -84,6 +134,9 @@ void transform_pass::run_core(graph &graph, target &target, const run_pass_optio
         for (size_t idx = 0; idx < transforms_.size(); idx++)
         {
             auto &&transform = transforms_[idx];
+            const auto sweep_start = std::chrono::steady_clock::now();
+            const auto nodes_before = graph.nodes().size();
+            const auto peak_memory_before = options.profiler ? pass_profiler::peak_memory() : 0;
             visitor.transform = transform.get();
             visitor.need_retry = false;
             visitor.visit(graph);
@@ -91,11 +144,39 @@ void transform_pass::run_core(graph &graph, target &target, const run_pass_optio
             if (visitor.need_retry)
             {
                 next_pass = true;
+                matches_++;
                 graph.dce();
-                break;
             }
+
+            if (options.profiler)
+            {
+                auto &profile = profiles[idx];
+                profile.duration += std::chrono::steady_clock::now() - sweep_start;
+                profile.peak_memory_before += peak_memory_before;
+                profile.peak_memory_after += pass_profiler::peak_memory();
+                if (visitor.need_retry)
+                {
+                    profile.matches++;
+                    profile.nodes_before += nodes_before;
+                    profile.nodes_after += graph.nodes().size();
+                }
+            }
+
+            if (next_pass)
+                break;
         }
     } while (next_pass);
+
+    for (size_t idx = 0; idx < profiles.size(); idx++)
+    {
+        auto &profile = profiles[idx];
+        profile.graph = graph.name();
+        profile.pass = name();
+        profile.transform = get_transform_name(*transforms_[idx]);
+        profile.thread = std::this_thread::get_id();
+        profile.start = start;
+        options.profiler->record(std::move(profile));
+    }
 }
 
 void pass_manager::dump_dir(const std::filesystem::path &dir)
@@ -113,12 +194,18 @@ void pass_manager::schedule_context(schedule::function_schedule_context *c)
     schedule_context_ = c;
 }
 
+void pass_manager::profiler(pass_profiler *p)
+{
+    profiler_ = p;
+}
+
 void pass_manager::run()
 {
     run_pass_options options;
     options.dump_dir = dump_dir_;
     options.quantizer = quantizer_;
     options.schedule_context = schedule_context_;
+    options.profiler = profiler_;
 
     for (auto &pass : passes_)
         pass->run(graph_, target_, options);
@@ -0,0 +1,221 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <nncase/transforms/pass_profiler.h>
+#include <sstream>
+#ifdef WIN32
+#include <Windows.h>
+#include <psapi.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+namespace
+{
+struct profile_total
+{
+    size_t runs = 0;
+    std::chrono::steady_clock::duration duration {};
+    size_t matches = 0;
+    size_t nodes_before = 0;
+    size_t nodes_after = 0;
+    size_t peak_memory_growth = 0;
+};
+
+double to_ms(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+int64_t to_us(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+std::string escape_json(const std::string &value)
+{
+    std::ostringstream ss;
+    for (auto c : value)
+    {
+        switch (c)
+        {
+        case '"':
+            ss << "\\\"";
+            break;
+        case '\\':
+            ss << "\\\\";
+            break;
+        case '\n':
+            ss << "\\n";
+            break;
+        default:
+            if ((unsigned char)c < 0x20)
+                ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c << std::dec << std::setfill(' ');
+            else
+                ss << c;
+            break;
+        }
+    }
+
+    return ss.str();
+}
+}
+
+pass_profiler::pass_profiler() noexcept
+    : origin_(std::chrono::steady_clock::now())
+{
+}
+
+void pass_profiler::record(pass_profile_entry entry)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    entries_.emplace_back(std::move(entry));
+}
+
+std::vector<pass_profile_entry> pass_profiler::entries() const
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    return entries_;
+}
+
+void pass_profiler::dump_table(std::ostream &output) const
+{
+    auto entries = this->entries();
+    std::map<std::string, profile_total> passes;
+    std::map<std::pair<std::string, std::string>, profile_total> transforms;
+    std::chrono::steady_clock::duration total_duration {};
+    for (auto &e : entries)
+    {
+        auto &total = e.transform.empty() ? passes[e.pass] : transforms[{ e.pass, e.transform }];
+        total.runs++;
+        total.duration += e.duration;
+        total.matches += e.matches;
+        total.nodes_before += e.nodes_before;
+        total.nodes_after += e.nodes_after;
+        total.peak_memory_growth += e.peak_memory_after - e.peak_memory_before;
+        if (e.transform.empty())
+            total_duration += e.duration;
+    }
+
+    auto by_duration = [](auto &lhs, auto &rhs) { return lhs.second.duration > rhs.second.duration; };
+    std::vector<std::pair<std::string, profile_total>> pass_rows(passes.begin(), passes.end());
+    std::sort(pass_rows.begin(), pass_rows.end(), by_duration);
+
+    auto write_row = [&](const std::string &name, const profile_total &total) {
+        auto percent = to_ms(total_duration) > 0 ? to_ms(total.duration) / to_ms(total_duration) * 100 : 0.0;
+        output << std::left << std::setw(56) << name << std::right
+               << std::setw(6) << total.runs
+               << std::setw(12) << std::fixed << std::setprecision(2) << to_ms(total.duration)
+               << std::setw(8) << std::setprecision(1) << percent
+               << std::setw(10) << total.matches
+               << std::setw(14) << total.nodes_before
+               << std::setw(13) << total.nodes_after
+               << std::setw(14) << std::setprecision(1) << total.peak_memory_growth / 1048576.0 << std::endl;
+    };
+
+    output << std::left << std::setw(56) << "Pass / transform" << std::right
+           << std::setw(6) << "Runs"
+           << std::setw(12) << "Time(ms)"
+           << std::setw(8) << "%"
+           << std::setw(10) << "Matches"
+           << std::setw(14) << "Nodes before"
+           << std::setw(13) << "Nodes after"
+           << std::setw(14) << "Peak +(MB)" << std::endl;
+    for (auto &[pass, total] : pass_rows)
+    {
+        write_row(pass, total);
+
+        std::vector<std::pair<std::string, profile_total>> transform_rows;
+        for (auto &[key, t] : transforms)
+        {
+            if (key.first == pass)
+                transform_rows.emplace_back(key.second, t);
+        }
+
+        std::sort(transform_rows.begin(), transform_rows.end(), by_duration);
+        for (auto &[transform, t] : transform_rows)
+            write_row("  " + transform, t);
+    }
+
+    output << std::left << std::setw(56) << "Total" << std::right << std::setw(18) << std::setprecision(2) << to_ms(total_duration) << std::endl;
+    output << std::left << std::setw(56) << "Process peak memory(MB)" << std::right << std::setw(18) << std::setprecision(1) << peak_memory() / 1048576.0 << std::endl;
+}
+
+void pass_profiler::dump_trace(std::ostream &output) const
+{
+    auto entries = this->entries();
+    std::vector<std::thread::id> threads;
+    auto get_tid = [&](std::thread::id id) {
+        auto it = std::find(threads.begin(), threads.end(), id);
+        if (it == threads.end())
+            it = threads.insert(it, id);
+        return (size_t)(it - threads.begin());
+    };
+
+    // Transforms report their total time in a pass, they are laid out back to back inside its slice
+    std::map<std::pair<std::thread::id, std::chrono::steady_clock::time_point>, std::chrono::steady_clock::duration> transform_offsets;
+
+    output << "{\"traceEvents\":[";
+    bool first = true;
+    for (auto &e : entries)
+    {
+        auto start = e.start;
+        if (!e.transform.empty())
+        {
+            auto &offset = transform_offsets[{ e.thread, e.start }];
+            start += offset;
+            offset += e.duration;
+        }
+
+        output << (first ? "\n" : ",\n")
+               << "{\"name\":\"" << escape_json(e.transform.empty() ? e.pass : e.transform) << "\","
+               << "\"cat\":\"" << (e.transform.empty() ? "pass" : "transform") << "\","
+               << "\"ph\":\"X\",\"pid\":0,\"tid\":" << get_tid(e.thread) << ","
+               << "\"ts\":" << to_us(start - origin_) << ",\"dur\":" << to_us(e.duration) << ","
+               << "\"args\":{\"graph\":\"" << escape_json(e.graph) << "\",\"pass\":\"" << escape_json(e.pass) << "\","
+               << "\"matches\":" << e.matches << ",\"nodes_before\":" << e.nodes_before << ",\"nodes_after\":" << e.nodes_after
+               << ",\"peak_memory_before\":" << e.peak_memory_before << ",\"peak_memory_after\":" << e.peak_memory_after << "}}";
+        first = false;
+    }
+
+    output << "\n],\"otherData\":{\"process_peak_memory\":" << peak_memory() << "}}" << std::endl;
+}
+
+size_t pass_profiler::peak_memory() noexcept
+{
+#ifdef WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    return 0;
+#elif defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage))
+        return 0;
+#ifdef __APPLE__
+    return (size_t)usage.ru_maxrss;
+#else
+    return (size_t)usage.ru_maxrss * 1024;
+#endif
+#else
+    return 0;
+#endif
+}
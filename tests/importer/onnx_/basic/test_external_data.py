@@ -0,0 +1,136 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+"""Initializers stored in an external data file"""
+
+import os
+import numpy as np
+import onnx
+import pytest
+import nncase
+from onnx import helper
+from onnx import TensorProto
+
+in_shape = [1, 4, 8, 8]
+
+
+def _make_module(u8_first):
+    nodes = []
+    initializers = []
+    input = helper.make_tensor_value_info('input', TensorProto.FLOAT, in_shape)
+    output = helper.make_tensor_value_info('output', TensorProto.FLOAT, in_shape)
+
+    weights = np.random.rand(in_shape[1], in_shape[1], 1, 1).astype(np.float32) - 0.5
+    bias = np.random.rand(1, in_shape[1], 1, 1).astype(np.float32)
+    shift = np.array([7], dtype=np.uint8)
+    shape = np.array(in_shape, dtype=np.int64)
+
+    # A 1 byte uint8 tensor in front moves the other tensors off their alignment in the data file.
+    # Conv and Add reference the weights and bias as constants, Reshape reads its shape into a vector.
+    tensors = [
+        helper.make_tensor('weights', TensorProto.FLOAT, weights.shape, weights.tobytes(), raw=True),
+        helper.make_tensor('bias', TensorProto.FLOAT, bias.shape, bias.tobytes(), raw=True),
+        helper.make_tensor('shape', TensorProto.INT64, shape.shape, shape.tobytes(), raw=True)
+    ]
+    u8 = helper.make_tensor('shift', TensorProto.UINT8, shift.shape, shift.tobytes(), raw=True)
+    initializers.extend([u8] + tensors if u8_first else tensors + [u8])
+
+    nodes.append(helper.make_node('Conv', ['input', 'weights'], ['conv']))
+    nodes.append(helper.make_node('Add', ['conv', 'bias'], ['biased']))
+    nodes.append(helper.make_node('Cast', ['shift'], ['shift_f'], to=TensorProto.FLOAT))
+    nodes.append(helper.make_node('Reshape', ['biased', 'shape'], ['reshaped']))
+    nodes.append(helper.make_node('Add', ['reshaped', 'shift_f'], ['output']))
+
+    graph_def = helper.make_graph(nodes, 'test-model', [input], [output], initializer=initializers)
+    model_def = helper.make_model(graph_def, producer_name='kendryte')
+
+    def expected(data):
+        return np.einsum('oc,nchw->nohw', weights[:, :, 0, 0], data) + bias + shift.astype(np.float32)
+
+    return model_def, expected
+
+
+def _save(model_def, tmpdir):
+    model_file = os.path.join(str(tmpdir), 'test.onnx')
+    onnx.save_model(model_def, model_file, save_as_external_data=True,
+                    all_tensors_to_one_file=True, location='test.onnx.data', size_threshold=0)
+    return model_file
+
+
+def _external_data(model_file):
+    model = onnx.load(model_file, load_external_data=False)
+    return {t.name: {e.key: e.value for e in t.external_data} for t in model.graph.initializer}
+
+
+def _compile(model_file, model_content=None):
+    compile_options = nncase.CompileOptions()
+    compile_options.target = 'cpu'
+    compiler = nncase.Compiler(compile_options)
+    import_options = nncase.ImportOptions()
+    import_options.model_dir = os.path.dirname(model_file)
+    if model_content is None:
+        with open(model_file, 'rb') as f:
+            model_content = f.read()
+    compiler.import_onnx(model_content, import_options)
+    compiler.compile()
+    return compiler.gencode_tobytes()
+
+
+def _run(kmodel, expected):
+    data = np.random.rand(*in_shape).astype(np.float32)
+    sim = nncase.Simulator()
+    sim.load_model(kmodel)
+    sim.set_input_tensor(0, nncase.RuntimeTensor.from_numpy(data))
+    sim.run()
+    np.testing.assert_allclose(sim.get_output_tensor(0).to_numpy(), expected(data), rtol=1e-4, atol=1e-5)
+
+
+def test_external_data_mapped(tmpdir):
+    model_def, expected = _make_module(False)
+    model_file = _save(model_def, tmpdir)
+    external = _external_data(model_file)
+    assert int(external['weights'].get('offset', 0)) % 4 == 0
+
+    _run(_compile(model_file), expected)
+
+
+def test_external_data_misaligned(tmpdir):
+    model_def, expected = _make_module(True)
+    model_file = _save(model_def, tmpdir)
+    external = _external_data(model_file)
+    assert int(external['weights']['offset']) % 4 != 0
+    assert int(external['bias']['offset']) % 4 != 0
+    assert int(external['shape']['offset']) % 8 != 0
+
+    _run(_compile(model_file), expected)
+
+
+@pytest.mark.parametrize('key', ['offset', 'length'])
+def test_external_data_out_of_range(tmpdir, key):
+    model_def, _ = _make_module(False)
+    model_file = _save(model_def, tmpdir)
+    model = onnx.load(model_file, load_external_data=False)
+    data_size = os.path.getsize(os.path.join(str(tmpdir), 'test.onnx.data'))
+    for entry in model.graph.initializer[0].external_data:
+        if entry.key == key:
+            entry.value = str(data_size + 1)
+    if key not in [e.key for e in model.graph.initializer[0].external_data]:
+        model.graph.initializer[0].external_data.add(key=key, value=str(data_size + 1))
+
+    with pytest.raises(RuntimeError, match='out of the range'):
+        _compile(model_file, model.SerializeToString())
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_external_data.py'])
@@ -0,0 +1,119 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+
+namespace
+{
+size_t get_span_size(const runtime_shape_t &shape, const runtime_shape_t &strides)
+{
+    size_t size = 1;
+    for (size_t i = 0; i < shape.size(); i++)
+        size += (shape[i] - 1) * strides[i];
+    return size;
+}
+}
+
+class ConvertTest : public ::testing::TestWithParam<
+                        std::tuple<
+                            std::pair<datatype_t, datatype_t>, // input type, output type
+                            runtime_shape_t, // shape
+                            runtime_shape_t, // input strides bias
+                            runtime_shape_t>> // output strides bias
+{
+public:
+    void SetUp() override
+    {
+        auto &&[types, shape, in_strides_bias, out_strides_bias] = GetParam();
+        in_type = types.first;
+        out_type = types.second;
+        this->shape = shape;
+        in_strides = get_strides(shape, in_strides_bias);
+        out_strides = get_strides(shape, out_strides_bias);
+
+        // Out of range and non finite values exercise saturation
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dist(-70000.f, 70000.f);
+        const float specials[] = { NAN, INFINITY, -INFINITY, 3e9f, -3e9f, 1e20f, 0.5f, -0.5f, 1.5f, 2.5f };
+        auto in_count = get_span_size(shape, in_strides);
+        std::vector<float> values(in_count);
+        for (size_t i = 0; i < in_count; i++)
+            values[i] = i % 7 == 3 ? specials[i / 7 % std::size(specials)] : dist(gen);
+
+        input.resize(in_count * get_bytes(in_type));
+        ASSERT_TRUE(cpu::reference::convert(dt_float32, in_type, reinterpret_cast<const gsl::byte *>(values.data()), input.data(),
+            runtime_shape_t { in_count }, runtime_shape_t { 1 }, runtime_shape_t { 1 }, default_kernel_context())
+                        .is_ok());
+
+        output_ref.assign(get_span_size(shape, out_strides) * get_bytes(out_type), gsl::byte { 0x5a });
+        output_opt = output_ref;
+    }
+
+    datatype_t in_type, out_type;
+    runtime_shape_t shape, in_strides, out_strides;
+    std::vector<gsl::byte> input, output_ref, output_opt;
+};
+
+TEST_P(ConvertTest, normal)
+{
+    ASSERT_TRUE(cpu::reference::convert(in_type, out_type, input.data(), output_ref.data(), shape, in_strides, out_strides, default_kernel_context()).is_ok());
+    ASSERT_TRUE(cpu::optimized::convert(in_type, out_type, input.data(), output_opt.data(), shape, in_strides, out_strides).is_ok());
+    EXPECT_EQ(output_ref, output_opt);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ConvertFloat,
+    ConvertTest,
+    testing::Combine(
+        testing::Values(
+            std::make_pair(dt_float32, dt_float16),
+            std::make_pair(dt_float32, dt_bfloat16),
+            std::make_pair(dt_float32, dt_int8),
+            std::make_pair(dt_float32, dt_uint8),
+            std::make_pair(dt_float32, dt_int16),
+            std::make_pair(dt_float32, dt_int32),
+            std::make_pair(dt_float16, dt_float32),
+            std::make_pair(dt_bfloat16, dt_float32),
+            std::make_pair(dt_bfloat16, dt_int32),
+            std::make_pair(dt_int8, dt_float32),
+            std::make_pair(dt_uint8, dt_float32),
+            std::make_pair(dt_int32, dt_float32)), // input type, output type
+        testing::Values(
+            runtime_shape_t { 1, 3, 17, 33 },
+            runtime_shape_t { 40000 }), // shape
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0 }), // input strides bias
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0 }))); // output strides bias
+
+INSTANTIATE_TEST_SUITE_P(
+    ConvertStrided,
+    ConvertTest,
+    testing::Combine(
+        testing::Values(
+            std::make_pair(dt_float32, dt_float16),
+            std::make_pair(dt_float32, dt_uint8),
+            std::make_pair(dt_int8, dt_float32)), // input type, output type
+        testing::Values(
+            runtime_shape_t { 2, 3, 17, 33 }), // shape
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0 },
+            runtime_shape_t { 0, 1, 0, 0 },
+            runtime_shape_t { 0, 0, 2, 0 }), // input strides bias
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0 },
+            runtime_shape_t { 0, 0, 3, 0 }))); // output strides bias
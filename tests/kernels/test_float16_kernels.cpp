@@ -0,0 +1,163 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/convolution.h>
+#include <nncase/kernels/tensor_compute.h>
+#include <nncase/runtime/bfloat16.h>
+#include <nncase/runtime/half.h>
+
+namespace
+{
+// One rounding of the result plus the rounding of every input, 10 and 7 bit mantissas
+template <class T>
+constexpr float tolerance = 0.f;
+template <>
+constexpr float tolerance<half> = 4e-3f;
+template <>
+constexpr float tolerance<bfloat16> = 3e-2f;
+
+template <class T>
+struct operands
+{
+    // The float kernels see the same rounded values, only the computation differs
+    operands(size_t count, float low, float high, uint32_t seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dist(low, high);
+        for (size_t i = 0; i < count; i++)
+        {
+            narrow.push_back(T(dist(gen)));
+            wide.push_back(float(narrow.back()));
+        }
+    }
+
+    std::vector<T> narrow;
+    std::vector<float> wide;
+};
+
+template <class T>
+void expect_near(const std::vector<T> &actual, const std::vector<float> &expected)
+{
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); i++)
+        EXPECT_NEAR(float(actual[i]), expected[i], tolerance<T> * std::max(1.f, std::fabs(expected[i]))) << "at " << i;
+}
+}
+
+template <class T>
+class Float16KernelTest : public ::testing::Test
+{
+};
+
+using Float16Types = ::testing::Types<half, bfloat16>;
+TYPED_TEST_SUITE(Float16KernelTest, Float16Types);
+
+TYPED_TEST(Float16KernelTest, binary)
+{
+    using T = TypeParam;
+    runtime_shape_t a_shape { 2, 3, 4, 5 }, b_shape { 3, 1, 5 };
+    auto a_strides = get_default_strides(a_shape), b_strides = get_default_strides(b_shape);
+    operands<T> a(compute_size(a_shape), -4.f, 4.f, 1), b(compute_size(b_shape), 0.5f, 2.f, 2);
+
+    for (auto op : { binary_add, binary_sub, binary_mul, binary_div, binary_min, binary_max })
+    {
+        std::vector<T> actual(a.narrow.size());
+        std::vector<float> expected(a.wide.size());
+        ASSERT_TRUE(kernels::binary(op, a.narrow.data(), b.narrow.data(), actual.data(), a_shape, a_strides, b_shape, b_strides,
+            a_strides, value_range<float>::full())
+                        .is_ok());
+        ASSERT_TRUE(kernels::binary(op, a.wide.data(), b.wide.data(), expected.data(), a_shape, a_strides, b_shape, b_strides,
+            a_strides, value_range<float>::full())
+                        .is_ok());
+        SCOPED_TRACE(binary_op_to_string(op));
+        expect_near(actual, expected);
+    }
+}
+
+TYPED_TEST(Float16KernelTest, unary)
+{
+    using T = TypeParam;
+    runtime_shape_t shape { 1, 3, 8, 8 };
+    auto strides = get_default_strides(shape);
+    operands<T> input(compute_size(shape), 0.1f, 3.f, 3);
+
+    for (auto op : { unary_abs, unary_exp, unary_log, unary_neg, unary_rsqrt, unary_sin, unary_sqrt, unary_square, unary_tanh })
+    {
+        std::vector<T> actual(input.narrow.size());
+        std::vector<float> expected(input.wide.size());
+        ASSERT_TRUE(kernels::unary(op, input.narrow.data(), actual.data(), shape, strides, strides).is_ok());
+        ASSERT_TRUE(kernels::unary(op, input.wide.data(), expected.data(), shape, strides, strides).is_ok());
+        SCOPED_TRACE(unary_op_to_string(op));
+        expect_near(actual, expected);
+    }
+}
+
+TYPED_TEST(Float16KernelTest, reduce)
+{
+    using T = TypeParam;
+    runtime_shape_t in_shape { 2, 16, 7, 9 }, axis { 2, 3 }, out_shape { 2, 16, 1, 1 };
+    auto in_strides = get_default_strides(in_shape), out_strides = get_default_strides(out_shape);
+    operands<T> input(compute_size(in_shape), -1.f, 1.f, 4);
+
+    for (auto [op, init_value] : { std::pair { reduce_mean, 0.f }, { reduce_sum, 0.f }, { reduce_min, std::numeric_limits<float>::max() },
+             { reduce_max, std::numeric_limits<float>::lowest() } })
+    {
+        std::vector<T> actual(compute_size(out_shape));
+        std::vector<float> expected(actual.size());
+        ASSERT_TRUE(kernels::reduce(op, init_value, input.narrow.data(), actual.data(), in_shape, axis, in_strides, out_strides, true).is_ok());
+        ASSERT_TRUE(kernels::reduce(op, init_value, input.wide.data(), expected.data(), in_shape, axis, in_strides, out_strides, true).is_ok());
+        SCOPED_TRACE(reduce_op_to_string(op));
+        expect_near(actual, expected);
+    }
+}
+
+TYPED_TEST(Float16KernelTest, conv2d)
+{
+    using T = TypeParam;
+    // The 3x3 and depthwise shapes get a specialized plan and run widened, the padded one runs the reference kernel
+    struct conv_case
+    {
+        int32_t groups;
+        int32_t pad;
+        bool specialized;
+    };
+    for (auto [groups, pad, specialized] : { conv_case { 1, 0, true }, { 8, 0, true }, { 1, 1, false } })
+    {
+        // A padded row makes the input strided, the widened path copies it contiguous
+        runtime_shape_t in_shape { 2, 8, 10, 10 }, w_shape { 8, (size_t)(8 / groups), 3, 3 }, bias_shape { 8 };
+        auto in_strides = get_strides(in_shape, { 0, 0, 0, 3 }), w_strides = get_default_strides(w_shape);
+        runtime_shape_t bias_strides { 1 };
+        padding pad_hw { pad, pad };
+        auto out_h = kernels::detail::get_windowed_output_size(10, 3, 1, 1, pad_hw);
+        runtime_shape_t out_shape { 2, 8, out_h, out_h };
+        auto out_strides = get_default_strides(out_shape);
+
+        operands<T> input(in_strides[0] * in_shape[0], -1.f, 1.f, 5), weights(compute_size(w_shape), -0.5f, 0.5f, 6), bias(8, -1.f, 1.f, 7);
+        auto plan = plan_conv2d(to_datatype<T>(), in_shape, in_strides, w_shape, pad_hw, pad_hw, groups, 1, 1, 1, 1);
+        EXPECT_EQ(specialized, plan.kernel != nullptr);
+
+        std::vector<T> actual(compute_size(out_shape));
+        std::vector<float> expected(actual.size());
+        ASSERT_TRUE(kernels::conv2d(input.narrow.data(), weights.narrow.data(), bias.narrow.data(), actual.data(), in_shape, in_strides,
+            w_shape, w_strides, bias_strides, out_strides, pad_hw, pad_hw, groups, 1, 1, 1, 1, { -2.f, 2.f }, plan)
+                        .is_ok());
+        ASSERT_TRUE(kernels::conv2d(input.wide.data(), weights.wide.data(), bias.wide.data(), expected.data(), in_shape, in_strides,
+            w_shape, w_strides, bias_strides, out_strides, pad_hw, pad_hw, groups, 1, 1, 1, 1, { -2.f, 2.f })
+                        .is_ok());
+        SCOPED_TRACE("groups " + std::to_string(groups) + " pad " + std::to_string(pad));
+        expect_near(actual, expected);
+    }
+}
@@ -0,0 +1,171 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+
+namespace
+{
+std::vector<float> make_input(const runtime_shape_t &shape)
+{
+    std::vector<float> input(compute_size(shape));
+    for (size_t i = 0; i < input.size(); i++)
+        input[i] = (float)i;
+    return input;
+}
+}
+
+class GatherTest : public ::testing::TestWithParam<
+                       std::tuple<
+                           runtime_shape_t, size_t, // input shape, axis
+                           runtime_shape_t, std::vector<int32_t>>> // indices shape, indices
+{
+public:
+    void SetUp() override
+    {
+        auto &&[in_shape, axis, indices_shape, indices] = GetParam();
+        this->in_shape = in_shape;
+        this->axis = axis;
+        this->indices_shape = indices_shape;
+        this->indices = indices;
+
+        out_shape.assign(in_shape.begin(), in_shape.begin() + axis);
+        out_shape.insert(out_shape.end(), indices_shape.begin(), indices_shape.end());
+        out_shape.insert(out_shape.end(), in_shape.begin() + axis + 1, in_shape.end());
+        input = make_input(in_shape);
+        output_ref.resize(compute_size(out_shape));
+        output_opt.resize(compute_size(out_shape));
+    }
+
+    result<void> gather(std::vector<float> &output, OpType type)
+    {
+        auto in = reinterpret_cast<const gsl::byte *>(input.data());
+        auto out = reinterpret_cast<gsl::byte *>(output.data());
+        auto in_strides = get_default_strides(in_shape);
+        auto out_strides = get_default_strides(out_shape);
+        if (type == OpType::Ref)
+            return cpu::reference::gather(dt_float32, in, out, in_shape, out_shape, in_strides, out_strides, indices.data(), indices_shape, axis, default_kernel_context());
+        else
+            return cpu::optimized::gather(dt_float32, in, out, in_shape, out_shape, in_strides, out_strides, indices.data(), indices_shape, axis, default_kernel_context());
+    }
+
+    runtime_shape_t in_shape, out_shape, indices_shape;
+    size_t axis;
+    std::vector<int32_t> indices;
+    std::vector<float> input, output_ref, output_opt;
+};
+
+TEST_P(GatherTest, normal)
+{
+    ASSERT_TRUE(gather(output_ref, OpType::Ref).is_ok());
+    ASSERT_TRUE(gather(output_opt, OpType::Opt).is_ok());
+    EXPECT_EQ(output_ref, output_opt);
+}
+
+TEST_P(GatherTest, out_of_range)
+{
+    indices.back() = (int32_t)in_shape[axis];
+    EXPECT_TRUE(gather(output_ref, OpType::Ref).is_err());
+    EXPECT_TRUE(gather(output_opt, OpType::Opt).is_err());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Gather,
+    GatherTest,
+    testing::Combine(
+        testing::Values(
+            runtime_shape_t { 5, 4, 3, 6 }), // input shape
+        testing::Values(0, 1, 2, 3), // axis
+        testing::Values(
+            runtime_shape_t { 3 }), // indices shape
+        testing::Values(
+            std::vector<int32_t> { 0, 2, 1 }, // indices
+            std::vector<int32_t> { -1, 0, 2 })));
+
+INSTANTIATE_TEST_SUITE_P(
+    GatherEmbedding,
+    GatherTest,
+    testing::Combine(
+        testing::Values(
+            runtime_shape_t { 16, 8 }), // vocab, hidden
+        testing::Values(0),
+        testing::Values(
+            runtime_shape_t { 2, 3 }), // batch, sequence
+        testing::Values(
+            std::vector<int32_t> { 15, 0, 7, 7, -2, 3 })));
+
+class GatherNDTest : public ::testing::TestWithParam<
+                         std::tuple<
+                             runtime_shape_t, size_t, // input shape, batch dims
+                             runtime_shape_t, std::vector<int32_t>>> // indices shape, indices
+{
+public:
+    void SetUp() override
+    {
+        auto &&[in_shape, batch_dims, indices_shape, indices] = GetParam();
+        this->in_shape = in_shape;
+        this->batch_dims = batch_dims;
+        this->indices_shape = indices_shape;
+        this->indices = indices;
+
+        out_shape.assign(indices_shape.begin(), indices_shape.end() - 1);
+        out_shape.insert(out_shape.end(), in_shape.begin() + batch_dims + indices_shape.back(), in_shape.end());
+        input = make_input(in_shape);
+        output_ref.resize(compute_size(out_shape));
+        output_opt.resize(compute_size(out_shape));
+    }
+
+    result<void> gather_nd(std::vector<float> &output, OpType type)
+    {
+        auto in = reinterpret_cast<const gsl::byte *>(input.data());
+        auto out = reinterpret_cast<gsl::byte *>(output.data());
+        auto in_strides = get_default_strides(in_shape);
+        auto out_strides = get_default_strides(out_shape);
+        if (type == OpType::Ref)
+            return cpu::reference::gather_nd(dt_float32, in, out, in_shape, out_shape, in_strides, out_strides, indices.data(), indices_shape, batch_dims, default_kernel_context());
+        else
+            return cpu::optimized::gather_nd(dt_float32, in, out, in_shape, out_shape, in_strides, out_strides, indices.data(), indices_shape, batch_dims, default_kernel_context());
+    }
+
+    runtime_shape_t in_shape, out_shape, indices_shape;
+    size_t batch_dims;
+    std::vector<int32_t> indices;
+    std::vector<float> input, output_ref, output_opt;
+};
+
+TEST_P(GatherNDTest, normal)
+{
+    ASSERT_TRUE(gather_nd(output_ref, OpType::Ref).is_ok());
+    ASSERT_TRUE(gather_nd(output_opt, OpType::Opt).is_ok());
+    EXPECT_EQ(output_ref, output_opt);
+}
+
+TEST_P(GatherNDTest, out_of_range)
+{
+    indices.back() = -1 - (int32_t)in_shape[batch_dims + indices_shape.back() - 1];
+    EXPECT_TRUE(gather_nd(output_ref, OpType::Ref).is_err());
+    EXPECT_TRUE(gather_nd(output_opt, OpType::Opt).is_err());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    GatherND,
+    GatherNDTest,
+    testing::Values(
+        std::make_tuple(runtime_shape_t { 4, 3, 5 }, 0, runtime_shape_t { 2, 1 }, std::vector<int32_t> { 3, -4 }),
+        std::make_tuple(runtime_shape_t { 4, 3, 5 }, 0, runtime_shape_t { 2, 2 }, std::vector<int32_t> { 3, 1, 0, -1 }),
+        std::make_tuple(runtime_shape_t { 4, 3, 5 }, 0, runtime_shape_t { 3 }, std::vector<int32_t> { 1, 2, 4 }),
+        std::make_tuple(runtime_shape_t { 4, 3, 5 }, 1, runtime_shape_t { 4, 1 }, std::vector<int32_t> { 0, 2, 1, -1 }),
+        std::make_tuple(runtime_shape_t { 4, 3, 5 }, 1, runtime_shape_t { 4, 2, 2 }, std::vector<int32_t> { 0, 4, 2, 1, 1, 1, 0, 0, 2, 3, -1, -5, 0, 0, 1, 2 })));
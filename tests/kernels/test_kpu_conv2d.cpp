@@ -0,0 +1,194 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <nncase/kernels/k210/k210_kernels.h>
+#include <random>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime::k210;
+
+namespace
+{
+// The scalar kpu_conv2d the optimized kernel replaced, kept to check it stays bit exact
+uint8_t reference_activation(const kpu_activation_table_t &activation, int64_t value)
+{
+    auto &seg = *std::find_if(activation.rbegin(), activation.rend(), [value](const kpu_activation_segment &seg) { return value > seg.start_x; });
+    auto act_value = runtime::carry_shift<int64_t, true>((value - seg.start_x) * seg.mul, seg.shift) + seg.add;
+    return (uint8_t)kernels::detail::clamp(act_value, int64_t(0), int64_t(255));
+}
+
+template <bool IsDepthwise, int32_t FilterSize>
+void reference_kpu_conv2d(const uint8_t *input, uint8_t *output, const uint8_t *weights, int32_t in_h, int32_t in_w, int32_t in_channels, int32_t out_channels, uint8_t pad_value, int32_t arg_x,
+    int32_t shift_x, int32_t arg_w, int32_t shift_w, int64_t arg_add, const kpu_batchnorm_segment *batchnorm, const kpu_activation_table_t &activation)
+{
+    const auto channel_size = size_t(in_h) * in_w;
+    const auto pad = FilterSize == 1 ? 0 : 1;
+    const auto groups = IsDepthwise ? out_channels : 1;
+    const auto g_ic = IsDepthwise ? 1 : in_channels / groups;
+    const auto g_oc = IsDepthwise ? 1 : out_channels;
+    std::vector<int64_t> workspace(channel_size * out_channels);
+    auto out_it = workspace.data();
+
+    for (int32_t og = 0; og < groups; og++)
+    {
+        const uint8_t *w_group_p = weights + (size_t)og * g_oc * g_ic * FilterSize * FilterSize;
+        for (int32_t oc = 0; oc < g_oc; oc++)
+        {
+            const uint8_t *w_oc_p = w_group_p + (size_t)oc * g_ic * FilterSize * FilterSize;
+            for (int32_t oy = 0; oy < in_h; oy++)
+            {
+                for (int32_t ox = 0; ox < in_w; ox++)
+                {
+                    int64_t value = 0;
+                    int64_t sum_x = 0, sum_w = 0;
+                    for (int32_t ic = 0; ic < g_ic; ic++)
+                    {
+                        const uint8_t *in_c_p = input + ((size_t)og * g_ic + ic) * in_h * in_w;
+                        const uint8_t *w_ic_p = w_oc_p + (size_t)ic * FilterSize * FilterSize;
+                        for (int32_t ky = 0; ky < FilterSize; ky++)
+                        {
+                            for (int32_t kx = 0; kx < FilterSize; kx++)
+                            {
+                                const int32_t in_y = oy - pad + ky;
+                                const int32_t in_x = ox - pad + kx;
+                                uint8_t x = in_x < 0 || in_x >= in_w || in_y < 0 || in_y >= in_h ? pad_value : in_c_p[in_y * in_w + in_x];
+                                uint8_t w = w_ic_p[ky * FilterSize + kx];
+                                sum_x += x;
+                                sum_w += w;
+                                value += (int32_t)x * w;
+                            }
+                        }
+                    }
+
+                    *out_it++ = value + (arg_x * sum_x >> shift_x) + (arg_w * sum_w >> shift_w) + arg_add * g_ic;
+                }
+            }
+        }
+    }
+
+    auto src_it = workspace.data();
+    for (int32_t oc = 0; oc < out_channels; oc++)
+    {
+        const auto &bn = batchnorm[oc];
+        for (size_t i = 0; i < channel_size; i++)
+            *output++ = reference_activation(activation, (*src_it++ * bn.mul >> bn.shift) + bn.add);
+    }
+}
+
+constexpr int64_t min_start_x = -(int64_t(1) << 35);
+
+kpu_activation_table_t make_activation(std::mt19937_64 &rng, bool ascending, bool negative_shift)
+{
+    kpu_activation_table_t act;
+    for (size_t i = 0; i < act.size(); i++)
+    {
+        act[i].start_x = i == 0 ? min_start_x : (ascending ? (int64_t(i) - 8) * 3000 : (int64_t)(rng() % 60000) - 30000);
+        act[i].mul = (int32_t)(rng() % 2000) - 1000;
+        act[i].shift = negative_shift && i % 5 == 0 ? -2 : (int32_t)(rng() % 16);
+        act[i].add = (int32_t)(rng() % 256);
+    }
+
+    return act;
+}
+
+template <bool IsDepthwise, int32_t FilterSize>
+void check_kpu_conv2d(std::mt19937_64 &rng, int32_t in_h, int32_t in_w, int32_t in_channels, int32_t out_channels, bool ascending, uint32_t num_threads)
+{
+    if (IsDepthwise)
+        out_channels = in_channels;
+
+    std::uniform_int_distribution<int> u8(0, 255);
+    std::vector<uint8_t> input(size_t(in_channels) * in_h * in_w), weights(size_t(IsDepthwise ? 1 : in_channels) * out_channels * FilterSize * FilterSize);
+    for (auto &v : input)
+        v = (uint8_t)u8(rng);
+    for (auto &v : weights)
+        v = (uint8_t)u8(rng);
+
+    auto pad_value = (uint8_t)u8(rng);
+    auto arg_x = (int32_t)(rng() % 2000) - 1000, shift_x = (int32_t)(rng() % 16);
+    auto arg_w = (int32_t)(rng() % 2000) - 1000, shift_w = (int32_t)(rng() % 16);
+    auto arg_add = (int64_t)(rng() % 200000) - 100000;
+    std::vector<kpu_batchnorm_segment> batchnorm(out_channels);
+    for (auto &bn : batchnorm)
+    {
+        bn.mul = (int32_t)(rng() % 4000) - 2000;
+        bn.shift = 10 + (int32_t)(rng() % 10);
+        bn.add = (int32_t)(rng() % 200000) - 100000;
+    }
+
+    auto activation = make_activation(rng, ascending, ascending && rng() % 2);
+
+    std::vector<uint8_t> expected(size_t(out_channels) * in_h * in_w), actual(expected.size());
+    reference_kpu_conv2d<IsDepthwise, FilterSize>(input.data(), expected.data(), weights.data(), in_h, in_w, in_channels, out_channels, pad_value,
+        arg_x, shift_x, arg_w, shift_w, arg_add, batchnorm.data(), activation);
+
+    kernels::k210::kpu_conv2d_workspace workspace;
+    kernels::kernel_context context { num_threads };
+    kernels::k210::kpu_conv2d<IsDepthwise, FilterSize>(input.data(), workspace, actual.data(), weights.data(), in_h, in_w, in_channels, out_channels, pad_value,
+        arg_x, shift_x, arg_w, shift_w, arg_add, batchnorm.data(), activation, context);
+
+    EXPECT_EQ(actual, expected) << "depthwise=" << IsDepthwise << " filter=" << FilterSize << " " << in_h << "x" << in_w
+                                << " ic=" << in_channels << " oc=" << out_channels << " ascending=" << ascending << " threads=" << num_threads;
+}
+}
+
+TEST(KpuActivationLookupTest, MatchesScalarSearch)
+{
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int64_t> values(min_start_x + 1, -min_start_x - 1);
+    for (int table = 0; table < 64; table++)
+    {
+        auto ascending = table % 2 == 0;
+        auto activation = make_activation(rng, ascending, table % 4 < 2);
+        // Repeated starts keep the table ascending, the last of them must win
+        if (table % 8 == 0)
+            activation[6].start_x = activation[7].start_x = activation[8].start_x;
+
+        kernels::k210::detail::kpu_activation_lookup lookup(activation);
+        std::vector<int64_t> samples;
+        for (auto &seg : activation)
+        {
+            for (int64_t delta = -2; delta <= 2; delta++)
+            {
+                if (seg.start_x + delta > min_start_x)
+                    samples.emplace_back(seg.start_x + delta);
+            }
+        }
+
+        for (int i = 0; i < 1000; i++)
+            samples.emplace_back(values(rng) % (rng() % 2 ? 100000 : -min_start_x));
+
+        for (auto value : samples)
+            ASSERT_EQ(lookup(value), reference_activation(activation, value)) << "table " << table << " value " << value;
+    }
+}
+
+TEST(KpuConv2dTest, MatchesScalarReference)
+{
+    std::mt19937_64 rng(42);
+    for (int i = 0; i < 40; i++)
+    {
+        auto in_h = 1 + (int32_t)(rng() % 20), in_w = 1 + (int32_t)(rng() % 20);
+        auto in_channels = 1 + (int32_t)(rng() % 40), out_channels = 1 + (int32_t)(rng() % 40);
+        auto num_threads = 1 + (uint32_t)(rng() % 4);
+        auto ascending = i % 2 == 0;
+        check_kpu_conv2d<true, 1>(rng, in_h, in_w, in_channels, out_channels, ascending, num_threads);
+        check_kpu_conv2d<true, 3>(rng, in_h, in_w, in_channels, out_channels, ascending, num_threads);
+        check_kpu_conv2d<false, 1>(rng, in_h, in_w, in_channels, out_channels, ascending, num_threads);
+        check_kpu_conv2d<false, 3>(rng, in_h, in_w, in_channels, out_channels, ascending, num_threads);
+    }
+}
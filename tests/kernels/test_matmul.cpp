@@ -0,0 +1,103 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+
+class MatMulTest : public ::testing::TestWithParam<
+                       std::tuple<
+                           std::pair<runtime_shape_t, runtime_shape_t>, // input a shape, input b shape (untransposed)
+                           bool, bool>> // transpose a, transpose b
+{
+public:
+    void SetUp() override
+    {
+        auto &&[shapes, transpose_a, transpose_b] = GetParam();
+        in_a_shape = shapes.first;
+        in_b_shape = shapes.second;
+        this->transpose_a = transpose_a;
+        this->transpose_b = transpose_b;
+        if (transpose_a)
+            std::swap(in_a_shape[in_a_shape.size() - 1], in_a_shape[in_a_shape.size() - 2]);
+        if (transpose_b)
+            std::swap(in_b_shape[in_b_shape.size() - 1], in_b_shape[in_b_shape.size() - 2]);
+        ASSERT_TRUE(kernels::detail::get_matmul_output_shape(in_a_shape, in_b_shape, transpose_a, transpose_b, out_shape));
+
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dist(-1.f, 1.f);
+        input_a.resize(compute_size(in_a_shape));
+        input_b.resize(compute_size(in_b_shape));
+        bias.resize(out_shape.back());
+        for (auto &v : input_a)
+            v = dist(gen);
+        for (auto &v : input_b)
+            v = dist(gen);
+        for (auto &v : bias)
+            v = dist(gen);
+
+        output_ref.resize(compute_size(out_shape));
+        output_opt.resize(compute_size(out_shape));
+    }
+
+    result<void> matmul(std::vector<float> &output, OpType type)
+    {
+        auto in_a_strides = get_default_strides(in_a_shape);
+        auto in_b_strides = get_default_strides(in_b_shape);
+        auto out_strides = get_default_strides(out_shape);
+        value_range<float> fused_activation { -2.f, 2.f };
+        if (type == OpType::Ref)
+            return cpu::reference::matmul(input_a.data(), input_b.data(), bias.data(), output.data(), in_a_shape, in_a_strides,
+                in_b_shape, in_b_strides, out_strides, transpose_a, transpose_b, fused_activation, default_kernel_context());
+        else
+            return cpu::optimized::matmul(input_a.data(), input_b.data(), bias.data(), output.data(), in_a_shape, in_a_strides,
+                in_b_shape, in_b_strides, out_strides, transpose_a, transpose_b, fused_activation);
+    }
+
+    runtime_shape_t in_a_shape, in_b_shape, out_shape;
+    bool transpose_a, transpose_b;
+    std::vector<float> input_a, input_b, bias, output_ref, output_opt;
+};
+
+TEST_P(MatMulTest, normal)
+{
+    ASSERT_TRUE(matmul(output_ref, OpType::Ref).is_ok());
+    ASSERT_TRUE(matmul(output_opt, OpType::Opt).is_ok());
+    for (size_t i = 0; i < output_ref.size(); i++)
+        EXPECT_NEAR(output_ref[i], output_opt[i], 1e-4f) << "at " << i;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    MatMul2D,
+    MatMulTest,
+    testing::Combine(
+        testing::Values(
+            std::make_pair(runtime_shape_t { 1, 7 }, runtime_shape_t { 7, 33 }),
+            std::make_pair(runtime_shape_t { 5, 1 }, runtime_shape_t { 1, 17 }),
+            std::make_pair(runtime_shape_t { 67, 300 }, runtime_shape_t { 300, 130 })), // input shapes
+        testing::Bool(), // transpose a
+        testing::Bool())); // transpose b
+
+INSTANTIATE_TEST_SUITE_P(
+    MatMulBatched,
+    MatMulTest,
+    testing::Combine(
+        testing::Values(
+            std::make_pair(runtime_shape_t { 2, 3, 17, 40 }, runtime_shape_t { 2, 3, 40, 19 }),
+            std::make_pair(runtime_shape_t { 4, 70, 64 }, runtime_shape_t { 64, 24 }),
+            std::make_pair(runtime_shape_t { 3, 1, 9, 16 }, runtime_shape_t { 5, 16, 20 }),
+            std::make_pair(runtime_shape_t { 16, 8 }, runtime_shape_t { 6, 8, 21 })), // input shapes
+        testing::Bool(), // transpose a
+        testing::Bool())); // transpose b
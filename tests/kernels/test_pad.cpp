@@ -0,0 +1,112 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+
+namespace
+{
+size_t get_span_size(const runtime_shape_t &shape, const runtime_shape_t &strides)
+{
+    size_t size = 1;
+    for (size_t i = 0; i < shape.size(); i++)
+        size += (shape[i] - 1) * strides[i];
+    return size;
+}
+}
+
+class PadTest : public ::testing::TestWithParam<
+                    std::tuple<
+                        datatype_t, // type
+                        pad_mode_t, // mode
+                        runtime_shape_t, // input shape
+                        runtime_paddings_t, // paddings
+                        runtime_shape_t, // input strides bias
+                        runtime_shape_t>> // output strides bias
+{
+public:
+    void SetUp() override
+    {
+        auto &&[type, mode, in_shape, paddings, in_strides_bias, out_strides_bias] = GetParam();
+        this->type = type;
+        this->mode = mode;
+        this->in_shape = in_shape;
+        this->paddings = paddings;
+        out_shape.resize(in_shape.size());
+        for (size_t i = 0; i < in_shape.size(); i++)
+            out_shape[i] = in_shape[i] + paddings[i].sum();
+        in_strides = get_strides(in_shape, in_strides_bias);
+        out_strides = get_strides(out_shape, out_strides_bias);
+
+        input.resize(get_span_size(in_shape, in_strides) * get_bytes(type));
+        for (size_t i = 0; i < input.size(); i++)
+            input[i] = (gsl::byte)(i * 37 + 11);
+
+        output_ref.assign(get_span_size(out_shape, out_strides) * get_bytes(type), gsl::byte { 0x5a });
+        output_opt = output_ref;
+    }
+
+    datatype_t type;
+    pad_mode_t mode;
+    runtime_shape_t in_shape, out_shape, in_strides, out_strides;
+    runtime_paddings_t paddings;
+    std::vector<gsl::byte> input, output_ref, output_opt;
+};
+
+TEST_P(PadTest, normal)
+{
+    scalar pad_value;
+    if (type == dt_float32)
+        pad_value = -1.5f;
+    else if (type == dt_bfloat16)
+        pad_value = bfloat16(-1.5f);
+    else
+        pad_value = (uint8_t)0xa5;
+
+    ASSERT_TRUE(cpu::reference::pad(type, input.data(), output_ref.data(), in_shape, in_strides, out_strides, paddings, mode, pad_value, default_kernel_context()).is_ok());
+    ASSERT_TRUE(cpu::optimized::pad(type, input.data(), output_opt.data(), in_shape, in_strides, out_strides, paddings, mode, pad_value).is_ok());
+    EXPECT_EQ(output_ref, output_opt);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    PadModes,
+    PadTest,
+    testing::Combine(
+        testing::Values(dt_float32, dt_bfloat16, dt_uint8), // type
+        testing::Values(pad_constant, pad_reflect, pad_symmetric, pad_edge), // mode
+        testing::Values(runtime_shape_t { 1, 3, 8, 17 }), // input shape
+        testing::Values(
+            runtime_paddings_t { { 0, 0 }, { 0, 0 }, { 1, 1 }, { 1, 1 } },
+            runtime_paddings_t { { 0, 0 }, { 1, 0 }, { 2, 3 }, { 3, 2 } },
+            runtime_paddings_t { { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 4 } },
+            runtime_paddings_t { { 0, 0 }, { 1, 1 }, { 3, 0 }, { 0, 0 } }), // paddings
+        testing::Values(runtime_shape_t { 0, 0, 0, 0 }), // input strides bias
+        testing::Values(runtime_shape_t { 0, 0, 0, 0 }))); // output strides bias
+
+INSTANTIATE_TEST_SUITE_P(
+    PadStrided,
+    PadTest,
+    testing::Combine(
+        testing::Values(dt_float32), // type
+        testing::Values(pad_constant, pad_reflect, pad_edge), // mode
+        testing::Values(runtime_shape_t { 2, 3, 8, 17 }), // input shape
+        testing::Values(runtime_paddings_t { { 0, 1 }, { 1, 0 }, { 2, 3 }, { 3, 2 } }), // paddings
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0 },
+            runtime_shape_t { 0, 1, 2, 0 }), // input strides bias
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0 },
+            runtime_shape_t { 0, 0, 3, 0 }))); // output strides bias
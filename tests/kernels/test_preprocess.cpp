@@ -0,0 +1,116 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+
+class PreprocessTest : public ::testing::TestWithParam<
+                           std::tuple<
+                               runtime_shape_t, bool, bool, bool, // NCHW input shape, input nhwc, output nhwc, swap rb
+                               std::array<int32_t, 2>, runtime_paddings_t>> // resize shape, paddings
+{
+public:
+    void SetUp() override
+    {
+        auto &&[nchw_shape, input_nhwc, output_nhwc, swap_rb, resize_shape, paddings] = GetParam();
+        this->input_nhwc = input_nhwc;
+        this->output_nhwc = output_nhwc;
+        this->swap_rb = swap_rb;
+        this->resize_shape = resize_shape[0] ? resize_shape : std::array<int32_t, 2> { (int32_t)nchw_shape[2], (int32_t)nchw_shape[3] };
+        this->paddings = paddings;
+
+        in_shape = input_nhwc ? runtime_shape_t { nchw_shape[0], nchw_shape[2], nchw_shape[3], nchw_shape[1] } : nchw_shape;
+        auto channels = nchw_shape[1];
+        auto out_h = (size_t)(paddings[0].sum() + this->resize_shape[0]);
+        auto out_w = (size_t)(paddings[1].sum() + this->resize_shape[1]);
+        out_shape = output_nhwc ? runtime_shape_t { nchw_shape[0], out_h, out_w, channels } : runtime_shape_t { nchw_shape[0], channels, out_h, out_w };
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int32_t> dis(0, 255);
+        input.resize(compute_size(in_shape));
+        for (auto &v : input)
+            v = (uint8_t)dis(gen);
+
+        for (size_t c = 0; c < channels; c++)
+        {
+            mean.push_back(100.f + c * 10.f);
+            std.push_back(50.f + c * 5.f);
+        }
+
+        output_ref.resize(compute_size(out_shape));
+        output_opt.resize(compute_size(out_shape));
+    }
+
+    result<void> preprocess(std::vector<float> &output, OpType type)
+    {
+        auto in_strides = get_default_strides(in_shape);
+        auto out_strides = get_default_strides(out_shape);
+        quant_param_t dequant { 3, 0.5f };
+        if (type == OpType::Ref)
+            return cpu::reference::preprocess(dt_uint8, reinterpret_cast<const gsl::byte *>(input.data()), output.data(), in_shape, in_strides, out_strides,
+                input_nhwc, output_nhwc, swap_rb, dequant, resize_shape[0], resize_shape[1], paddings, 57.f, mean.data(), std.data(), default_kernel_context());
+        else
+            return cpu::optimized::preprocess(dt_uint8, reinterpret_cast<const gsl::byte *>(input.data()), output.data(), in_shape, in_strides, out_strides,
+                input_nhwc, output_nhwc, swap_rb, dequant, resize_shape[0], resize_shape[1], paddings, 57.f, mean.data(), std.data(), default_kernel_context());
+    }
+
+    runtime_shape_t in_shape, out_shape;
+    bool input_nhwc, output_nhwc, swap_rb;
+    std::array<int32_t, 2> resize_shape;
+    runtime_paddings_t paddings;
+    std::vector<uint8_t> input;
+    std::vector<float> mean, std, output_ref, output_opt;
+};
+
+TEST_P(PreprocessTest, normal)
+{
+    ASSERT_TRUE(preprocess(output_ref, OpType::Ref).is_ok());
+    ASSERT_TRUE(preprocess(output_opt, OpType::Opt).is_ok());
+    for (size_t i = 0; i < output_ref.size(); i++)
+        ASSERT_NEAR(output_ref[i], output_opt[i], 1e-4f) << "at " << i;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    PreprocessTestIdentity,
+    PreprocessTest,
+    testing::Combine(
+        testing::Values(
+            runtime_shape_t { 1, 3, 8, 10 },
+            runtime_shape_t { 2, 1, 5, 7 }), // NCHW input shape
+        testing::Bool(), // input nhwc
+        testing::Bool(), // output nhwc
+        testing::Bool(), // swap rb
+        testing::Values(
+            std::array<int32_t, 2> { 0, 0 }), // resize shape, 0 means the input shape
+        testing::Values(
+            runtime_paddings_t { { 0, 0 }, { 0, 0 } })));
+
+INSTANTIATE_TEST_SUITE_P(
+    PreprocessTestLetterbox,
+    PreprocessTest,
+    testing::Combine(
+        testing::Values(
+            runtime_shape_t { 1, 3, 18, 32 }), // NCHW input shape
+        testing::Bool(), // input nhwc
+        testing::Bool(), // output nhwc
+        testing::Bool(), // swap rb
+        testing::Values(
+            std::array<int32_t, 2> { 9, 16 },
+            std::array<int32_t, 2> { 27, 48 }), // resize shape
+        testing::Values(
+            runtime_paddings_t { { 0, 0 }, { 0, 0 } },
+            runtime_paddings_t { { 3, 4 }, { 0, 0 } },
+            runtime_paddings_t { { 2, 2 }, { 1, 3 } })));
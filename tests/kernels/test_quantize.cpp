@@ -0,0 +1,106 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+
+namespace
+{
+size_t get_span_size(const runtime_shape_t &shape, const runtime_shape_t &strides)
+{
+    size_t size = 1;
+    for (size_t i = 0; i < shape.size(); i++)
+        size += (shape[i] - 1) * strides[i];
+    return size;
+}
+}
+
+class QuantizeTest : public ::testing::TestWithParam<
+                         std::tuple<
+                             datatype_t, // quantized type
+                             runtime_shape_t, // shape
+                             runtime_shape_t, // float tensor strides bias
+                             runtime_shape_t>> // quantized tensor strides bias
+{
+public:
+    void SetUp() override
+    {
+        auto &&[qtype, shape, f_strides_bias, q_strides_bias] = GetParam();
+        this->qtype = qtype;
+        this->shape = shape;
+        f_strides = get_strides(shape, f_strides_bias);
+        q_strides = get_strides(shape, q_strides_bias);
+        auto f_size = get_span_size(shape, f_strides);
+        auto q_size = get_span_size(shape, q_strides);
+
+        // Ties and out of range values exercise rounding and saturation
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dist(-3.f, 3.f);
+        const float specials[] = { NAN, INFINITY, -INFINITY, 1e10f, 0.5f / scale, 1.5f / scale, -2.5f / scale };
+        floats.resize(f_size);
+        for (size_t i = 0; i < f_size; i++)
+            floats[i] = i % 5 == 2 ? specials[i / 5 % std::size(specials)] : dist(gen);
+
+        quants.resize(q_size);
+        for (size_t i = 0; i < q_size; i++)
+            quants[i] = gsl::byte(i * 37 % 256);
+
+        q_ref.assign(q_size, gsl::byte { 0x5a });
+        q_opt = q_ref;
+        f_ref.assign(f_size, -1.f);
+        f_opt = f_ref;
+    }
+
+    static constexpr float scale = 41.f;
+    static constexpr float bias = 3.f;
+    datatype_t qtype;
+    runtime_shape_t shape, f_strides, q_strides;
+    std::vector<float> floats, f_ref, f_opt;
+    std::vector<gsl::byte> quants, q_ref, q_opt;
+};
+
+TEST_P(QuantizeTest, quantize)
+{
+    auto input = reinterpret_cast<const gsl::byte *>(floats.data());
+    ASSERT_TRUE(cpu::reference::quantize(dt_float32, qtype, input, q_ref.data(), shape, f_strides, q_strides, scale, bias, default_kernel_context()).is_ok());
+    ASSERT_TRUE(cpu::optimized::quantize(dt_float32, qtype, input, q_opt.data(), shape, f_strides, q_strides, scale, bias, default_kernel_context()).is_ok());
+    EXPECT_EQ(q_ref, q_opt);
+}
+
+TEST_P(QuantizeTest, dequantize)
+{
+    auto ref = reinterpret_cast<gsl::byte *>(f_ref.data());
+    auto opt = reinterpret_cast<gsl::byte *>(f_opt.data());
+    ASSERT_TRUE(cpu::reference::dequantize(qtype, dt_float32, quants.data(), ref, shape, q_strides, f_strides, 1.f / scale, bias, default_kernel_context()).is_ok());
+    ASSERT_TRUE(cpu::optimized::dequantize(qtype, dt_float32, quants.data(), opt, shape, q_strides, f_strides, 1.f / scale, bias, default_kernel_context()).is_ok());
+    EXPECT_EQ(f_ref, f_opt);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Quantize,
+    QuantizeTest,
+    testing::Combine(
+        testing::Values(dt_uint8, dt_int8), // quantized type
+        testing::Values(
+            runtime_shape_t { 2, 3, 17, 33 },
+            runtime_shape_t { 1, 1, 1, 40000 }), // shape
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0 },
+            runtime_shape_t { 0, 1, 0, 0 },
+            runtime_shape_t { 0, 0, 2, 0 }), // float tensor strides bias
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0 },
+            runtime_shape_t { 0, 0, 3, 0 }))); // quantized tensor strides bias
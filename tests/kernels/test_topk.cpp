@@ -0,0 +1,130 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+
+class TopKTest : public ::testing::TestWithParam<
+                     std::tuple<
+                         runtime_shape_t, int32_t, int64_t, // input shape, axis, k
+                         bool, bool>> // largest, sorted
+{
+public:
+    void SetUp() override
+    {
+        auto &&[in_shape, axis, k, largest, sorted] = GetParam();
+        this->in_shape = in_shape;
+        this->axis = axis;
+        this->k = k;
+        this->largest = largest;
+        this->sorted = sorted;
+
+        out_shape = in_shape;
+        out_shape[axis] = (size_t)k;
+
+        // Distinct values so the selection and its order are unique
+        input.resize(compute_size(in_shape));
+        for (size_t i = 0; i < input.size(); i++)
+            input[i] = (float)i;
+        std::shuffle(input.begin(), input.end(), std::mt19937(42));
+
+        values_ref.resize(compute_size(out_shape));
+        values_opt.resize(compute_size(out_shape));
+        indices_ref.resize(compute_size(out_shape));
+        indices_opt.resize(compute_size(out_shape));
+    }
+
+    result<void> topk(std::vector<float> &values, std::vector<int64_t> &indices, OpType type)
+    {
+        auto in_strides = get_default_strides(in_shape);
+        auto out_strides = get_default_strides(out_shape);
+        if (type == OpType::Ref)
+            return cpu::reference::topk(input.data(), values.data(), indices.data(), in_shape, in_strides,
+                out_shape, out_strides, out_shape, out_strides, k, axis, largest, sorted);
+        else
+            return cpu::optimized::topk(input.data(), values.data(), indices.data(), in_shape, k, axis, largest, sorted);
+    }
+
+    // Unsorted results may come in any order along the axis
+    void sort_along_axis(std::vector<float> &values, std::vector<int64_t> &indices)
+    {
+        size_t inner = std::accumulate(out_shape.begin() + axis + 1, out_shape.end(), 1, std::multiplies<size_t> {});
+        size_t outer = compute_size(out_shape) / (inner * k);
+        for (size_t o = 0; o < outer; o++)
+        {
+            for (size_t i = 0; i < inner; i++)
+            {
+                std::vector<std::pair<int64_t, float>> row;
+                for (int64_t j = 0; j < k; j++)
+                {
+                    auto off = (o * k + j) * inner + i;
+                    row.emplace_back(indices[off], values[off]);
+                }
+                std::sort(row.begin(), row.end());
+                for (int64_t j = 0; j < k; j++)
+                {
+                    auto off = (o * k + j) * inner + i;
+                    indices[off] = row[j].first;
+                    values[off] = row[j].second;
+                }
+            }
+        }
+    }
+
+    runtime_shape_t in_shape, out_shape;
+    int32_t axis;
+    int64_t k;
+    bool largest, sorted;
+    std::vector<float> input, values_ref, values_opt;
+    std::vector<int64_t> indices_ref, indices_opt;
+};
+
+TEST_P(TopKTest, normal)
+{
+    ASSERT_TRUE(topk(values_ref, indices_ref, OpType::Ref).is_ok());
+    ASSERT_TRUE(topk(values_opt, indices_opt, OpType::Opt).is_ok());
+    if (!sorted)
+    {
+        sort_along_axis(values_ref, indices_ref);
+        sort_along_axis(values_opt, indices_opt);
+    }
+
+    EXPECT_EQ(values_ref, values_opt);
+    EXPECT_EQ(indices_ref, indices_opt);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TopKLastAxis,
+    TopKTest,
+    testing::Combine(
+        testing::Values(
+            runtime_shape_t { 3, 1000 }), // input shape
+        testing::Values(1), // axis
+        testing::Values(1, 5, 100, 999, 1000), // k
+        testing::Bool(), // largest
+        testing::Bool())); // sorted
+
+INSTANTIATE_TEST_SUITE_P(
+    TopKInnerAxis,
+    TopKTest,
+    testing::Combine(
+        testing::Values(
+            runtime_shape_t { 2, 300, 4 }), // input shape
+        testing::Values(1), // axis
+        testing::Values(1, 10, 200), // k
+        testing::Bool(), // largest
+        testing::Bool())); // sorted
@@ -0,0 +1,74 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import numpy as np
+import onnx
+import pytest
+import nncase
+from onnx import helper
+from onnx import TensorProto
+
+
+def _make_module():
+    nodes = []
+    initializers = []
+    in_shape = [1, 8, 16, 16]
+    channels = in_shape[1]
+    rng = np.random.default_rng(0)
+
+    input = helper.make_tensor_value_info('input', TensorProto.FLOAT, in_shape)
+    output = helper.make_tensor_value_info('output', TensorProto.FLOAT, in_shape)
+
+    # Convs run on the KPU and Exp on the stackvm, every conv becomes a k210 graph called from the stackvm graph
+    last = 'input'
+    for i in range(4):
+        weights = rng.random((channels, channels, 3, 3), dtype=np.float32) - 0.5
+        initializers.append(helper.make_tensor(f'w{i}', TensorProto.FLOAT,
+                                               weights.shape, weights.flatten().tolist()))
+        nodes.append(helper.make_node('Conv', [last, f'w{i}'], [f'conv{i}'], pads=[1, 1, 1, 1]))
+        last = 'output' if i == 3 else f'exp{i}'
+        nodes.append(helper.make_node('Exp', [f'conv{i}'], [last]))
+
+    graph_def = helper.make_graph(nodes, 'test-model', [input], [output], initializer=initializers)
+    return helper.make_model(graph_def, producer_name='kendryte')
+
+
+def _compile(model_def, calib, tmpdir, compile_threads):
+    compile_options = nncase.CompileOptions()
+    compile_options.target = 'k210'
+    compile_options.dump_dir = str(tmpdir)
+    compile_options.compile_threads = compile_threads
+    compiler = nncase.Compiler(compile_options)
+    compiler.import_onnx(model_def.SerializeToString(), nncase.ImportOptions())
+    ptq_options = nncase.PTQTensorOptions()
+    ptq_options.set_tensor_data(calib.tobytes())
+    ptq_options.samples_count = calib.shape[0]
+    compiler.use_ptq(ptq_options)
+    compiler.compile()
+    return compiler.gencode_tobytes()
+
+
+def test_compile_threads(tmpdir):
+    model_def = _make_module()
+    calib = np.random.default_rng(1).random((4, 8, 16, 16), dtype=np.float32)
+
+    serial = _compile(model_def, calib, tmpdir.mkdir('serial'), 1)
+    for compile_threads in [0, 2, 4]:
+        parallel = _compile(model_def, calib, tmpdir.mkdir(f'threads_{compile_threads}'), compile_threads)
+        assert parallel == serial, f'compile_threads={compile_threads} changed the kmodel'
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_compile_threads.py'])
@@ -0,0 +1,96 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import numpy as np
+import onnx
+import pytest
+import nncase
+from onnx import helper
+from onnx import TensorProto
+
+
+def _make_module():
+    nodes = []
+    initializers = []
+    in_shape = [2, 8, 10, 10]
+    channels = 8
+
+    input = helper.make_tensor_value_info('input', TensorProto.FLOAT, in_shape)
+    output = helper.make_tensor_value_info('output', TensorProto.FLOAT, [2, channels])
+
+    def add_weights(name, shape):
+        data = np.random.rand(*shape).astype(np.float32) - 0.5
+        initializers.append(helper.make_tensor(name, TensorProto.FLOAT, data.shape, data.flatten().tolist()))
+
+    add_weights('w0', [channels, in_shape[1], 3, 3])
+    add_weights('b0', [channels])
+    add_weights('w1', [channels, channels, 3, 3])
+    add_weights('scale', [channels, 1, 1])
+
+    # The unpadded conv has a specialized kernel, the padded one runs the reference kernel
+    nodes.append(helper.make_node('Conv', ['input', 'w0', 'b0'], ['conv0']))
+    nodes.append(helper.make_node('Tanh', ['conv0'], ['act0']))
+    nodes.append(helper.make_node('Conv', ['act0', 'w1'], ['conv1'], pads=[1, 1, 1, 1]))
+    nodes.append(helper.make_node('Mul', ['conv1', 'scale'], ['scaled']))
+    nodes.append(helper.make_node('ReduceMean', ['scaled'], ['output'], axes=[2, 3], keepdims=0))
+
+    graph_def = helper.make_graph(nodes, 'test-model', [input], [output], initializer=initializers)
+    return helper.make_model(graph_def, producer_name='kendryte')
+
+
+def _compile(model_def, tmpdir, compute_type, target='cpu'):
+    compile_options = nncase.CompileOptions()
+    compile_options.target = target
+    compile_options.dump_dir = str(tmpdir)
+    compile_options.compute_type = compute_type
+    compiler = nncase.Compiler(compile_options)
+    compiler.import_onnx(model_def.SerializeToString(), nncase.ImportOptions())
+    compiler.compile()
+    return compiler.gencode_tobytes()
+
+
+def _run(kmodel, data):
+    sim = nncase.Simulator()
+    sim.load_model(kmodel)
+    sim.set_input_tensor(0, nncase.RuntimeTensor.from_numpy(data))
+    sim.run()
+    return sim.get_output_tensor(0).to_numpy()
+
+
+@pytest.mark.parametrize('compute_type,tolerance', [('float16', 1e-2), ('bfloat16', 5e-2)])
+def test_compute_type(tmpdir, compute_type, tolerance):
+    model_def = _make_module()
+    data = np.random.rand(2, 8, 10, 10).astype(np.float32) - 0.5
+
+    expected = _run(_compile(model_def, tmpdir.mkdir('float32'), 'float32'), data)
+    kmodel = _compile(model_def, tmpdir.mkdir(compute_type), compute_type)
+    actual = _run(kmodel, data)
+
+    # The inputs and outputs stay float, only the computation is narrowed
+    assert actual.dtype == np.float32
+    np.testing.assert_allclose(actual, expected, rtol=tolerance, atol=tolerance)
+
+
+def test_compute_type_non_cpu_target(tmpdir):
+    compile_options = nncase.CompileOptions()
+    compile_options.target = 'k210'
+    compile_options.dump_dir = str(tmpdir)
+    compile_options.compute_type = 'float16'
+    with pytest.raises(ValueError, match='only supported by the cpu target'):
+        nncase.Compiler(compile_options)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_compute_type.py'])
@@ -0,0 +1,101 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import numpy as np
+import onnx
+import pytest
+import nncase
+from onnx import helper
+from onnx import TensorProto
+
+max_batch = 4
+
+
+def _make_module():
+    nodes = []
+    initializers = []
+    in_shape = [1, 3, 8, 8]
+    channels = 4
+
+    input = helper.make_tensor_value_info('input', TensorProto.FLOAT, in_shape)
+    features = helper.make_tensor_value_info('features', TensorProto.FLOAT, [1, channels, 8, 8])
+    pooled = helper.make_tensor_value_info('pooled', TensorProto.FLOAT, [1, channels])
+
+    weights = np.random.rand(channels, in_shape[1], 3, 3).astype(np.float32) - 0.5
+    initializers.append(helper.make_tensor('weights', TensorProto.FLOAT,
+                                           weights.shape, weights.flatten().tolist()))
+    initializers.append(helper.make_tensor('zero', TensorProto.FLOAT, [1], [0.0]))
+
+    nodes.append(helper.make_node('Conv', ['input', 'weights'], ['conv'], pads=[1, 1, 1, 1]))
+    nodes.append(helper.make_node('Relu', ['conv'], ['features']))
+    nodes.append(helper.make_node('ReduceMean', ['features'], ['mean'], axes=[2, 3], keepdims=0))
+
+    # A 1-D tensor off the batch path, it must stay static
+    nodes.append(helper.make_node('RandomNormal', [], ['noise'], shape=[channels]))
+    nodes.append(helper.make_node('Mul', ['noise', 'zero'], ['offset']))
+    nodes.append(helper.make_node('Add', ['mean', 'offset'], ['pooled']))
+
+    graph_def = helper.make_graph(nodes, 'test-model', [input], [features, pooled], initializer=initializers)
+    return helper.make_model(graph_def, producer_name='kendryte')
+
+
+def _compile(model_def, tmpdir, batch):
+    compile_options = nncase.CompileOptions()
+    compile_options.target = 'cpu'
+    compile_options.dump_dir = str(tmpdir)
+    compile_options.max_batch = batch
+    compiler = nncase.Compiler(compile_options)
+    compiler.import_onnx(model_def.SerializeToString(), nncase.ImportOptions())
+    compiler.compile()
+    return compiler.gencode_tobytes()
+
+
+def _run(sim, data):
+    sim.set_input_tensor(0, nncase.RuntimeTensor.from_numpy(data))
+    sim.run()
+    return [sim.get_output_tensor(i).to_numpy() for i in range(sim.outputs_size)]
+
+
+def test_dynamic_batch(tmpdir):
+    model_def = _make_module()
+    data = np.random.rand(max_batch, 3, 8, 8).astype(np.float32)
+
+    static_sim = nncase.Simulator()
+    static_sim.load_model(_compile(model_def, tmpdir.mkdir('static'), 0))
+    sim = nncase.Simulator()
+    sim.load_model(_compile(model_def, tmpdir.mkdir('dynamic'), max_batch))
+    assert sim.max_batch == max_batch
+
+    expected = [_run(static_sim, data[n:n + 1]) for n in range(max_batch)]
+
+    sim.batch = 1
+    for n in range(max_batch):
+        for actual, golden in zip(_run(sim, data[n:n + 1]), expected[n]):
+            np.testing.assert_allclose(actual, golden, rtol=1e-5, atol=1e-6)
+
+    for batch in [2, max_batch]:
+        sim.batch = batch
+        outputs = _run(sim, data[:batch])
+        for i, output in enumerate(outputs):
+            assert output.shape[0] == batch
+            for n in range(batch):
+                np.testing.assert_allclose(output[n:n + 1], expected[n][i], rtol=1e-5, atol=1e-6)
+
+    with pytest.raises(RuntimeError):
+        sim.batch = max_batch + 1
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_dynamic_batch.py'])
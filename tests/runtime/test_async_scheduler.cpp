@@ -0,0 +1,126 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <nncase/runtime/async_scheduler.h>
+#include <string>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+
+namespace
+{
+struct task_trace
+{
+    std::mutex lock;
+    std::vector<std::string> stages;
+
+    void add(std::string stage)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stages.emplace_back(std::move(stage));
+    }
+};
+
+async_scheduler::task make_task(task_trace &trace, std::atomic<size_t> &completed, std::error_condition &error)
+{
+    async_scheduler::task t;
+    t.copy_inputs = [&]() -> result<void> { trace.add("in"); return ok(); };
+    t.compute = [&]() -> result<void> { trace.add("compute"); return ok(); };
+    t.copy_outputs = [&]() -> result<void> { trace.add("out"); return ok(); };
+    t.callback = [&](result<void> r) {
+        if (r.is_err())
+            error = r.unwrap_err();
+        completed++;
+    };
+    return t;
+}
+}
+
+TEST(AsyncSchedulerTest, RunsAllStagesInOrder)
+{
+    constexpr size_t tasks = 16;
+    async_scheduler scheduler(2);
+    std::vector<task_trace> traces(tasks);
+    std::vector<std::error_condition> errors(tasks);
+    std::atomic<size_t> completed = 0;
+
+    for (size_t i = 0; i < tasks; i++)
+        EXPECT_TRUE(scheduler.post(make_task(traces[i], completed, errors[i])).is_ok());
+    scheduler.wait_idle();
+
+    EXPECT_EQ(tasks, completed);
+    for (size_t i = 0; i < tasks; i++)
+    {
+        EXPECT_FALSE(errors[i]);
+        EXPECT_EQ((std::vector<std::string> { "in", "compute", "out" }), traces[i].stages);
+    }
+}
+
+TEST(AsyncSchedulerTest, FailedStageSkipsTheRest)
+{
+    async_scheduler scheduler;
+    task_trace in_trace, compute_trace;
+    std::error_condition in_error, compute_error;
+    std::atomic<size_t> completed = 0;
+
+    auto in_task = make_task(in_trace, completed, in_error);
+    in_task.copy_inputs = []() -> result<void> { return err(std::errc::io_error); };
+    auto compute_task = make_task(compute_trace, completed, compute_error);
+    compute_task.compute = []() -> result<void> { return err(std::errc::invalid_argument); };
+
+    EXPECT_TRUE(scheduler.post(std::move(in_task)).is_ok());
+    EXPECT_TRUE(scheduler.post(std::move(compute_task)).is_ok());
+    scheduler.wait_idle();
+
+    EXPECT_EQ(2, completed);
+    EXPECT_EQ(std::errc::io_error, in_error);
+    EXPECT_TRUE(in_trace.stages.empty());
+    EXPECT_EQ(std::errc::invalid_argument, compute_error);
+    EXPECT_EQ((std::vector<std::string> { "in" }), compute_trace.stages);
+}
+
+TEST(AsyncSchedulerTest, RejectsIncompleteTask)
+{
+    async_scheduler scheduler;
+    async_scheduler::task t;
+    t.compute = []() -> result<void> { return ok(); };
+
+    auto r = scheduler.post(std::move(t));
+    ASSERT_TRUE(r.is_err());
+    EXPECT_EQ(std::errc::invalid_argument, r.unwrap_err());
+}
+
+TEST(AsyncSchedulerTest, CallbackMayWaitForDrain)
+{
+    async_scheduler scheduler;
+    task_trace trace;
+    std::error_condition error;
+    std::atomic<size_t> completed = 0;
+    std::promise<void> drained;
+
+    auto t = make_task(trace, completed, error);
+    t.callback = [&](result<void>) {
+        scheduler.wait_idle();
+        drained.set_value();
+    };
+
+    EXPECT_TRUE(scheduler.post(std::move(t)).is_ok());
+    EXPECT_EQ(std::future_status::ready, drained.get_future().wait_for(std::chrono::seconds(10)));
+}
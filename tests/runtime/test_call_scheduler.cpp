@@ -0,0 +1,188 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <gtest/gtest.h>
+#include <nncase/runtime/runtime_module.h>
+#include <runtime/stackvm/call_scheduler.h>
+#include <thread>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+namespace
+{
+class fake_module : public runtime_module
+{
+protected:
+    result<std::unique_ptr<runtime_function>> create_function() noexcept override
+    {
+        return err(std::errc::not_supported);
+    }
+};
+
+// A function without inputs or outputs, its body works on buffers the test owns
+class fake_function : public runtime_function
+{
+public:
+    fake_function(runtime_module &module, std::function<result<void>()> body)
+        : runtime_function(module), body_(std::move(body))
+    {
+    }
+
+protected:
+    result<void> initialize_core(NNCASE_UNUSED runtime_function_init_context &context) noexcept override { return ok(); }
+    result<runtime_tensor> allocate_input_tensor(NNCASE_UNUSED size_t index) noexcept override { return err(std::errc::not_supported); }
+    result<runtime_tensor> allocate_output_tensor(NNCASE_UNUSED size_t index) noexcept override { return err(std::errc::not_supported); }
+    result<void> validate_input_tensor(NNCASE_UNUSED size_t index, NNCASE_UNUSED runtime_tensor tensor) noexcept override { return ok(); }
+    result<void> validate_output_tensor(NNCASE_UNUSED size_t index, NNCASE_UNUSED runtime_tensor tensor) noexcept override { return ok(); }
+    result<void> invoke_core() noexcept override { return body_(); }
+
+private:
+    std::function<result<void>()> body_;
+};
+
+call_scheduler::buffer_span span_of(const std::vector<float> &buffer)
+{
+    return { (uintptr_t)buffer.data(), (uintptr_t)(buffer.data() + buffer.size()) };
+}
+
+call_scheduler::call make_call(fake_function &function, std::vector<call_scheduler::buffer_span> reads, std::vector<call_scheduler::buffer_span> writes)
+{
+    call_scheduler::call c { &function };
+    c.reads = std::move(reads);
+    c.writes = std::move(writes);
+    return c;
+}
+
+// Waits for a flag another call sets
+bool wait_for(const std::atomic<bool> &flag, std::chrono::milliseconds timeout = std::chrono::seconds(1))
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!flag && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+    return flag;
+}
+
+struct two_branch_graph
+{
+    std::vector<float> input, a, b, sum;
+    std::atomic<bool> b_started = false;
+    bool overlapped = false;
+
+    // a = input * 2 and b = input + 1 run on different modules, sum = a + b joins them on the module of a
+    fake_module module_a, module_b;
+    fake_function call_a { module_a, [this] {
+                              overlapped = wait_for(b_started);
+                              for (size_t i = 0; i < input.size(); i++)
+                                  a[i] = input[i] * 2;
+                              return ok();
+                          } };
+    fake_function call_b { module_b, [this] {
+                              b_started = true;
+                              for (size_t i = 0; i < input.size(); i++)
+                                  b[i] = input[i] + 1;
+                              return ok();
+                          } };
+    fake_function call_sum { module_a, [this] {
+                                for (size_t i = 0; i < input.size(); i++)
+                                    sum[i] = a[i] + b[i];
+                                return ok();
+                            } };
+
+    two_branch_graph(size_t size)
+        : input(size), a(size), b(size), sum(size)
+    {
+        for (size_t i = 0; i < size; i++)
+            input[i] = (float)i * 0.5f - 3.f;
+    }
+};
+}
+
+TEST(CallSchedulerTest, OverlappedCallsMatchSerialExecution)
+{
+    constexpr size_t size = 4096;
+    two_branch_graph serial(size);
+    serial.b_started = true;
+    ASSERT_TRUE(serial.call_a.invoke().is_ok());
+    ASSERT_TRUE(serial.call_b.invoke().is_ok());
+    ASSERT_TRUE(serial.call_sum.invoke().is_ok());
+
+    two_branch_graph g(size);
+    {
+        call_scheduler scheduler;
+        ASSERT_TRUE(scheduler.post(make_call(g.call_a, { span_of(g.input) }, { span_of(g.a) })).is_ok());
+        ASSERT_TRUE(scheduler.post(make_call(g.call_b, { span_of(g.input) }, { span_of(g.b) })).is_ok());
+        ASSERT_TRUE(scheduler.post(make_call(g.call_sum, { span_of(g.a), span_of(g.b) }, { span_of(g.sum) })).is_ok());
+        ASSERT_TRUE(scheduler.wait_all().is_ok());
+    }
+
+    // call_a only finishes early if call_b could not start while it was in flight
+    EXPECT_TRUE(g.overlapped);
+    EXPECT_EQ(g.a, serial.a);
+    EXPECT_EQ(g.b, serial.b);
+    EXPECT_EQ(g.sum, serial.sum);
+}
+
+TEST(CallSchedulerTest, WriteWaitsForInFlightRead)
+{
+    std::vector<float> x(1024, 1.f), y(1024, 0.f);
+    std::atomic<bool> write_started = false;
+    bool write_overlapped = true;
+
+    fake_module module_read, module_write;
+    fake_function read { module_read, [&] {
+                            // Gives the write a chance to start if the scheduler let it
+                            write_overlapped = wait_for(write_started, std::chrono::milliseconds(100));
+                            y = x;
+                            return ok();
+                        } };
+    fake_function write { module_write, [&] {
+                             write_started = true;
+                             std::fill(x.begin(), x.end(), 2.f);
+                             return ok();
+                         } };
+
+    call_scheduler scheduler;
+    ASSERT_TRUE(scheduler.post(make_call(read, { span_of(x) }, { span_of(y) })).is_ok());
+    ASSERT_TRUE(scheduler.post(make_call(write, {}, { span_of(x) })).is_ok());
+    ASSERT_TRUE(scheduler.wait_all().is_ok());
+
+    EXPECT_FALSE(write_overlapped);
+    EXPECT_EQ(y, std::vector<float>(1024, 1.f));
+    EXPECT_EQ(x, std::vector<float>(1024, 2.f));
+}
+
+TEST(CallSchedulerTest, ReturnsFirstError)
+{
+    std::vector<float> x(16);
+    fake_module module;
+    fake_function failing { module, [] { return err(std::errc::invalid_argument); } };
+    fake_function next { module, [] { return ok(); } };
+
+    call_scheduler scheduler;
+    ASSERT_TRUE(scheduler.post(make_call(failing, {}, { span_of(x) })).is_ok());
+    auto r = scheduler.post(make_call(next, {}, { span_of(x) }));
+    if (r.is_ok())
+        r = scheduler.wait_all();
+    ASSERT_TRUE(r.is_err());
+    EXPECT_EQ(r.unwrap_err(), std::errc::invalid_argument);
+
+    // The error is reported once
+    EXPECT_TRUE(scheduler.wait_all().is_ok());
+}
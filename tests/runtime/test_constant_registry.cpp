@@ -0,0 +1,149 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <nncase/runtime/constant_registry.h>
+#include <runtime/stackvm/rdata_blocks.h>
+#include <thread>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+namespace
+{
+gsl::span<const gsl::byte> as_span(const std::vector<uint8_t> &data)
+{
+    return { reinterpret_cast<const gsl::byte *>(data.data()), data.size() };
+}
+
+// The registry is process-wide, so every test uses its own hashes
+constexpr uint64_t hash_base = 0x5EED000000000000ULL;
+}
+
+TEST(ConstantRegistryTest, SharesEqualBlocks)
+{
+    std::vector<uint8_t> data(256, 7), copy = data;
+    auto before = constant_registry::stats();
+
+    auto a = constant_registry::acquire(hash_base + 1, as_span(data)).unwrap();
+    auto b = constant_registry::acquire(hash_base + 1, as_span(copy)).unwrap();
+    EXPECT_EQ(a.get(), b.get());
+    EXPECT_NE(reinterpret_cast<const uint8_t *>(a.get()), data.data());
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), reinterpret_cast<const uint8_t *>(a.get())));
+
+    auto after = constant_registry::stats();
+    EXPECT_EQ(after.blocks, before.blocks + 1);
+    EXPECT_EQ(after.bytes, before.bytes + data.size());
+    EXPECT_EQ(after.misses, before.misses + 1);
+    EXPECT_EQ(after.hits, before.hits + 1);
+}
+
+TEST(ConstantRegistryTest, KeepsCollidingBlocksApart)
+{
+    std::vector<uint8_t> data(64, 1), other(64, 2), shorter(32, 1);
+    auto a = constant_registry::acquire(hash_base + 2, as_span(data)).unwrap();
+    auto b = constant_registry::acquire(hash_base + 2, as_span(other)).unwrap();
+    auto c = constant_registry::acquire(hash_base + 2, as_span(shorter)).unwrap();
+    EXPECT_NE(a.get(), b.get());
+    EXPECT_NE(a.get(), c.get());
+    EXPECT_EQ(reinterpret_cast<const uint8_t *>(b.get())[0], 2);
+    EXPECT_EQ(constant_registry::acquire(hash_base + 2, as_span(other)).unwrap().get(), b.get());
+}
+
+TEST(ConstantRegistryTest, ReleasesWithTheLastHolder)
+{
+    std::vector<uint8_t> data(1024, 3);
+    auto before = constant_registry::stats();
+    auto a = constant_registry::acquire(hash_base + 3, as_span(data)).unwrap();
+    auto b = a;
+
+    a.reset();
+    EXPECT_EQ(constant_registry::stats().blocks, before.blocks + 1);
+    b.reset();
+    auto released = constant_registry::stats();
+    EXPECT_EQ(released.blocks, before.blocks);
+    EXPECT_EQ(released.bytes, before.bytes);
+
+    // An expired block is created again
+    auto c = constant_registry::acquire(hash_base + 3, as_span(data)).unwrap();
+    EXPECT_EQ(constant_registry::stats().misses, before.misses + 2);
+    EXPECT_EQ(constant_registry::stats().blocks, before.blocks + 1);
+}
+
+TEST(ConstantRegistryTest, SharesAcrossThreads)
+{
+    std::vector<uint8_t> data(4096, 9);
+    constexpr size_t threads = 8;
+    std::vector<constant_registry::block_t> blocks(threads);
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < threads; i++)
+        workers.emplace_back([&, i] { blocks[i] = constant_registry::acquire(hash_base + 4, as_span(data)).unwrap(); });
+    for (auto &w : workers)
+        w.join();
+
+    for (auto &block : blocks)
+        EXPECT_EQ(block.get(), blocks[0].get());
+}
+
+TEST(RdataBlocksTest, MapsOffsetsToBlocks)
+{
+    std::vector<uint8_t> first(16, 1), second(8, 2);
+    rdata_blocks blocks;
+    EXPECT_TRUE(blocks.empty());
+    ASSERT_TRUE(blocks.add(0, first.size(), constant_registry::acquire(hash_base + 5, as_span(first)).unwrap()).is_ok());
+    // A gap between the blocks
+    ASSERT_TRUE(blocks.add(32, second.size(), constant_registry::acquire(hash_base + 6, as_span(second)).unwrap()).is_ok());
+    EXPECT_FALSE(blocks.empty());
+
+    auto first_data = blocks.at(0).unwrap();
+    EXPECT_EQ(blocks.at(5).unwrap(), first_data + 5);
+    // One past the end of a block is a valid address for an empty tensor
+    EXPECT_EQ(blocks.at(16).unwrap(), first_data + 16);
+    EXPECT_TRUE(blocks.at(17).is_err());
+    EXPECT_EQ(*reinterpret_cast<const uint8_t *>(blocks.at(35).unwrap()), 2);
+    EXPECT_TRUE(blocks.at(41).is_err());
+}
+
+TEST(RdataBlocksTest, RejectsUnorderedBlocks)
+{
+    std::vector<uint8_t> data(16, 4);
+    rdata_blocks blocks;
+    ASSERT_TRUE(blocks.add(16, data.size(), constant_registry::acquire(hash_base + 7, as_span(data)).unwrap()).is_ok());
+    EXPECT_TRUE(blocks.add(8, data.size(), constant_registry::acquire(hash_base + 7, as_span(data)).unwrap()).is_err());
+    EXPECT_TRUE(blocks.add(0, data.size(), constant_registry::acquire(hash_base + 7, as_span(data)).unwrap()).is_err());
+    // Offsets before the first block are not mapped
+    EXPECT_TRUE(blocks.at(4).is_err());
+}
+
+TEST(RdataBlocksTest, RecognizesBlockAddresses)
+{
+    std::vector<uint8_t> first(16, 1), second(24, 2);
+    rdata_blocks blocks;
+    auto a = constant_registry::acquire(hash_base + 8, as_span(first)).unwrap();
+    auto b = constant_registry::acquire(hash_base + 9, as_span(second)).unwrap();
+    ASSERT_TRUE(blocks.add(0, first.size(), a).is_ok());
+    ASSERT_TRUE(blocks.add(16, second.size(), b).is_ok());
+
+    auto addr = [](const constant_registry::block_t &block, size_t offset) { return reinterpret_cast<uintptr_t>(block.get()) + offset; };
+    EXPECT_TRUE(blocks.contains(addr(a, 0)));
+    EXPECT_TRUE(blocks.contains(addr(a, 15)));
+    EXPECT_TRUE(blocks.contains(addr(b, 23)));
+    // One past a block is outside it, unless the other block happens to start there
+    EXPECT_EQ(blocks.contains(addr(a, 16)), addr(a, 16) == addr(b, 0));
+    EXPECT_EQ(blocks.contains(addr(b, 24)), addr(b, 24) == addr(a, 0));
+    EXPECT_FALSE(blocks.contains(reinterpret_cast<uintptr_t>(first.data())));
+    EXPECT_FALSE(blocks.contains(0));
+}
@@ -0,0 +1,283 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <nncase/kernels/convolution.h>
+#include <nncase/kernels/tensor_compute.h>
+#include <nncase/runtime/kernel_tuner.h>
+#include <nncase/runtime/runtime_op_utility.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+
+namespace
+{
+class temp_file
+{
+public:
+    temp_file(const char *name)
+        : path_(std::filesystem::temp_directory_path() / name)
+    {
+        std::filesystem::remove(path_);
+    }
+
+    ~temp_file()
+    {
+        std::filesystem::remove(path_);
+    }
+
+    std::string path() const { return path_.string(); }
+
+    void write(const std::string &content) const
+    {
+        std::ofstream(path_, std::ios::trunc) << content;
+    }
+
+    std::string read() const
+    {
+        std::ifstream file(path_);
+        return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    }
+
+private:
+    std::filesystem::path path_;
+};
+
+// Runs the candidates, the ones in slow sleep so the others always win
+struct fake_op
+{
+    std::vector<size_t> slow {};
+    std::vector<size_t> failing {};
+    std::vector<size_t> runs {};
+
+    kernel_tuner::run_candidate_t runner()
+    {
+        return [this](size_t index) -> result<void> {
+            runs.emplace_back(index);
+            if (std::find(failing.begin(), failing.end(), index) != failing.end())
+                return err(std::errc::not_supported);
+            if (std::find(slow.begin(), slow.end(), index) != slow.end())
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            return ok();
+        };
+    }
+};
+
+const std::vector<std::string> candidates { "static", "fast", "other" };
+
+template <class T>
+std::vector<T> make_random(size_t size)
+{
+    std::mt19937 gen(size);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    std::vector<T> data(size);
+    for (auto &v : data)
+        v = (T)dist(gen);
+    return data;
+}
+}
+
+TEST(KernelTunerTest, LoadsOwnAndForeignEntries)
+{
+    temp_file file("nncase_test_kernel_tuner_load.txt");
+    file.write(kernel_tuner::cpu_model() + "\top;a\tfast  \r\n"
+        + "malformed line\n"
+        + "only\tone tab\n"
+        + "\n"
+        + "another cpu\top;a\tother\n");
+
+    kernel_tuner tuner(false);
+    EXPECT_TRUE(tuner.load(file.path().c_str()).is_ok());
+    EXPECT_EQ(tuner.size(), 2);
+
+    fake_op op;
+    EXPECT_EQ(tuner.select("op;a", candidates, op.runner()).unwrap(), 1);
+    EXPECT_TRUE(op.runs.empty());
+}
+
+TEST(KernelTunerTest, MissingFileLeavesCacheEmpty)
+{
+    temp_file file("nncase_test_kernel_tuner_missing.txt");
+    kernel_tuner tuner;
+    EXPECT_TRUE(tuner.load(file.path().c_str()).is_ok());
+    EXPECT_EQ(tuner.size(), 0);
+}
+
+TEST(KernelTunerTest, SaveKeepsForeignEntries)
+{
+    temp_file file("nncase_test_kernel_tuner_save.txt");
+    file.write("another cpu\top;a\tother\n");
+
+    kernel_tuner tuner;
+    EXPECT_TRUE(tuner.load(file.path().c_str()).is_ok());
+    fake_op op { { 0, 2 } };
+    EXPECT_EQ(tuner.select("op;b", candidates, op.runner()).unwrap(), 1);
+    EXPECT_TRUE(tuner.save(file.path().c_str()).is_ok());
+
+    kernel_tuner reloaded(false);
+    EXPECT_TRUE(reloaded.load(file.path().c_str()).is_ok());
+    EXPECT_EQ(reloaded.size(), 2);
+    EXPECT_NE(file.read().find("another cpu\top;a\tother\n"), std::string::npos);
+    EXPECT_NE(file.read().find(kernel_tuner::cpu_model() + "\top;b\tfast\n"), std::string::npos);
+
+    fake_op cached;
+    EXPECT_EQ(reloaded.select("op;b", candidates, cached.runner()).unwrap(), 1);
+    EXPECT_TRUE(cached.runs.empty());
+}
+
+TEST(KernelTunerTest, CachedChoiceIsNotRunAgain)
+{
+    kernel_tuner tuner;
+    fake_op op { { 0, 2 } };
+    EXPECT_EQ(tuner.select("op;c", candidates, op.runner()).unwrap(), 1);
+    EXPECT_FALSE(op.runs.empty());
+
+    // Faster now, but the cached choice wins without timing anything
+    fake_op again { { 1 } };
+    EXPECT_EQ(tuner.select("op;c", candidates, again.runner()).unwrap(), 1);
+    EXPECT_TRUE(again.runs.empty());
+}
+
+TEST(KernelTunerTest, StaleChoiceIsTunedAgain)
+{
+    temp_file file("nncase_test_kernel_tuner_stale.txt");
+    file.write(kernel_tuner::cpu_model() + "\top;d\tremoved\n");
+
+    kernel_tuner tuner;
+    EXPECT_TRUE(tuner.load(file.path().c_str()).is_ok());
+    fake_op op { { 0, 1 } };
+    EXPECT_EQ(tuner.select("op;d", candidates, op.runner()).unwrap(), 2);
+    EXPECT_FALSE(op.runs.empty());
+    EXPECT_EQ(tuner.size(), 1);
+
+    EXPECT_TRUE(tuner.save(file.path().c_str()).is_ok());
+    EXPECT_EQ(file.read(), kernel_tuner::cpu_model() + "\top;d\tother\n");
+}
+
+TEST(KernelTunerTest, TuningOffReturnsStaticChoice)
+{
+    kernel_tuner tuner(false);
+    fake_op op { { 0 } };
+    EXPECT_EQ(tuner.select("op;e", candidates, op.runner()).unwrap(), 0);
+    EXPECT_TRUE(op.runs.empty());
+    EXPECT_EQ(tuner.size(), 0);
+}
+
+TEST(KernelTunerTest, FailingCandidateIsSkipped)
+{
+    kernel_tuner tuner;
+    fake_op op { { 0 }, { 1 } };
+    EXPECT_EQ(tuner.select("op;f", candidates, op.runner()).unwrap(), 2);
+    EXPECT_EQ(std::count(op.runs.begin(), op.runs.end(), 1), 1);
+}
+
+TEST(KernelTunerTest, FailingStaticChoiceFails)
+{
+    kernel_tuner tuner;
+    fake_op op { {}, { 0 } };
+    EXPECT_TRUE(tuner.select("op;g", candidates, op.runner()).is_err());
+    EXPECT_EQ(tuner.size(), 0);
+}
+
+TEST(KernelTunerTest, CopyCandidatesMatchReference)
+{
+    runtime_shape_t shape { 2, 3, 4, 5 };
+    auto dest_strides = get_default_strides(shape);
+    runtime_shape_t src_strides { 3 * 4 * 8, 4 * 8, 8, 1 };
+    auto plan = kernels::plan_copy(shape, src_strides, dest_strides);
+    ASSERT_TRUE(plan.optimized);
+
+    auto plans = kernels::copy_candidates(plan);
+    ASSERT_EQ(plans.size(), 2);
+    EXPECT_STREQ(plans[0].name, plan.name);
+    EXPECT_FALSE(plans[1].optimized);
+
+    auto src = make_random<float>(2 * 3 * 4 * 8);
+    std::vector<float> expected(compute_size(shape));
+    EXPECT_TRUE(kernels::copy(dt_float32, reinterpret_cast<const gsl::byte *>(src.data()), reinterpret_cast<gsl::byte *>(expected.data()),
+        shape, src_strides, dest_strides, plans[1])
+                    .is_ok());
+
+    for (auto &candidate : plans)
+    {
+        std::vector<float> output(expected.size());
+        EXPECT_TRUE(kernels::copy(dt_float32, reinterpret_cast<const gsl::byte *>(src.data()), reinterpret_cast<gsl::byte *>(output.data()),
+            shape, src_strides, dest_strides, candidate)
+                        .is_ok());
+        EXPECT_EQ(output, expected) << candidate.name;
+    }
+
+    auto reference = kernels::copy_candidates(plans[1]);
+    ASSERT_EQ(reference.size(), 1);
+    EXPECT_FALSE(reference[0].optimized);
+}
+
+TEST(KernelTunerTest, Conv2dCandidatesMatchReference)
+{
+    runtime_shape_t in_shape { 1, 4, 6, 6 }, w_shape { 8, 4, 1, 1 }, out_shape { 1, 8, 6, 6 };
+    auto in_strides = get_default_strides(in_shape);
+    auto w_strides = get_default_strides(w_shape);
+    auto out_strides = get_default_strides(out_shape);
+    runtime_shape_t bias_strides { 1 };
+    auto pad = padding::zero();
+    auto plan = kernels::plan_conv2d(dt_float32, in_shape, in_strides, w_shape, pad, pad, 1, 1, 1, 1, 1);
+    ASSERT_NE(plan.kernel, nullptr);
+
+    auto candidates = kernels::conv2d_candidates(plan, 4);
+    std::vector<std::string> names;
+    for (auto &c : candidates)
+        names.emplace_back(c.name);
+    EXPECT_EQ(names, (std::vector<std::string> { std::string(plan.name) + "@4", std::string(plan.name) + "@2", std::string(plan.name) + "@1", "reference" }));
+    EXPECT_EQ(candidates[0].num_threads, 0);
+    EXPECT_EQ(candidates[1].num_threads, 2);
+    EXPECT_EQ(candidates[3].plan.kernel, nullptr);
+
+    auto input = make_random<float>(compute_size(in_shape));
+    auto weights = make_random<float>(compute_size(w_shape));
+    auto bias = make_random<float>(8);
+    auto run = [&](const kernels::conv2d_candidate &candidate, std::vector<float> &output) {
+        kernels::kernel_context context { 4 };
+        if (candidate.num_threads)
+            context.num_threads = candidate.num_threads;
+        output.resize(compute_size(out_shape));
+        return kernels::conv2d(input.data(), weights.data(), bias.data(), output.data(), in_shape, in_strides, w_shape, w_strides, bias_strides, out_strides,
+            pad, pad, 1, 1, 1, 1, 1, value_range<float>::full(), candidate.plan, context);
+    };
+
+    std::vector<float> expected;
+    ASSERT_TRUE(run(candidates.back(), expected).is_ok());
+    for (auto &candidate : candidates)
+    {
+        std::vector<float> output;
+        ASSERT_TRUE(run(candidate, output).is_ok());
+        for (size_t i = 0; i < expected.size(); i++)
+            EXPECT_NEAR(output[i], expected[i], 1e-5f) << candidate.name << " at " << i;
+    }
+
+    kernel_tuner tuner;
+    std::vector<float> output;
+    auto index = tuner.select("conv2d;test", names, [&](size_t i) { return run(candidates[i], output); }).unwrap();
+    EXPECT_LT(index, candidates.size());
+    EXPECT_EQ(tuner.size(), 1);
+
+    auto reference = kernels::conv2d_candidates(candidates.back().plan, 4);
+    ASSERT_EQ(reference.size(), 1);
+    EXPECT_EQ(reference[0].name, "reference");
+}
@@ -0,0 +1,278 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <nncase/runtime/half.h>
+#include <nncase/runtime/interpreter.h>
+#include <nncase/runtime/model.h>
+#include <nncase/runtime/stackvm/opcode.h>
+#include <nncase/runtime/stackvm/runtime_module.h>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+namespace
+{
+constexpr size_t channels = 8;
+constexpr size_t in_size = 6;
+constexpr size_t out_size = in_size - 2;
+constexpr size_t in_count = channels * in_size * in_size;
+constexpr size_t out_count = channels * out_size * out_size;
+constexpr size_t w_count = channels * channels * 3 * 3;
+constexpr size_t data_pool_size = 100;
+
+class byte_writer
+{
+public:
+    template <class T>
+    void write(const T &value)
+    {
+        auto begin = reinterpret_cast<const uint8_t *>(&value);
+        data.insert(data.end(), begin, begin + sizeof(T));
+    }
+
+    template <class T>
+    void write_at(size_t offset, const T &value)
+    {
+        std::memcpy(data.data() + offset, &value, sizeof(T));
+    }
+
+    void align(size_t alignment)
+    {
+        data.resize((data.size() + alignment - 1) / alignment * alignment);
+    }
+
+    std::vector<uint8_t> data;
+};
+
+// A stackvm kmodel running one float16 3x3 conv2d: input [1,8,6,6] -> output [1,8,4,4]. The
+// conv has a specialized float kernel, so its images are widened in scratch buffers
+std::vector<uint8_t> make_conv2d_model()
+{
+    byte_writer text;
+    auto ldc = [&](int32_t value) {
+        text.write((uint8_t)opcode_t::LDC_I4);
+        text.write(value);
+    };
+    auto lea = [&](memory_location_t location, uint32_t offset) {
+        text.write((uint8_t)opcode_t::LEA_BUFFER);
+        text.write(location);
+        text.write<uint8_t>(0);
+        text.write(offset);
+    };
+    auto stshape = [&](uint8_t reg, std::vector<int32_t> shape) {
+        for (auto dim : shape)
+            ldc(dim);
+        text.write((uint8_t)opcode_t::STSHAPE);
+        text.write(reg);
+        text.write((uint8_t)shape.size());
+    };
+
+    lea(mem_input, 0);
+    lea(mem_rdata, 0);
+    lea(mem_rdata, w_count * sizeof(half));
+    lea(mem_output, 0);
+    for (int i = 0; i < 6; i++)
+        ldc(0);
+    stshape(0, { 1, channels, in_size, in_size });
+    stshape(1, { in_count, in_size * in_size, in_size, 1 });
+    stshape(2, { channels, channels, 3, 3 });
+    stshape(3, { channels * 9, 9, 3, 1 });
+    stshape(4, { 1 });
+    stshape(5, { out_count, out_size * out_size, out_size, 1 });
+    text.write((uint8_t)opcode_t::TENSOR);
+    text.write((uint16_t)tensor_function_t::CONV2D);
+    text.write(dt_float16);
+    for (uint8_t reg = 0; reg < 6; reg++)
+        text.write(reg);
+    for (uint16_t attr : { 1, 1, 1, 1, 1 })
+        text.write(attr);
+    text.write(-100.f);
+    text.write(100.f);
+    text.write((uint8_t)opcode_t::RET);
+
+    byte_writer rdata;
+    for (size_t i = 0; i < w_count; i++)
+        rdata.write(half(0.125f));
+    for (size_t i = 0; i < channels; i++)
+        rdata.write(half(0.5f));
+
+    byte_writer mod;
+    mod.data.resize(sizeof(module_header));
+    mod.write(mempool_desc { mem_rdata, {}, (uint32_t)rdata.data.size() });
+    mod.write(mempool_desc { mem_data, {}, (uint32_t)data_pool_size });
+
+    auto function_start = mod.data.size();
+    mod.data.resize(function_start + sizeof(function_header));
+    mod.write(memory_range { mem_input, dt_float16, 0, 0, (uint32_t)(in_count * sizeof(half)) });
+    for (uint32_t dim : { 4u, 1u, (uint32_t)channels, (uint32_t)in_size, (uint32_t)in_size })
+        mod.write(dim);
+    mod.write(memory_range { mem_output, dt_float16, 0, 0, (uint32_t)(out_count * sizeof(half)) });
+    for (uint32_t dim : { 4u, 1u, (uint32_t)channels, (uint32_t)out_size, (uint32_t)out_size })
+        mod.write(dim);
+    mod.align(8);
+
+    function_header function {};
+    function.header_size = sizeof(function_header);
+    function.size = (uint32_t)(mod.data.size() - function_start);
+    function.input_pool_size = in_count * sizeof(half);
+    function.output_pool_size = out_count * sizeof(half);
+    function.inputs = 1;
+    function.outputs = 1;
+    function.text_size = (uint32_t)text.data.size();
+    mod.write_at(function_start, function);
+
+    for (auto [name, body] : { std::pair { ".text", &text }, { ".rdata", &rdata } })
+    {
+        section_header section {};
+        std::strcpy(section.name, name);
+        section.body_size = section.memory_size = (uint32_t)body->data.size();
+        mod.write(section);
+        mod.data.insert(mod.data.end(), body->data.begin(), body->data.end());
+    }
+    mod.align(8);
+
+    module_header header {};
+    std::memcpy(header.type.data(), stackvm_module_type.data(), header.type.size());
+    header.version = stackvm_module_version;
+    header.header_size = sizeof(module_header);
+    header.size = (uint32_t)mod.data.size();
+    header.mempools = 2;
+    header.functions = 1;
+    header.sections = 2;
+    mod.write_at(0, header);
+
+    model_header model {};
+    model.identifier = MODEL_IDENTIFIER;
+    model.version = MODEL_VERSION;
+    model.header_size = sizeof(model_header);
+    model.alignment = 8;
+    model.modules = 1;
+
+    byte_writer kmodel;
+    kmodel.write(model);
+    kmodel.data.insert(kmodel.data.end(), mod.data.begin(), mod.data.end());
+    return kmodel.data;
+}
+
+// Rounds every allocation up to 64 bytes and checks each span comes back whole
+class padding_allocator : public host_allocator
+{
+public:
+    static constexpr size_t granularity = 64;
+
+    static size_t padded(size_t bytes) noexcept { return (bytes + granularity - 1) / granularity * granularity; }
+
+    gsl::span<gsl::byte> allocate(allocation_state &, size_t bytes) override
+    {
+        auto size = padded(bytes);
+        auto ptr = new gsl::byte[size];
+        std::lock_guard<std::mutex> lock(lock_);
+        live_.emplace(ptr, size);
+        return { ptr, size };
+    }
+
+    void free(allocation_state &, gsl::span<gsl::byte> buffer) noexcept override
+    {
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            auto it = live_.find(buffer.data());
+            EXPECT_NE(it, live_.end());
+            if (it != live_.end())
+            {
+                EXPECT_EQ(it->second, buffer.size_bytes());
+                live_.erase(it);
+            }
+        }
+        delete[] buffer.data();
+    }
+
+    size_t live() const
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        return live_.size();
+    }
+
+private:
+    mutable std::mutex lock_;
+    std::map<gsl::byte *, size_t> live_;
+};
+
+gsl::span<const gsl::byte> as_span(const std::vector<uint8_t> &data)
+{
+    return { reinterpret_cast<const gsl::byte *>(data.data()), data.size() };
+}
+}
+
+TEST(MemoryStatsTest, CountsCategories)
+{
+    auto kmodel = make_conv2d_model();
+    padding_allocator allocator;
+    std::shared_ptr<allocation_tracker> tracker;
+    runtime_tensor output;
+    {
+        interpreter interp;
+        ASSERT_TRUE(interp.allocator(allocator).is_ok());
+        ASSERT_TRUE(interp.load_model(as_span(kmodel)).is_ok());
+        tracker = interp.memory_tracker();
+
+        // Only the data pool is allocated at load, the sections are used in place
+        auto loaded = interp.memory_stats().unwrap();
+        ASSERT_EQ(1, loaded.modules.size());
+        EXPECT_EQ(padding_allocator::padded(data_pool_size), loaded.usage.data_bytes);
+        EXPECT_EQ(0, loaded.usage.section_bytes);
+        EXPECT_EQ(0, loaded.usage.tensor_bytes);
+        EXPECT_EQ(0, loaded.usage.scratch_bytes);
+        EXPECT_EQ(loaded.usage.data_bytes, loaded.modules[0].usage.data_bytes);
+
+        auto input = interp.input_tensor(0).unwrap();
+        {
+            auto map = std::move(hrt::map(input, hrt::map_write).unwrap());
+            auto values = map.buffer().as_span<half>();
+            std::fill(values.begin(), values.end(), half(1.f));
+        }
+        ASSERT_TRUE(interp.run().is_ok());
+        output = interp.output_tensor(0).unwrap();
+        {
+            auto map = std::move(hrt::map(output, hrt::map_read).unwrap());
+            for (auto value : map.buffer().as_span<half>())
+                EXPECT_EQ(9.5f, float(value));
+        }
+
+        // The scratch buffers are freed when the conv returns, the peak holds the widened weights, bias and images
+        auto ran = interp.memory_stats().unwrap();
+        auto tensor_bytes = padding_allocator::padded(in_count * sizeof(half)) + padding_allocator::padded(out_count * sizeof(half));
+        EXPECT_EQ(tensor_bytes, ran.usage.tensor_bytes);
+        EXPECT_EQ(0, ran.usage.scratch_bytes);
+        EXPECT_GE(ran.usage.peak_scratch_bytes, (w_count + channels + in_count + out_count) * sizeof(float));
+        EXPECT_EQ(ran.usage.peak_scratch_bytes, ran.modules[0].usage.peak_scratch_bytes);
+        EXPECT_GE(ran.usage.peak_bytes, ran.usage.data_bytes + ran.usage.tensor_bytes + ran.usage.peak_scratch_bytes);
+    }
+
+    // The output outlives the interpreter and keeps its bytes counted until it is released
+    auto kept = tracker->usage();
+    EXPECT_EQ(0, kept.data_bytes);
+    EXPECT_EQ(padding_allocator::padded(out_count * sizeof(half)), kept.tensor_bytes);
+    EXPECT_EQ(1, allocator.live());
+
+    output.reset();
+    auto released = tracker->usage();
+    EXPECT_EQ(0, released.total_bytes());
+    EXPECT_EQ(0, allocator.live());
+}
@@ -0,0 +1,159 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <nncase/pipeline.h>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace nncase;
+
+TEST(BlockingQueueTest, PopsInOrderAndDrainsAfterClose)
+{
+    blocking_queue<int> queue(4);
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    queue.close();
+    EXPECT_FALSE(queue.push(3));
+    EXPECT_EQ(queue.pop(), 1);
+    EXPECT_EQ(queue.pop(), 2);
+    EXPECT_EQ(queue.pop(), std::nullopt);
+}
+
+TEST(BlockingQueueTest, PushWaitsForRoom)
+{
+    blocking_queue<int> queue(1);
+    EXPECT_TRUE(queue.push(1));
+
+    std::atomic<bool> pushed = false;
+    std::thread producer([&] {
+        EXPECT_TRUE(queue.push(2));
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(pushed);
+    EXPECT_EQ(queue.pop(), 1);
+    producer.join();
+    EXPECT_TRUE(pushed);
+    EXPECT_EQ(queue.pop(), 2);
+}
+
+TEST(BlockingQueueTest, CloseWakesWaiters)
+{
+    blocking_queue<int> empty(1);
+    std::thread consumer([&] { EXPECT_EQ(empty.pop(), std::nullopt); });
+
+    blocking_queue<int> full(1);
+    EXPECT_TRUE(full.push(1));
+    std::thread producer([&] { EXPECT_FALSE(full.push(2)); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    empty.close();
+    full.close();
+    consumer.join();
+    producer.join();
+}
+
+TEST(PipelineTest, WritesEveryInputOnce)
+{
+    constexpr int inputs = 1000;
+    constexpr size_t workers = 4;
+    std::vector<int> written;
+    std::set<std::thread::id> writer_threads;
+    std::atomic<size_t> bad_worker = 0;
+
+    run_pipeline<int, int>(
+        workers, 2, 8,
+        [&](auto &&push) {
+            for (int i = 0; i < inputs; i++)
+                EXPECT_TRUE(push(i));
+        },
+        [&](size_t worker, int &input, auto &&emit) {
+            if (worker >= workers)
+                bad_worker++;
+            emit(input * 2);
+        },
+        [&](int output) {
+            written.push_back(output);
+            writer_threads.insert(std::this_thread::get_id());
+        });
+
+    EXPECT_EQ(bad_worker, 0);
+    EXPECT_EQ(writer_threads.size(), 1);
+    std::sort(written.begin(), written.end());
+    ASSERT_EQ(written.size(), (size_t)inputs);
+    for (int i = 0; i < inputs; i++)
+        EXPECT_EQ(written[i], i * 2);
+}
+
+TEST(PipelineTest, WorkerErrorStopsTheProducer)
+{
+    // The producer would never end on its own
+    auto run = [&] {
+        run_pipeline<int, int>(
+            3, 2, 2,
+            [&](auto &&push) {
+                for (int i = 0; push(i); i++)
+                    ;
+            },
+            [&](size_t, int &input, auto &&emit) {
+                if (input == 100)
+                    throw std::runtime_error("worker");
+                emit(input);
+            },
+            [&](int) {});
+    };
+    EXPECT_THROW(run(), std::runtime_error);
+}
+
+TEST(PipelineTest, WriterErrorStopsTheWorkers)
+{
+    auto run = [&] {
+        run_pipeline<int, int>(
+            2, 2, 1,
+            [&](auto &&push) {
+                for (int i = 0; push(i); i++)
+                    ;
+            },
+            [&](size_t, int &input, auto &&emit) { emit(input); },
+            [&](int output) {
+                if (output == 10)
+                    throw std::runtime_error("writer");
+            });
+    };
+    EXPECT_THROW(run(), std::runtime_error);
+}
+
+TEST(PipelineTest, ProducerErrorIsRethrown)
+{
+    std::atomic<int> processed = 0;
+    auto run = [&] {
+        run_pipeline<int, int>(
+            2, 4, 4,
+            [&](auto &&push) {
+                push(1);
+                throw std::invalid_argument("producer");
+            },
+            [&](size_t, int &, auto &&) { processed++; },
+            [&](int) {});
+    };
+    EXPECT_THROW(run(), std::invalid_argument);
+    EXPECT_LE(processed, 1);
+}
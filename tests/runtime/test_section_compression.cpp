@@ -0,0 +1,213 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <nncase/codegen/compression.h>
+#include <nncase/runtime/error.h>
+#include <random>
+#include <runtime/section.h>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+
+namespace
+{
+constexpr size_t guard_size = 64;
+constexpr uint8_t guard_value = 0xCD;
+
+// Output buffer with guard bytes on both sides to catch out of bounds writes
+class guarded_output
+{
+public:
+    guarded_output(size_t size)
+        : buffer_(size + guard_size * 2, guard_value), size_(size)
+    {
+    }
+
+    gsl::span<gsl::byte> span() noexcept
+    {
+        return { reinterpret_cast<gsl::byte *>(buffer_.data() + guard_size), size_ };
+    }
+
+    std::vector<uint8_t> data() const
+    {
+        return { buffer_.begin() + guard_size, buffer_.begin() + guard_size + size_ };
+    }
+
+    bool guards_intact() const noexcept
+    {
+        auto intact = [](auto begin, auto end) { return std::all_of(begin, end, [](uint8_t v) { return v == guard_value; }); };
+        return intact(buffer_.begin(), buffer_.begin() + guard_size)
+            && intact(buffer_.end() - guard_size, buffer_.end());
+    }
+
+private:
+    std::vector<uint8_t> buffer_;
+    size_t size_;
+};
+
+result<void> decompress(const std::vector<uint8_t> &input, guarded_output &output)
+{
+    // Copy the input to an exactly sized buffer so sanitizers catch over-reads
+    auto exact = std::make_unique<uint8_t[]>(input.size());
+    std::copy(input.begin(), input.end(), exact.get());
+    return decompress_section({ reinterpret_cast<const gsl::byte *>(exact.get()), input.size() }, output.span());
+}
+
+std::vector<uint8_t> round_trip(const std::vector<uint8_t> &input)
+{
+    auto compressed = codegen::compress_section(input);
+    guarded_output output(input.size());
+    auto r = decompress(compressed, output);
+    EXPECT_TRUE(r.is_ok());
+    EXPECT_TRUE(output.guards_intact());
+    return output.data();
+}
+
+std::vector<uint8_t> random_bytes(size_t size, uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<uint8_t> data(size);
+    std::generate(data.begin(), data.end(), [&] { return (uint8_t)dist(gen); });
+    return data;
+}
+
+// Low-entropy data with plenty of short matches, similar to quantized weights
+std::vector<uint8_t> weight_like_bytes(size_t size, uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(0, 3);
+    std::vector<uint8_t> data(size);
+    std::generate(data.begin(), data.end(), [&] { return (uint8_t)(dist(gen) * 17); });
+    return data;
+}
+
+std::vector<uint8_t> compressible_sample()
+{
+    return weight_like_bytes(4096, 7);
+}
+}
+
+TEST(SectionCompressionTest, RoundTripsEmpty)
+{
+    std::vector<uint8_t> input;
+    auto compressed = codegen::compress_section(input);
+    EXPECT_FALSE(compressed.empty());
+    EXPECT_EQ(round_trip(input), input);
+}
+
+TEST(SectionCompressionTest, RoundTripsRandom)
+{
+    for (size_t size : { 1, 5, 12, 13, 100, 4096, 70000 })
+    {
+        auto input = weight_like_bytes(size, (uint32_t)size);
+        EXPECT_EQ(round_trip(input), input) << "size " << size;
+    }
+}
+
+TEST(SectionCompressionTest, RoundTripsIncompressible)
+{
+    auto input = random_bytes(65536, 1);
+    auto compressed = codegen::compress_section(input);
+    // Literal-only blocks only pay for the token and length bytes
+    EXPECT_LE(compressed.size(), input.size() + input.size() / 255 + 16);
+    EXPECT_EQ(round_trip(input), input);
+}
+
+TEST(SectionCompressionTest, RoundTripsRepetitive)
+{
+    std::vector<uint8_t> zeros(200000, 0);
+    auto compressed = codegen::compress_section(zeros);
+    EXPECT_LT(compressed.size(), zeros.size() / 100);
+    EXPECT_EQ(round_trip(zeros), zeros);
+
+    // Short periods exercise matches that overlap their own output
+    for (size_t period : { 1, 2, 3, 7, 300 })
+    {
+        auto pattern = random_bytes(period, (uint32_t)period);
+        std::vector<uint8_t> input(100000);
+        for (size_t i = 0; i < input.size(); i++)
+            input[i] = pattern[i % period];
+        EXPECT_EQ(round_trip(input), input) << "period " << period;
+    }
+}
+
+TEST(SectionCompressionTest, RejectsTruncatedInput)
+{
+    auto input = compressible_sample();
+    auto compressed = codegen::compress_section(input);
+    for (size_t size = 0; size < compressed.size(); size++)
+    {
+        std::vector<uint8_t> truncated(compressed.begin(), compressed.begin() + size);
+        guarded_output output(input.size());
+        EXPECT_TRUE(decompress(truncated, output).is_err()) << "size " << size;
+        EXPECT_TRUE(output.guards_intact()) << "size " << size;
+    }
+}
+
+TEST(SectionCompressionTest, RejectsWrongOutputSize)
+{
+    auto input = compressible_sample();
+    auto compressed = codegen::compress_section(input);
+    for (size_t size : { input.size() - 1, input.size() + 1, (size_t)0 })
+    {
+        guarded_output output(size);
+        EXPECT_TRUE(decompress(compressed, output).is_err()) << "size " << size;
+        EXPECT_TRUE(output.guards_intact()) << "size " << size;
+    }
+}
+
+TEST(SectionCompressionTest, RejectsBadMatchOffset)
+{
+    // One literal, then a match at offset 0 or before the start of the output
+    for (uint8_t offset : { 0, 2 })
+    {
+        std::vector<uint8_t> block { 0x10, 'a', offset, 0, 0x00 };
+        guarded_output output(5);
+        EXPECT_TRUE(decompress(block, output).is_err()) << "offset " << (int)offset;
+        EXPECT_TRUE(output.guards_intact());
+    }
+}
+
+TEST(SectionCompressionTest, RejectsUnterminatedLength)
+{
+    // A literal length extension that runs off the end of the input
+    std::vector<uint8_t> block { 0xF0, 255, 255 };
+    guarded_output output(1024);
+    EXPECT_TRUE(decompress(block, output).is_err());
+    EXPECT_TRUE(output.guards_intact());
+}
+
+TEST(SectionCompressionTest, SurvivesCorruptInput)
+{
+    auto input = compressible_sample();
+    auto compressed = codegen::compress_section(input);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> pos_dist(0, compressed.size() - 1);
+    std::uniform_int_distribution<int> byte_dist(0, 255);
+    for (size_t i = 0; i < 500; i++)
+    {
+        auto corrupt = compressed;
+        for (size_t flips = 1 + i % 4; flips; flips--)
+            corrupt[pos_dist(gen)] = (uint8_t)byte_dist(gen);
+
+        // Corruption may still decode to a block of the right size, but must never escape the output
+        guarded_output output(input.size());
+        (void)decompress(corrupt, output);
+        EXPECT_TRUE(output.guards_intact()) << "iteration " << i;
+    }
+}
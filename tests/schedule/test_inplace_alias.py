@@ -0,0 +1,118 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+"""System test: in-place ops reuse the buffer of their input"""
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import re
+import numpy as np
+import pytest
+import nncase
+from onnx import helper
+from onnx import TensorProto
+
+in_shape = [1, 4, 8, 8]
+
+
+def _conv1x1(name, input, output, initializers):
+    weights = np.random.rand(in_shape[1], in_shape[1], 1, 1).astype(np.float32) - 0.5
+    initializers.append(helper.make_tensor(name + '_w', TensorProto.FLOAT,
+                                           weights.shape, weights.flatten().tolist()))
+    return helper.make_node('Conv', [input, name + '_w'], [output], name=name), weights[:, :, 0, 0]
+
+
+def _make_module(conv_has_two_consumers):
+    nodes = []
+    initializers = []
+    input = helper.make_tensor_value_info('input', TensorProto.FLOAT, in_shape)
+    output = helper.make_tensor_value_info('output', TensorProto.FLOAT, in_shape)
+
+    conv, w1 = _conv1x1('conv', 'input', 'conv_out', initializers)
+    nodes.append(conv)
+    nodes.append(helper.make_node('Sin', ['conv_out'], ['sin_out'], name='sin'))
+    nodes.append(helper.make_node('Cos', ['sin_out'], ['cos_out'], name='cos'))
+    last = 'cos_out'
+    if conv_has_two_consumers:
+        nodes.append(helper.make_node('Add', ['conv_out', 'cos_out'], ['add_out'], name='add'))
+        last = 'add_out'
+    conv2, w2 = _conv1x1('conv2', last, 'output', initializers)
+    nodes.append(conv2)
+
+    graph_def = helper.make_graph(nodes, 'test-model', [input], [output], initializer=initializers)
+    return helper.make_model(graph_def, producer_name='kendryte'), w1, w2
+
+
+def _expected(data, w1, w2, conv_has_two_consumers):
+    conv = np.einsum('oc,nchw->nohw', w1, data)
+    x = np.cos(np.sin(conv))
+    if conv_has_two_consumers:
+        x = x + conv
+    return np.einsum('oc,nchw->nohw', w2, x)
+
+
+def _physical_buffer_owners(dump_dir):
+    owners = []
+    for sched in dump_dir.visit('*.sched'):
+        in_section = False
+        for line in sched.read().splitlines():
+            if line.startswith('.'):
+                in_section = line == '.physical_buffer'
+            elif in_section:
+                m = re.match(r'%\d+\((.*)\)\t : ', line)
+                if m:
+                    owners.append(m.group(1))
+    return owners
+
+
+def _compile_and_run(tmpdir, conv_has_two_consumers):
+    model_def, w1, w2 = _make_module(conv_has_two_consumers)
+    compile_options = nncase.CompileOptions()
+    compile_options.target = 'cpu'
+    compile_options.dump_ir = True
+    compile_options.dump_dir = str(tmpdir)
+    compiler = nncase.Compiler(compile_options)
+    compiler.import_onnx(model_def.SerializeToString(), nncase.ImportOptions())
+    compiler.compile()
+    kmodel = compiler.gencode_tobytes()
+
+    data = np.random.rand(*in_shape).astype(np.float32)
+    sim = nncase.Simulator()
+    sim.load_model(kmodel)
+    sim.set_input_tensor(0, nncase.RuntimeTensor.from_numpy(data))
+    sim.run()
+    np.testing.assert_allclose(sim.get_output_tensor(0).to_numpy(),
+                               _expected(data, w1, w2, conv_has_two_consumers), rtol=1e-4, atol=1e-5)
+    return _physical_buffer_owners(tmpdir)
+
+
+def _owns_buffer(owners, node):
+    # importers name nodes like "sin(Sin)" or "conv.conv2d(Conv)"
+    return any(re.split(r'[.(]', o)[0] == node for o in owners)
+
+
+def test_inplace_chain_reuses_buffer(tmpdir):
+    owners = _compile_and_run(tmpdir, False)
+    assert not _owns_buffer(owners, 'sin')
+    assert not _owns_buffer(owners, 'cos')
+
+
+def test_inplace_refused_for_shared_input(tmpdir):
+    # conv_out is also read by add after sin, so sin must not overwrite it
+    owners = _compile_and_run(tmpdir, True)
+    assert _owns_buffer(owners, 'sin')
+    assert not _owns_buffer(owners, 'cos')
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_inplace_alias.py'])
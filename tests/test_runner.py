@@ -441,6 +441,7 @@ class TestRunner(metaclass=ABCMeta):
             elif os.path.splitext(model_file)[-1] == ".onnx":
                 compile_options.input_layout = cfg['input_layout']
                 compile_options.output_layout = cfg['output_layout']
+                import_options.model_dir = os.path.dirname(model_file)
         elif isinstance(model_file, list):
             if os.path.splitext(model_file[1])[-1] == ".caffemodel":
                 compile_options.input_layout = cfg['input_layout']
@@ -0,0 +1,66 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import pytest
+import numpy as np
+from onnx import helper
+from onnx import TensorProto
+from onnx_test_runner import OnnxTestRunner
+
+
+def _make_module(in_shape):
+    initializers = []
+    nodes = []
+
+    input = helper.make_tensor_value_info('input', TensorProto.FLOAT, in_shape)
+    output = helper.make_tensor_value_info('output', TensorProto.FLOAT, in_shape)
+
+    def constant(name):
+        value = np.random.rand(*in_shape).astype(np.float32)
+        initializers.append(helper.make_tensor(name, TensorProto.FLOAT, in_shape, value.flatten().tolist()))
+
+    # constant chain: c0 -> sin -> mul(c1) -> add(c2) -> exp
+    constant('c0')
+    constant('c1')
+    constant('c2')
+    nodes.append(helper.make_node('Sin', ['c0'], ['sin_out'], name='sin'))
+    nodes.append(helper.make_node('Mul', ['sin_out', 'c1'], ['mul_out'], name='mul'))
+    nodes.append(helper.make_node('Add', ['mul_out', 'c2'], ['add_out'], name='add'))
+    nodes.append(helper.make_node('Exp', ['add_out'], ['exp_out'], name='exp'))
+
+    # sin_out is also read outside the chain, so it must survive folding next to exp_out
+    nodes.append(helper.make_node('Add', ['input', 'sin_out'], ['shifted'], name='shift'))
+    nodes.append(helper.make_node('Mul', ['shifted', 'exp_out'], ['output'], name='scale'))
+
+    graph_def = helper.make_graph(nodes, 'test-model', [input], [output], initializer=initializers)
+    return helper.make_model(graph_def, producer_name='kendryte')
+
+
+in_shapes = [
+    [1, 3, 8, 8]
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+def test_fold_constant_chain(in_shape, request):
+    model_def = _make_module(in_shape)
+
+    runner = OnnxTestRunner(request.node.name)
+    model_file = runner.from_onnx_helper(model_def)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_fold_constant_chain.py'])
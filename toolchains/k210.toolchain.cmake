@@ -4,6 +4,7 @@ set(K210_SDK_DIR ${K210_SDK_DIR} CACHE STRING "root path to k210 sdk")
 
 set(ENABLE_K210_RUNTIME ON)
 set(DEFAULT_BUILTIN_RUNTIMES OFF)
+set(ENABLE_ASYNC_RUNTIME OFF)
 set(DEFAULT_SHARED_RUNTIME_TENSOR_PLATFORM_IMPL OFF)
 
 if(K210_SDK_DIR)
@@ -15,6 +15,7 @@ set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
 set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
 set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
 set(ENABLE_VULKAN_RUNTIME OFF)
+set(ENABLE_ASYNC_RUNTIME OFF)
 set(ENABLE_OPENMP OFF)
 set(ENABLE_VULKAN OFF)
 set(ENABLE_HALIDE OFF)
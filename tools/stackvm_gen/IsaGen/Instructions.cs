@@ -179,6 +179,7 @@ namespace IsaGen
         TRANSPOSE,
         TOPK,
         UNARY,
+        PREPROCESS,
     }
 
     [BitLength(8)]
@@ -1499,6 +1500,54 @@ namespace IsaGen
             public ushort TableLength { get; set; }
         }
 
+        [DisplayName("TENSOR.MATMUL")]
+        [Category("Tensor Instructions")]
+        [Description("MatMul")]
+        public class MatMulInstruction : TensorInstruction
+        {
+            public override TensorFunction Function => TensorFunction.MATMUL;
+
+            [DisplayName("datatype")]
+            [Description("Datatype")]
+            public DataType DataType { get; set; }
+
+            [DisplayName("rshape_src1")]
+            [Description("Source1 shape register")]
+            public byte RshapeSrc1 { get; set; }
+
+            [DisplayName("rstride_src1")]
+            [Description("Source1 stride register")]
+            public byte RstrideSrc1 { get; set; }
+
+            [DisplayName("rshape_src2")]
+            [Description("Source2 shape register")]
+            public byte RshapeSrc2 { get; set; }
+
+            [DisplayName("rstride_src2")]
+            [Description("Source2 stride register")]
+            public byte RstrideSrc2 { get; set; }
+
+            [DisplayName("rstride_dest")]
+            [Description("Dest stride register")]
+            public byte RstrideDest { get; set; }
+
+            [DisplayName("transpose_a")]
+            [Description("Transpose source1")]
+            public bool TransposeA { get; set; }
+
+            [DisplayName("transpose_b")]
+            [Description("Transpose source2")]
+            public bool TransposeB { get; set; }
+
+            [DisplayName("fused_clamp_low")]
+            [Description("FusedClampLow")]
+            public float FusedClampLow { get; set; }
+
+            [DisplayName("fused_clamp_high")]
+            [Description("FusedClampHigh")]
+            public float FusedClampHigh { get; set; }
+        }
+
         [DisplayName("TENSOR.ONEHOT")]
         [Category("Tensor Instructions")]
         [Description("OneHot")]
@@ -1563,6 +1612,66 @@ namespace IsaGen
             public PadMode PadMode { get; set; }
         }
 
+        [DisplayName("TENSOR.PREPROCESS")]
+        [Category("Tensor Instructions")]
+        [Description("Preprocess")]
+        public class PreprocessInstruction : TensorInstruction
+        {
+            public override TensorFunction Function => TensorFunction.PREPROCESS;
+
+            [DisplayName("datatype")]
+            [Description("Datatype")]
+            public DataType DataType { get; set; }
+
+            [DisplayName("rshape_src")]
+            [Description("Source shape register")]
+            public byte RshapeSrc { get; set; }
+
+            [DisplayName("rstride_src")]
+            [Description("Source stride register")]
+            public byte RstrideSrc { get; set; }
+
+            [DisplayName("rstride_dest")]
+            [Description("Dest stride register")]
+            public byte RstrideDest { get; set; }
+
+            [DisplayName("rpaddings")]
+            [Description("Letterbox paddings register")]
+            public byte Rpaddings { get; set; }
+
+            [DisplayName("input_nhwc")]
+            [Description("Input is NHWC")]
+            public bool InputNHWC { get; set; }
+
+            [DisplayName("output_nhwc")]
+            [Description("Output is NHWC")]
+            public bool OutputNHWC { get; set; }
+
+            [DisplayName("swap_rb")]
+            [Description("Swap R and B channels")]
+            public bool SwapRB { get; set; }
+
+            [DisplayName("zero_point")]
+            [Description("Dequantize zero point")]
+            public int ZeroPoint { get; set; }
+
+            [DisplayName("scale")]
+            [Description("Dequantize scale")]
+            public float Scale { get; set; }
+
+            [DisplayName("resize_h")]
+            [Description("Letterbox resize height")]
+            public int ResizeH { get; set; }
+
+            [DisplayName("resize_w")]
+            [Description("Letterbox resize width")]
+            public int ResizeW { get; set; }
+
+            [DisplayName("pad_value")]
+            [Description("Letterbox pad value")]
+            public float PadValue { get; set; }
+        }
+
         [DisplayName("TENSOR.QUANTIZE")]
         [Category("Tensor Instructions")]
         [Description("Quantize")]